@@ -0,0 +1,108 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadPool.h"
+
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+
+namespace carla {
+
+  /// Runs tasks that write files in a pool of background threads, so the
+  /// caller does not wait for the encoding and the disk.
+  ///
+  /// At most @a max_pending_tasks tasks are queued or running, posting more
+  /// blocks the caller until some finish, which keeps the memory held by the
+  /// queued tasks bounded when the disk cannot keep up.
+  class AsyncFileWriter : private NonCopyable {
+  public:
+
+    explicit AsyncFileWriter(size_t worker_threads = 2u, size_t max_pending_tasks = 64u)
+      : _max_pending_tasks(max_pending_tasks) {
+      DEBUG_ASSERT(worker_threads > 0u);
+      DEBUG_ASSERT(max_pending_tasks > 0u);
+      _pool.AsyncRun(worker_threads);
+    }
+
+    /// Waits for the pending tasks before joining the threads.
+    ~AsyncFileWriter() {
+      Flush();
+    }
+
+    /// Post a task that writes a file and returns its path. Errors are logged
+    /// and forwarded to the returned future, which may be discarded.
+    ///
+    /// @warning Blocks while the queue is full.
+    template <typename FunctorT>
+    std::future<std::string> Post(FunctorT &&functor) {
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]() { return _pending_tasks < _max_pending_tasks; });
+        ++_pending_tasks;
+      }
+      return _pool.Post([this, task=std::forward<FunctorT>(functor)]() mutable -> std::string {
+        std::exception_ptr error;
+        std::string path;
+        try {
+          // Destroy the task, and whatever it keeps alive, before notifying.
+          auto local_task = std::move(task);
+          path = local_task();
+        } catch (const std::exception &e) {
+          log_error("failed to write file:", e.what());
+          error = std::current_exception();
+        }
+        OnTaskFinished();
+        if (error != nullptr) {
+          std::rethrow_exception(error);
+        }
+        return path;
+      });
+    }
+
+    /// Block until every task posted so far has finished.
+    void Flush() {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait(lock, [this]() { return _pending_tasks == 0u; });
+    }
+
+    size_t GetMaxNumberOfPendingTasks() const {
+      return _max_pending_tasks;
+    }
+
+    size_t GetNumberOfPendingTasks() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _pending_tasks;
+    }
+
+  private:
+
+    void OnTaskFinished() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      DEBUG_ASSERT(_pending_tasks > 0u);
+      --_pending_tasks;
+      _cv.notify_all();
+    }
+
+    const size_t _max_pending_tasks;
+
+    mutable std::mutex _mutex;
+
+    std::condition_variable _cv;
+
+    size_t _pending_tasks = 0u;
+
+    ThreadPool _pool;
+  };
+
+} // namespace carla
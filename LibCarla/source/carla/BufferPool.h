@@ -8,53 +8,182 @@
 
 #include "carla/Buffer.h"
 
-#if defined(__clang__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wold-style-cast"
-#endif
-#include "moodycamel/ConcurrentQueue.h"
-#if defined(__clang__)
-#  pragma clang diagnostic pop
-#endif
-
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace carla {
 
   /// A pool of Buffer. Buffers popped from this pool automatically return to
   /// the pool on destruction so the allocated memory can be reused.
   ///
+  /// Idle buffers are kept in size classes by capacity (powers of two), so a
+  /// buffer of the right size is found without scanning the whole pool.
+  ///
+  /// Every @a trim_period pops, the buffers that stayed idle for the whole
+  /// period are released, this way the pool follows the high-water mark of
+  /// the buffers in use instead of keeping the worst case forever.
+  ///
   /// @warning Buffers adjust their size only by growing, they never shrink
-  /// unless explicitly cleared. The allocated memory is only deleted when this
-  /// pool is destroyed.
+  /// unless explicitly cleared.
   class BufferPool : public std::enable_shared_from_this<BufferPool> {
   public:
 
+    using size_type = Buffer::size_type;
+
+    struct Statistics {
+      /// Number of buffers waiting in the pool.
+      size_t idle_buffers = 0u;
+      /// Memory held by the buffers waiting in the pool.
+      size_t idle_bytes = 0u;
+      /// Number of pops that found a suitable buffer in the pool.
+      uint64_t hits = 0u;
+      /// Number of pops that had to allocate a new buffer.
+      uint64_t misses = 0u;
+      /// Number of idle buffers released by trimming.
+      uint64_t trimmed = 0u;
+    };
+
+    static constexpr size_t default_trim_period = 1000u;
+
     BufferPool() = default;
 
-    explicit BufferPool(size_t estimated_size) : _queue(estimated_size) {}
+    /// @param trim_period number of pops between trims, 0 disables trimming.
+    explicit BufferPool(size_t trim_period) : _trim_period(trim_period) {}
 
-    /// Pop a Buffer from the queue, creates a new one if the queue is empty.
+    /// Pop the biggest Buffer in the pool, creates a new one if the pool is
+    /// empty.
     Buffer Pop() {
       Buffer item;
-      _queue.try_dequeue(item); // we don't care if it fails.
+      std::vector<Buffer> trimmed;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto i = _classes.size(); i > 0u; --i) {
+          if (!_classes[i - 1u].empty()) {
+            item = TakeBack(i - 1u);
+            break;
+          }
+        }
+        CountPop(item.capacity() > 0u, trimmed);
+      }
+      return Adopt(std::move(item));
+    }
+
+    /// Pop a Buffer of @a size bytes, reusing an idle buffer with enough
+    /// capacity if there is one in the pool.
+    Buffer Pop(size_type size) {
+      Buffer item;
+      std::vector<Buffer> trimmed;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto size_class = GetSizeClass(size);
+        auto &candidates = _classes[size_class];
+        auto it = std::find_if(candidates.begin(), candidates.end(), [=](const Buffer &buffer) {
+          return buffer.capacity() >= size;
+        });
+        if (it != candidates.end()) {
+          std::swap(*it, candidates.back());
+          item = TakeBack(size_class);
+        } else if ((size_class + 1u < _classes.size()) && !_classes[size_class + 1u].empty()) {
+          // Any buffer of the next class fits, do not look further to avoid
+          // wasting big buffers in small messages.
+          item = TakeBack(size_class + 1u);
+        }
+        CountPop(item.capacity() > 0u, trimmed);
+      }
+      item.reset(size);
+      return Adopt(std::move(item));
+    }
+
+    Statistics GetStatistics() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto result = _statistics;
+      for (auto &size_class : _classes) {
+        result.idle_buffers += size_class.size();
+        for (auto &buffer : size_class) {
+          result.idle_bytes += buffer.capacity();
+        }
+      }
+      return result;
+    }
+
+  private:
+
+    friend class Buffer;
+
+    static constexpr size_t number_of_classes = 8u * sizeof(size_type);
+
+    /// Index of the highest bit set in @a capacity.
+    static size_t GetSizeClass(size_type capacity) {
+      size_t result = 0u;
+      while (capacity > 1u) {
+        capacity >>= 1u;
+        ++result;
+      }
+      return result;
+    }
+
+    Buffer Adopt(Buffer &&item) {
 #if __cplusplus >= 201703L // C++17
       item._parent_pool = weak_from_this();
 #else
       item._parent_pool = shared_from_this();
 #endif
-      return item;
+      return std::move(item);
     }
 
-  private:
+    Buffer TakeBack(size_t size_class) {
+      auto &idle = _classes[size_class];
+      Buffer item = std::move(idle.back());
+      idle.pop_back();
+      _low_water_marks[size_class] = std::min(_low_water_marks[size_class], idle.size());
+      return item;
+    }
 
-    friend class Buffer;
+    /// Update the statistics, and at the end of a trim period move to @a
+    /// trimmed the buffers that were not needed during the period. The caller
+    /// releases them after unlocking the mutex.
+    void CountPop(bool hit, std::vector<Buffer> &trimmed) {
+      ++(hit ? _statistics.hits : _statistics.misses);
+      if ((_trim_period == 0u) || (++_pops_since_trim < _trim_period)) {
+        return;
+      }
+      _pops_since_trim = 0u;
+      for (auto i = 0u; i < _classes.size(); ++i) {
+        auto &idle = _classes[i];
+        // The oldest buffers are at the front.
+        const auto count = std::min(_low_water_marks[i], idle.size());
+        for (auto j = 0u; j < count; ++j) {
+          idle[j]._parent_pool.reset();
+          trimmed.emplace_back(std::move(idle[j]));
+        }
+        idle.erase(idle.begin(), idle.begin() + static_cast<std::ptrdiff_t>(count));
+        _low_water_marks[i] = idle.size();
+        _statistics.trimmed += count;
+      }
+    }
 
     void Push(Buffer &&buffer) {
-      _queue.enqueue(std::move(buffer));
+      const auto size_class = GetSizeClass(buffer.capacity());
+      std::lock_guard<std::mutex> lock(_mutex);
+      _classes[size_class].emplace_back(std::move(buffer));
     }
 
-    moodycamel::ConcurrentQueue<Buffer> _queue;
+    const size_t _trim_period = default_trim_period;
+
+    mutable std::mutex _mutex;
+
+    std::array<std::vector<Buffer>, number_of_classes> _classes;
+
+    /// Minimum number of idle buffers of each class since the last trim.
+    std::array<size_t, number_of_classes> _low_water_marks{};
+
+    size_t _pops_since_trim = 0u;
+
+    Statistics _statistics;
   };
 
 } // namespace carla
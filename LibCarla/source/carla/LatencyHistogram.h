@@ -0,0 +1,128 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+
+  /// Histogram of latencies with buckets of powers of two microseconds:
+  /// bucket 0 counts the samples under 1us and bucket i the samples in
+  /// [2^(i-1), 2^i) us, the last bucket also counts everything above.
+  ///
+  /// Samples are recorded with relaxed atomics, Record can be called from any
+  /// number of threads without locking.
+  class LatencyHistogram : private NonCopyable {
+  public:
+
+    static constexpr size_t number_of_buckets = 32u;
+
+    struct Statistics {
+      /// Number of samples recorded.
+      uint64_t count = 0u;
+      /// Average latency in milliseconds.
+      double mean = 0.0;
+      /// Maximum latency in milliseconds.
+      double max = 0.0;
+      /// Percentiles in milliseconds, approximated by the upper bound of
+      /// their bucket.
+      double p50 = 0.0;
+      double p90 = 0.0;
+      double p99 = 0.0;
+      /// Number of samples in each bucket.
+      std::vector<uint64_t> buckets;
+    };
+
+    LatencyHistogram() {
+      Reset();
+    }
+
+    template <typename Rep, typename Period>
+    void Record(std::chrono::duration<Rep, Period> latency) {
+      const auto us = static_cast<uint64_t>(std::max<int64_t>(
+          0,
+          std::chrono::duration_cast<std::chrono::microseconds>(latency).count()));
+      _buckets[GetBucket(us)].fetch_add(1u, std::memory_order_relaxed);
+      _sum.fetch_add(us, std::memory_order_relaxed);
+      auto max = _max.load(std::memory_order_relaxed);
+      while ((us > max) && !_max.compare_exchange_weak(max, us, std::memory_order_relaxed));
+    }
+
+    /// Snapshot of the histogram, it may be slightly inconsistent if samples
+    /// are recorded concurrently.
+    Statistics GetStatistics() const {
+      Statistics result;
+      result.buckets.reserve(number_of_buckets);
+      for (auto &bucket : _buckets) {
+        result.buckets.emplace_back(bucket.load(std::memory_order_relaxed));
+      }
+      for (auto count : result.buckets) {
+        result.count += count;
+      }
+      if (result.count == 0u) {
+        return result;
+      }
+      const auto max_us = _max.load(std::memory_order_relaxed);
+      result.mean = ToMilliseconds(_sum.load(std::memory_order_relaxed)) / static_cast<double>(result.count);
+      result.max = ToMilliseconds(max_us);
+      result.p50 = GetPercentile(result, 0.50, max_us);
+      result.p90 = GetPercentile(result, 0.90, max_us);
+      result.p99 = GetPercentile(result, 0.99, max_us);
+      return result;
+    }
+
+    void Reset() {
+      for (auto &bucket : _buckets) {
+        bucket.store(0u, std::memory_order_relaxed);
+      }
+      _sum.store(0u, std::memory_order_relaxed);
+      _max.store(0u, std::memory_order_relaxed);
+    }
+
+  private:
+
+    static size_t GetBucket(uint64_t us) {
+      size_t bucket = 0u;
+      while ((us > 0u) && (bucket + 1u < number_of_buckets)) {
+        us >>= 1u;
+        ++bucket;
+      }
+      return bucket;
+    }
+
+    static double ToMilliseconds(uint64_t us) {
+      return static_cast<double>(us) / 1000.0;
+    }
+
+    static double GetPercentile(const Statistics &statistics, double percentile, uint64_t max_us) {
+      const auto target = static_cast<uint64_t>(percentile * static_cast<double>(statistics.count));
+      uint64_t accumulated = 0u;
+      for (auto i = 0u; i < statistics.buckets.size(); ++i) {
+        accumulated += statistics.buckets[i];
+        if (accumulated > target) {
+          const uint64_t upper_bound = (i + 1u < number_of_buckets) ? (uint64_t(1u) << i) : max_us;
+          return ToMilliseconds(std::min(upper_bound, max_us));
+        }
+      }
+      return ToMilliseconds(max_us);
+    }
+
+    std::array<std::atomic<uint64_t>, number_of_buckets> _buckets;
+
+    std::atomic<uint64_t> _sum;
+
+    std::atomic<uint64_t> _max;
+  };
+
+} // namespace carla
@@ -0,0 +1,147 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace carla {
+namespace detail {
+
+  /// Thread-safe free list of memory blocks of @a BlockSize bytes, keeps up
+  /// to @a MaxIdleBlocks released blocks for reuse.
+  template <size_t BlockSize, size_t MaxIdleBlocks = 64u>
+  class FixedSizeMemoryPool : private NonCopyable {
+  public:
+
+    /// The instance is never destroyed, blocks may still be released during
+    /// the destruction of static objects.
+    static FixedSizeMemoryPool &GetInstance() {
+      static auto *instance = new FixedSizeMemoryPool;
+      return *instance;
+    }
+
+    void *Allocate() {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_idle_blocks.empty()) {
+          void *block = _idle_blocks.back();
+          _idle_blocks.pop_back();
+          return block;
+        }
+      }
+      return ::operator new(BlockSize);
+    }
+
+    void Deallocate(void *block) {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_idle_blocks.size() < MaxIdleBlocks) {
+          _idle_blocks.emplace_back(block);
+          return;
+        }
+      }
+      ::operator delete(block);
+    }
+
+  private:
+
+    FixedSizeMemoryPool() {
+      _idle_blocks.reserve(MaxIdleBlocks);
+    }
+
+    std::mutex _mutex;
+
+    std::vector<void *> _idle_blocks;
+  };
+
+  template <typename T>
+  using MemoryPoolFor = FixedSizeMemoryPool<sizeof(T)>;
+
+  template <typename T>
+  struct PooledDeleter {
+    void operator()(T *object) const {
+      object->~T();
+      MemoryPoolFor<T>::GetInstance().Deallocate(object);
+    }
+  };
+
+} // namespace detail
+
+  /// Allocator drawing single objects from a FixedSizeMemoryPool, arrays fall
+  /// back to the global allocator.
+  template <typename T>
+  class PoolAllocator {
+  public:
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+      using other = PoolAllocator<U>;
+    };
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) {
+      static_assert(
+          alignof(T) <= alignof(std::max_align_t),
+          "Over-aligned types are not supported");
+      if (n == 1u) {
+        return static_cast<T *>(detail::MemoryPoolFor<T>::GetInstance().Allocate());
+      }
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *pointer, size_t n) noexcept {
+      if (n == 1u) {
+        detail::MemoryPoolFor<T>::GetInstance().Deallocate(pointer);
+      } else {
+        ::operator delete(pointer);
+      }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept {
+      return true;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept {
+      return false;
+    }
+  };
+
+  /// Like MakeShared, but the object and its reference count are allocated
+  /// from memory pools, so creating objects at a steady rate does not hit the
+  /// global allocator.
+  ///
+  /// @a construct receives the memory for a T and must construct the object
+  /// in it with placement new, which allows building types whose constructor
+  /// is only accessible from the caller.
+  template <typename T, typename ConstructorT>
+  static inline SharedPtr<T> MakePooledShared(ConstructorT &&construct) {
+    auto &pool = detail::MemoryPoolFor<T>::GetInstance();
+    // Return the memory to the pool if the constructor throws.
+    auto release = [&pool](void *memory) { pool.Deallocate(memory); };
+    std::unique_ptr<void, decltype(release)> memory(pool.Allocate(), release);
+    T *object = construct(memory.get());
+    memory.release();
+    return SharedPtr<T>(object, detail::PooledDeleter<T>{}, PoolAllocator<T>{});
+  }
+
+} // namespace carla
@@ -34,6 +34,27 @@ namespace carla {
       namespace mp = ::clmdep_msgpack;
       return mp::unpack(reinterpret_cast<const char *>(data), size).template as<T>();
     }
+
+    /// Size of @a objs packed one after the other, computed without copying
+    /// them to a buffer.
+    template <typename... Ts>
+    static size_t GetPackedSize(const Ts &... objs) {
+      namespace mp = ::clmdep_msgpack;
+      SizeCounter counter;
+      mp::packer<SizeCounter> packer(counter);
+      using expander = int[];
+      (void)expander{0, ((void)packer.pack(objs), 0)...};
+      return counter.size;
+    }
+
+  private:
+
+    struct SizeCounter {
+      size_t size = 0u;
+      void write(const char *, size_t length) {
+        size += length;
+      }
+    };
   };
 
 } // namespace carla
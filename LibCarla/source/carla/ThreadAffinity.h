@@ -0,0 +1,91 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/StringUtil.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif // __linux__
+
+namespace carla {
+
+  /// Parse a list of CPUs in the format of taskset, e.g. "0-3,8,10-11".
+  /// Returns an empty list if @a str is not valid.
+  inline std::vector<size_t> ParseCpuList(const std::string &str) {
+    std::vector<size_t> result;
+    std::vector<std::string> items;
+    StringUtil::Split(items, str, ",");
+    for (auto &item : items) {
+      StringUtil::Trim(item);
+      if (item.empty()) {
+        continue;
+      }
+      try {
+        const auto dash = item.find('-');
+        const auto first = std::stoul(item.substr(0u, dash));
+        const auto last = (dash == std::string::npos) ? first : std::stoul(item.substr(dash + 1u));
+        if (last < first) {
+          return {};
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+          result.emplace_back(cpu);
+        }
+      } catch (const std::exception &) {
+        return {};
+      }
+    }
+    return result;
+  }
+
+  /// Pin the calling thread to @a cpus. Threads created afterwards by this
+  /// thread inherit its affinity.
+  ///
+  /// @return false if @a cpus is empty, or pinning threads is not supported
+  /// on this platform.
+  inline bool SetCurrentThreadAffinity(const std::vector<size_t> &cpus) {
+#if defined(__linux__)
+    if (cpus.empty()) {
+      return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif // __linux__
+  }
+
+  /// CPUs the calling thread is allowed to run on, empty if unknown.
+  inline std::vector<size_t> GetCurrentThreadAffinity() {
+    std::vector<size_t> result;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+      for (size_t cpu = 0u; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+          result.emplace_back(cpu);
+        }
+      }
+    }
+#endif // __linux__
+    return result;
+  }
+
+} // namespace carla
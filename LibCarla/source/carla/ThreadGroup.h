@@ -36,6 +36,10 @@ namespace carla {
       }
     }
 
+    size_t size() const {
+      return _threads.size();
+    }
+
     void JoinAll() {
       for (auto &thread : _threads) {
         DEBUG_ASSERT_NE(thread.get_id(), std::this_thread::get_id());
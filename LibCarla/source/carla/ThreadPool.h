@@ -6,20 +6,41 @@
 
 #pragma once
 
+#include "carla/Logging.h"
 #include "carla/MoveHandler.h"
 #include "carla/NonCopyable.h"
+#include "carla/ThreadAffinity.h"
 #include "carla/ThreadGroup.h"
 #include "carla/Time.h"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
 
+#include <algorithm>
 #include <future>
+#include <mutex>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 namespace carla {
 
+  /// Number of threads of a pool and the CPUs they run on.
+  struct ThreadPoolOptions {
+    /// Threads launched when the pool starts running.
+    size_t threads = 1u;
+    /// Upper bound for the pools that grow with their load, zero for the
+    /// hardware concurrency.
+    size_t max_threads = 0u;
+    /// CPUs the threads are pinned to, empty to not pin them.
+    std::vector<size_t> cpu_affinity;
+
+    size_t GetMaxThreads() const {
+      const size_t max = max_threads > 0u ? max_threads : std::thread::hardware_concurrency();
+      return std::max({max, threads, size_t(1u)});
+    }
+  };
+
   /// A thread pool based on Boost.Asio's io context.
   class ThreadPool : private NonCopyable {
   public:
@@ -49,7 +70,8 @@ namespace carla {
     /// threads if @a worker_threads is provided, otherwise use all available
     /// hardware concurrency.
     void AsyncRun(size_t worker_threads) {
-      _workers.CreateThreads(worker_threads, [this]() { Run(); });
+      std::lock_guard<std::mutex> lock(_workers_mutex);
+      LaunchThreads(worker_threads);
     }
 
     /// @copydoc AsyncRun(size_t)
@@ -57,6 +79,33 @@ namespace carla {
       AsyncRun(std::thread::hardware_concurrency());
     }
 
+    /// Launch @a options.threads threads pinned to @a options.cpu_affinity.
+    void AsyncRun(const ThreadPoolOptions &options) {
+      SetCpuAffinity(options.cpu_affinity);
+      AsyncRun(options.threads);
+    }
+
+    /// Launch threads until the pool has at least @a worker_threads.
+    void EnsureThreads(size_t worker_threads) {
+      std::lock_guard<std::mutex> lock(_workers_mutex);
+      if (_workers.size() < worker_threads) {
+        LaunchThreads(worker_threads - _workers.size());
+      }
+    }
+
+    /// Number of threads launched.
+    size_t GetNumberOfThreads() const {
+      std::lock_guard<std::mutex> lock(_workers_mutex);
+      return _workers.size();
+    }
+
+    /// Pin the threads launched from now on to @a cpus, empty to not pin
+    /// them.
+    void SetCpuAffinity(std::vector<size_t> cpus) {
+      std::lock_guard<std::mutex> lock(_workers_mutex);
+      _cpu_affinity = std::move(cpus);
+    }
+
     /// Run tasks in this thread.
     ///
     /// @warning This function blocks until the ThreadPool has been stopped.
@@ -75,16 +124,31 @@ namespace carla {
     /// Stop the ThreadPool and join all its threads.
     void Stop() {
       _io_context.stop();
+      std::lock_guard<std::mutex> lock(_workers_mutex);
       _workers.JoinAll();
     }
 
   private:
 
+    /// @pre _workers_mutex is locked.
+    void LaunchThreads(size_t count) {
+      _workers.CreateThreads(count, [this, cpus=_cpu_affinity]() {
+        if (!cpus.empty() && !SetCurrentThreadAffinity(cpus)) {
+          log_warning("thread pool: unable to set the CPU affinity");
+        }
+        Run();
+      });
+    }
+
     boost::asio::io_context _io_context;
 
     boost::asio::io_context::work _work_to_do;
 
+    mutable std::mutex _workers_mutex;
+
     ThreadGroup _workers;
+
+    std::vector<size_t> _cpu_affinity;
   };
 
 } // namespace carla
@@ -0,0 +1,38 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Transform.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/rpc/ActorId.h"
+
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  /// Kinematics of all the actors of a WorldSnapshot stored as parallel
+  /// arrays, in the same order the snapshot iterates its actors.
+  struct ActorKinematics {
+
+    std::vector<ActorId> ids;
+
+    std::vector<geom::Transform> transforms;
+
+    std::vector<geom::Vector3D> velocities;
+
+    std::vector<geom::Vector3D> angular_velocities;
+
+    std::vector<geom::Vector3D> accelerations;
+
+    size_t size() const {
+      return ids.size();
+    }
+  };
+
+} // namespace client
+} // namespace carla
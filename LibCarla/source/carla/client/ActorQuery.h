@@ -0,0 +1,73 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/BoundingBox.h"
+#include "carla/geom/Location.h"
+#include "carla/geom/Rotation.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/rpc/ActorId.h"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  /// Selects actors of the episode and which of their attributes are
+  /// retrieved, see World::QueryActors.
+  struct ActorQuery {
+
+    enum Attribute : uint32_t {
+      Location        = (0x1 << 0),
+      Rotation        = (0x1 << 1),
+      Velocity        = (0x1 << 2),
+      AngularVelocity = (0x1 << 3),
+      Acceleration    = (0x1 << 4),
+      BoundingBox     = (0x1 << 5),
+      AllAttributes   = 0x3F
+    };
+
+    /// Unix shell-style pattern the type id of the actors has to match.
+    std::string type_pattern = "*";
+
+    /// If set, only the actors within @a radius meters of this location.
+    boost::optional<geom::Location> location;
+
+    float radius = 0.0f;
+
+    /// Attributes to retrieve, a combination of Attribute flags.
+    uint32_t attributes = Location | Rotation;
+  };
+
+  /// Attributes of the actors selected by an ActorQuery, stored in parallel
+  /// arrays. Only the arrays of the requested attributes are filled.
+  struct ActorQueryResult {
+
+    /// Frame of the episode state the query was evaluated on.
+    uint64_t frame = 0u;
+
+    std::vector<ActorId> ids;
+
+    std::vector<geom::Location> locations;
+
+    std::vector<geom::Rotation> rotations;
+
+    std::vector<geom::Vector3D> velocities;
+
+    std::vector<geom::Vector3D> angular_velocities;
+
+    std::vector<geom::Vector3D> accelerations;
+
+    std::vector<geom::BoundingBox> bounding_boxes;
+  };
+
+} // namespace client
+} // namespace carla
@@ -40,6 +40,17 @@ namespace client {
       return _simulator->GetNetworkingTimeout();
     }
 
+    /// Per function call counts, bytes and latencies of the requests this
+    /// client sent to the simulator, and message rates of the streams it is
+    /// subscribed to.
+    RpcStatistics GetRpcStatistics() const {
+      return _simulator->GetRpcStatistics();
+    }
+
+    void ResetRpcStatistics() const {
+      _simulator->ResetRpcStatistics();
+    }
+
     /// Return the version string of this client API.
     std::string GetClientVersion() const {
       return _simulator->GetClientVersion();
@@ -137,6 +148,15 @@ namespace client {
       _simulator->SetReplayerIgnoreHero(ignore_hero);
     }
 
+    /// Set how the callbacks of the sensors that start listening from now on
+    /// are run: in the streaming threads as the data arrives (the default, 0
+    /// worker threads), or in a separate pool of @a options.worker_threads
+    /// threads fed by a bounded queue per sensor, so a slow callback never
+    /// delays reading the data of the other sensors.
+    void SetSensorCallbackOptions(const streaming::CallbackQueueOptions &options) const {
+      _simulator->SetSensorCallbackOptions(options);
+    }
+
     void ApplyBatch(
         std::vector<rpc::Command> commands,
         bool do_tick_cue = false) const {
@@ -153,6 +173,56 @@ namespace client {
       return responses;
     }
 
+    /// Retrieve the physics control of every vehicle in @a vehicles, all the
+    /// requests are sent at once instead of one round trip per vehicle.
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<rpc::ActorId> &vehicles) const {
+      return _simulator->GetVehiclesPhysicsControl(vehicles);
+    }
+
+    /// Retrieve the light state of every vehicle in @a vehicles, all the
+    /// requests are sent at once instead of one round trip per vehicle.
+    std::vector<rpc::VehicleLightState> GetVehiclesLightState(
+        const std::vector<rpc::ActorId> &vehicles) const {
+      return _simulator->GetVehiclesLightState(vehicles);
+    }
+
+    /// Apply the controls of @a batch, a faster alternative to ApplyBatch for
+    /// batches of vehicle controls, vehicle light states and walker controls.
+    void ApplyControlBatch(
+        const rpc::ControlBatch &batch,
+        bool do_tick_cue = false) const {
+      _simulator->ApplyControlBatch(batch, do_tick_cue);
+    }
+
+    /// Like ApplyControlBatch but waits for the controls to be applied.
+    /// Return the ids of the actors the control could not be applied to.
+    std::vector<rpc::ActorId> ApplyControlBatchSync(
+        const rpc::ControlBatch &batch,
+        bool do_tick_cue = false) const {
+      auto failed = _simulator->ApplyControlBatchSync(batch, false);
+      if (do_tick_cue)
+        _simulator->Tick(_simulator->GetNetworkingTimeout());
+
+      return failed;
+    }
+
+    /// Spawn the actors of @a request in a single call, each one at the first
+    /// free spawn point found by the simulator. A faster alternative to a
+    /// batch of SpawnActor commands that need no retries when a spawn point
+    /// is taken.
+    ///
+    /// Return one response per description, in the same order.
+    std::vector<rpc::CommandResponse> SpawnActorsBulk(
+        const rpc::SpawnActorsBulk &request,
+        bool do_tick_cue = false) const {
+      auto responses = _simulator->SpawnActorsBulk(request, false);
+      if (do_tick_cue)
+        _simulator->Tick(_simulator->GetNetworkingTimeout());
+
+      return responses;
+    }
+
   private:
 
     std::shared_ptr<detail::Simulator> _simulator;
@@ -0,0 +1,181 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/FrameSynchronizer.h"
+
+#include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/client/Sensor.h"
+#include "carla/sensor/SensorData.h"
+
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+namespace carla {
+namespace client {
+
+  FrameSynchronizer::FrameSynchronizer(
+      std::vector<SharedPtr<Sensor>> sensors,
+      const time_duration timeout,
+      const bool allow_partial,
+      const size_t queue_size)
+    : _sensors(std::move(sensors)),
+      _queue_size(queue_size),
+      _bundler(_sensors.size(), timeout, allow_partial) {
+    if (_sensors.empty()) {
+      throw_exception(std::invalid_argument("FrameSynchronizer: no sensors given"));
+    }
+    for (const auto &sensor : _sensors) {
+      if (sensor == nullptr) {
+        throw_exception(std::invalid_argument("FrameSynchronizer: invalid sensor"));
+      }
+    }
+  }
+
+  FrameSynchronizer::~FrameSynchronizer() {
+    if (_is_listening) {
+      try {
+        Stop();
+      } catch (const std::exception &e) {
+        log_error("exception trying to stop frame synchronizer:", e.what());
+      }
+    }
+  }
+
+  void FrameSynchronizer::Listen(CallbackFunctionType callback) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::swap(_callback, callback);
+    }
+    WeakPtr<FrameSynchronizer> weak = shared_from_this();
+    for (auto i = 0u; i < _sensors.size(); ++i) {
+      _sensors[i]->Listen([weak, i](auto data) {
+        auto self = weak.lock();
+        if (self != nullptr) {
+          self->Push(i, std::move(data));
+        }
+      });
+    }
+    _is_listening = true;
+  }
+
+  void FrameSynchronizer::Stop() {
+    for (auto &sensor : _sensors) {
+      if (sensor->IsListening()) {
+        sensor->Stop();
+      }
+    }
+    _is_listening = false;
+  }
+
+  SharedPtr<SensorBundle> FrameSynchronizer::WaitForBundle(const time_duration timeout) {
+    return WaitForBundle(boost::none, timeout);
+  }
+
+  SharedPtr<SensorBundle> FrameSynchronizer::WaitForBundle(
+      const size_t frame,
+      const time_duration timeout) {
+    return WaitForBundle(boost::optional<size_t>(frame), timeout);
+  }
+
+  SharedPtr<SensorBundle> FrameSynchronizer::WaitForBundle(
+      const boost::optional<size_t> frame,
+      const time_duration timeout) {
+    const auto deadline = clock::now() + timeout.to_chrono();
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_callback) {
+      throw_exception(std::logic_error(
+          "FrameSynchronizer: cannot wait for bundles while listening with a callback"));
+    }
+    while (true) {
+      const auto now = clock::now();
+      for (auto &bundle : _bundler.Expire(now)) {
+        _queue.emplace_back(std::move(bundle));
+      }
+      // Discard the bundles older than the requested frame.
+      while (!_queue.empty() && frame.has_value() && (_queue.front()->GetFrame() < *frame)) {
+        _queue.pop_front();
+      }
+      if (!_queue.empty()) {
+        if (frame.has_value() && (_queue.front()->GetFrame() != *frame)) {
+          // The frame was dropped, keep the newer bundle for the next call.
+          return nullptr;
+        }
+        auto bundle = std::move(_queue.front());
+        _queue.pop_front();
+        return bundle;
+      }
+      if (now >= deadline) {
+        return nullptr;
+      }
+      auto wake_up = deadline;
+      const auto expiration = _bundler.GetNextExpiration();
+      if (expiration.has_value() && (*expiration < wake_up)) {
+        wake_up = *expiration;
+      }
+      _cv.wait_until(lock, wake_up);
+    }
+  }
+
+  size_t FrameSynchronizer::GetNumberOfDroppedFrames() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bundler.GetNumberOfDroppedFrames();
+  }
+
+  void FrameSynchronizer::Push(const size_t index, SharedPtr<sensor::SensorData> data) {
+    const auto now = clock::now();
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto bundles = _bundler.Expire(now);
+    auto pushed = _bundler.Push(index, std::move(data), now);
+    bundles.insert(bundles.end(), pushed.begin(), pushed.end());
+    if (!bundles.empty()) {
+      Deliver(lock, std::move(bundles));
+    }
+  }
+
+  void FrameSynchronizer::Deliver(
+      std::unique_lock<std::mutex> &lock,
+      detail::FrameBundler::BundleList bundles) {
+    if (!_callback) {
+      for (auto &bundle : bundles) {
+        _queue.emplace_back(std::move(bundle));
+      }
+      while (_queue.size() > _queue_size) {
+        _queue.pop_front();
+      }
+      lock.unlock();
+      _cv.notify_all();
+      return;
+    }
+    // Take a ticket before releasing the state, so the bundles of different
+    // streams reach the callback in order. No lock is held while calling the
+    // callback, it may need to wait for the GIL.
+    auto callback = _callback;
+    const size_t ticket = _next_ticket++;
+    lock.unlock();
+    {
+      std::unique_lock<std::mutex> turn(_callback_mutex);
+      _callback_cv.wait(turn, [&]() { return _serving_ticket == ticket; });
+    }
+    for (auto &bundle : bundles) {
+      try {
+        callback(std::move(bundle));
+      } catch (const std::exception &e) {
+        log_error("FrameSynchronizer callback:", e.what());
+      } catch (...) {
+        log_error("FrameSynchronizer callback: unknown exception");
+      }
+    }
+    {
+      std::lock_guard<std::mutex> turn(_callback_mutex);
+      ++_serving_ticket;
+    }
+    _callback_cv.notify_all();
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,127 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/client/SensorBundle.h"
+#include "carla/client/detail/FrameBundler.h"
+
+#include <boost/optional.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  class Sensor;
+
+  /// Listens to several sensors and delivers their data matched by frame, as
+  /// a single SensorBundle per frame.
+  ///
+  /// Bundles are either passed to a callback, or queued to be retrieved with
+  /// WaitForBundle. A frame in which some of the sensors did not generate
+  /// data, e.g. sensors with different tick rates, is delivered as a partial
+  /// bundle if @a allow_partial is set, and dropped otherwise.
+  class FrameSynchronizer
+    : public EnableSharedFromThis<FrameSynchronizer>,
+      private NonCopyable {
+  public:
+
+    using CallbackFunctionType = std::function<void(SharedPtr<SensorBundle>)>;
+
+    /// @param timeout time a frame waits for the missing data since its first
+    /// data is received, zero to wait until a newer frame is complete. The
+    /// timeout is evaluated each time new data arrives, and while waiting in
+    /// WaitForBundle.
+    /// @param queue_size maximum number of bundles waiting to be retrieved
+    /// with WaitForBundle, the oldest are discarded.
+    FrameSynchronizer(
+        std::vector<SharedPtr<Sensor>> sensors,
+        time_duration timeout,
+        bool allow_partial,
+        size_t queue_size = 100u);
+
+    ~FrameSynchronizer();
+
+    const std::vector<SharedPtr<Sensor>> &GetSensors() const {
+      return _sensors;
+    }
+
+    /// Start listening to the sensors, @a callback is called with each
+    /// bundle. If @a callback is empty the bundles are queued instead.
+    ///
+    /// @warning This steals the data stream of every sensor from any
+    /// callback previously set with Sensor::Listen.
+    void Listen(CallbackFunctionType callback = {});
+
+    /// Stop listening to the sensors.
+    void Stop();
+
+    bool IsListening() const {
+      return _is_listening;
+    }
+
+    /// Wait for the next queued bundle. Returns nullptr if the timeout is met.
+    SharedPtr<SensorBundle> WaitForBundle(time_duration timeout);
+
+    /// Wait for the bundle of @a frame, discarding the older ones. Returns
+    /// nullptr if the timeout is met or the frame was dropped.
+    SharedPtr<SensorBundle> WaitForBundle(size_t frame, time_duration timeout);
+
+    /// Number of frames dropped because they missed the data of some sensor.
+    size_t GetNumberOfDroppedFrames() const;
+
+  private:
+
+    using clock = detail::FrameBundler::clock;
+
+    void Push(size_t index, SharedPtr<sensor::SensorData> data);
+
+    /// Deliver the @a bundles, unlocks @a lock before calling the callback.
+    /// Bundles delivered from different streams reach the callback in the
+    /// order they left the bundler, without holding @a lock while waiting for
+    /// their turn.
+    void Deliver(std::unique_lock<std::mutex> &lock, detail::FrameBundler::BundleList bundles);
+
+    SharedPtr<SensorBundle> WaitForBundle(boost::optional<size_t> frame, time_duration timeout);
+
+    const std::vector<SharedPtr<Sensor>> _sensors;
+
+    const size_t _queue_size;
+
+    bool _is_listening = false;
+
+    mutable std::mutex _mutex;
+
+    std::condition_variable _cv;
+
+    /// Ticket of the next callback delivery, guarded by _mutex.
+    size_t _next_ticket = 0u;
+
+    /// Keeps the callbacks in order of frame, guards _serving_ticket.
+    std::mutex _callback_mutex;
+
+    std::condition_variable _callback_cv;
+
+    /// Ticket of the delivery allowed to call the callback.
+    size_t _serving_ticket = 0u;
+
+    detail::FrameBundler _bundler;
+
+    CallbackFunctionType _callback;
+
+    std::deque<SharedPtr<SensorBundle>> _queue;
+  };
+
+} // namespace client
+} // namespace carla
@@ -13,6 +13,7 @@
 
 #include "carla/road/element/RoadInfoSignal.h"
 
+#include <memory>
 #include <string>
 
 namespace carla {
@@ -122,10 +123,12 @@ namespace client {
     Landmark(
         SharedPtr<Waypoint> waypoint,
         SharedPtr<const Map> parent,
+        std::shared_ptr<const road::Map> map,
         const road::element::RoadInfoSignal* signal,
         double distance_from_search = 0)
       : _waypoint(waypoint),
         _parent(parent),
+        _map(std::move(map)),
         _signal(signal),
         _distance_from_search(distance_from_search) {}
 
@@ -134,6 +137,9 @@ namespace client {
 
     SharedPtr<const Map> _parent;
 
+    /// Road map owning @a _signal.
+    std::shared_ptr<const road::Map> _map;
+
     const road::element::RoadInfoSignal* _signal;
 
     double _distance_from_search;
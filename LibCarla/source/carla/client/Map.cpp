@@ -6,6 +6,7 @@
 
 #include "carla/client/Map.h"
 
+#include "carla/Debug.h"
 #include "carla/client/Junction.h"
 #include "carla/client/Waypoint.h"
 #include "carla/opendrive/OpenDriveParser.h"
@@ -18,18 +19,30 @@
 namespace carla {
 namespace client {
 
-  static auto MakeMap(const std::string &opendrive_contents) {
+  static std::shared_ptr<road::Map> MakeMap(const std::string &opendrive_contents) {
     auto stream = std::istringstream(opendrive_contents);
     auto map = opendrive::OpenDriveParser::Load(stream.str());
     if (!map.has_value()) {
       throw_exception(std::runtime_error("failed to generate map"));
     }
-    return std::move(*map);
+    return std::make_shared<road::Map>(std::move(*map));
+  }
+
+  static road::MapChange ApplyPatch(
+      road::Map &map,
+      const std::string &opendrive_patch,
+      const road::MapChange &removed) {
+    auto change = opendrive::OpenDriveParser::LoadPatch(map, opendrive_patch, removed);
+    if (!change.has_value()) {
+      throw_exception(std::runtime_error("failed to apply OpenDRIVE patch"));
+    }
+    return std::move(*change);
   }
 
   Map::Map(rpc::MapInfo description, std::string xodr_content)
     : _description(std::move(description)),
-      _map(MakeMap(xodr_content)){
+      _current_map(MakeMap(xodr_content)) {
+    _map.store(_current_map);
     open_drive_file = xodr_content;
   }
   Map::Map(std::string name, std::string xodr_content)
@@ -45,14 +58,15 @@ namespace client {
   const geom::Location &location,
   bool project_to_road,
   int32_t lane_type) const {
+    const auto map = _map.load();
     boost::optional<road::element::Waypoint> waypoint;
     if (project_to_road) {
-      waypoint = _map.GetClosestWaypointOnRoad(location, lane_type);
+      waypoint = map->GetClosestWaypointOnRoad(location, lane_type);
     } else {
-      waypoint = _map.GetWaypoint(location, lane_type);
+      waypoint = map->GetWaypoint(location, lane_type);
     }
     return waypoint.has_value() ?
-    SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
+    SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, *waypoint}) :
     nullptr;
   }
 
@@ -60,15 +74,17 @@ namespace client {
       carla::road::RoadId road_id,
       carla::road::LaneId lane_id,
       float s) const {
+    const auto map = _map.load();
     boost::optional<road::element::Waypoint> waypoint;
-    waypoint = _map.GetWaypoint(road_id, lane_id, s);
+    waypoint = map->GetWaypoint(road_id, lane_id, s);
     return waypoint.has_value() ?
-        SharedPtr<Waypoint>(new Waypoint{shared_from_this(), *waypoint}) :
+        SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, *waypoint}) :
         nullptr;
   }
 
   Map::TopologyList Map::GetTopology() const {
     namespace re = carla::road::element;
+    const auto map = _map.load();
     std::unordered_map<re::Waypoint, SharedPtr<Waypoint>> waypoints;
 
     auto get_or_make_waypoint = [&](const auto &waypoint) {
@@ -76,13 +92,13 @@ namespace client {
       if (it == waypoints.end()) {
         it = waypoints.emplace(
             waypoint,
-            SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint})).first;
+            SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, waypoint})).first;
       }
       return it->second;
     };
 
     TopologyList result;
-    auto topology = _map.GenerateTopology();
+    auto topology = map->GenerateTopology();
     result.reserve(topology.size());
     for (const auto &pair : topology) {
       result.emplace_back(
@@ -93,11 +109,25 @@ namespace client {
   }
 
   std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(double distance) const {
+    const auto map = _map.load();
     std::vector<SharedPtr<Waypoint>> result;
-    const auto waypoints = _map.GenerateWaypoints(distance);
+    const auto waypoints = map->GenerateWaypoints(distance);
     result.reserve(waypoints.size());
     for (const auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), waypoint}));
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, waypoint}));
+    }
+    return result;
+  }
+
+  std::vector<SharedPtr<Waypoint>> Map::GenerateWaypoints(
+      double distance,
+      const std::vector<road::RoadId> &road_ids) const {
+    const auto map = _map.load();
+    std::vector<SharedPtr<Waypoint>> result;
+    const auto waypoints = map->GenerateWaypoints(distance, road_ids);
+    result.reserve(waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, waypoint}));
     }
     return result;
   }
@@ -105,19 +135,19 @@ namespace client {
   std::vector<road::element::LaneMarking> Map::CalculateCrossedLanes(
   const geom::Location &origin,
   const geom::Location &destination) const {
-    return _map.CalculateCrossedLanes(origin, destination);
+    return _map.load()->CalculateCrossedLanes(origin, destination);
   }
 
-  const geom::GeoLocation &Map::GetGeoReference() const {
-    return _map.GetGeoReference();
+  geom::GeoLocation Map::GetGeoReference() const {
+    return _map.load()->GetGeoReference();
   }
 
   std::vector<geom::Location> Map::GetAllCrosswalkZones() const {
-    return _map.GetAllCrosswalkZones();
+    return _map.load()->GetAllCrosswalkZones();
   }
 
   SharedPtr<Junction> Map::GetJunction(const Waypoint &waypoint) const {
-    const road::Junction *juncptr = GetMap().GetJunction(waypoint.GetJunctionId());
+    const road::Junction *juncptr = waypoint._map->GetJunction(waypoint.GetJunctionId());
     auto junction = SharedPtr<Junction>(new Junction(shared_from_this(), juncptr));
     return junction;
   }
@@ -125,58 +155,74 @@ namespace client {
   std::vector<std::pair<SharedPtr<Waypoint>, SharedPtr<Waypoint>>> Map::GetJunctionWaypoints(
       road::JuncId id,
       road::Lane::LaneType lane_type) const {
+    const auto map = _map.load();
     std::vector<std::pair<SharedPtr<Waypoint>, SharedPtr<Waypoint>>> result;
-    auto junction_waypoints = GetMap().GetJunctionWaypoints(id, lane_type);
+    auto junction_waypoints = map->GetJunctionWaypoints(id, lane_type);
     for (auto &waypoint_pair : junction_waypoints) {
       result.emplace_back(
-      std::make_pair(SharedPtr<Waypoint>(new Waypoint(shared_from_this(), waypoint_pair.first)),
-      SharedPtr<Waypoint>(new Waypoint(shared_from_this(), waypoint_pair.second))));
+      std::make_pair(SharedPtr<Waypoint>(new Waypoint(shared_from_this(), map, waypoint_pair.first)),
+      SharedPtr<Waypoint>(new Waypoint(shared_from_this(), map, waypoint_pair.second))));
     }
     return result;
   }
 
   std::vector<SharedPtr<Landmark>> Map::GetAllLandmarks() const {
+    const auto map = _map.load();
     std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
+    auto signal_references = map->GetAllSignalReferences();
     for(auto* signal_reference : signal_references) {
       result.emplace_back(
-          new Landmark(nullptr, shared_from_this(), signal_reference, 0));
+          new Landmark(nullptr, shared_from_this(), map, signal_reference, 0));
     }
     return result;
   }
 
   std::vector<SharedPtr<Landmark>> Map::GetLandmarksFromId(std::string id) const {
+    const auto map = _map.load();
     std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
+    auto signal_references = map->GetSignalReferencesById(id);
     for(auto* signal_reference : signal_references) {
-      if(signal_reference->GetSignalId() == id) {
-        result.emplace_back(
-            new Landmark(nullptr, shared_from_this(), signal_reference, 0));
-      }
+      result.emplace_back(
+          new Landmark(nullptr, shared_from_this(), map, signal_reference, 0));
     }
     return result;
   }
 
   std::vector<SharedPtr<Landmark>> Map::GetAllLandmarksOfType(std::string type) const {
+    const auto map = _map.load();
     std::vector<SharedPtr<Landmark>> result;
-    auto signal_references = _map.GetAllSignalReferences();
+    auto signal_references = map->GetAllSignalReferences();
     for(auto* signal_reference : signal_references) {
       if(signal_reference->GetSignal()->GetType() == type) {
         result.emplace_back(
-            new Landmark(nullptr, shared_from_this(), signal_reference, 0));
+            new Landmark(nullptr, shared_from_this(), map, signal_reference, 0));
       }
     }
     return result;
   }
 
+  std::vector<SharedPtr<Landmark>> Map::GetLandmarksInRadius(
+      const geom::Location &location,
+      const double radius) const {
+    const auto map = _map.load();
+    std::vector<SharedPtr<Landmark>> result;
+    auto signal_references = map->GetSignalReferencesInRadius(location, radius);
+    for(auto* signal_reference : signal_references) {
+      result.emplace_back(
+          new Landmark(nullptr, shared_from_this(), map, signal_reference, 0));
+    }
+    return result;
+  }
+
   std::vector<SharedPtr<Landmark>>
       Map::GetLandmarkGroup(const Landmark &landmark) const {
+    const auto &map = landmark._map;
     std::vector<SharedPtr<Landmark>> result;
     auto &controllers = landmark._signal->GetSignal()->GetControllers();
     for (auto& controller_id : controllers) {
-      const auto &controller = _map.GetControllers().at(controller_id);
+      const auto &controller = map->GetControllers().at(controller_id);
       for(auto& signal_id : controller->GetSignals()) {
-        auto& signal = _map.GetSignals().at(signal_id);
+        auto& signal = map->GetSignals().at(signal_id);
         auto new_landmarks = GetLandmarksFromId(signal->GetSignalId());
         result.insert(result.end(), new_landmarks.begin(), new_landmarks.end());
       }
@@ -188,5 +234,125 @@ namespace client {
     traffic_manager::InMemoryMap::Cook(shared_from_this(), path);
   }
 
+  std::pair<SharedPtr<const road::RoutePlanner>, Map::RoadMapPtr>
+      Map::GetRoutePlannerAndMap() const {
+    auto map = _map.load();
+    std::lock_guard<std::mutex> lock(_route_planner_mutex);
+    if ((_route_planner == nullptr) || (_route_planner_map != map)) {
+      // The planner references the road map, keep it alive with the planner.
+      _route_planner = SharedPtr<const road::RoutePlanner>(
+          new road::RoutePlanner(*map),
+          [map](const road::RoutePlanner *planner) { delete planner; });
+      _route_planner_map = map;
+    }
+    return {_route_planner, _route_planner_map};
+  }
+
+  SharedPtr<const road::RoutePlanner> Map::GetRoutePlanner() const {
+    return GetRoutePlannerAndMap().first;
+  }
+
+  Map::Route Map::MakeRoute(
+      const RoadMapPtr &map,
+      const road::RoutePlanner::Route &route) const {
+    Route result;
+    result.reserve(route.size());
+    for (const auto &pair : route) {
+      result.emplace_back(
+          SharedPtr<Waypoint>(new Waypoint{shared_from_this(), map, pair.first}),
+          pair.second);
+    }
+    return result;
+  }
+
+  Map::Route Map::TraceRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      double sampling_resolution) const {
+    const auto planner = GetRoutePlannerAndMap();
+    return MakeRoute(
+        planner.second,
+        planner.first->TraceRoute(origin, destination, sampling_resolution));
+  }
+
+  std::vector<Map::Route> Map::TraceRoutes(
+      const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+      double sampling_resolution) const {
+    const auto planner = GetRoutePlannerAndMap();
+    const auto routes = planner.first->TraceRoutes(queries, sampling_resolution);
+    std::vector<Route> result;
+    result.reserve(routes.size());
+    for (const auto &route : routes) {
+      result.emplace_back(MakeRoute(planner.second, route));
+    }
+    return result;
+  }
+
+  road::MapChange Map::ApplyOpenDrivePatch(
+      const std::string &opendrive_patch,
+      const road::MapChange &removed) {
+    road::MapChange change;
+    {
+      std::lock_guard<std::mutex> lock(_patch_mutex);
+      // Fold the patch first, it fails before touching any road map if the
+      // patch cannot be parsed.
+      std::string patched_open_drive =
+          _patched_open_drive.empty() ? open_drive_file : _patched_open_drive;
+      if (!opendrive::OpenDriveParser::MergePatch(patched_open_drive, opendrive_patch, removed)) {
+        throw_exception(std::runtime_error("failed to apply OpenDRIVE patch"));
+      }
+      // Published road maps are never modified. The newest retired one that no
+      // reader holds anymore is brought up to date, otherwise a new one is
+      // loaded from the patched document.
+      std::shared_ptr<road::Map> next;
+      for (auto it = _retired_maps.begin(); it != _retired_maps.end(); ++it) {
+        if (it->map.use_count() == 1) {
+          next = std::move(it->map);
+          const size_t missing = _generation - it->generation;
+          DEBUG_ASSERT(missing <= _patches.size());
+          for (auto patch = _patches.end() - missing; patch != _patches.end(); ++patch) {
+            ApplyPatch(*next, patch->first, patch->second);
+          }
+          _retired_maps.erase(it);
+          break;
+        }
+      }
+      if (next == nullptr) {
+        next = MakeMap(_patched_open_drive.empty() ? open_drive_file : _patched_open_drive);
+      }
+      change = ApplyPatch(*next, opendrive_patch, removed);
+      _patched_open_drive = std::move(patched_open_drive);
+      _patches.emplace_back(opendrive_patch, removed);
+      _retired_maps.push_front(RetiredMap{std::move(_current_map), _generation});
+      ++_generation;
+      _current_map = std::move(next);
+      _map.store(_current_map);
+      // Readers may still hold the dropped road maps, they are released with
+      // the last reference.
+      while (_retired_maps.size() > max_retired_maps) {
+        _retired_maps.pop_back();
+      }
+      while (_patches.size() > _generation - _retired_maps.back().generation) {
+        _patches.pop_front();
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(_route_planner_mutex);
+      _route_planner.reset();
+      _route_planner_map.reset();
+    }
+    _on_change_callbacks.Call(change);
+    return change;
+  }
+
+  size_t Map::RegisterOnChangeEvent(
+      std::function<void(const road::MapChange &)> callback) const {
+    return _on_change_callbacks.Push(std::move(callback));
+  }
+
+  void Map::RemoveOnChangeEvent(size_t id) const {
+    _on_change_callbacks.Remove(id);
+  }
+
 } // namespace client
 } // namespace carla
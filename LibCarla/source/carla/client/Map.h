@@ -6,16 +6,26 @@
 
 #pragma once
 
+#include "carla/AtomicSharedPtr.h"
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
+#include "carla/client/detail/CallbackList.h"
 #include "carla/road/element/LaneMarking.h"
 #include "carla/road/Lane.h"
 #include "carla/road/Map.h"
+#include "carla/road/MapChange.h"
 #include "carla/road/RoadTypes.h"
+#include "carla/road/RoutePlanner.h"
 #include "carla/rpc/MapInfo.h"
 #include "Landmark.h"
 
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace carla {
 namespace geom { class GeoLocation; }
@@ -39,8 +49,10 @@ namespace client {
       return _description.name;
     }
 
-    const road::Map &GetMap() const {
-      return _map;
+    /// Returns the current road map. Patches never modify a road map that has
+    /// been published, it remains valid and unchanged after them.
+    std::shared_ptr<const road::Map> GetMap() const {
+      return _map.load();
     }
 
     const std::string &GetOpenDrive() const {
@@ -67,11 +79,16 @@ namespace client {
 
     std::vector<SharedPtr<Waypoint>> GenerateWaypoints(double distance) const;
 
+    /// Same as GenerateWaypoints but only in the roads @a road_ids.
+    std::vector<SharedPtr<Waypoint>> GenerateWaypoints(
+        double distance,
+        const std::vector<road::RoadId> &road_ids) const;
+
     std::vector<road::element::LaneMarking> CalculateCrossedLanes(
         const geom::Location &origin,
         const geom::Location &destination) const;
 
-    const geom::GeoLocation &GetGeoReference() const;
+    geom::GeoLocation GetGeoReference() const;
 
     std::vector<geom::Location> GetAllCrosswalkZones() const;
 
@@ -91,19 +108,117 @@ namespace client {
     /// Returns all the landmarks in the map of a specific type
     std::vector<SharedPtr<Landmark>> GetAllLandmarksOfType(std::string type) const;
 
+    /// Returns all the landmarks in the map whose signal is within @a radius
+    /// of @a location
+    std::vector<SharedPtr<Landmark>> GetLandmarksInRadius(
+        const geom::Location &location,
+        double radius) const;
+
     /// Returns all the landmarks in the same group including this one
     std::vector<SharedPtr<Landmark>> GetLandmarkGroup(const Landmark &landmark) const;
 
     /// Cooks InMemoryMap used by the traffic manager
     void CookInMemoryMap(const std::string& path) const;
 
+    /// Returns the global route planner of this map, its graph is built the
+    /// first time it is requested and reused until the map is patched. The
+    /// planner keeps alive the road map it was built on.
+    SharedPtr<const road::RoutePlanner> GetRoutePlanner() const;
+
+    using Route = std::vector<std::pair<SharedPtr<Waypoint>, road::RoadOption>>;
+
+    /// Returns the list of waypoints, separated by @a sampling_resolution, and
+    /// road options to drive from @a origin to @a destination.
+    Route TraceRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double sampling_resolution) const;
+
+    /// Same as TraceRoute for each pair of (origin, destination), the routes
+    /// are computed in parallel.
+    std::vector<Route> TraceRoutes(
+        const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+        double sampling_resolution) const;
+
+    /// Apply an incremental update to this map, adding or replacing the roads,
+    /// junctions and signals in @a opendrive_patch and removing the ones in
+    /// @a removed, see opendrive::OpenDriveParser::LoadPatch. Only the local
+    /// copy of the map is modified, and the callbacks registered with
+    /// RegisterOnChangeEvent are called with the changes.
+    ///
+    /// The patch is applied to another road map that then replaces the
+    /// current one, queries running concurrently and existing waypoints and
+    /// landmarks keep using the road map they were created from. A road map
+    /// retired by a previous patch is brought up to date if no reader holds
+    /// it anymore, otherwise a new one is loaded from the OpenDRIVE document
+    /// with the patches folded in.
+    road::MapChange ApplyOpenDrivePatch(
+        const std::string &opendrive_patch,
+        const road::MapChange &removed = road::MapChange{});
+
+    /// Register a @a callback to be called after each patch applied to this
+    /// map. Returns an id to remove the callback.
+    size_t RegisterOnChangeEvent(std::function<void(const road::MapChange &)> callback) const;
+
+    void RemoveOnChangeEvent(size_t id) const;
+
   private:
 
+    using RoadMapPtr = std::shared_ptr<const road::Map>;
+
+    using Patch = std::pair<std::string, road::MapChange>;
+
+    /// Road map replaced by a patch, @a generation is the number of patches
+    /// applied to it.
+    struct RetiredMap {
+      std::shared_ptr<road::Map> map;
+      size_t generation;
+    };
+
+    /// Maximum number of retired road maps kept for reuse, bounds the patches
+    /// kept to bring them up to date.
+    static constexpr size_t max_retired_maps = 2u;
+
+    std::pair<SharedPtr<const road::RoutePlanner>, RoadMapPtr> GetRoutePlannerAndMap() const;
+
+    Route MakeRoute(
+        const RoadMapPtr &map,
+        const road::RoutePlanner::Route &route) const;
+
     std::string open_drive_file;
 
     const rpc::MapInfo _description;
 
-    const road::Map _map;
+    /// Road map currently published to the readers.
+    AtomicSharedPtr<const road::Map> _map;
+
+    /// Guards the members below, serializes the patches.
+    std::mutex _patch_mutex;
+
+    /// Mutable alias of the published road map.
+    std::shared_ptr<road::Map> _current_map;
+
+    /// OpenDRIVE document with every patch applied folded in, empty until
+    /// the first patch.
+    std::string _patched_open_drive;
+
+    /// Number of patches applied since the map was loaded.
+    size_t _generation = 0u;
+
+    /// Road maps published before the last patches, newest first.
+    std::deque<RetiredMap> _retired_maps;
+
+    /// Patches applied since the oldest retired road map, the last one is the
+    /// patch of generation _generation - 1.
+    std::deque<Patch> _patches;
+
+    mutable std::mutex _route_planner_mutex;
+
+    mutable SharedPtr<const road::RoutePlanner> _route_planner;
+
+    mutable RoadMapPtr _route_planner_map;
+
+    mutable detail::CallbackList<const road::MapChange &> _on_change_callbacks;
   };
 
 } // namespace client
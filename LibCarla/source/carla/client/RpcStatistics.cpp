@@ -0,0 +1,137 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/RpcStatistics.h"
+
+#include <sstream>
+
+namespace carla {
+namespace client {
+
+  /// Function names are plain identifiers, escape anyway the characters that
+  /// would break the output.
+  static std::string Escape(const std::string &str) {
+    std::string result;
+    result.reserve(str.size());
+    for (auto c : str) {
+      if ((c == '"') || (c == '\\')) {
+        result += '\\';
+        result += c;
+      } else if (c == '\n') {
+        result += "\\n";
+      } else {
+        result += c;
+      }
+    }
+    return result;
+  }
+
+  /// Upper bound in seconds of @a bucket of a LatencyHistogram.
+  static double GetBucketUpperBound(size_t bucket) {
+    return static_cast<double>(uint64_t(1u) << bucket) * 1e-6;
+  }
+
+  std::string RpcStatistics::ToJson() const {
+    std::ostringstream out;
+    out << "{\"calls\":[";
+    for (auto i = 0u; i < calls.size(); ++i) {
+      const auto &call = calls[i];
+      const auto &latency = call.latency;
+      out << (i > 0u ? "," : "")
+          << "{\"function\":\"" << Escape(call.function) << '"'
+          << ",\"calls\":" << call.calls
+          << ",\"errors\":" << call.errors
+          << ",\"bytes_sent\":" << call.bytes_sent
+          << ",\"bytes_received\":" << call.bytes_received
+          << ",\"latency\":{\"count\":" << latency.count
+          << ",\"mean_ms\":" << latency.mean
+          << ",\"max_ms\":" << latency.max
+          << ",\"p50_ms\":" << latency.p50
+          << ",\"p90_ms\":" << latency.p90
+          << ",\"p99_ms\":" << latency.p99
+          << ",\"buckets\":[";
+      for (auto j = 0u; j < latency.buckets.size(); ++j) {
+        out << (j > 0u ? "," : "") << latency.buckets[j];
+      }
+      out << "]}}";
+    }
+    out << "],\"streams\":[";
+    for (auto i = 0u; i < streams.size(); ++i) {
+      const auto &stream = streams[i];
+      out << (i > 0u ? "," : "")
+          << "{\"stream_id\":" << stream.stream_id
+          << ",\"messages\":" << stream.messages
+          << ",\"bytes\":" << stream.bytes
+          << ",\"seconds\":" << stream.seconds
+          << ",\"messages_per_second\":" << stream.GetMessagesPerSecond()
+          << ",\"bytes_per_second\":" << stream.GetBytesPerSecond()
+          << '}';
+    }
+    out << "]}";
+    return out.str();
+  }
+
+  std::string RpcStatistics::ToPrometheus() const {
+    std::ostringstream out;
+    auto write_counter = [&](const char *name, const char *help, auto &&get_value) {
+      out << "# HELP " << name << ' ' << help << '\n'
+          << "# TYPE " << name << " counter\n";
+      for (auto &&call : calls) {
+        out << name << "{function=\"" << Escape(call.function) << "\"} " << get_value(call) << '\n';
+      }
+    };
+    write_counter("carla_rpc_calls_total", "Number of calls to each remote function.",
+        [](const RpcCallStatistics &call) { return call.calls; });
+    write_counter("carla_rpc_errors_total", "Number of calls that failed or timed out.",
+        [](const RpcCallStatistics &call) { return call.errors; });
+    write_counter("carla_rpc_sent_bytes_total", "Size of the encoded arguments sent.",
+        [](const RpcCallStatistics &call) { return call.bytes_sent; });
+    write_counter("carla_rpc_received_bytes_total", "Size of the encoded responses received.",
+        [](const RpcCallStatistics &call) { return call.bytes_received; });
+
+    out << "# HELP carla_rpc_latency_seconds Time from sending a request to receiving its response.\n"
+        << "# TYPE carla_rpc_latency_seconds histogram\n";
+    for (auto &&call : calls) {
+      const auto &latency = call.latency;
+      const auto function = Escape(call.function);
+      // Every series has the same buckets, even the empty ones; the last
+      // bucket of the histogram is unbounded and goes in "+Inf".
+      uint64_t accumulated = 0u;
+      for (auto i = 0u; i + 1u < LatencyHistogram::number_of_buckets; ++i) {
+        if (i < latency.buckets.size()) {
+          accumulated += latency.buckets[i];
+        }
+        out << "carla_rpc_latency_seconds_bucket{function=\"" << function
+            << "\",le=\"" << GetBucketUpperBound(i) << "\"} " << accumulated << '\n';
+      }
+      out << "carla_rpc_latency_seconds_bucket{function=\"" << function << "\",le=\"+Inf\"} "
+          << latency.count << '\n'
+          << "carla_rpc_latency_seconds_sum{function=\"" << function << "\"} "
+          << latency.mean * static_cast<double>(latency.count) * 1e-3 << '\n'
+          << "carla_rpc_latency_seconds_count{function=\"" << function << "\"} "
+          << latency.count << '\n';
+    }
+
+    auto write_stream_metric = [&](const char *name, const char *type, const char *help, auto &&get_value) {
+      out << "# HELP " << name << ' ' << help << '\n'
+          << "# TYPE " << name << ' ' << type << '\n';
+      for (auto &&stream : streams) {
+        out << name << "{stream_id=\"" << stream.stream_id << "\"} " << get_value(stream) << '\n';
+      }
+    };
+    write_stream_metric("carla_stream_messages_total", "counter", "Number of messages received on each stream.",
+        [](const StreamStatistics &stream) { return stream.messages; });
+    write_stream_metric("carla_stream_received_bytes_total", "counter", "Bytes received on each stream.",
+        [](const StreamStatistics &stream) { return stream.bytes; });
+    write_stream_metric("carla_stream_messages_per_second", "gauge", "Average message rate since subscribing.",
+        [](const StreamStatistics &stream) { return stream.GetMessagesPerSecond(); });
+    write_stream_metric("carla_stream_received_bytes_per_second", "gauge", "Average bytes per second since subscribing.",
+        [](const StreamStatistics &stream) { return stream.GetBytesPerSecond(); });
+    return out.str();
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,82 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/LatencyHistogram.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace carla {
+namespace client {
+
+  /// Statistics of the calls a client made to a remote function.
+  struct RpcCallStatistics {
+
+    std::string function;
+
+    /// Number of calls, including the ones that failed.
+    uint64_t calls = 0u;
+
+    /// Number of calls that timed out or failed to reach the server.
+    uint64_t errors = 0u;
+
+    /// Size of the encoded arguments sent, not counting the framing of the
+    /// protocol. Only recorded if CARLA_RPC_STATS_BYTES is set, zero
+    /// otherwise.
+    uint64_t bytes_sent = 0u;
+
+    /// Size of the encoded responses received. Only recorded if
+    /// CARLA_RPC_STATS_BYTES is set, zero otherwise.
+    uint64_t bytes_received = 0u;
+
+    /// Time from sending the request to receiving the response, calls that
+    /// expect no response are not included.
+    LatencyHistogram::Statistics latency;
+  };
+
+  /// Statistics of the messages a client received on a stream.
+  struct StreamStatistics {
+
+    uint32_t stream_id = 0u;
+
+    uint64_t messages = 0u;
+
+    uint64_t bytes = 0u;
+
+    /// Seconds since the client subscribed to the stream.
+    double seconds = 0.0;
+
+    double GetMessagesPerSecond() const {
+      return seconds > 0.0 ? static_cast<double>(messages) / seconds : 0.0;
+    }
+
+    double GetBytesPerSecond() const {
+      return seconds > 0.0 ? static_cast<double>(bytes) / seconds : 0.0;
+    }
+  };
+
+  /// Network activity of a client: the remote calls it made and the streams
+  /// it is subscribed to.
+  struct RpcStatistics {
+
+    /// One element per function called, sorted by name.
+    std::vector<RpcCallStatistics> calls;
+
+    /// One element per active subscription, sorted by stream id.
+    std::vector<StreamStatistics> streams;
+
+    std::string ToJson() const;
+
+    /// Prometheus text exposition format, the latencies as histograms in
+    /// seconds.
+    std::string ToPrometheus() const;
+  };
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,86 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  /// Data generated by several sensors in the same frame, as delivered by a
+  /// FrameSynchronizer. The data is in the same order as the sensors of the
+  /// synchronizer, a sensor that did not generate data this frame has a null
+  /// entry.
+  class SensorBundle
+    : public EnableSharedFromThis<SensorBundle>,
+      private NonCopyable {
+  public:
+
+    using value_type = SharedPtr<sensor::SensorData>;
+
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    SensorBundle(size_t frame, std::vector<value_type> data)
+      : _frame(frame),
+        _data(std::move(data)),
+        _count(static_cast<size_t>(std::count_if(_data.begin(), _data.end(), [](const value_type &item) {
+          return item != nullptr;
+        }))) {}
+
+    /// Frame count when the data was generated.
+    size_t GetFrame() const {
+      return _frame;
+    }
+
+    /// Whether every sensor of the synchronizer generated data this frame.
+    bool IsComplete() const {
+      return _count == _data.size();
+    }
+
+    /// Number of sensors that generated data this frame.
+    size_t GetNumberOfSensorsWithData() const {
+      return _count;
+    }
+
+    size_t size() const {
+      return _data.size();
+    }
+
+    const value_type &at(size_t pos) const {
+      return _data.at(pos);
+    }
+
+    const value_type &operator[](size_t pos) const {
+      DEBUG_ASSERT(pos < _data.size());
+      return _data[pos];
+    }
+
+    const_iterator begin() const {
+      return _data.begin();
+    }
+
+    const_iterator end() const {
+      return _data.end();
+    }
+
+  private:
+
+    const size_t _frame;
+
+    const std::vector<value_type> _data;
+
+    const size_t _count;
+  };
+
+} // namespace client
+} // namespace carla
@@ -47,6 +47,10 @@ namespace client {
     _is_listening = false;
   }
 
+  streaming::CallbackQueueStats ServerSideSensor::GetCallbackStats() const {
+    return GetEpisode().Lock()->GetSensorCallbackStats(*this);
+  }
+
   bool ServerSideSensor::Destroy() {
     if (IsListening()) {
       Stop();
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Sensor.h"
+#include "carla/streaming/CallbackQueueOptions.h"
 
 namespace carla {
 namespace client {
@@ -36,6 +37,12 @@ namespace client {
       return _is_listening;
     }
 
+    /// Return the state of the callback queue of this sensor, all zeros if it
+    /// is not listening through a callback queue.
+    ///
+    /// @see Client::SetSensorCallbackOptions
+    streaming::CallbackQueueStats GetCallbackStats() const;
+
     /// @copydoc Actor::Destroy()
     ///
     /// Additionally stop listening.
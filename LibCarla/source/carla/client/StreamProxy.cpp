@@ -0,0 +1,223 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/StreamProxy.h"
+
+#include "carla/Logging.h"
+#include "carla/rpc/Server.h"
+#include "carla/sensor/SensorRegistry.h"
+#include "carla/sensor/s11n/EpisodeStateSerializer.h"
+#include "carla/sensor/s11n/SensorHeaderSerializer.h"
+#include "carla/streaming/Client.h"
+#include "carla/streaming/Server.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace carla {
+namespace client {
+
+  // ===========================================================================
+  // -- Episode state messages -------------------------------------------------
+  // ===========================================================================
+
+  /// Whether @a buffer is a message of the episode state stream, and if so
+  /// whether it is a keyframe.
+  static bool IsEpisodeStateMessage(const Buffer &buffer, bool &is_keyframe) {
+    using SensorHeaderSerializer = sensor::s11n::SensorHeaderSerializer;
+    using EpisodeStateSerializer = sensor::s11n::EpisodeStateSerializer;
+    constexpr auto offset = SensorHeaderSerializer::header_offset;
+    if (buffer.size() < offset + EpisodeStateSerializer::header_offset) {
+      return false;
+    }
+    using WorldObserver = sensor::SensorRegistry::get<FWorldObserver *>;
+    if (SensorHeaderSerializer::Deserialize(buffer).sensor_type != WorldObserver::index) {
+      return false;
+    }
+    EpisodeStateSerializer::Header header;
+    std::memcpy(&header, buffer.data() + offset, sizeof(header));
+    is_keyframe = (header.encoding == EpisodeStateSerializer::Encoding::Keyframe);
+    return true;
+  }
+
+  // ===========================================================================
+  // -- StreamProxy::Pimpl -----------------------------------------------------
+  // ===========================================================================
+
+  class StreamProxy::Pimpl {
+  public:
+
+    Pimpl(
+        const std::string &simulator_host,
+        const std::string &listen_address,
+        uint16_t port,
+        size_t worker_threads)
+      : local_server(listen_address, port + 1u, listen_address, port + 1u),
+        simulator_client(simulator_host),
+        rpc_server(listen_address, port) {
+      const auto threads = std::max<size_t>(worker_threads, 1u);
+      local_server.AsyncRun(threads);
+      simulator_client.AsyncRun(threads);
+      rpc_server.BindAsync("relay_stream", [this](streaming::Token token) {
+        return Relay(token);
+      });
+      rpc_server.BindAsync("release_stream", [this](streaming::Token token) {
+        Release(token);
+      });
+      rpc_server.AsyncRun(1u);
+      sweeper = std::thread([this]() { Sweep(); });
+    }
+
+    ~Pimpl() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+      }
+      sweeper_cv.notify_all();
+      sweeper.join();
+    }
+
+    streaming::Token Relay(const streaming::Token &token) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = relays.find(MakeKey(token));
+      if (it == relays.end()) {
+        auto stream = local_server.MakeStream();
+        simulator_client.Subscribe(token, [stream](Buffer buffer) mutable {
+          // Late joiners need the last keyframe of the episode state, and
+          // the deltas since, to decode the following deltas.
+          bool is_keyframe = false;
+          if (IsEpisodeStateMessage(buffer, is_keyframe)) {
+            stream.WriteAndKeep(std::move(buffer), is_keyframe);
+          } else {
+            stream.Write(std::move(buffer));
+          }
+        });
+        it = relays.emplace(MakeKey(token), RelayedStream{token, stream, 0u, 0u}).first;
+        log_debug("stream proxy: relaying", relays.size(), "streams");
+      }
+      auto &relay = it->second;
+      ++relay.references;
+      relay.awaited_connections =
+          std::max(relay.awaited_connections, relay.stream.GetNumberOfConnections()) + 1u;
+      return relay.stream.token();
+    }
+
+    void Release(const streaming::Token &token) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = relays.find(MakeKey(token));
+      if (it == relays.end()) {
+        // Already dropped when its subscribers disconnected.
+        log_debug("stream proxy: releasing a stream that is not relayed");
+        return;
+      }
+      DEBUG_ASSERT(it->second.references > 0u);
+      if (--it->second.references == 0u) {
+        Drop(it);
+      }
+    }
+
+    size_t GetNumberOfRelayedStreams() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      return relays.size();
+    }
+
+  private:
+
+    struct RelayedStream {
+      streaming::Token token;
+      streaming::Stream stream;
+      size_t references;
+      /// Number of connections to the local stream once every client given
+      /// the relay has subscribed to it.
+      size_t awaited_connections;
+    };
+
+    using RelayMap = std::unordered_map<std::string, RelayedStream>;
+
+    static std::string MakeKey(const streaming::Token &token) {
+      return {token.data.begin(), token.data.end()};
+    }
+
+    /// @pre mutex is locked.
+    RelayMap::iterator Drop(RelayMap::iterator it) {
+      simulator_client.UnSubscribe(it->second.token);
+      it = relays.erase(it);
+      log_debug("stream proxy: relaying", relays.size(), "streams");
+      return it;
+    }
+
+    /// Drop the relays whose clients disconnected without releasing them,
+    /// e.g. because the client crashed.
+    void Sweep() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!sweeper_cv.wait_for(lock, std::chrono::seconds(1), [this]() { return stopped; })) {
+        for (auto it = relays.begin(); it != relays.end();) {
+          const auto &stream = it->second.stream;
+          if ((stream.GetNumberOfSessions() == 0u) &&
+              (stream.GetNumberOfConnections() >= it->second.awaited_connections)) {
+            log_debug("stream proxy: dropping a relay with no subscribers");
+            it = Drop(it);
+          } else {
+            ++it;
+          }
+        }
+      }
+    }
+
+    // The order of these members is important, the servers and clients must
+    // stop before the streams they write to are destroyed.
+
+    streaming::Server local_server;
+
+    mutable std::mutex mutex;
+
+    RelayMap relays;
+
+    streaming::Client simulator_client;
+
+    rpc::Server rpc_server;
+
+    std::condition_variable sweeper_cv;
+
+    bool stopped = false;
+
+    std::thread sweeper;
+  };
+
+  // ===========================================================================
+  // -- StreamProxy ------------------------------------------------------------
+  // ===========================================================================
+
+  constexpr const char *StreamProxy::environment_variable;
+
+  StreamProxy::StreamProxy(
+      const std::string &simulator_host,
+      const std::string &listen_address,
+      uint16_t port,
+      size_t worker_threads)
+    : _pimpl(std::make_unique<Pimpl>(simulator_host, listen_address, port, worker_threads)) {}
+
+  StreamProxy::~StreamProxy() = default;
+
+  streaming::Token StreamProxy::Relay(const streaming::Token &token) {
+    return _pimpl->Relay(token);
+  }
+
+  void StreamProxy::Release(const streaming::Token &token) {
+    _pimpl->Release(token);
+  }
+
+  size_t StreamProxy::GetNumberOfRelayedStreams() const {
+    return _pimpl->GetNumberOfRelayedStreams();
+  }
+
+} // namespace client
+} // namespace carla
@@ -0,0 +1,70 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/streaming/Token.h"
+
+#include <memory>
+#include <string>
+
+namespace carla {
+namespace client {
+
+  /// Relays the streams of a simulator to the clients running on the same
+  /// host, so each stream is received once from the simulator no matter how
+  /// many local clients subscribe to it.
+  ///
+  /// Clients find the proxy through the CARLA_STREAM_PROXY environment
+  /// variable ("host:port"). The proxy answers the "relay_stream" and
+  /// "release_stream" RPCs at @a port, and serves the relayed streams at
+  /// @a port + 1.
+  ///
+  /// A relay is dropped when released as many times as it was requested, or
+  /// when every client it was given to disconnected from it. Clients
+  /// subscribing to the episode state stream late receive its last keyframe
+  /// and the deltas since first.
+  class StreamProxy : private NonCopyable {
+  public:
+
+    /// Environment variable the clients read to find a proxy.
+    static constexpr const char *environment_variable = "CARLA_STREAM_PROXY";
+
+    /// @param simulator_host host of the simulator, used for the tokens that
+    ///   do not carry an address.
+    /// @param listen_address local address the proxy listens on, also given
+    ///   to the clients in the relayed tokens.
+    /// @param port RPC port of the proxy, the relayed streams use the next
+    ///   one.
+    /// @param worker_threads threads receiving and forwarding the streams.
+    StreamProxy(
+        const std::string &simulator_host,
+        const std::string &listen_address,
+        uint16_t port,
+        size_t worker_threads = 1u);
+
+    ~StreamProxy();
+
+    /// Token of a local stream relaying @a token, subscribing to it the
+    /// first time. Each call needs a matching Release.
+    streaming::Token Relay(const streaming::Token &token);
+
+    /// Release a reference to the relay of @a token, when none is left the
+    /// proxy unsubscribes from the simulator.
+    void Release(const streaming::Token &token);
+
+    /// Number of streams being relayed.
+    size_t GetNumberOfRelayedStreams() const;
+
+  private:
+
+    class Pimpl;
+    const std::unique_ptr<Pimpl> _pimpl;
+  };
+
+} // namespace client
+} // namespace carla
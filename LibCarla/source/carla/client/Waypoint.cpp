@@ -15,20 +15,24 @@
 namespace carla {
 namespace client {
 
-  Waypoint::Waypoint(SharedPtr<const Map> parent, road::element::Waypoint waypoint)
+  Waypoint::Waypoint(
+      SharedPtr<const Map> parent,
+      std::shared_ptr<const road::Map> map,
+      road::element::Waypoint waypoint)
     : _parent(std::move(parent)),
+      _map(std::move(map)),
       _waypoint(std::move(waypoint)),
-      _transform(_parent->GetMap().ComputeTransform(_waypoint)),
-      _mark_record(_parent->GetMap().GetMarkRecord(_waypoint)) {}
+      _transform(_map->ComputeTransform(_waypoint)),
+      _mark_record(_map->GetMarkRecord(_waypoint)) {}
 
   Waypoint::~Waypoint() = default;
 
   road::JuncId Waypoint::GetJunctionId() const {
-    return _parent->GetMap().GetJunctionId(_waypoint.road_id);
+    return _map->GetJunctionId(_waypoint.road_id);
   }
 
   bool Waypoint::IsJunction() const {
-    return _parent->GetMap().IsJunction(_waypoint.road_id);
+    return _map->IsJunction(_waypoint.road_id);
   }
 
   SharedPtr<Junction> Waypoint::GetJunction() const {
@@ -39,30 +43,30 @@ namespace client {
   }
 
   double Waypoint::GetLaneWidth() const {
-    return _parent->GetMap().GetLaneWidth(_waypoint);
+    return _map->GetLaneWidth(_waypoint);
 
   }
 
   road::Lane::LaneType Waypoint::GetType() const {
-    return _parent->GetMap().GetLaneType(_waypoint);
+    return _map->GetLaneType(_waypoint);
   }
 
   std::vector<SharedPtr<Waypoint>> Waypoint::GetNext(double distance) const {
-    auto waypoints = _parent->GetMap().GetNext(_waypoint, distance);
+    auto waypoints = _map->GetNext(_waypoint, distance);
     std::vector<SharedPtr<Waypoint>> result;
     result.reserve(waypoints.size());
     for (auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, std::move(waypoint))));
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, _map, std::move(waypoint))));
     }
     return result;
   }
 
   std::vector<SharedPtr<Waypoint>> Waypoint::GetPrevious(double distance) const {
-    auto waypoints = _parent->GetMap().GetPrevious(_waypoint, distance);
+    auto waypoints = _map->GetPrevious(_waypoint, distance);
     std::vector<SharedPtr<Waypoint>> result;
     result.reserve(waypoints.size());
     for (auto &waypoint : waypoints) {
-      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, std::move(waypoint))));
+      result.emplace_back(SharedPtr<Waypoint>(new Waypoint(_parent, _map, std::move(waypoint))));
     }
     return result;
   }
@@ -80,7 +84,7 @@ namespace client {
       current_s = result.back()->GetDistance();
     }
     double remaining_length;
-    double road_length = _parent->GetMap().GetLane(_waypoint).GetRoad()->GetLength();
+    double road_length = _map->GetLane(_waypoint).GetRoad()->GetLength();
     if(_waypoint.lane_id < 0) {
       remaining_length = road_length - current_s;
     } else {
@@ -111,7 +115,7 @@ namespace client {
     }
 
     double remaining_length;
-    double road_length = _parent->GetMap().GetLane(_waypoint).GetRoad()->GetLength();
+    double road_length = _map->GetLane(_waypoint).GetRoad()->GetLength();
     if(_waypoint.lane_id < 0) {
       remaining_length = road_length - current_s;
     } else {
@@ -129,18 +133,18 @@ namespace client {
 
   SharedPtr<Waypoint> Waypoint::GetRight() const {
     auto right_lane_waypoint =
-        _parent->GetMap().GetRight(_waypoint);
+        _map->GetRight(_waypoint);
     if (right_lane_waypoint.has_value()) {
-      return SharedPtr<Waypoint>(new Waypoint(_parent, std::move(*right_lane_waypoint)));
+      return SharedPtr<Waypoint>(new Waypoint(_parent, _map, std::move(*right_lane_waypoint)));
     }
     return nullptr;
   }
 
   SharedPtr<Waypoint> Waypoint::GetLeft() const {
     auto left_lane_waypoint =
-        _parent->GetMap().GetLeft(_waypoint);
+        _map->GetLeft(_waypoint);
     if (left_lane_waypoint.has_value()) {
-      return SharedPtr<Waypoint>(new Waypoint(_parent, std::move(*left_lane_waypoint)));
+      return SharedPtr<Waypoint>(new Waypoint(_parent, _map, std::move(*left_lane_waypoint)));
     }
     return nullptr;
   }
@@ -218,7 +222,7 @@ namespace client {
   std::vector<SharedPtr<Landmark>> Waypoint::GetAllLandmarksInDistance(
       double distance, bool stop_at_junction) const {
     std::vector<SharedPtr<Landmark>> result;
-    auto signals = _parent->GetMap().GetSignalsInDistance(
+    auto signals = _map->GetSignalsInDistance(
         _waypoint, distance, stop_at_junction);
     std::unordered_set<const road::element::RoadInfoSignal*> added_signals; // check for repeated signals
     for(auto &signal_data : signals){
@@ -226,9 +230,9 @@ namespace client {
         continue;
       }
       added_signals.insert(signal_data.signal);
-      auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, signal_data.waypoint));
+      auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, _map, signal_data.waypoint));
       result.emplace_back(
-          new Landmark(waypoint, _parent, signal_data.signal, signal_data.accumulated_s));
+          new Landmark(waypoint, _parent, _map, signal_data.signal, signal_data.accumulated_s));
     }
     return result;
   }
@@ -237,16 +241,16 @@ namespace client {
         double distance, std::string filter_type, bool stop_at_junction) const {
     std::vector<SharedPtr<Landmark>> result;
     std::unordered_set<const road::element::RoadInfoSignal*> added_signals; // check for repeated signals
-    auto signals = _parent->GetMap().GetSignalsInDistance(
+    auto signals = _map->GetSignalsInDistance(
         _waypoint, distance, stop_at_junction);
     for(auto &signal_data : signals){
       if(signal_data.signal->GetSignal()->GetType() == filter_type) {
         if(added_signals.count(signal_data.signal) > 0) {
           continue;
         }
-        auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, signal_data.waypoint));
+        auto waypoint = SharedPtr<Waypoint>(new Waypoint(_parent, _map, signal_data.waypoint));
         result.emplace_back(
-            new Landmark(waypoint, _parent, signal_data.signal, signal_data.accumulated_s));
+            new Landmark(waypoint, _parent, _map, signal_data.signal, signal_data.accumulated_s));
       }
     }
     return result;
@@ -17,7 +17,10 @@
 
 #include <boost/optional.hpp>
 
+#include <memory>
+
 namespace carla {
+namespace road { class Map; }
 namespace client {
 
   class Map;
@@ -104,10 +107,17 @@ namespace client {
 
     friend class Map;
 
-    Waypoint(SharedPtr<const Map> parent, road::element::Waypoint waypoint);
+    Waypoint(
+        SharedPtr<const Map> parent,
+        std::shared_ptr<const road::Map> map,
+        road::element::Waypoint waypoint);
 
     SharedPtr<const Map> _parent;
 
+    /// Road map this waypoint was created from, patches to the parent map do
+    /// not affect it.
+    std::shared_ptr<const road::Map> _map;
+
     road::element::Waypoint _waypoint;
 
     geom::Transform _transform;
@@ -115,6 +115,10 @@ namespace client {
                                   _episode.Lock()->GetActorsById(actor_ids)}};
   }
 
+  ActorQueryResult World::QueryActors(const ActorQuery &query) const {
+    return _episode.Lock()->QueryActors(query);
+  }
+
   SharedPtr<Actor> World::SpawnActor(
       const ActorBlueprint &blueprint,
       const geom::Transform &transform,
@@ -156,6 +160,10 @@ namespace client {
     return _episode.Lock()->Tick(local_timeout);
   }
 
+  LatencyHistogram::Statistics World::GetTickLatencyStatistics() const {
+    return _episode.Lock()->GetTickLatencyStatistics();
+  }
+
   void World::SetPedestriansCrossFactor(float percentage) {
     _episode.Lock()->SetPedestriansCrossFactor(percentage);
   }
@@ -280,11 +288,11 @@ namespace client {
   std::vector<SharedPtr<Actor>> World::GetTrafficLightsInJunction(
       const road::JuncId junc_id) const {
     std::vector<SharedPtr<Actor>> Result;
-    SharedPtr<Map> map = GetMap();
-    const road::Junction* junction = map->GetMap().GetJunction(junc_id);
+    const auto map = GetMap()->GetMap();
+    const road::Junction* junction = map->GetJunction(junc_id);
     for (const road::ContId& cont_id : junction->GetControllers()) {
       const std::unique_ptr<road::Controller>& controller =
-          map->GetMap().GetControllers().at(cont_id);
+          map->GetControllers().at(cont_id);
       for (road::SignId sign_id : controller->GetSignals()) {
         SharedPtr<Actor> traffic_light = GetTrafficLightFromOpenDRIVE(sign_id);
         if (traffic_light) {
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include "carla/LatencyHistogram.h"
 #include "carla/Memory.h"
 #include "carla/Time.h"
+#include "carla/client/ActorQuery.h"
 #include "carla/client/DebugHelper.h"
 #include "carla/client/Landmark.h"
 #include "carla/client/Waypoint.h"
@@ -105,6 +107,12 @@ namespace client {
     /// Return a list with the actors requested by ActorId.
     SharedPtr<ActorList> GetActors(const std::vector<ActorId> &actor_ids) const;
 
+    /// Return the ids and the requested attributes of the actors selected by
+    /// @a query, in parallel arrays. Evaluated in the client against the
+    /// latest state received, a spatial query only visits the actors near
+    /// the query location.
+    ActorQueryResult QueryActors(const ActorQuery &query) const;
+
     /// Spawn an actor into the world based on the @a blueprint provided at @a
     /// transform. If a @a parent is provided, the actor is attached to
     /// @a parent.
@@ -139,6 +147,10 @@ namespace client {
     /// @return The id of the frame that this call started.
     uint64_t Tick(time_duration timeout);
 
+    /// Latency of the calls to Tick made by this client, from sending the
+    /// tick cue to receiving the state of the new frame.
+    LatencyHistogram::Statistics GetTickLatencyStatistics() const;
+
     /// set the probability that an agent could cross the roads in its path following
     /// percentage of 0.0f means no pedestrian can cross roads
     /// percentage of 0.5f means 50% of all pedestrians can cross roads
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/client/Timestamp.h"
+#include "carla/client/ActorKinematics.h"
 #include "carla/client/ActorSnapshot.h"
 #include "carla/client/detail/EpisodeState.h"
 
@@ -35,6 +36,13 @@ namespace client {
       return _state->GetTimestamp();
     }
 
+    /// Whether the actors of this snapshot are older than its frame. The
+    /// snapshot keeps the actors of the last frame fully received while
+    /// waiting for the next keyframe after a lost update.
+    bool IsStale() const {
+      return _state->IsStale();
+    }
+
     /// Check if an actor is present in this snapshot.
     bool Contains(ActorId actor_id) const {
       return _state->ContainsActorSnapshot(actor_id);
@@ -60,6 +68,13 @@ namespace client {
       return _state->end();
     }
 
+    /// Return the kinematics of all the actors as parallel arrays, in the
+    /// same order as the iterators. The arrays are built the first time they
+    /// are requested and keep the state of this snapshot alive.
+    std::shared_ptr<const ActorKinematics> GetActorKinematics() const {
+      return {_state, &_state->GetKinematics()};
+    }
+
     bool operator==(const WorldSnapshot &rhs) const {
       return GetTimestamp() == rhs.GetTimestamp();
     }
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/geom/Math.h"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Uniform grid over the XY plane indexing a list of locations, used to
+  /// find the actors around a point without visiting all of them.
+  class ActorGridIndex : private NonCopyable {
+  public:
+
+    explicit ActorGridIndex(float cell_size = 50.0f)
+      : _cell_size(cell_size) {
+      DEBUG_ASSERT(_cell_size > 0.0f);
+    }
+
+    /// Index the elements in [@a begin, @a end), @a get_location returns the
+    /// location of an element. The positions reported by ForEachInRadius are
+    /// relative to @a begin.
+    template <typename IteratorT, typename GetLocationT>
+    void Build(IteratorT begin, IteratorT end, GetLocationT &&get_location) {
+      _cells.clear();
+      size_t position = 0u;
+      for (auto it = begin; it != end; ++it, ++position) {
+        const geom::Location location = get_location(*it);
+        _cells[MakeKey(ToCell(location.x), ToCell(location.y))].emplace_back(
+            Entry{position, location});
+      }
+    }
+
+    /// Call @a func with the position of each element within @a radius of
+    /// @a center, in no particular order.
+    template <typename FuncT>
+    void ForEachInRadius(const geom::Location &center, float radius, FuncT &&func) const {
+      const float squared_radius = radius * radius;
+      auto visit = [&](const std::vector<Entry> &entries) {
+        for (auto &&entry : entries) {
+          if (geom::Math::DistanceSquared(entry.location, center) <= squared_radius) {
+            func(entry.position);
+          }
+        }
+      };
+      const auto min_x = ToCell(center.x - radius);
+      const auto max_x = ToCell(center.x + radius);
+      const auto min_y = ToCell(center.y - radius);
+      const auto max_y = ToCell(center.y + radius);
+      const auto cells_in_range =
+          static_cast<uint64_t>(max_x - min_x + 1) * static_cast<uint64_t>(max_y - min_y + 1);
+      if (cells_in_range > _cells.size()) {
+        // Big radius, cheaper to visit the non-empty cells.
+        for (auto &&cell : _cells) {
+          visit(cell.second);
+        }
+        return;
+      }
+      for (auto x = min_x; x <= max_x; ++x) {
+        for (auto y = min_y; y <= max_y; ++y) {
+          auto it = _cells.find(MakeKey(x, y));
+          if (it != _cells.end()) {
+            visit(it->second);
+          }
+        }
+      }
+    }
+
+  private:
+
+    struct Entry {
+      size_t position;
+      geom::Location location;
+    };
+
+    int64_t ToCell(float value) const {
+      return static_cast<int64_t>(std::floor(value / _cell_size));
+    }
+
+    static uint64_t MakeKey(int64_t x, int64_t y) {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32u) |
+             static_cast<uint64_t>(static_cast<uint32_t>(y));
+    }
+
+    const float _cell_size;
+
+    std::unordered_map<uint64_t, std::vector<Entry>> _cells;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
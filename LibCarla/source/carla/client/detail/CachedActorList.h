@@ -50,6 +50,13 @@ namespace detail {
     template <typename RangeT>
     std::vector<rpc::Actor> GetActorsById(const RangeT &range) const;
 
+    /// Call @a func with a pointer to the cached actor of each id in @a
+    /// range, or nullptr if not cached, without copying the actors.
+    ///
+    /// @warning The list is locked while calling @a func.
+    template <typename RangeT, typename FuncT>
+    void ForEachActorById(const RangeT &range, FuncT &&func) const;
+
     void Clear();
 
   private:
@@ -116,6 +123,15 @@ namespace detail {
     return result;
   }
 
+  template <typename RangeT, typename FuncT>
+  inline void CachedActorList::ForEachActorById(const RangeT &range, FuncT &&func) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto &&id : range) {
+      auto it = _actors.find(id);
+      func(it != _actors.end() ? &it->second : nullptr);
+    }
+  }
+
   inline void CachedActorList::Clear() {
     std::lock_guard<std::mutex> lock(_mutex);
     _actors.clear();
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/AtomicList.h"
+#include "carla/Debug.h"
 #include "carla/NonCopyable.h"
 
 #include <atomic>
@@ -7,9 +7,15 @@
 #include "carla/client/detail/Client.h"
 
 #include "carla/Exception.h"
+#include "carla/Logging.h"
+#include "carla/MsgPack.h"
+#include "carla/StringUtil.h"
+#include "carla/ThreadPool.h"
 #include "carla/Version.h"
 #include "carla/client/FileTransfer.h"
+#include "carla/client/StreamProxy.h"
 #include "carla/client/TimeoutException.h"
+#include "carla/client/detail/RpcRecorder.h"
 #include "carla/rpc/ActorDescription.h"
 #include "carla/rpc/BoneTransformDataIn.h"
 #include "carla/rpc/Client.h"
@@ -21,10 +27,18 @@
 #include "carla/rpc/WalkerBoneControlOut.h"
 #include "carla/rpc/WalkerControl.h"
 #include "carla/streaming/Client.h"
+#include "carla/streaming/detail/Token.h"
 
 #include <rpc/rpc_error.h>
 
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
 
 namespace carla {
 namespace client {
@@ -39,6 +53,52 @@ namespace detail {
     return true;
   }
 
+  /// Read @a name from the environment as a positive number, zero if not set
+  /// or invalid.
+  static size_t GetEnvironmentNumber(const char *name) {
+    const char *value = std::getenv(name);
+    if (value == nullptr) {
+      return 0u;
+    }
+    try {
+      return std::stoul(value);
+    } catch (const std::exception &) {
+      log_warning("ignoring invalid value of", name, ':', value);
+      return 0u;
+    }
+  }
+
+  /// IO threads of the streaming client. By default one thread per stream up
+  /// to the hardware concurrency; a non-zero @a worker_threads, or the
+  /// environment variable CARLA_STREAMING_CLIENT_THREADS, fixes the number
+  /// of threads instead. CARLA_STREAMING_CLIENT_MAX_THREADS caps the number
+  /// of threads, and CARLA_STREAMING_CLIENT_CPU_AFFINITY pins them to a list
+  /// of CPUs such as "0-3,8".
+  static ThreadPoolOptions GetStreamingThreadOptions(size_t worker_threads) {
+    ThreadPoolOptions options;
+    const auto threads = worker_threads > 0u ?
+        worker_threads :
+        GetEnvironmentNumber("CARLA_STREAMING_CLIENT_THREADS");
+    if (threads > 0u) {
+      options.threads = threads;
+      options.max_threads = threads;
+    } else {
+      options.max_threads = GetEnvironmentNumber("CARLA_STREAMING_CLIENT_MAX_THREADS");
+    }
+    const char *affinity = std::getenv("CARLA_STREAMING_CLIENT_CPU_AFFINITY");
+    if (affinity != nullptr) {
+      options.cpu_affinity = ParseCpuList(affinity);
+      if (options.cpu_affinity.empty()) {
+        log_warning("ignoring invalid CARLA_STREAMING_CLIENT_CPU_AFFINITY:", affinity);
+      }
+    }
+    return options;
+  }
+
+  static std::string MakeTokenKey(const streaming::Token &token) {
+    return {token.data.begin(), token.data.end()};
+  }
+
   // ===========================================================================
   // -- Client::Pimpl ----------------------------------------------------------
   // ===========================================================================
@@ -49,24 +109,67 @@ namespace detail {
     Pimpl(const std::string &host, uint16_t port, size_t worker_threads)
       : endpoint(host + ":" + std::to_string(port)),
         rpc_client(host, port),
-        streaming_client(host) {
+        streaming_client(host),
+        record_sizes(GetEnvironmentNumber("CARLA_RPC_STATS_BYTES") > 0u) {
       rpc_client.set_timeout(5000u);
-      streaming_client.AsyncRun(
-          worker_threads > 0u ? worker_threads : std::thread::hardware_concurrency());
+      streaming_client.AsyncRun(GetStreamingThreadOptions(worker_threads));
+      ConnectToStreamProxy();
+      StartStatisticsDump();
+    }
+
+    ~Pimpl() {
+      StopStatisticsDump();
     }
 
+    /// Use the stream proxy named by the environment, see StreamProxy.
+    void ConnectToStreamProxy() {
+      const char *value = std::getenv(StreamProxy::environment_variable);
+      if ((value == nullptr) || (*value == '\0')) {
+        return;
+      }
+      const std::string proxy = value;
+      const auto colon = proxy.rfind(':');
+      uint16_t port = 0u;
+      try {
+        port = static_cast<uint16_t>(std::stoi(proxy.substr(colon + 1u)));
+      } catch (const std::exception &) {}
+      if ((colon == std::string::npos) || (port == 0u)) {
+        log_warning(StreamProxy::environment_variable, "should be host:port, ignoring", proxy);
+        return;
+      }
+      proxy_client = std::make_unique<rpc::Client>(proxy.substr(0u, colon), port);
+      proxy_client->set_timeout(2000u);
+      log_debug("using stream proxy", proxy);
+    }
+
+    /// Size of @a objects encoded, if sizes are recorded. Computing it costs
+    /// as much as encoding them again, so it is only done on request.
+    template <typename ... Ts>
+    size_t GetRecordedSize(const Ts &... objects) const {
+      return record_sizes ? MsgPack::GetPackedSize(objects ...) : 0u;
+    }
+
+    /// @pre @a function is a string literal, see RpcRecorder::GetLiteralCall.
     template <typename ... Args>
-    auto RawCall(const std::string &function, Args && ... args) {
+    auto RawCall(const char *function, Args && ... args) {
+      auto &call = recorder.GetLiteralCall(function);
+      call.RecordRequest(GetRecordedSize(args ...));
+      const auto start = RpcRecorder::clock::now();
       try {
-        return rpc_client.call(function, std::forward<Args>(args) ...);
+        auto object = rpc_client.call(function, std::forward<Args>(args) ...);
+        call.RecordResponse(start, GetRecordedSize(object.get()));
+        return object;
       } catch (const ::rpc::timeout &) {
+        call.RecordError();
         throw_exception(TimeoutException(endpoint, GetTimeout()));
+      } catch (...) {
+        call.RecordError();
+        throw;
       }
     }
 
-    template <typename T, typename ... Args>
-    auto CallAndWait(const std::string &function, Args && ... args) {
-      auto object = RawCall(function, std::forward<Args>(args) ...);
+    template <typename T>
+    static auto UnpackResponse(const clmdep_msgpack::object_handle &object) {
       using R = typename carla::rpc::Response<T>;
       auto response = object.template as<R>();
       if (response.HasError()) {
@@ -75,8 +178,55 @@ namespace detail {
       return Get(response);
     }
 
+    template <typename T, typename ... Args>
+    auto CallAndWait(const char *function, Args && ... args) {
+      auto object = RawCall(function, std::forward<Args>(args) ...);
+      return UnpackResponse<T>(object);
+    }
+
+    /// Send the request and return immediately, the result is retrieved
+    /// from the returned future. Requests issued this way are pipelined, the
+    /// timeout counts from the moment the caller starts waiting on the
+    /// future.
+    template <typename T, typename ... Args>
+    auto CallAsync(const char *function, Args && ... args) {
+      auto *call = &recorder.GetLiteralCall(function);
+      call->RecordRequest(GetRecordedSize(args ...));
+      const auto start = RpcRecorder::clock::now();
+      auto future = rpc_client.pipelined_call(function, std::forward<Args>(args) ...);
+      const auto timeout = GetTimeout();
+      return std::async(std::launch::deferred, [this, call, start, timeout, future = std::move(future)]() mutable {
+        if (future.wait_for(timeout.to_chrono()) == std::future_status::timeout) {
+          call->RecordError();
+          throw_exception(TimeoutException(endpoint, timeout));
+        }
+        auto object = future.get();
+        call->RecordResponse(start, GetRecordedSize(object.get()));
+        return UnpackResponse<T>(object);
+      });
+    }
+
+    /// Call @a function once for each of the @a ids, all the requests are
+    /// sent before waiting for the first response so the whole batch costs a
+    /// single round trip.
+    template <typename T>
+    std::vector<T> CallForEach(const char *function, const std::vector<ActorId> &ids) {
+      std::vector<std::future<T>> futures;
+      futures.reserve(ids.size());
+      for (auto id : ids) {
+        futures.emplace_back(CallAsync<T>(function, id));
+      }
+      std::vector<T> result;
+      result.reserve(futures.size());
+      for (auto &future : futures) {
+        result.emplace_back(future.get());
+      }
+      return result;
+    }
+
     template <typename ... Args>
-    void AsyncCall(const std::string &function, Args && ... args) {
+    void AsyncCall(const char *function, Args && ... args) {
+      recorder.GetLiteralCall(function).RecordRequest(GetRecordedSize(args ...));
       // Discard returned future.
       rpc_client.async_call(function, std::forward<Args>(args) ...);
     }
@@ -87,11 +237,157 @@ namespace detail {
       return time_duration::milliseconds(static_cast<size_t>(*timeout));
     }
 
+    /// Wrap @a callback to count the messages received on @a token.
+    std::function<void(Buffer)> CountMessages(
+        const streaming::Token &token,
+        std::function<void(Buffer)> callback) {
+      auto stream = recorder.AddStream(
+          MakeTokenKey(token),
+          streaming::detail::token_type(token).get_stream_id());
+      return [stream, callback = std::move(callback)](Buffer buffer) {
+        stream->RecordMessage(buffer.size());
+        callback(std::move(buffer));
+      };
+    }
+
+    /// If CARLA_RPC_STATS_FILE is set, write the statistics of the client to
+    /// that file every CARLA_RPC_STATS_INTERVAL seconds (10 by default), as
+    /// JSON if the name ends in ".json" and in the Prometheus text format
+    /// otherwise.
+    void StartStatisticsDump() {
+      const char *path = std::getenv("CARLA_RPC_STATS_FILE");
+      if ((path == nullptr) || (*path == '\0')) {
+        return;
+      }
+      const auto interval = GetEnvironmentNumber("CARLA_RPC_STATS_INTERVAL");
+      statistics_dump_thread = std::thread([this, file = std::string(path), interval]() {
+        const auto period = std::chrono::seconds(interval > 0u ? interval : 10u);
+        std::unique_lock<std::mutex> lock(statistics_dump_mutex);
+        bool stop = false;
+        while (!stop) {
+          stop = statistics_dump_condition.wait_for(lock, period, [this]() {
+            return stop_statistics_dump;
+          });
+          WriteStatistics(file);
+        }
+      });
+    }
+
+    void StopStatisticsDump() {
+      if (!statistics_dump_thread.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(statistics_dump_mutex);
+        stop_statistics_dump = true;
+      }
+      statistics_dump_condition.notify_one();
+      statistics_dump_thread.join();
+    }
+
+    /// Write to a temporary file and rename it, readers never see a file
+    /// half written.
+    void WriteStatistics(const std::string &path) const {
+      const auto statistics = recorder.GetStatistics();
+      const auto temporary = path + ".tmp";
+      {
+        std::ofstream out(temporary, std::ios::trunc);
+        out << (StringUtil::EndsWith(path, ".json") ?
+            statistics.ToJson() :
+            statistics.ToPrometheus());
+        if (!out) {
+          log_warning("unable to write RPC statistics to", temporary);
+          return;
+        }
+      }
+      if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        log_warning("unable to write RPC statistics to", path);
+      }
+    }
+
+    /// Token to subscribe to instead of @a token, the one of the stream
+    /// proxy relaying it if there is a proxy. The proxy is only asked the
+    /// first time, each call needs a matching ReleaseStream.
+    streaming::Token RelayStream(const streaming::Token &token) {
+      std::lock_guard<std::mutex> lock(proxy_mutex);
+      auto it = relayed_tokens.find(MakeTokenKey(token));
+      if (it != relayed_tokens.end()) {
+        ++it->second.references;
+        return it->second.token;
+      }
+      if (proxy_client == nullptr) {
+        return token;
+      }
+      try {
+        auto relayed = proxy_client->call("relay_stream", token).as<streaming::Token>();
+        relayed_tokens.emplace(MakeTokenKey(token), RelayedToken{relayed, 1u});
+        return relayed;
+      } catch (const std::exception &e) {
+        log_warning("stream proxy not available, subscribing to the simulator:", e.what());
+        proxy_client = nullptr;
+        return token;
+      }
+    }
+
+    /// Token @a token was subscribed with. The proxy is told when the last
+    /// reference is released.
+    streaming::Token ReleaseStream(const streaming::Token &token) {
+      std::lock_guard<std::mutex> lock(proxy_mutex);
+      auto it = relayed_tokens.find(MakeTokenKey(token));
+      if (it == relayed_tokens.end()) {
+        return token;
+      }
+      const auto relayed = it->second.token;
+      DEBUG_ASSERT(it->second.references > 0u);
+      if (--it->second.references == 0u) {
+        relayed_tokens.erase(it);
+        if (proxy_client != nullptr) {
+          proxy_client->async_call("release_stream", token);
+        }
+      }
+      return relayed;
+    }
+
+    /// Token @a token was subscribed with.
+    streaming::Token GetSubscribedToken(const streaming::Token &token) const {
+      std::lock_guard<std::mutex> lock(proxy_mutex);
+      auto it = relayed_tokens.find(MakeTokenKey(token));
+      return it != relayed_tokens.end() ? it->second.token : token;
+    }
+
     const std::string endpoint;
 
     rpc::Client rpc_client;
 
     streaming::Client streaming_client;
+
+    mutable std::mutex proxy_mutex;
+
+    std::unique_ptr<rpc::Client> proxy_client;
+
+    struct RelayedToken {
+      streaming::Token token;
+      size_t references;
+    };
+
+    std::unordered_map<std::string, RelayedToken> relayed_tokens;
+
+    std::mutex sensor_callback_options_mutex;
+
+    streaming::CallbackQueueOptions sensor_callback_options;
+
+    RpcRecorder recorder;
+
+    /// Whether the sizes of the requests and responses are recorded.
+    const bool record_sizes;
+
+    std::mutex statistics_dump_mutex;
+
+    std::condition_variable statistics_dump_condition;
+
+    bool stop_statistics_dump = false;
+
+    std::thread statistics_dump_thread;
   };
 
   // ===========================================================================
@@ -281,6 +577,16 @@ namespace detail {
     return _pimpl->CallAndWait<carla::rpc::VehicleLightState>("get_vehicle_light_state", vehicle);
   }
 
+  std::vector<rpc::VehiclePhysicsControl> Client::GetVehiclesPhysicsControl(
+      const std::vector<rpc::ActorId> &vehicles) const {
+    return _pimpl->CallForEach<carla::rpc::VehiclePhysicsControl>("get_physics_control", vehicles);
+  }
+
+  std::vector<rpc::VehicleLightState> Client::GetVehiclesLightState(
+      const std::vector<rpc::ActorId> &vehicles) const {
+    return _pimpl->CallForEach<carla::rpc::VehicleLightState>("get_vehicle_light_state", vehicles);
+  }
+
   void Client::ApplyPhysicsControlToVehicle(
       rpc::ActorId vehicle,
       const rpc::VehiclePhysicsControl &physics_control) {
@@ -560,11 +866,46 @@ namespace detail {
   void Client::SubscribeToStream(
       const streaming::Token &token,
       std::function<void(Buffer)> callback) {
-    _pimpl->streaming_client.Subscribe(token, std::move(callback));
+    _pimpl->streaming_client.Subscribe(
+        _pimpl->RelayStream(token),
+        _pimpl->CountMessages(token, std::move(callback)));
+  }
+
+  void Client::SubscribeToSensorStream(
+      const streaming::Token &token,
+      std::function<void(Buffer)> callback) {
+    _pimpl->streaming_client.Subscribe(
+        _pimpl->RelayStream(token),
+        GetSensorCallbackOptions(),
+        _pimpl->CountMessages(token, std::move(callback)));
   }
 
   void Client::UnSubscribeFromStream(const streaming::Token &token) {
-    _pimpl->streaming_client.UnSubscribe(token);
+    _pimpl->recorder.RemoveStream(MakeTokenKey(token));
+    _pimpl->streaming_client.UnSubscribe(_pimpl->ReleaseStream(token));
+  }
+
+  void Client::SetSensorCallbackOptions(const streaming::CallbackQueueOptions &options) {
+    std::lock_guard<std::mutex> lock(_pimpl->sensor_callback_options_mutex);
+    _pimpl->sensor_callback_options = options;
+  }
+
+  streaming::CallbackQueueOptions Client::GetSensorCallbackOptions() const {
+    std::lock_guard<std::mutex> lock(_pimpl->sensor_callback_options_mutex);
+    return _pimpl->sensor_callback_options;
+  }
+
+  boost::optional<streaming::CallbackQueueStats> Client::GetStreamCallbackStats(
+      const streaming::Token &token) const {
+    return _pimpl->streaming_client.GetCallbackQueueStats(_pimpl->GetSubscribedToken(token));
+  }
+
+  RpcStatistics Client::GetRpcStatistics() const {
+    return _pimpl->recorder.GetStatistics();
+  }
+
+  void Client::ResetRpcStatistics() {
+    _pimpl->recorder.Reset();
   }
 
   void Client::DrawDebugShape(const rpc::DebugShape &shape) {
@@ -582,6 +923,23 @@ namespace detail {
     return result.as<std::vector<rpc::CommandResponse>>();
   }
 
+  void Client::ApplyControlBatch(const rpc::ControlBatch &batch, bool do_tick_cue) {
+    _pimpl->AsyncCall("apply_control_batch", batch, do_tick_cue);
+  }
+
+  std::vector<rpc::ActorId> Client::ApplyControlBatchSync(
+      const rpc::ControlBatch &batch,
+      bool do_tick_cue) {
+    return _pimpl->CallAndWait<std::vector<rpc::ActorId>>("apply_control_batch", batch, do_tick_cue);
+  }
+
+  std::vector<rpc::CommandResponse> Client::SpawnActorsBulk(
+      const rpc::SpawnActorsBulk &request,
+      bool do_tick_cue) {
+    using return_t = std::vector<rpc::CommandResponse>;
+    return _pimpl->CallAndWait<return_t>("spawn_actors_bulk", request, do_tick_cue);
+  }
+
   uint64_t Client::SendTickCue() {
     return _pimpl->CallAndWait<uint64_t>("tick_cue");
   }
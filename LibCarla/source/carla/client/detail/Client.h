@@ -9,6 +9,7 @@
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/Time.h"
+#include "carla/client/RpcStatistics.h"
 #include "carla/geom/Transform.h"
 #include "carla/geom/Location.h"
 #include "carla/rpc/Actor.h"
@@ -16,6 +17,7 @@
 #include "carla/rpc/AttachmentType.h"
 #include "carla/rpc/Command.h"
 #include "carla/rpc/CommandResponse.h"
+#include "carla/rpc/ControlBatch.h"
 #include "carla/rpc/EnvironmentObject.h"
 #include "carla/rpc/EpisodeInfo.h"
 #include "carla/rpc/EpisodeSettings.h"
@@ -24,6 +26,7 @@
 #include "carla/rpc/MapInfo.h"
 #include "carla/rpc/MapLayer.h"
 #include "carla/rpc/OpendriveGenerationParameters.h"
+#include "carla/rpc/SpawnActorsBulk.h"
 #include "carla/rpc/TrafficLightState.h"
 #include "carla/rpc/VehicleDoor.h"
 #include "carla/rpc/VehicleLightStateList.h"
@@ -33,6 +36,9 @@
 #include "carla/rpc/WeatherParameters.h"
 #include "carla/rpc/Texture.h"
 #include "carla/rpc/MaterialParameter.h"
+#include "carla/streaming/CallbackQueueOptions.h"
+
+#include <boost/optional.hpp>
 
 #include <functional>
 #include <memory>
@@ -153,6 +159,16 @@ namespace detail {
 
     rpc::VehicleLightState GetVehicleLightState(rpc::ActorId vehicle) const;
 
+    /// Like GetVehiclePhysicsControl for many vehicles at once, the requests
+    /// are pipelined and answered in a single round trip.
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<rpc::ActorId> &vehicles) const;
+
+    /// Like GetVehicleLightState for many vehicles at once, the requests are
+    /// pipelined and answered in a single round trip.
+    std::vector<rpc::VehicleLightState> GetVehiclesLightState(
+        const std::vector<rpc::ActorId> &vehicles) const;
+
     void ApplyPhysicsControlToVehicle(
         rpc::ActorId vehicle,
         const rpc::VehiclePhysicsControl &physics_control);
@@ -356,8 +372,28 @@ namespace detail {
         const streaming::Token &token,
         std::function<void(Buffer)> callback);
 
+    /// Subscribe with the callback queue options set for sensors.
+    void SubscribeToSensorStream(
+        const streaming::Token &token,
+        std::function<void(Buffer)> callback);
+
     void UnSubscribeFromStream(const streaming::Token &token);
 
+    /// Set how the callbacks of the sensor streams subscribed from now on are
+    /// run.
+    void SetSensorCallbackOptions(const streaming::CallbackQueueOptions &options);
+
+    streaming::CallbackQueueOptions GetSensorCallbackOptions() const;
+
+    boost::optional<streaming::CallbackQueueStats> GetStreamCallbackStats(
+        const streaming::Token &token) const;
+
+    /// Calls made and stream messages received since the client was created
+    /// or the last ResetRpcStatistics.
+    RpcStatistics GetRpcStatistics() const;
+
+    void ResetRpcStatistics();
+
     void DrawDebugShape(const rpc::DebugShape &shape);
 
     void ApplyBatch(
@@ -368,6 +404,21 @@ namespace detail {
         std::vector<rpc::Command> commands,
         bool do_tick_cue);
 
+    void ApplyControlBatch(
+        const rpc::ControlBatch &batch,
+        bool do_tick_cue);
+
+    /// Return the ids of the actors the control could not be applied to.
+    std::vector<rpc::ActorId> ApplyControlBatchSync(
+        const rpc::ControlBatch &batch,
+        bool do_tick_cue);
+
+    /// Return one response per description, the id of the actor spawned or
+    /// the reason it could not be spawned.
+    std::vector<rpc::CommandResponse> SpawnActorsBulk(
+        const rpc::SpawnActorsBulk &request,
+        bool do_tick_cue);
+
     uint64_t SendTickCue();
 
     std::vector<rpc::LightState> QueryLightsStateToServer() const;
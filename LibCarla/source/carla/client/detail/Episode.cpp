@@ -7,12 +7,17 @@
 #include "carla/client/detail/Episode.h"
 
 #include "carla/Logging.h"
+#include "carla/StringUtil.h"
 #include "carla/client/detail/Client.h"
+#include "carla/client/detail/LaneInvasionTracker.h"
 #include "carla/client/detail/WalkerNavigation.h"
 #include "carla/sensor/Deserializer.h"
 #include "carla/trafficmanager/TrafficManager.h"
 
+#include <algorithm>
 #include <exception>
+#include <numeric>
+#include <unordered_map>
 
 namespace carla {
 namespace client {
@@ -57,8 +62,16 @@ using namespace std::chrono_literals;
       if (self != nullptr) {
 
         auto data = sensor::Deserializer::Deserialize(std::move(buffer));
-        auto next = std::make_shared<const EpisodeState>(CastData(*data));
+        const auto &raw_state = CastData(*data);
         auto prev = self->GetState();
+        if (!prev->CanBeUpdatedWith(raw_state)) {
+          // A delta that does not follow the last state (we just connected or
+          // a message was lost), the actors are not updated until the next
+          // keyframe.
+          log_debug("episode state: skipping delta", raw_state.GetSequence(),
+                    "on top of", prev->GetSequence());
+        }
+        auto next = std::make_shared<const EpisodeState>(raw_state, *prev);
 
         // TODO: Update how the map change is detected
         bool HasMapChanged = next->HasMapChanged();
@@ -86,6 +99,14 @@ using namespace std::chrono_literals;
             }
           } while (!self->_state.compare_exchange(&prev, next));
 
+          // Wake up the threads waiting for this frame. Locking the mutex
+          // guarantees a waiter cannot miss the notification between
+          // checking the frame and going to sleep.
+          {
+            std::lock_guard<std::mutex> lock(self->_frame_mutex);
+          }
+          self->_frame_received.notify_all();
+
           if(UpdateLights) {
             self->_on_light_update_callbacks.Call(next);
           }
@@ -108,6 +129,12 @@ using namespace std::chrono_literals;
             navigation->Tick(self);
           }
 
+          // Tick client-side lane invasion sensors.
+          auto lane_invasion_tracker = self->_lane_invasion_tracker.load();
+          if (lane_invasion_tracker != nullptr) {
+            lane_invasion_tracker->Tick(next);
+          }
+
           // Call user callbacks.
           self->_on_tick_callbacks.Call(next);
         }
@@ -115,6 +142,13 @@ using namespace std::chrono_literals;
     });
   }
 
+  bool Episode::WaitForFrame(uint64_t frame, time_duration timeout) const {
+    std::unique_lock<std::mutex> lock(_frame_mutex);
+    return _frame_received.wait_for(lock, timeout.to_chrono(), [&]() {
+      return GetState()->GetFrame() >= frame;
+    });
+  }
+
   boost::optional<rpc::Actor> Episode::GetActorById(ActorId id) {
     auto actor = _actors.GetActorById(id);
     if (!actor.has_value()) {
@@ -139,6 +173,18 @@ using namespace std::chrono_literals;
     return navigation;
   }
 
+  std::shared_ptr<LaneInvasionTracker> Episode::CreateLaneInvasionTrackerIfMissing() {
+    std::shared_ptr<LaneInvasionTracker> tracker;
+    do {
+      tracker = _lane_invasion_tracker.load();
+      if (tracker == nullptr) {
+        auto new_tracker = std::make_shared<LaneInvasionTracker>();
+        _lane_invasion_tracker.compare_exchange(&tracker, new_tracker);
+      }
+    } while (tracker == nullptr);
+    return tracker;
+  }
+
   std::vector<rpc::Actor> Episode::GetActorsById(const std::vector<ActorId> &actor_ids) {
     return GetActorsById_Impl(_client, _actors, actor_ids);
   }
@@ -147,10 +193,92 @@ using namespace std::chrono_literals;
     return GetActorsById_Impl(_client, _actors, GetState()->GetActorIds());
   }
 
+  ActorQueryResult Episode::QueryActors(const ActorQuery &query) {
+    const auto state = GetState();
+    ActorQueryResult result;
+    result.frame = state->GetFrame();
+
+    // Candidates, as positions in the state.
+    std::vector<size_t> positions;
+    if (query.location.has_value()) {
+      state->GetGridIndex().ForEachInRadius(*query.location, query.radius, [&](size_t position) {
+        positions.emplace_back(position);
+      });
+      std::sort(positions.begin(), positions.end());
+    } else {
+      positions.resize(state->size());
+      std::iota(positions.begin(), positions.end(), size_t(0u));
+    }
+
+    // Filter by type, this needs the actor descriptions.
+    std::vector<size_t> selected;
+    const bool filter_by_type = (query.type_pattern != "*");
+    const bool with_bounding_boxes = (query.attributes & ActorQuery::BoundingBox) != 0u;
+    if (filter_by_type || with_bounding_boxes) {
+      std::vector<ActorId> ids;
+      ids.reserve(positions.size());
+      for (auto position : positions) {
+        ids.emplace_back(state->GetActorSnapshotAt(position).id);
+      }
+      auto missing_ids = _actors.GetMissingIds(ids);
+      if (!missing_ids.empty()) {
+        _actors.InsertRange(_client.GetActorsById(missing_ids));
+      }
+      // There are usually few different types, match each one only once.
+      std::unordered_map<std::string, bool> type_matches;
+      auto it = positions.begin();
+      _actors.ForEachActorById(ids, [&](const rpc::Actor *actor) {
+        const auto position = *it++;
+        if (filter_by_type) {
+          if (actor == nullptr) {
+            return;
+          }
+          auto match = type_matches.find(actor->description.id);
+          if (match == type_matches.end()) {
+            match = type_matches.emplace(
+                actor->description.id,
+                StringUtil::Match(actor->description.id, query.type_pattern)).first;
+          }
+          if (!match->second) {
+            return;
+          }
+        }
+        selected.emplace_back(position);
+        if (with_bounding_boxes) {
+          result.bounding_boxes.emplace_back(
+              actor != nullptr ? actor->bounding_box : geom::BoundingBox{});
+        }
+      });
+    } else {
+      selected = std::move(positions);
+    }
+
+    // Dynamic attributes, from the snapshots.
+    result.ids.reserve(selected.size());
+    for (auto position : selected) {
+      result.ids.emplace_back(state->GetActorSnapshotAt(position).id);
+    }
+    auto fill = [&](uint32_t attribute, auto &column, auto get) {
+      if ((query.attributes & attribute) != 0u) {
+        column.reserve(selected.size());
+        for (auto position : selected) {
+          column.emplace_back(get(state->GetActorSnapshotAt(position)));
+        }
+      }
+    };
+    fill(ActorQuery::Location, result.locations, [](const ActorSnapshot &s) { return s.transform.location; });
+    fill(ActorQuery::Rotation, result.rotations, [](const ActorSnapshot &s) { return s.transform.rotation; });
+    fill(ActorQuery::Velocity, result.velocities, [](const ActorSnapshot &s) { return s.velocity; });
+    fill(ActorQuery::AngularVelocity, result.angular_velocities, [](const ActorSnapshot &s) { return s.angular_velocity; });
+    fill(ActorQuery::Acceleration, result.accelerations, [](const ActorSnapshot &s) { return s.acceleration; });
+    return result;
+  }
+
   void Episode::OnEpisodeStarted() {
     _actors.Clear();
     _on_tick_callbacks.Clear();
     _navigation.reset();
+    _lane_invasion_tracker.reset();
     traffic_manager::TrafficManager::Release();
   }
 
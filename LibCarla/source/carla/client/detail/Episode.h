@@ -9,14 +9,18 @@
 #include "carla/AtomicSharedPtr.h"
 #include "carla/NonCopyable.h"
 #include "carla/RecurrentSharedFuture.h"
+#include "carla/client/ActorQuery.h"
 #include "carla/client/Timestamp.h"
 #include "carla/client/WorldSnapshot.h"
 #include "carla/client/detail/CachedActorList.h"
 #include "carla/client/detail/CallbackList.h"
 #include "carla/client/detail/EpisodeState.h"
+#include "carla/client/detail/LaneInvasionTracker.h"
 #include "carla/client/detail/WalkerNavigation.h"
 #include "carla/rpc/EpisodeInfo.h"
 
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 
 namespace carla {
@@ -57,6 +61,8 @@ namespace detail {
       return nav;
     }
 
+    std::shared_ptr<LaneInvasionTracker> CreateLaneInvasionTrackerIfMissing();
+
     void RegisterActor(rpc::Actor actor) {
       _actors.Insert(std::move(actor));
     }
@@ -67,10 +73,20 @@ namespace detail {
 
     std::vector<rpc::Actor> GetActors();
 
+    /// Evaluate @a query against the current episode state. The actor
+    /// descriptions are only requested to the server for actors missing in
+    /// the cache, and only if the query filters by type or asks for the
+    /// bounding boxes.
+    ActorQueryResult QueryActors(const ActorQuery &query);
+
     boost::optional<WorldSnapshot> WaitForState(time_duration timeout) {
       return _snapshot.WaitFor(timeout);
     }
 
+    /// Block until the state of @a frame, or a later one, is received.
+    /// Return false if @a timeout elapses first.
+    bool WaitForFrame(uint64_t frame, time_duration timeout) const;
+
     size_t RegisterOnTickEvent(std::function<void(WorldSnapshot)> callback) {
       return _on_tick_callbacks.Push(std::move(callback));
     }
@@ -128,6 +144,8 @@ namespace detail {
 
     AtomicSharedPtr<WalkerNavigation> _navigation;
 
+    AtomicSharedPtr<LaneInvasionTracker> _lane_invasion_tracker;
+
     std::string _pending_exceptions_msg;
 
     CachedActorList _actors;
@@ -140,6 +158,11 @@ namespace detail {
 
     RecurrentSharedFuture<WorldSnapshot> _snapshot;
 
+    mutable std::mutex _frame_mutex;
+
+    /// Notified each time a new state is stored.
+    mutable std::condition_variable _frame_received;
+
     const streaming::Token _token;
 
     bool _pending_exceptions = false;
@@ -6,10 +6,39 @@
 
 #include "carla/client/detail/EpisodeState.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace carla {
 namespace client {
 namespace detail {
 
+  using Serializer = sensor::s11n::EpisodeStateSerializer;
+
+  static void ReadKeyframe(
+      const sensor::data::RawEpisodeState &state,
+      std::vector<ActorSnapshot> &actors) {
+    DEBUG_ASSERT(!state.IsDelta());
+    actors.reserve(state.size());
+    for (auto &&actor : state) {
+      actors.emplace_back(ActorSnapshot{
+          actor.id,
+          actor.actor_state,
+          actor.transform,
+          actor.velocity,
+          actor.angular_velocity,
+          actor.acceleration,
+          actor.state});
+    }
+  }
+
+  static bool HaveSameIds(
+      const std::vector<ActorSnapshot> &lhs,
+      const std::vector<ActorSnapshot> &rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        [](const ActorSnapshot &a, const ActorSnapshot &b) { return a.id == b.id; });
+  }
+
   EpisodeState::EpisodeState(const sensor::data::RawEpisodeState &state)
     : _episode_id(state.GetEpisodeId()),
       _timestamp(
@@ -18,24 +47,104 @@ namespace detail {
           state.GetDeltaSeconds(),
           state.GetPlatformTimeStamp()),
       _map_origin(state.GetMapOrigin()),
-      _simulation_state(state.GetSimulationState()) {
-    _actors.reserve(state.size());
-    for (auto &&actor : state) {
-      DEBUG_ONLY(auto result = )
-      _actors.emplace(
-          actor.id,
-          ActorSnapshot{
-              actor.id,
-              actor.actor_state,
-              actor.transform,
-              actor.velocity,
-              actor.angular_velocity,
-              actor.acceleration,
-              actor.state});
-      DEBUG_ASSERT(result.second);
+      _simulation_state(state.GetSimulationState()),
+      _sequence(state.GetSequence()) {
+    ReadKeyframe(state, _actors);
+  }
+
+  EpisodeState::EpisodeState(
+      const sensor::data::RawEpisodeState &state,
+      const EpisodeState &previous)
+    : _episode_id(state.GetEpisodeId()),
+      _timestamp(
+          state.GetFrame(),
+          state.GetGameTimeStamp(),
+          state.GetDeltaSeconds(),
+          state.GetPlatformTimeStamp()),
+      _map_origin(state.GetMapOrigin()),
+      _simulation_state(state.GetSimulationState()),
+      _sequence(state.GetSequence()) {
+    if (!previous.CanBeUpdatedWith(state)) {
+      // Missing the message before this delta, advance the timestamp but
+      // wait for the next keyframe to update the actors.
+      _sequence = 0u;
+      _is_stale = true;
+      if (_episode_id == previous._episode_id) {
+        _actors = previous._actors;
+        _index = previous.GetSharedIndex();
+      }
+    } else if (state.IsDelta()) {
+      _actors = previous._actors;
+      _index = previous.GetSharedIndex();
+      ApplyDelta(state);
+    } else {
+      ReadKeyframe(state, _actors);
+      if (HaveSameIds(_actors, previous._actors)) {
+        _index = previous.GetSharedIndex();
+      }
     }
   }
 
+  void EpisodeState::ApplyDelta(const sensor::data::RawEpisodeState &state) {
+    const auto header = state.GetDeltaHeader();
+    const auto number_of_actors = _actors.size();
+    const unsigned char *position = state.GetDeltaRecords();
+    Serializer::DeltaRecordHeader record;
+    for (auto i = 0u; i < header.number_of_records; ++i) {
+      std::memcpy(&record, position, sizeof(record));
+      auto it = _index->find(record.id);
+      if (it != _index->end()) {
+        position = Serializer::ReadDeltaRecord(position, record, _actors[it->second]);
+      } else {
+        // New actors come with all the fields.
+        DEBUG_ASSERT(record.fields == Serializer::AllFields);
+        _actors.emplace_back();
+        position = Serializer::ReadDeltaRecord(position, record, _actors.back());
+      }
+    }
+    if (header.number_of_removed_actors > 0u) {
+      std::vector<bool> removed(number_of_actors, false);
+      for (auto i = 0u; i < header.number_of_removed_actors; ++i) {
+        auto it = _index->find(state.GetRemovedActorId(i));
+        if (it != _index->end()) {
+          removed[it->second] = true;
+        }
+      }
+      // Compact the array keeping the order of the remaining actors.
+      size_t count = 0u;
+      for (auto i = 0u; i < _actors.size(); ++i) {
+        if ((i >= number_of_actors) || !removed[i]) {
+          if (count != i) {
+            _actors[count] = _actors[i];
+          }
+          ++count;
+        }
+      }
+      _actors.resize(count);
+    }
+    if (_actors.size() != number_of_actors || header.number_of_removed_actors > 0u) {
+      // Rebuilt on the next lookup.
+      _index = nullptr;
+    }
+  }
+
+  const std::shared_ptr<const EpisodeState::ActorIndex> &EpisodeState::GetSharedIndex() const {
+    std::call_once(_index_flag, [this]() {
+      if (_index != nullptr) {
+        return;
+      }
+      auto index = std::make_shared<ActorIndex>();
+      index->reserve(_actors.size());
+      for (auto i = 0u; i < _actors.size(); ++i) {
+        DEBUG_ONLY(auto result = )
+        index->emplace(_actors[i].id, i);
+        DEBUG_ASSERT(result.second);
+      }
+      _index = std::move(index);
+    });
+    return _index;
+  }
+
 } // namespace detail
 } // namespace client
 } // namespace carla
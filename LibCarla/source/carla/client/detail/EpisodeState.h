@@ -6,36 +6,80 @@
 
 #pragma once
 
-#include "carla/Iterator.h"
 #include "carla/ListView.h"
 #include "carla/NonCopyable.h"
+#include "carla/client/ActorKinematics.h"
 #include "carla/client/ActorSnapshot.h"
 #include "carla/client/Timestamp.h"
+#include "carla/client/detail/ActorGridIndex.h"
 #include "carla/geom/Vector3DInt.h"
 #include "carla/sensor/data/RawEpisodeState.h"
 
+#include <boost/iterator/transform_iterator.hpp>
 #include <boost/optional.hpp>
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace carla {
 namespace client {
 namespace detail {
 
   /// Represents the state of all the actors of an episode at a given frame.
+  ///
+  /// The snapshots are stored in a flat array, the map from actor id to
+  /// position in the array is built the first time an actor is looked up,
+  /// and shared between consecutive states as long as the set of actors does
+  /// not change. The kinematics of all the actors are also available as
+  /// parallel arrays, built on demand too.
   class EpisodeState
     : public std::enable_shared_from_this<EpisodeState>,
       private NonCopyable {
 
       using SimulationState = sensor::s11n::EpisodeStateSerializer::SimulationState;
 
+      using ActorIndex = std::unordered_map<ActorId, size_t>;
+
+      struct GetSnapshotId {
+        ActorId operator()(const ActorSnapshot &snapshot) const {
+          return snapshot.id;
+        }
+      };
+
   public:
 
-    explicit EpisodeState(uint64_t episode_id) : _episode_id(episode_id) {}
+    explicit EpisodeState(uint64_t episode_id)
+      : _episode_id(episode_id),
+        _index(std::make_shared<ActorIndex>()) {}
 
+    /// @pre @a state is not a delta.
     explicit EpisodeState(const sensor::data::RawEpisodeState &state);
 
+    /// Decode @a state on top of @a previous. If @a state is a keyframe,
+    /// @a previous is only used to share the actor index when the actors are
+    /// the same.
+    ///
+    /// If @a state is a delta that cannot be applied on top of @a previous,
+    /// only the frame and timestamp are taken from it. The actors are kept
+    /// from @a previous (or left empty if the episode changed), the state is
+    /// marked as stale, and it does not accept further deltas until the next
+    /// keyframe.
+    EpisodeState(
+        const sensor::data::RawEpisodeState &state,
+        const EpisodeState &previous);
+
+    /// Whether @a state can be decoded on top of this state. Always true for
+    /// keyframes, deltas need to be the next message of the same episode.
+    bool CanBeUpdatedWith(const sensor::data::RawEpisodeState &state) const {
+      return
+          !state.IsDelta() ||
+          ((state.GetEpisodeId() == _episode_id) &&
+           (_sequence > 0u) &&
+           (state.GetSequence() == _sequence + 1u));
+    }
+
     auto GetEpisodeId() const {
       return _episode_id;
     }
@@ -48,6 +92,18 @@ namespace detail {
       return _timestamp;
     }
 
+    /// Sequence number of the message this state was decoded from, zero if
+    /// none or if the message was a delta that could not be applied.
+    uint64_t GetSequence() const {
+      return _sequence;
+    }
+
+    /// Whether the actors of this state are older than its frame, because a
+    /// delta was lost and the next keyframe has not arrived yet.
+    bool IsStale() const {
+      return _is_stale;
+    }
+
     SimulationState GetsimulationState() const {
       return _simulation_state;
     }
@@ -61,7 +117,8 @@ namespace detail {
     }
 
     bool ContainsActorSnapshot(ActorId actor_id) const {
-      return _actors.find(actor_id) != _actors.end();
+      const auto &index = GetIndex();
+      return index.find(actor_id) != index.end();
     }
 
     ActorSnapshot GetActorSnapshot(ActorId id) const {
@@ -78,32 +135,84 @@ namespace detail {
 
     auto GetActorIds() const {
       return MakeListView(
-          iterator::make_map_keys_const_iterator(_actors.begin()),
-          iterator::make_map_keys_const_iterator(_actors.end()));
+          boost::make_transform_iterator(_actors.begin(), GetSnapshotId{}),
+          boost::make_transform_iterator(_actors.end(), GetSnapshotId{}));
     }
 
     size_t size() const {
       return _actors.size();
     }
 
+    /// Snapshot at @a position of the array iterated by begin() and end().
+    const ActorSnapshot &GetActorSnapshotAt(size_t position) const {
+      DEBUG_ASSERT(position < _actors.size());
+      return _actors[position];
+    }
+
+    /// Grid index over the actor locations of this state, built the first
+    /// time it is requested.
+    const ActorGridIndex &GetGridIndex() const {
+      std::call_once(_grid_index_flag, [this]() {
+        auto grid_index = std::make_unique<ActorGridIndex>();
+        grid_index->Build(_actors.begin(), _actors.end(), [](const ActorSnapshot &snapshot) {
+          return snapshot.transform.location;
+        });
+        _grid_index = std::move(grid_index);
+      });
+      return *_grid_index;
+    }
+
+    /// Kinematics of the actors of this state as parallel arrays, built the
+    /// first time they are requested.
+    const ActorKinematics &GetKinematics() const {
+      std::call_once(_kinematics_flag, [this]() {
+        auto kinematics = std::make_unique<ActorKinematics>();
+        kinematics->ids.reserve(_actors.size());
+        kinematics->transforms.reserve(_actors.size());
+        kinematics->velocities.reserve(_actors.size());
+        kinematics->angular_velocities.reserve(_actors.size());
+        kinematics->accelerations.reserve(_actors.size());
+        for (auto &&snapshot : _actors) {
+          kinematics->ids.emplace_back(snapshot.id);
+          kinematics->transforms.emplace_back(snapshot.transform);
+          kinematics->velocities.emplace_back(snapshot.velocity);
+          kinematics->angular_velocities.emplace_back(snapshot.angular_velocity);
+          kinematics->accelerations.emplace_back(snapshot.acceleration);
+        }
+        _kinematics = std::move(kinematics);
+      });
+      return *_kinematics;
+    }
+
     auto begin() const {
-      return iterator::make_map_values_const_iterator(_actors.begin());
+      return _actors.begin();
     }
 
     auto end() const {
-      return iterator::make_map_values_const_iterator(_actors.end());
+      return _actors.end();
     }
 
   private:
 
     template <typename T>
     void CopyActorSnapshotIfPresent(ActorId id, T &value) const {
-      auto it = _actors.find(id);
-      if (it != _actors.end()) {
-        value = it->second;
+      const auto &index = GetIndex();
+      auto it = index.find(id);
+      if (it != index.end()) {
+        value = _actors[it->second];
       }
     }
 
+    const ActorIndex &GetIndex() const {
+      return *GetSharedIndex();
+    }
+
+    /// Map from actor id to position in the array, built the first time it
+    /// is requested unless it was shared by the previous state.
+    const std::shared_ptr<const ActorIndex> &GetSharedIndex() const;
+
+    void ApplyDelta(const sensor::data::RawEpisodeState &state);
+
     const uint64_t _episode_id;
 
     const Timestamp _timestamp;
@@ -112,7 +221,23 @@ namespace detail {
 
     SimulationState _simulation_state;
 
-    std::unordered_map<ActorId, ActorSnapshot> _actors;
+    uint64_t _sequence = 0u;
+
+    bool _is_stale = false;
+
+    std::vector<ActorSnapshot> _actors;
+
+    mutable std::once_flag _index_flag;
+
+    mutable std::shared_ptr<const ActorIndex> _index;
+
+    mutable std::once_flag _grid_index_flag;
+
+    mutable std::unique_ptr<const ActorGridIndex> _grid_index;
+
+    mutable std::once_flag _kinematics_flag;
+
+    mutable std::unique_ptr<const ActorKinematics> _kinematics;
   };
 
 } // namespace detail
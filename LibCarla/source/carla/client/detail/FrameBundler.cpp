@@ -0,0 +1,104 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/FrameBundler.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/sensor/SensorData.h"
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  FrameBundler::FrameBundler(
+      const size_t number_of_streams,
+      const time_duration timeout,
+      const bool allow_partial)
+    : _number_of_streams(number_of_streams),
+      _timeout(std::chrono::duration_cast<clock::duration>(timeout.to_chrono())),
+      _allow_partial(allow_partial) {
+    DEBUG_ASSERT(_number_of_streams > 0u);
+  }
+
+  FrameBundler::BundleList FrameBundler::Push(
+      const size_t index,
+      SharedPtr<sensor::SensorData> data,
+      const clock::time_point now) {
+    DEBUG_ASSERT(index < _number_of_streams);
+    DEBUG_ASSERT(data != nullptr);
+    BundleList result;
+    const size_t frame = data->GetFrame();
+    if (_last_frame.has_value() && (frame <= *_last_frame)) {
+      log_debug("FrameBundler: discarding late data of frame", frame);
+      return result;
+    }
+
+    auto it = _pending.find(frame);
+    if (it == _pending.end()) {
+      PendingFrame pending;
+      pending.first_arrival = now;
+      pending.data.resize(_number_of_streams);
+      it = _pending.emplace(frame, std::move(pending)).first;
+    }
+    auto &pending = it->second;
+    if (pending.data[index] == nullptr) {
+      ++pending.count;
+    }
+    // Sensors sending several messages per frame keep the most recent one.
+    pending.data[index] = std::move(data);
+
+    if (pending.count == _number_of_streams) {
+      Resolve(std::next(it), result);
+    } else if (_pending.size() > MAX_PENDING_FRAMES) {
+      Resolve(std::next(_pending.begin()), result);
+    }
+    return result;
+  }
+
+  FrameBundler::BundleList FrameBundler::Expire(const clock::time_point now) {
+    BundleList result;
+    if (_timeout == clock::duration::zero()) {
+      return result;
+    }
+    // Resolve in order up to the newest frame expired.
+    auto end = _pending.begin();
+    for (auto it = _pending.begin(); it != _pending.end(); ++it) {
+      if (it->second.first_arrival + _timeout <= now) {
+        end = std::next(it);
+      }
+    }
+    Resolve(end, result);
+    return result;
+  }
+
+  boost::optional<FrameBundler::clock::time_point> FrameBundler::GetNextExpiration() const {
+    if ((_timeout == clock::duration::zero()) || _pending.empty()) {
+      return boost::none;
+    }
+    auto first_arrival = _pending.begin()->second.first_arrival;
+    for (const auto &pair : _pending) {
+      first_arrival = std::min(first_arrival, pair.second.first_arrival);
+    }
+    return first_arrival + _timeout;
+  }
+
+  void FrameBundler::Resolve(const PendingMap::iterator end, BundleList &result) {
+    for (auto it = _pending.begin(); it != end; ++it) {
+      auto &pending = it->second;
+      if ((pending.count == _number_of_streams) || _allow_partial) {
+        result.emplace_back(MakeShared<SensorBundle>(it->first, std::move(pending.data)));
+      } else {
+        ++_dropped_frames;
+      }
+      _last_frame = it->first;
+    }
+    _pending.erase(_pending.begin(), end);
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
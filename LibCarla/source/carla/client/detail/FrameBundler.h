@@ -0,0 +1,95 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/Time.h"
+#include "carla/client/SensorBundle.h"
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+namespace detail {
+
+  /// Matches the data of several sensor streams by frame number.
+  ///
+  /// Each stream delivers its data in order, so once a frame is complete the
+  /// previous pending frames cannot receive more data and are resolved too.
+  /// A resolved frame that misses data is either delivered as a partial
+  /// bundle or dropped depending on the policy. Frames pending for longer
+  /// than the timeout, or beyond the maximum number of pending frames, are
+  /// resolved the same way.
+  ///
+  /// @warning This class is not thread-safe.
+  class FrameBundler : private NonCopyable {
+  public:
+
+    using clock = std::chrono::steady_clock;
+
+    using BundleList = std::vector<SharedPtr<SensorBundle>>;
+
+    /// Maximum number of frames waiting for data at the same time.
+    static constexpr size_t MAX_PENDING_FRAMES = 32u;
+
+    /// A @a timeout of zero never expires the pending frames.
+    FrameBundler(size_t number_of_streams, time_duration timeout, bool allow_partial);
+
+    /// Add the @a data received from stream @a index. Returns the bundles
+    /// resolved, ordered by frame.
+    BundleList Push(size_t index, SharedPtr<sensor::SensorData> data, clock::time_point now);
+
+    /// Resolve the frames pending since before @a now minus the timeout.
+    BundleList Expire(clock::time_point now);
+
+    /// Time at which the oldest pending frame expires, if any.
+    boost::optional<clock::time_point> GetNextExpiration() const;
+
+    /// Number of frames dropped because they missed data.
+    size_t GetNumberOfDroppedFrames() const {
+      return _dropped_frames;
+    }
+
+  private:
+
+    struct PendingFrame {
+
+      clock::time_point first_arrival;
+
+      std::vector<SharedPtr<sensor::SensorData>> data;
+
+      size_t count = 0u;
+    };
+
+    using PendingMap = std::map<size_t, PendingFrame>;
+
+    /// Resolve the pending frames up to @a end (not included).
+    void Resolve(PendingMap::iterator end, BundleList &result);
+
+    const size_t _number_of_streams;
+
+    const clock::duration _timeout;
+
+    const bool _allow_partial;
+
+    PendingMap _pending;
+
+    /// Last frame resolved, data arriving for it or a previous frame is late.
+    boost::optional<size_t> _last_frame;
+
+    size_t _dropped_frames = 0u;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,222 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/client/detail/LaneInvasionTracker.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+#include "carla/client/Map.h"
+#include "carla/client/WorldSnapshot.h"
+#include "carla/geom/Math.h"
+#include "carla/sensor/data/LaneInvasionEvent.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  using LaneCrossingCalculator = road::element::LaneCrossingCalculator;
+
+  // ===========================================================================
+  // -- Static local methods ---------------------------------------------------
+  // ===========================================================================
+
+  static geom::Location Rotate(float yaw, const geom::Location &location) {
+    yaw *= geom::Math::Pi<float>() / 180.0f;
+    const float c = std::cos(yaw);
+    const float s = std::sin(yaw);
+    return {
+        c * location.x - s * location.y,
+        s * location.x + c * location.y,
+        location.z};
+  }
+
+  static std::array<geom::Location, 4u> MakeCorners(
+      const geom::BoundingBox &box,
+      const geom::Transform &transform) {
+    const auto location = transform.location + box.location;
+    const auto yaw = transform.rotation.yaw;
+    return {{
+        location + Rotate(yaw, geom::Location( box.extent.x,  box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location(-box.extent.x,  box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location( box.extent.x, -box.extent.y, 0.0f)),
+        location + Rotate(yaw, geom::Location(-box.extent.x, -box.extent.y, 0.0f))}};
+  }
+
+  // ===========================================================================
+  // -- LaneInvasionTracker ----------------------------------------------------
+  // ===========================================================================
+
+  LaneInvasionTracker::~LaneInvasionTracker() {
+    if (_map != nullptr) {
+      _map->RemoveOnChangeEvent(_map_change_callback_id);
+    }
+  }
+
+  size_t LaneInvasionTracker::Register(
+      SharedPtr<const Map> map,
+      ActorId parent,
+      const geom::BoundingBox &parent_bounding_box,
+      CallbackFunctionType callback) {
+    DEBUG_ASSERT(map != nullptr);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (map != _map) {
+      SetMap(std::move(map));
+    }
+    // Unique among trackers, a sensor may be stopped after the episode changed.
+    static std::atomic_size_t next_id{1u};
+    Entry entry;
+    entry.id = next_id++;
+    entry.parent = parent;
+    entry.parent_bounding_box = parent_bounding_box;
+    entry.callback = std::make_shared<CallbackFunctionType>(std::move(callback));
+    _entries.emplace_back(std::move(entry));
+    return _entries.back().id;
+  }
+
+  void LaneInvasionTracker::Unregister(const size_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.erase(
+        std::remove_if(_entries.begin(), _entries.end(), [id](const Entry &entry) {
+          return entry.id == id;
+        }),
+        _entries.end());
+  }
+
+  void LaneInvasionTracker::SetMap(SharedPtr<const Map> map) {
+    if (_map != nullptr) {
+      _map->RemoveOnChangeEvent(_map_change_callback_id);
+    }
+    _map = std::move(map);
+    // The positions resolved on the previous map, or before the map is
+    // patched, are no longer valid.
+    ResetCorners();
+    _map_change_callback_id = _map->RegisterOnChangeEvent([this](const road::MapChange &) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      ResetCorners();
+    });
+  }
+
+  void LaneInvasionTracker::ResetCorners() {
+    for (auto &entry : _entries) {
+      entry.has_corners = false;
+    }
+  }
+
+  void LaneInvasionTracker::Tick(const WorldSnapshot &snapshot) {
+    struct Event {
+      std::shared_ptr<CallbackFunctionType> callback;
+      ActorId parent;
+      geom::Transform transform;
+      std::vector<road::element::LaneMarking> crossed_lanes;
+    };
+    std::vector<Event> events;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_entries.empty()) {
+        return;
+      }
+      const auto map_snapshot = _map->GetMap();
+      const auto &map = *map_snapshot;
+      const size_t frame = snapshot.GetFrame();
+
+      // Collect the corners of every parent that moved since the last tick.
+      std::vector<std::pair<Entry *, geom::Transform>> moved_entries;
+      std::vector<LaneCrossingCalculator::Position> positions;
+      std::vector<geom::Location> destinations;
+      for (auto &entry : _entries) {
+        // Make sure the parent is alive.
+        auto parent = snapshot.Find(entry.parent);
+        if (!parent) {
+          continue;
+        }
+
+        // Make sure the current frame is up-to-date.
+        if (entry.has_corners && (entry.frame >= frame)) {
+          continue;
+        }
+
+        const auto corners = MakeCorners(entry.parent_bounding_box, parent->transform);
+
+        // First frame there is nothing to compare with.
+        if (!entry.has_corners) {
+          for (auto i = 0u; i < 4u; ++i) {
+            entry.corners[i] = LaneCrossingCalculator::Locate(map, corners[i]);
+          }
+          entry.has_corners = true;
+          entry.frame = frame;
+          continue;
+        }
+
+        // Make sure the distance is long enough.
+        constexpr float distance_threshold = 10.0f * std::numeric_limits<float>::epsilon();
+        bool moved = true;
+        for (auto i = 0u; i < 4u; ++i) {
+          if ((corners[i] - entry.corners[i].location).Length() < distance_threshold) {
+            moved = false;
+            break;
+          }
+        }
+        if (!moved) {
+          continue;
+        }
+
+        moved_entries.emplace_back(&entry, parent->transform);
+        for (auto i = 0u; i < 4u; ++i) {
+          positions.emplace_back(std::move(entry.corners[i]));
+          destinations.emplace_back(corners[i]);
+        }
+      }
+
+      if (moved_entries.empty()) {
+        return;
+      }
+
+      // Finally compute the crossed lanes of all the sensors in one pass.
+      auto crossed_lanes = LaneCrossingCalculator::Calculate(map, positions, destinations);
+
+      for (auto j = 0u; j < moved_entries.size(); ++j) {
+        auto &entry = *moved_entries[j].first;
+        std::vector<road::element::LaneMarking> lanes;
+        for (auto i = 0u; i < 4u; ++i) {
+          const auto index = 4u * j + i;
+          entry.corners[i] = std::move(positions[index]);
+          lanes.insert(lanes.end(), crossed_lanes[index].begin(), crossed_lanes[index].end());
+        }
+        entry.frame = frame;
+        if (!lanes.empty()) {
+          events.push_back(Event{
+              entry.callback,
+              entry.parent,
+              moved_entries[j].second,
+              std::move(lanes)});
+        }
+      }
+    }
+
+    // Call the user callbacks without holding the lock, so they can stop the
+    // sensors.
+    for (auto &event : events) {
+      try {
+        (*event.callback)(MakeShared<sensor::data::LaneInvasionEvent>(
+            snapshot.GetTimestamp().frame,
+            snapshot.GetTimestamp().elapsed_seconds,
+            event.transform,
+            event.parent,
+            std::move(event.crossed_lanes)));
+      } catch (const std::exception &e) {
+        log_error("LaneInvasionSensor:", e.what());
+      }
+    }
+  }
+
+} // namespace detail
+} // namespace client
+} // namespace carla
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/BoundingBox.h"
+#include "carla/road/element/LaneCrossingCalculator.h"
+#include "carla/rpc/ActorId.h"
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace carla {
+namespace sensor { class SensorData; }
+namespace client {
+
+  class Map;
+  class WorldSnapshot;
+
+namespace detail {
+
+  /// Computes the lane invasions of all the client-side lane invasion sensors
+  /// of an episode in a single pass per tick.
+  ///
+  /// The position of each corner of the parent's bounding box resolved on the
+  /// previous tick is kept as the origin of the next calculation, so a single
+  /// R-tree query per corner is done each tick.
+  class LaneInvasionTracker : private NonCopyable {
+  public:
+
+    using CallbackFunctionType = std::function<void(SharedPtr<sensor::SensorData>)>;
+
+    ~LaneInvasionTracker();
+
+    /// Register a sensor attached to @a parent, @a callback is called with a
+    /// LaneInvasionEvent each tick the parent crosses a lane marking of
+    /// @a map. Returns the id used to unregister the sensor.
+    size_t Register(
+        SharedPtr<const Map> map,
+        ActorId parent,
+        const geom::BoundingBox &parent_bounding_box,
+        CallbackFunctionType callback);
+
+    void Unregister(size_t id);
+
+    void Tick(const WorldSnapshot &snapshot);
+
+  private:
+
+    using Position = road::element::LaneCrossingCalculator::Position;
+
+    struct Entry {
+
+      size_t id;
+
+      ActorId parent;
+
+      geom::BoundingBox parent_bounding_box;
+
+      std::shared_ptr<CallbackFunctionType> callback;
+
+      bool has_corners = false;
+
+      /// Frame at which the corners were resolved.
+      size_t frame = 0u;
+
+      std::array<Position, 4u> corners;
+    };
+
+    std::mutex _mutex;
+
+    void SetMap(SharedPtr<const Map> map);
+
+    void ResetCorners();
+
+    SharedPtr<const Map> _map;
+
+    size_t _map_change_callback_id = 0u;
+
+    std::vector<Entry> _entries;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
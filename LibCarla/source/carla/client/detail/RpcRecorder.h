@@ -0,0 +1,244 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/LatencyHistogram.h"
+#include "carla/NonCopyable.h"
+#include "carla/client/RpcStatistics.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace carla {
+namespace client {
+namespace detail {
+
+  /// Counts the remote calls and the stream messages of a client. The
+  /// counters are relaxed atomics; finding the entry of a function takes a
+  /// lock only the first time when the name is a string literal, see
+  /// GetLiteralCall.
+  class RpcRecorder : private NonCopyable {
+  public:
+
+    using clock = std::chrono::steady_clock;
+
+    class Call : private NonCopyable {
+    public:
+
+      /// A request of @a bytes was sent.
+      void RecordRequest(size_t bytes) {
+        _calls.fetch_add(1u, std::memory_order_relaxed);
+        _bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+      }
+
+      /// The response to a request sent at @a start arrived.
+      void RecordResponse(clock::time_point start, size_t bytes) {
+        _latency.Record(clock::now() - start);
+        _bytes_received.fetch_add(bytes, std::memory_order_relaxed);
+      }
+
+      void RecordError() {
+        _errors.fetch_add(1u, std::memory_order_relaxed);
+      }
+
+    private:
+
+      friend RpcRecorder;
+
+      void Reset() {
+        _calls.store(0u, std::memory_order_relaxed);
+        _errors.store(0u, std::memory_order_relaxed);
+        _bytes_sent.store(0u, std::memory_order_relaxed);
+        _bytes_received.store(0u, std::memory_order_relaxed);
+        _latency.Reset();
+      }
+
+      std::atomic<uint64_t> _calls{0u};
+
+      std::atomic<uint64_t> _errors{0u};
+
+      std::atomic<uint64_t> _bytes_sent{0u};
+
+      std::atomic<uint64_t> _bytes_received{0u};
+
+      LatencyHistogram _latency;
+    };
+
+    class Stream : private NonCopyable {
+    public:
+
+      explicit Stream(uint32_t stream_id)
+        : _stream_id(stream_id),
+          _start(clock::now().time_since_epoch().count()) {}
+
+      void RecordMessage(size_t bytes) {
+        _messages.fetch_add(1u, std::memory_order_relaxed);
+        _bytes.fetch_add(bytes, std::memory_order_relaxed);
+      }
+
+    private:
+
+      friend RpcRecorder;
+
+      void Reset() {
+        _messages.store(0u, std::memory_order_relaxed);
+        _bytes.store(0u, std::memory_order_relaxed);
+        _start.store(clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+      }
+
+      const uint32_t _stream_id;
+
+      std::atomic<clock::rep> _start;
+
+      std::atomic<uint64_t> _messages{0u};
+
+      std::atomic<uint64_t> _bytes{0u};
+    };
+
+    /// Entry of @a function, valid as long as the recorder.
+    Call &GetCall(const std::string &function) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return GetCallLocked(function);
+    }
+
+    /// Same as GetCall, but the entry is cached by the address of
+    /// @a function, so once found it is returned without locking.
+    ///
+    /// @pre @a function is a string literal, or any other string that is
+    /// never modified nor destroyed.
+    Call &GetLiteralCall(const char *function) {
+      const auto first = GetLiteralSlot(function);
+      for (auto i = 0u; i < _literal_calls.size(); ++i) {
+        auto &slot = _literal_calls[(first + i) % _literal_calls.size()];
+        const char *name = slot.name.load(std::memory_order_acquire);
+        if (name == function) {
+          return *slot.call.load(std::memory_order_relaxed);
+        } else if (name == nullptr) {
+          break;
+        }
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto &call = GetCallLocked(function);
+      for (auto i = 0u; i < _literal_calls.size(); ++i) {
+        auto &slot = _literal_calls[(first + i) % _literal_calls.size()];
+        const char *name = slot.name.load(std::memory_order_relaxed);
+        if (name == function) {
+          break;
+        } else if (name == nullptr) {
+          slot.call.store(&call, std::memory_order_relaxed);
+          slot.name.store(function, std::memory_order_release);
+          break;
+        }
+      }
+      return call;
+    }
+
+    /// Start counting the messages of the stream identified by @a key, the
+    /// stream is counted until RemoveStream is called with the same key.
+    std::shared_ptr<Stream> AddStream(const std::string &key, uint32_t stream_id) {
+      auto stream = std::make_shared<Stream>(stream_id);
+      std::lock_guard<std::mutex> lock(_mutex);
+      _streams[key] = stream;
+      return stream;
+    }
+
+    void RemoveStream(const std::string &key) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _streams.erase(key);
+    }
+
+    RpcStatistics GetStatistics() const {
+      RpcStatistics result;
+      const auto now = clock::now().time_since_epoch();
+      std::lock_guard<std::mutex> lock(_mutex);
+      result.calls.reserve(_calls.size());
+      for (auto &&item : _calls) {
+        const Call &call = *item.second;
+        RpcCallStatistics statistics;
+        statistics.function = item.first;
+        statistics.calls = call._calls.load(std::memory_order_relaxed);
+        statistics.errors = call._errors.load(std::memory_order_relaxed);
+        statistics.bytes_sent = call._bytes_sent.load(std::memory_order_relaxed);
+        statistics.bytes_received = call._bytes_received.load(std::memory_order_relaxed);
+        statistics.latency = call._latency.GetStatistics();
+        result.calls.emplace_back(std::move(statistics));
+      }
+      std::sort(result.calls.begin(), result.calls.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.function < rhs.function;
+      });
+      result.streams.reserve(_streams.size());
+      for (auto &&item : _streams) {
+        const Stream &stream = *item.second;
+        const clock::duration elapsed{now.count() - stream._start.load(std::memory_order_relaxed)};
+        StreamStatistics statistics;
+        statistics.stream_id = stream._stream_id;
+        statistics.messages = stream._messages.load(std::memory_order_relaxed);
+        statistics.bytes = stream._bytes.load(std::memory_order_relaxed);
+        statistics.seconds = std::chrono::duration<double>(elapsed).count();
+        result.streams.emplace_back(statistics);
+      }
+      std::sort(result.streams.begin(), result.streams.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.stream_id < rhs.stream_id;
+      });
+      return result;
+    }
+
+    /// Zero every counter, the streams start measuring their rates again.
+    void Reset() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for (auto &&item : _calls) {
+        item.second->Reset();
+      }
+      for (auto &&item : _streams) {
+        item.second->Reset();
+      }
+    }
+
+  private:
+
+    /// @pre _mutex is locked.
+    Call &GetCallLocked(const std::string &function) {
+      auto &call = _calls[function];
+      if (call == nullptr) {
+        call = std::make_unique<Call>();
+      }
+      return *call;
+    }
+
+    static constexpr size_t literal_slot_bits = 10u;
+
+    static size_t GetLiteralSlot(const char *function) {
+      // Fibonacci hashing of the address.
+      const auto address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(function));
+      return static_cast<size_t>((address * 11400714819323198485ull) >> (64u - literal_slot_bits));
+    }
+
+    struct LiteralSlot {
+      std::atomic<const char *> name{nullptr};
+      std::atomic<Call *> call{nullptr};
+    };
+
+    mutable std::mutex _mutex;
+
+    std::unordered_map<std::string, std::unique_ptr<Call>> _calls;
+
+    /// Open addressing table from the address of a function name to its
+    /// entry in _calls, written only with _mutex locked.
+    std::array<LiteralSlot, (size_t(1u) << literal_slot_bits)> _literal_calls;
+
+    std::unordered_map<std::string, std::shared_ptr<Stream>> _streams;
+  };
+
+} // namespace detail
+} // namespace client
+} // namespace carla
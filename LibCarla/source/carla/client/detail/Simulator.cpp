@@ -10,6 +10,7 @@
 #include "carla/Exception.h"
 #include "carla/Logging.h"
 #include "carla/RecurrentSharedFuture.h"
+#include "carla/StopWatch.h"
 #include "carla/client/BlueprintLibrary.h"
 #include "carla/client/FileTransfer.h"
 #include "carla/client/Map.h"
@@ -46,17 +47,7 @@ namespace detail {
   }
 
   static bool SynchronizeFrame(uint64_t frame, const Episode &episode, time_duration timeout) {
-    bool result = true;
-    auto start = std::chrono::system_clock::now();
-    while (frame > episode.GetState()->GetTimestamp().frame) {
-      std::this_thread::yield();
-      auto end = std::chrono::system_clock::now();
-      auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(end-start);
-      if(timeout.to_chrono() < diff) {
-        result = false;
-        break;
-      }
-    }
+    bool result = episode.WaitForFrame(frame, timeout);
     if(result) {
       carla::traffic_manager::TrafficManager::Tick();
     }
@@ -212,11 +203,13 @@ namespace detail {
 
   uint64_t Simulator::Tick(time_duration timeout) {
     DEBUG_ASSERT(_episode != nullptr);
+    StopWatch stop_watch;
     const auto frame = _client.SendTickCue();
     bool result = SynchronizeFrame(frame, *_episode, timeout);
     if (!result) {
       throw_exception(TimeoutException(_client.GetEndpoint(), timeout));
     }
+    _tick_latency.Record(stop_watch.GetDuration());
     return frame;
   }
 
@@ -370,7 +363,7 @@ namespace detail {
       const Sensor &sensor,
       std::function<void(SharedPtr<sensor::SensorData>)> callback) {
     DEBUG_ASSERT(_episode != nullptr);
-    _client.SubscribeToStream(
+    _client.SubscribeToSensorStream(
         sensor.GetActorDescription().GetStreamToken(),
         [cb=std::move(callback), ep=WeakEpisodeProxy{shared_from_this()}](auto buffer) {
           auto data = sensor::Deserializer::Deserialize(std::move(buffer));
@@ -383,6 +376,29 @@ namespace detail {
     _client.UnSubscribeFromStream(sensor.GetActorDescription().GetStreamToken());
   }
 
+  streaming::CallbackQueueStats Simulator::GetSensorCallbackStats(const Sensor &sensor) const {
+    auto stats = _client.GetStreamCallbackStats(sensor.GetActorDescription().GetStreamToken());
+    return stats ? *stats : streaming::CallbackQueueStats{};
+  }
+
+  size_t Simulator::RegisterLaneInvasionSensor(
+      const Vehicle &vehicle,
+      std::function<void(SharedPtr<sensor::SensorData>)> callback) {
+    DEBUG_ASSERT(_episode != nullptr);
+    auto tracker = _episode->CreateLaneInvasionTrackerIfMissing();
+    DEBUG_ASSERT(tracker != nullptr);
+    return tracker->Register(
+        GetCurrentMap(),
+        vehicle.GetId(),
+        vehicle.GetBoundingBox(),
+        std::move(callback));
+  }
+
+  void Simulator::UnregisterLaneInvasionSensor(size_t id) {
+    DEBUG_ASSERT(_episode != nullptr);
+    _episode->CreateLaneInvasionTrackerIfMissing()->Unregister(id);
+  }
+
   void Simulator::FreezeAllTrafficLights(bool frozen) {
     _client.FreezeAllTrafficLights(frozen);
   }
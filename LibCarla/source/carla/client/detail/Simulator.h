@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/Debug.h"
+#include "carla/LatencyHistogram.h"
 #include "carla/Memory.h"
 #include "carla/NonCopyable.h"
 #include "carla/client/Actor.h"
@@ -161,6 +162,14 @@ namespace detail {
       return _client.GetTimeout();
     }
 
+    RpcStatistics GetRpcStatistics() const {
+      return _client.GetRpcStatistics();
+    }
+
+    void ResetRpcStatistics() {
+      _client.ResetRpcStatistics();
+    }
+
     std::string GetClientVersion() {
       return _client.GetClientVersion();
     }
@@ -189,6 +198,12 @@ namespace detail {
 
     uint64_t Tick(time_duration timeout);
 
+    /// Latency from sending the tick cue to receiving the state of the new
+    /// frame, measured on every successful Tick.
+    LatencyHistogram::Statistics GetTickLatencyStatistics() const {
+      return _tick_latency.GetStatistics();
+    }
+
     /// @}
     // =========================================================================
     /// @name Access to global objects in the episode
@@ -253,6 +268,16 @@ namespace detail {
       return _client.GetVehicleLightState(vehicle.GetId());
     }
 
+    std::vector<rpc::VehiclePhysicsControl> GetVehiclesPhysicsControl(
+        const std::vector<ActorId> &vehicles) const {
+      return _client.GetVehiclesPhysicsControl(vehicles);
+    }
+
+    std::vector<rpc::VehicleLightState> GetVehiclesLightState(
+        const std::vector<ActorId> &vehicles) const {
+      return _client.GetVehiclesLightState(vehicles);
+    }
+
     /// Returns all the BBs of all the elements of the level
     std::vector<geom::BoundingBox> GetLevelBBs(uint8_t queried_tag) const {
       return _client.GetLevelBBs(queried_tag);
@@ -319,6 +344,11 @@ namespace detail {
       return _episode->GetActors();
     }
 
+    ActorQueryResult QueryActors(const ActorQuery &query) const {
+      DEBUG_ASSERT(_episode != nullptr);
+      return _episode->QueryActors(query);
+    }
+
     /// Creates an actor instance out of a description of an existing actor.
     /// Note that this does not spawn an actor.
     ///
@@ -580,6 +610,24 @@ namespace detail {
 
     void UnSubscribeFromSensor(const Sensor &sensor);
 
+    /// Set how the callbacks of the sensors that start listening from now on
+    /// are run.
+    void SetSensorCallbackOptions(const streaming::CallbackQueueOptions &options) {
+      _client.SetSensorCallbackOptions(options);
+    }
+
+    /// Return the state of the callback queue of @a sensor, all zeros if it
+    /// is not listening through a callback queue.
+    streaming::CallbackQueueStats GetSensorCallbackStats(const Sensor &sensor) const;
+
+    /// Register a client-side lane invasion sensor attached to @a vehicle.
+    /// All of them are computed together on each tick of the episode.
+    size_t RegisterLaneInvasionSensor(
+        const Vehicle &vehicle,
+        std::function<void(SharedPtr<sensor::SensorData>)> callback);
+
+    void UnregisterLaneInvasionSensor(size_t id);
+
     /// @}
     // =========================================================================
     /// @name Operations with traffic lights
@@ -646,6 +694,18 @@ namespace detail {
       return _client.ApplyBatchSync(std::move(commands), do_tick_cue);
     }
 
+    void ApplyControlBatch(const rpc::ControlBatch &batch, bool do_tick_cue) {
+      _client.ApplyControlBatch(batch, do_tick_cue);
+    }
+
+    auto ApplyControlBatchSync(const rpc::ControlBatch &batch, bool do_tick_cue) {
+      return _client.ApplyControlBatchSync(batch, do_tick_cue);
+    }
+
+    auto SpawnActorsBulk(const rpc::SpawnActorsBulk &request, bool do_tick_cue) {
+      return _client.SpawnActorsBulk(request, do_tick_cue);
+    }
+
     /// @}
     // =========================================================================
     /// @name Operations lights
@@ -713,6 +773,8 @@ namespace detail {
     SharedPtr<Map> _cached_map;
 
     std::string _open_drive_file;
+
+    LatencyHistogram _tick_latency;
   };
 
 } // namespace detail
@@ -0,0 +1,95 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/geom/Location.h"
+#include "carla/geom/Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace geom {
+
+  /// Set of occupied locations, bucketed in a uniform grid over the XY plane
+  /// with cells as big as the clearance required, so checking whether a
+  /// location is free only visits the 3x3 cells around it.
+  class OccupancyGrid {
+  public:
+
+    /// @param clearance minimum distance in meters between a free location
+    ///   and any occupied one.
+    explicit OccupancyGrid(float clearance)
+      : _clearance(std::max(clearance, 0.0f)),
+        _cell_size(std::max(clearance, 1.0f)) {}
+
+    float GetClearance() const {
+      return _clearance;
+    }
+
+    void Occupy(const Location &location) {
+      _cells[MakeKey(ToCell(location.x), ToCell(location.y))].emplace_back(location);
+      ++_size;
+    }
+
+    /// Whether every occupied location is farther than the clearance from
+    /// @a location.
+    bool IsFree(const Location &location) const {
+      const float squared_clearance = _clearance * _clearance;
+      const auto cell_x = ToCell(location.x);
+      const auto cell_y = ToCell(location.y);
+      for (auto x = cell_x - 1; x <= cell_x + 1; ++x) {
+        for (auto y = cell_y - 1; y <= cell_y + 1; ++y) {
+          auto it = _cells.find(MakeKey(x, y));
+          if (it == _cells.end()) {
+            continue;
+          }
+          for (auto &&occupied : it->second) {
+            if (Math::DistanceSquared(occupied, location) < squared_clearance) {
+              return false;
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    /// Number of occupied locations.
+    size_t size() const {
+      return _size;
+    }
+
+    void clear() {
+      _cells.clear();
+      _size = 0u;
+    }
+
+  private:
+
+    int64_t ToCell(float value) const {
+      return static_cast<int64_t>(std::floor(value / _cell_size));
+    }
+
+    static uint64_t MakeKey(int64_t x, int64_t y) {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32u) |
+             static_cast<uint64_t>(static_cast<uint32_t>(y));
+    }
+
+    float _clearance;
+
+    float _cell_size;
+
+    size_t _size = 0u;
+
+    std::unordered_map<uint64_t, std::vector<Location>> _cells;
+  };
+
+} // namespace geom
+} // namespace carla
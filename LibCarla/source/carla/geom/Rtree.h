@@ -61,6 +61,16 @@ namespace geom {
       return query_result;
     }
 
+    /// Returns points that intersect the specified geometry.
+    template<typename Geometry>
+    std::vector<TreeElement> GetIntersections(const Geometry &geometry) const {
+      std::vector<TreeElement> query_result;
+      _rtree.query(
+          boost::geometry::index::intersects(geometry),
+          std::back_inserter(query_result));
+      return query_result;
+    }
+
     size_t GetTreeSize() const {
       return _rtree.size();
     }
@@ -94,6 +104,17 @@ namespace geom {
       _rtree.insert(elements.begin(), elements.end());
     }
 
+    /// Remove all the elements accepted by @a filter. Returns the number of
+    /// elements removed.
+    template <typename Filter>
+    size_t RemoveElements(Filter filter) {
+      std::vector<TreeElement> query_result;
+      _rtree.query(
+          boost::geometry::index::satisfies(filter),
+          std::back_inserter(query_result));
+      return _rtree.remove(query_result.begin(), query_result.end());
+    }
+
     /// Return nearest neighbors with a user defined filter.
     /// The filter reveices as an argument a TreeElement value and needs to
     /// return a bool to accept or reject the value
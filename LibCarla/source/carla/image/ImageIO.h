@@ -24,6 +24,17 @@ namespace image {
       IO::write_view(out_filename, image_view);
       return out_filename;
     }
+
+    /// Same as above, encoding with @a options.
+    template <typename ViewT, typename IO = io::any>
+    static std::string WriteView(
+        std::string out_filename,
+        const ViewT &image_view,
+        const io::write_options &options,
+        IO = IO()) {
+      IO::write_view(out_filename, image_view, options);
+      return out_filename;
+    }
   };
 
 } // namespace image
@@ -91,6 +91,16 @@ namespace io {
       "LIBCARLA_IMAGE_WITH_PNG_SUPPORT, LIBCARLA_IMAGE_WITH_JPEG_SUPPORT, "
       "or LIBCARLA_IMAGE_WITH_TIFF_SUPPORT");
 
+  /// Encoder settings, each format ignores the ones that do not apply to it.
+  struct write_options {
+    /// zlib compression level of PNG files, from 0 (fastest) to 9 (smallest).
+    int png_compression_level = 3;
+    /// Quality of JPEG files, from 0 to 100.
+    int jpeg_quality = 100;
+    /// Use the fast integer DCT for JPEG files, slightly less accurate.
+    bool jpeg_fast_dct = false;
+  };
+
 namespace detail {
 
   template <typename ViewT, typename IOTag>
@@ -123,6 +133,13 @@ namespace detail {
       boost::gil::write_view(std::forward<Str>(out_filename), view, boost::gil::png_tag());
     }
 
+    template <typename Str, typename ViewT>
+    static void write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
+      boost::gil::image_write_info<boost::gil::png_tag> info;
+      info._compression_level = options.png_compression_level;
+      boost::gil::write_view(std::forward<Str>(out_filename), view, info);
+    }
+
 #endif // LIBCARLA_IMAGE_WITH_PNG_SUPPORT
   };
 
@@ -162,6 +179,29 @@ namespace detail {
           boost::gil::jpeg_tag());
     }
 
+    template <typename Str, typename ViewT>
+    static typename std::enable_if<is_write_supported<ViewT, boost::gil::jpeg_tag>::value>::type
+    write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
+      boost::gil::write_view(std::forward<Str>(out_filename), view, make_write_info(options));
+    }
+
+    template <typename Str, typename ViewT>
+    static typename std::enable_if<!is_write_supported<ViewT, boost::gil::jpeg_tag>::value>::type
+    write_view(Str &&out_filename, const ViewT &view, const write_options &options) {
+      boost::gil::write_view(
+          std::forward<Str>(out_filename),
+          boost::gil::color_converted_view<boost::gil::rgb8_pixel_t>(view),
+          make_write_info(options));
+    }
+
+    static boost::gil::image_write_info<boost::gil::jpeg_tag> make_write_info(const write_options &options) {
+      return boost::gil::image_write_info<boost::gil::jpeg_tag>(
+          options.jpeg_quality,
+          options.jpeg_fast_dct ?
+              boost::gil::jpeg_dct_method::fast :
+              boost::gil::jpeg_dct_method::default_value);
+    }
+
 #endif // LIBCARLA_IMAGE_WITH_JPEG_SUPPORT
   };
 
@@ -200,6 +240,11 @@ namespace detail {
           boost::gil::tiff_tag());
     }
 
+    template <typename Str, typename ViewT>
+    static void write_view(Str &&out_filename, const ViewT &view, const write_options &) {
+      write_view(std::forward<Str>(out_filename), view);
+    }
+
 #endif // LIBCARLA_IMAGE_WITH_TIFF_SUPPORT
   };
 
@@ -0,0 +1,355 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/image/ImageKernels.h"
+
+#include "carla/Debug.h"
+#include "carla/ThreadPool.h"
+#include "carla/image/CityScapesPalette.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+
+#if defined(__AVX2__)
+#  define LIBCARLA_IMAGE_KERNELS_AVX2
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  define LIBCARLA_IMAGE_KERNELS_SSE2
+#  include <emmintrin.h>
+#endif
+
+namespace carla {
+namespace image {
+
+  static_assert(sizeof(ImageKernels::Color) == sizeof(uint32_t), "Invalid Color size");
+
+  /// Pixels per tile, small enough for a tile to stay in L2 cache.
+  static constexpr size_t TILE_SIZE = 16u * 1024u;
+
+  static constexpr uint32_t MAX_ENCODED_DEPTH = 256u * 256u * 256u - 1u;
+
+  // ===========================================================================
+  // -- Scalar reference -------------------------------------------------------
+  // ===========================================================================
+
+  static inline uint32_t EncodedDepth(const ImageKernels::Color &color) {
+    return color.r + (color.g * 256u) + (color.b * 256u * 256u);
+  }
+
+  static inline float NormalizedDepth(const uint32_t depth) {
+    return static_cast<float>(depth) / static_cast<float>(MAX_ENCODED_DEPTH);
+  }
+
+  /// Same rounding as boost::gil converting a float channel to uint8.
+  static inline uint8_t ToChannel(const float value) {
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+  }
+
+  static inline uint8_t LogarithmicDepthLevel(const uint32_t depth) {
+    const float value = 1.0f + std::log(NormalizedDepth(depth)) / 5.70378f;
+    return ToChannel(std::max(std::min(value, 1.0f), 0.005f));
+  }
+
+  static inline ImageKernels::Color Gray(const uint8_t level) {
+    return {level, level, level, 255u};
+  }
+
+  // ===========================================================================
+  // -- Lookup tables ----------------------------------------------------------
+  // ===========================================================================
+
+  /// The logarithmic depth level is monotonic in the encoded depth, so instead
+  /// of computing the logarithm per pixel the level is found in the table of
+  /// the smallest encoded depth of each level. A coarse table indexed by the
+  /// top bits of the depth gives the level directly for most pixels.
+  class LogarithmicDepthTable {
+  public:
+
+    static constexpr uint32_t BUCKET_BITS = 12u;
+
+    LogarithmicDepthTable() {
+      for (auto level = 0u; level < _thresholds.size(); ++level) {
+        uint32_t low = 0u;
+        uint32_t high = MAX_ENCODED_DEPTH + 1u;
+        while (low < high) {
+          const uint32_t middle = low + (high - low) / 2u;
+          if (LogarithmicDepthLevel(middle) >= level) {
+            high = middle;
+          } else {
+            low = middle + 1u;
+          }
+        }
+        _thresholds[level] = static_cast<int32_t>(low);
+      }
+      for (auto bucket = 0u; bucket < _buckets.size(); ++bucket) {
+        _buckets[bucket] = SearchLevel(bucket << BUCKET_BITS);
+      }
+    }
+
+    uint8_t GetLevel(const uint32_t depth) const {
+      uint32_t level = _buckets[depth >> BUCKET_BITS];
+      while ((level < 255u) && (static_cast<uint32_t>(_thresholds[level + 1u]) <= depth)) {
+        ++level;
+      }
+      return static_cast<uint8_t>(level);
+    }
+
+  private:
+
+    uint8_t SearchLevel(const uint32_t depth) const {
+      const int32_t value = static_cast<int32_t>(depth);
+      uint32_t level = 0u;
+      for (uint32_t step = 128u; step > 0u; step /= 2u) {
+        level += (_thresholds[level + step] <= value) ? step : 0u;
+      }
+      return static_cast<uint8_t>(level);
+    }
+
+    std::array<int32_t, 256u> _thresholds;
+
+    std::array<uint8_t, ((MAX_ENCODED_DEPTH + 1u) >> BUCKET_BITS)> _buckets;
+  };
+
+  static const LogarithmicDepthTable &GetLogarithmicDepthTable() {
+    static const LogarithmicDepthTable table;
+    return table;
+  }
+
+  static const std::array<uint32_t, 256u> &GetCityScapesTable() {
+    static const std::array<uint32_t, 256u> table = []() {
+      std::array<uint32_t, 256u> result;
+      for (auto tag = 0u; tag < result.size(); ++tag) {
+        const auto color = CityScapesPalette::GetColor(static_cast<uint8_t>(tag));
+        const ImageKernels::Color pixel{color[0u], color[1u], color[2u], 255u};
+        std::memcpy(&result[tag], &pixel, sizeof(pixel));
+      }
+      return result;
+    }();
+    return table;
+  }
+
+  // ===========================================================================
+  // -- Vectorized kernels -----------------------------------------------------
+  // ===========================================================================
+
+#if defined(LIBCARLA_IMAGE_KERNELS_AVX2)
+
+  static constexpr size_t LANES = 8u;
+
+  using Vector = __m256i;
+
+  static inline Vector Load(const ImageKernels::Color *data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  }
+
+  static inline void Store(ImageKernels::Color *data, Vector value) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(data), value);
+  }
+
+  static inline Vector EncodedDepth(Vector pixels) {
+    const auto mask = _mm256_set1_epi32(0xFF);
+    const auto r = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), mask);
+    const auto g = _mm256_and_si256(pixels, _mm256_set1_epi32(0xFF00));
+    const auto b = _mm256_slli_epi32(_mm256_and_si256(pixels, mask), 16);
+    return _mm256_or_si256(_mm256_or_si256(r, g), b);
+  }
+
+  static inline __m256 NormalizedDepth(Vector depth) {
+    return _mm256_div_ps(
+        _mm256_cvtepi32_ps(depth),
+        _mm256_set1_ps(static_cast<float>(MAX_ENCODED_DEPTH)));
+  }
+
+  static inline Vector ToChannel(__m256 value) {
+    return _mm256_cvttps_epi32(_mm256_add_ps(
+        _mm256_mul_ps(value, _mm256_set1_ps(255.0f)),
+        _mm256_set1_ps(0.5f)));
+  }
+
+  static inline Vector Gray(Vector level) {
+    const auto gray = _mm256_or_si256(
+        _mm256_or_si256(level, _mm256_slli_epi32(level, 8)),
+        _mm256_slli_epi32(level, 16));
+    return _mm256_or_si256(gray, _mm256_set1_epi32(static_cast<int>(0xFF000000u)));
+  }
+
+  static inline void StoreFloat(float *data, __m256 value) {
+    _mm256_storeu_ps(data, value);
+  }
+
+  static inline __m256 Multiply(__m256 value, float factor) {
+    return _mm256_mul_ps(value, _mm256_set1_ps(factor));
+  }
+
+  static inline Vector CityScapesColor(const uint32_t *table, Vector pixels) {
+    const auto tag = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), _mm256_set1_epi32(0xFF));
+    return _mm256_i32gather_epi32(reinterpret_cast<const int *>(table), tag, 4);
+  }
+
+#elif defined(LIBCARLA_IMAGE_KERNELS_SSE2)
+
+  static constexpr size_t LANES = 4u;
+
+  using Vector = __m128i;
+
+  static inline Vector Load(const ImageKernels::Color *data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  }
+
+  static inline void Store(ImageKernels::Color *data, Vector value) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(data), value);
+  }
+
+  static inline Vector EncodedDepth(Vector pixels) {
+    const auto mask = _mm_set1_epi32(0xFF);
+    const auto r = _mm_and_si128(_mm_srli_epi32(pixels, 16), mask);
+    const auto g = _mm_and_si128(pixels, _mm_set1_epi32(0xFF00));
+    const auto b = _mm_slli_epi32(_mm_and_si128(pixels, mask), 16);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+  }
+
+  static inline __m128 NormalizedDepth(Vector depth) {
+    return _mm_div_ps(
+        _mm_cvtepi32_ps(depth),
+        _mm_set1_ps(static_cast<float>(MAX_ENCODED_DEPTH)));
+  }
+
+  static inline Vector ToChannel(__m128 value) {
+    return _mm_cvttps_epi32(_mm_add_ps(
+        _mm_mul_ps(value, _mm_set1_ps(255.0f)),
+        _mm_set1_ps(0.5f)));
+  }
+
+  static inline Vector Gray(Vector level) {
+    const auto gray = _mm_or_si128(
+        _mm_or_si128(level, _mm_slli_epi32(level, 8)),
+        _mm_slli_epi32(level, 16));
+    return _mm_or_si128(gray, _mm_set1_epi32(static_cast<int>(0xFF000000u)));
+  }
+
+  static inline void StoreFloat(float *data, __m128 value) {
+    _mm_storeu_ps(data, value);
+  }
+
+  static inline __m128 Multiply(__m128 value, float factor) {
+    return _mm_mul_ps(value, _mm_set1_ps(factor));
+  }
+
+#endif
+
+  // ===========================================================================
+  // -- ImageKernels -----------------------------------------------------------
+  // ===========================================================================
+
+  static ThreadPool &GetThreadPool() {
+    // Never destroyed, the workers may still be in use when static objects
+    // are destroyed at exit.
+    static ThreadPool *pool = []() {
+      auto *result = new ThreadPool();
+      result->AsyncRun(std::max(2u, std::thread::hardware_concurrency()));
+      return result;
+    }();
+    return *pool;
+  }
+
+  void ImageKernels::ParallelFor(
+      const size_t size,
+      const size_t tile_size,
+      const std::function<void(size_t, size_t)> &callback) {
+    DEBUG_ASSERT(tile_size > 0u);
+    if (size <= tile_size) {
+      callback(0u, size);
+      return;
+    }
+    auto &pool = GetThreadPool();
+    std::vector<std::future<void>> results;
+    results.reserve(size / tile_size);
+    std::exception_ptr exception;
+    try {
+      for (size_t begin = tile_size; begin < size; begin += tile_size) {
+        const size_t end = std::min(begin + tile_size, size);
+        results.emplace_back(pool.Post([&callback, begin, end]() { callback(begin, end); }));
+      }
+      // The first tile is processed by the calling thread.
+      callback(0u, tile_size);
+    } catch (...) {
+      exception = std::current_exception();
+    }
+    // The tasks reference @a callback, wait for all of them before leaving
+    // even if one failed.
+    for (auto &result : results) {
+      try {
+        result.get();
+      } catch (...) {
+        if (exception == nullptr) {
+          exception = std::current_exception();
+        }
+      }
+    }
+    if (exception != nullptr) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  void ImageKernels::ConvertInPlace(Color *data, const size_t size, ColorConverter::Depth) {
+    ParallelFor(size, TILE_SIZE, [data](size_t begin, const size_t end) {
+#if defined(LIBCARLA_IMAGE_KERNELS_AVX2) || defined(LIBCARLA_IMAGE_KERNELS_SSE2)
+      for (; begin + LANES <= end; begin += LANES) {
+        const auto depth = NormalizedDepth(EncodedDepth(Load(data + begin)));
+        Store(data + begin, Gray(ToChannel(depth)));
+      }
+#endif
+      for (; begin < end; ++begin) {
+        data[begin] = Gray(ToChannel(NormalizedDepth(EncodedDepth(data[begin]))));
+      }
+    });
+  }
+
+  void ImageKernels::ConvertInPlace(Color *data, const size_t size, ColorConverter::LogarithmicDepth) {
+    const auto &table = GetLogarithmicDepthTable();
+    // A gathered binary search is slower than the scalar table lookup.
+    ParallelFor(size, TILE_SIZE, [data, &table](size_t begin, const size_t end) {
+      for (; begin < end; ++begin) {
+        data[begin] = Gray(table.GetLevel(EncodedDepth(data[begin])));
+      }
+    });
+  }
+
+  void ImageKernels::ConvertInPlace(Color *data, const size_t size, ColorConverter::CityScapesPalette) {
+    const auto &table = GetCityScapesTable();
+    ParallelFor(size, TILE_SIZE, [data, &table](size_t begin, const size_t end) {
+#if defined(LIBCARLA_IMAGE_KERNELS_AVX2)
+      for (; begin + LANES <= end; begin += LANES) {
+        Store(data + begin, CityScapesColor(table.data(), Load(data + begin)));
+      }
+#endif
+      for (; begin < end; ++begin) {
+        std::memcpy(static_cast<void *>(&data[begin]), &table[data[begin].r], sizeof(Color));
+      }
+    });
+  }
+
+  void ImageKernels::DecodeDepthInMeters(const Color *src, const size_t size, float *dst) {
+    ParallelFor(size, TILE_SIZE, [src, dst](size_t begin, const size_t end) {
+#if defined(LIBCARLA_IMAGE_KERNELS_AVX2) || defined(LIBCARLA_IMAGE_KERNELS_SSE2)
+      for (; begin + LANES <= end; begin += LANES) {
+        const auto depth = NormalizedDepth(EncodedDepth(Load(src + begin)));
+        StoreFloat(dst + begin, Multiply(depth, DEPTH_FAR_PLANE));
+      }
+#endif
+      for (; begin < end; ++begin) {
+        dst[begin] = DEPTH_FAR_PLANE * NormalizedDepth(EncodedDepth(src[begin]));
+      }
+    });
+  }
+
+} // namespace image
+} // namespace carla
@@ -0,0 +1,71 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/image/ColorConverter.h"
+#include "carla/sensor/data/Color.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace carla {
+namespace image {
+
+  /// Color conversions of BGRA8 sensor images vectorized with SSE2 or AVX2,
+  /// depending on the target of the build, with a scalar fallback. Images are
+  /// split in tiles processed in parallel by a thread pool shared by all the
+  /// conversions.
+  ///
+  /// The result is identical to the color converted views of ImageView for
+  /// the same ColorConverter.
+  class ImageKernels {
+  public:
+
+    using Color = sensor::data::Color;
+
+    /// Far plane of the depth camera, the depth encoded as 1 is this far.
+    static constexpr float DEPTH_FAR_PLANE = 1000.0f;
+
+    /// Call @a callback(begin, end) for consecutive ranges of at most
+    /// @a tile_size elements covering [0, size), in parallel. Blocks until
+    /// all the ranges are processed.
+    static void ParallelFor(
+        size_t size,
+        size_t tile_size,
+        const std::function<void(size_t, size_t)> &callback);
+
+    /// @name In-place conversion of @a size BGRA8 pixels.
+    /// @{
+
+    static void ConvertInPlace(Color *data, size_t size, ColorConverter::Depth);
+
+    static void ConvertInPlace(Color *data, size_t size, ColorConverter::LogarithmicDepth);
+
+    static void ConvertInPlace(Color *data, size_t size, ColorConverter::CityScapesPalette);
+
+    template <typename ImageT, typename ColorConverterT>
+    static void ConvertInPlace(ImageT &image, ColorConverterT converter) {
+      ConvertInPlace(image.data(), image.size(), converter);
+    }
+
+    /// @}
+
+    /// Decode the depth encoded in @a size BGRA8 pixels of @a src as float
+    /// meters into @a dst.
+    static void DecodeDepthInMeters(const Color *src, size_t size, float *dst);
+
+    template <typename ImageT>
+    static std::vector<float> DecodeDepthInMeters(const ImageT &image) {
+      std::vector<float> result(image.size());
+      DecodeDepthInMeters(image.data(), image.size(), result.data());
+      return result;
+    }
+  };
+
+} // namespace image
+} // namespace carla
@@ -0,0 +1,154 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/image/ImageResampler.h"
+
+#include "carla/Debug.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace carla {
+namespace image {
+
+  static constexpr uint32_t CHANNELS = 4u;
+
+  ImageResampler::ImageResampler(
+      const uint32_t source_width,
+      const uint32_t source_height,
+      const uint32_t bytes_per_pixel,
+      const uint32_t roi_x,
+      const uint32_t roi_y,
+      const uint32_t roi_width,
+      const uint32_t roi_height,
+      const uint32_t factor,
+      const Filter filter)
+    : _source_width(source_width),
+      _source_height(source_height),
+      _bytes_per_pixel(bytes_per_pixel),
+      _roi_x(std::min(roi_x, source_width)),
+      _roi_y(std::min(roi_y, source_height)),
+      _filter(bytes_per_pixel == CHANNELS ? filter : Filter::Nearest) {
+    DEBUG_ASSERT(bytes_per_pixel > 0u);
+    _roi_width = source_width - _roi_x;
+    if (roi_width > 0u) {
+      _roi_width = std::min(_roi_width, roi_width);
+    }
+    _roi_height = source_height - _roi_y;
+    if (roi_height > 0u) {
+      _roi_height = std::min(_roi_height, roi_height);
+    }
+    // The output keeps at least one pixel of an non-empty region.
+    _factor = std::max(1u, std::min({factor, _roi_width, _roi_height}));
+  }
+
+  static void NearestRow(
+      const unsigned char *source_row,
+      unsigned char *destination_row,
+      const uint32_t width,
+      const uint32_t factor,
+      const uint32_t bytes_per_pixel) {
+    const size_t step = static_cast<size_t>(factor) * bytes_per_pixel;
+    if (step == bytes_per_pixel) {
+      std::memcpy(destination_row, source_row, static_cast<size_t>(width) * bytes_per_pixel);
+      return;
+    }
+    for (auto x = 0u; x < width; ++x) {
+      std::memcpy(destination_row, source_row, bytes_per_pixel);
+      source_row += step;
+      destination_row += bytes_per_pixel;
+    }
+  }
+
+  static void BoxRow(
+      const unsigned char *source_row,
+      const size_t source_stride,
+      unsigned char *destination_row,
+      const uint32_t width,
+      const uint32_t factor,
+      std::vector<uint32_t> &sums) {
+    sums.assign(static_cast<size_t>(width) * CHANNELS, 0u);
+    for (auto row = 0u; row < factor; ++row) {
+      const unsigned char *source = source_row + row * source_stride;
+      uint32_t *sum = sums.data();
+      for (auto x = 0u; x < width; ++x) {
+        for (auto i = 0u; i < factor; ++i) {
+          sum[0u] += source[0u];
+          sum[1u] += source[1u];
+          sum[2u] += source[2u];
+          sum[3u] += source[3u];
+          source += CHANNELS;
+        }
+        sum += CHANNELS;
+      }
+    }
+    const uint32_t count = factor * factor;
+    for (auto sum : sums) {
+      *destination_row++ = static_cast<unsigned char>((sum + count / 2u) / count);
+    }
+  }
+
+  void ImageResampler::ResampleRows(
+      const unsigned char *source,
+      unsigned char *destination,
+      const uint32_t begin_row,
+      uint32_t end_row) const {
+    DEBUG_ASSERT(source != nullptr);
+    DEBUG_ASSERT(destination != nullptr);
+    end_row = std::min(end_row, GetOutputHeight());
+    const auto width = GetOutputWidth();
+    const size_t source_stride = static_cast<size_t>(_source_width) * _bytes_per_pixel;
+    const size_t destination_stride = static_cast<size_t>(width) * _bytes_per_pixel;
+
+    // Bilinear interpolation at the center of a block of an integer factor
+    // is a box filter of the 2x2 central pixels for even factors, and the
+    // central pixel for odd factors.
+    auto filter = _filter;
+    auto offset = _factor / 2u;
+    auto box = _factor;
+    if (filter == Filter::Bilinear) {
+      if (_factor % 2u == 0u) {
+        filter = Filter::Box;
+        offset = _factor / 2u - 1u;
+        box = 2u;
+      } else {
+        filter = Filter::Nearest;
+      }
+    } else if (filter == Filter::Box) {
+      offset = 0u;
+    }
+
+    std::vector<uint32_t> sums;
+    for (auto row = begin_row; row < end_row; ++row) {
+      const unsigned char *source_row =
+          source +
+          (static_cast<size_t>(_roi_y) + static_cast<size_t>(row) * _factor + offset) * source_stride +
+          (static_cast<size_t>(_roi_x) + offset) * _bytes_per_pixel;
+      unsigned char *destination_row = destination + row * destination_stride;
+      if (filter == Filter::Box) {
+        if (box == _factor) {
+          BoxRow(source_row, source_stride, destination_row, width, box, sums);
+        } else {
+          // Average the 2x2 central pixels of each block.
+          for (auto x = 0u; x < width; ++x) {
+            const unsigned char *block = source_row + static_cast<size_t>(x) * _factor * CHANNELS;
+            for (auto c = 0u; c < CHANNELS; ++c) {
+              const uint32_t sum =
+                  block[c] + block[c + CHANNELS] +
+                  block[c + source_stride] + block[c + source_stride + CHANNELS];
+              destination_row[x * CHANNELS + c] = static_cast<unsigned char>((sum + 2u) / 4u);
+            }
+          }
+        }
+      } else {
+        NearestRow(source_row, destination_row, width, _factor, _bytes_per_pixel);
+      }
+    }
+  }
+
+} // namespace image
+} // namespace carla
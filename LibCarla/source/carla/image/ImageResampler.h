@@ -0,0 +1,122 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace image {
+
+  /// Crops a region of interest out of an image and downscales it by an
+  /// integer factor, before the image is sent to the client.
+  ///
+  /// The output is computed by rows, so the caller can split the rows among
+  /// its own worker threads. Source and destination must not overlap.
+  class ImageResampler {
+  public:
+
+    enum class Filter : uint8_t {
+      /// Pick the source pixel at the center of each block. The only filter
+      /// valid for encoded data, like depth or semantic tags.
+      Nearest,
+      /// Average of the factor x factor block of source pixels.
+      Box,
+      /// Interpolate the source pixels around the center of each block.
+      Bilinear
+    };
+
+    /// Identity, the image is sent as is.
+    ImageResampler() = default;
+
+    /// The region of interest is clamped to the source image, a zero
+    /// @a roi_width or @a roi_height extends it to the edge of the image.
+    /// Box and Bilinear are only supported for images of 4 channels of 8
+    /// bits, other images fall back to Nearest.
+    ImageResampler(
+        uint32_t source_width,
+        uint32_t source_height,
+        uint32_t bytes_per_pixel,
+        uint32_t roi_x,
+        uint32_t roi_y,
+        uint32_t roi_width,
+        uint32_t roi_height,
+        uint32_t factor,
+        Filter filter);
+
+    uint32_t GetSourceWidth() const {
+      return _source_width;
+    }
+
+    uint32_t GetSourceHeight() const {
+      return _source_height;
+    }
+
+    /// Size in bytes of the source image.
+    size_t GetSourceSize() const {
+      return static_cast<size_t>(_source_width) * _source_height * _bytes_per_pixel;
+    }
+
+    uint32_t GetOutputWidth() const {
+      return _roi_width / _factor;
+    }
+
+    uint32_t GetOutputHeight() const {
+      return _roi_height / _factor;
+    }
+
+    /// Size in bytes of the output image.
+    size_t GetOutputSize() const {
+      return static_cast<size_t>(GetOutputWidth()) * GetOutputHeight() * _bytes_per_pixel;
+    }
+
+    Filter GetFilter() const {
+      return _filter;
+    }
+
+    /// Whether the output is the source image unchanged.
+    bool IsIdentity() const {
+      return (_factor == 1u) &&
+             (_roi_width == _source_width) &&
+             (_roi_height == _source_height);
+    }
+
+    /// Compute the output rows [@a begin_row, @a end_row) of @a destination
+    /// from the tightly packed @a source image.
+    void ResampleRows(
+        const unsigned char *source,
+        unsigned char *destination,
+        uint32_t begin_row,
+        uint32_t end_row) const;
+
+    void Resample(const unsigned char *source, unsigned char *destination) const {
+      ResampleRows(source, destination, 0u, GetOutputHeight());
+    }
+
+  private:
+
+    uint32_t _source_width = 0u;
+
+    uint32_t _source_height = 0u;
+
+    uint32_t _bytes_per_pixel = 4u;
+
+    uint32_t _roi_x = 0u;
+
+    uint32_t _roi_y = 0u;
+
+    uint32_t _roi_width = 0u;
+
+    uint32_t _roi_height = 0u;
+
+    uint32_t _factor = 1u;
+
+    Filter _filter = Filter::Nearest;
+  };
+
+} // namespace image
+} // namespace carla
@@ -21,6 +21,9 @@
 
 #include <pugixml/pugixml.hpp>
 
+#include <set>
+#include <sstream>
+
 namespace carla {
 namespace opendrive {
 
@@ -49,5 +52,155 @@ namespace opendrive {
     return map_builder.Build();
   }
 
+  boost::optional<road::MapChange> OpenDriveParser::LoadPatch(
+      road::Map &map,
+      const std::string &opendrive_patch,
+      const road::MapChange &removed) {
+    carla::road::MapBuilder map_builder;
+
+    if (!opendrive_patch.empty()) {
+      pugi::xml_document xml;
+      pugi::xml_parse_result parse_result = xml.load_string(opendrive_patch.c_str());
+
+      if (parse_result == false) {
+        log_error("unable to parse the OpenDRIVE patch XML string");
+        return {};
+      }
+
+      parser::RoadParser::Parse(xml, map_builder);
+      parser::JunctionParser::Parse(xml, map_builder);
+      parser::GeometryParser::Parse(xml, map_builder);
+      parser::LaneParser::Parse(xml, map_builder);
+      parser::ProfilesParser::Parse(xml, map_builder);
+      parser::TrafficGroupParser::Parse(xml, map_builder);
+      parser::SignalParser::Parse(xml, map_builder);
+      parser::ObjectParser::Parse(xml, map_builder);
+      parser::ControllerParser::Parse(xml, map_builder);
+    }
+
+    return map_builder.ApplyTo(map, removed);
+  }
+
+  /// Insert a copy of @a node after the last child of @a parent with the same
+  /// name, to keep the order of the elements of the document.
+  static void InsertCopy(pugi::xml_node parent, const pugi::xml_node &node) {
+    pugi::xml_node last;
+    for (auto child : parent.children(node.name())) {
+      last = child;
+    }
+    if (last) {
+      parent.insert_copy_after(node, last);
+    } else {
+      parent.append_copy(node);
+    }
+  }
+
+  /// Remove the children of @a parent named @a name for which @a pred is true.
+  template <typename Pred>
+  static void RemoveChildrenIf(pugi::xml_node parent, const char *name, Pred &&pred) {
+    for (pugi::xml_node node = parent.child(name); node;) {
+      pugi::xml_node next = node.next_sibling(name);
+      if (pred(node)) {
+        parent.remove_child(node);
+      }
+      node = next;
+    }
+  }
+
+  bool OpenDriveParser::MergePatch(
+      std::string &opendrive,
+      const std::string &opendrive_patch,
+      const road::MapChange &removed) {
+    pugi::xml_document xml;
+    if (xml.load_string(opendrive.c_str()) == false) {
+      log_error("unable to parse the OpenDRIVE XML string");
+      return false;
+    }
+    pugi::xml_document patch_xml;
+    if (!opendrive_patch.empty() && (patch_xml.load_string(opendrive_patch.c_str()) == false)) {
+      log_error("unable to parse the OpenDRIVE patch XML string");
+      return false;
+    }
+    pugi::xml_node open_drive_node = xml.child("OpenDRIVE");
+    const pugi::xml_node patch_node = patch_xml.child("OpenDRIVE");
+
+    // Elements replaced or removed, same as MapBuilder::ApplyTo.
+    std::set<road::RoadId> roads(removed.roads.begin(), removed.roads.end());
+    std::set<road::RoadId> removed_roads = roads;
+    for (auto node : patch_node.children("road")) {
+      roads.insert(node.attribute("id").as_uint());
+      removed_roads.erase(node.attribute("id").as_uint());
+    }
+    std::set<road::JuncId> junctions(removed.junctions.begin(), removed.junctions.end());
+    for (auto node : patch_node.children("junction")) {
+      junctions.insert(node.attribute("id").as_int());
+    }
+    std::set<road::ContId> controllers;
+    for (auto node : patch_node.children("controller")) {
+      controllers.emplace(node.attribute("id").value());
+    }
+    std::set<road::SignId> patch_signals;
+    for (auto road_node : patch_node.children("road")) {
+      for (auto node : road_node.child("signals").children("signal")) {
+        patch_signals.emplace(node.attribute("id").value());
+      }
+    }
+    std::set<road::SignId> removed_signals(removed.signals.begin(), removed.signals.end());
+    for (auto road_node : open_drive_node.children("road")) {
+      if (roads.count(road_node.attribute("id").as_uint()) > 0u) {
+        for (auto node : road_node.child("signals").children("signal")) {
+          removed_signals.emplace(node.attribute("id").value());
+        }
+      }
+    }
+    for (const auto &signal_id : patch_signals) {
+      removed_signals.erase(signal_id);
+    }
+
+    // Remove the old elements and whatever references the removed ones.
+    RemoveChildrenIf(open_drive_node, "road", [&](const pugi::xml_node &node) {
+      return roads.count(node.attribute("id").as_uint()) > 0u;
+    });
+    RemoveChildrenIf(open_drive_node, "junction", [&](const pugi::xml_node &node) {
+      return junctions.count(node.attribute("id").as_int()) > 0u;
+    });
+    RemoveChildrenIf(open_drive_node, "controller", [&](const pugi::xml_node &node) {
+      return controllers.count(node.attribute("id").value()) > 0u;
+    });
+    for (auto road_node : open_drive_node.children("road")) {
+      pugi::xml_node signals_node = road_node.child("signals");
+      RemoveChildrenIf(signals_node, "signal", [&](const pugi::xml_node &node) {
+        const road::SignId signal_id = node.attribute("id").value();
+        return (removed_signals.count(signal_id) > 0u) || (patch_signals.count(signal_id) > 0u);
+      });
+      RemoveChildrenIf(signals_node, "signalReference", [&](const pugi::xml_node &node) {
+        return removed_signals.count(node.attribute("id").value()) > 0u;
+      });
+    }
+    for (auto controller_node : open_drive_node.children("controller")) {
+      RemoveChildrenIf(controller_node, "control", [&](const pugi::xml_node &node) {
+        return removed_signals.count(node.attribute("signalId").value()) > 0u;
+      });
+    }
+    for (auto junction_node : open_drive_node.children("junction")) {
+      RemoveChildrenIf(junction_node, "connection", [&](const pugi::xml_node &node) {
+        return (removed_roads.count(node.attribute("incomingRoad").as_uint()) > 0u) ||
+            (removed_roads.count(node.attribute("connectingRoad").as_uint()) > 0u);
+      });
+    }
+
+    // Add the new ones.
+    for (const char *name : {"road", "controller", "junction"}) {
+      for (auto node : patch_node.children(name)) {
+        InsertCopy(open_drive_node, node);
+      }
+    }
+
+    std::ostringstream out;
+    xml.save(out, "", pugi::format_raw);
+    opendrive = out.str();
+    return true;
+  }
+
 } // namespace opendrive
 } // namespace carla
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/MapChange.h"
 
 #include <boost/optional.hpp>
 
@@ -19,6 +20,31 @@ namespace opendrive {
   public:
 
     static boost::optional<road::Map> Load(const std::string &opendrive);
+
+    /// Parse @a opendrive_patch, an OpenDRIVE document with the roads,
+    /// junctions and controllers to add or replace, and apply it to @a map
+    /// together with the removal of the elements listed in @a removed. The
+    /// patch may be empty if only removing elements.
+    ///
+    /// Returns the elements that changed, or an empty optional if the patch
+    /// could not be parsed (in which case @a map is not modified).
+    static boost::optional<road::MapChange> LoadPatch(
+        road::Map &map,
+        const std::string &opendrive_patch,
+        const road::MapChange &removed = road::MapChange{});
+
+    /// Fold the same patch as LoadPatch into the OpenDRIVE document
+    /// @a opendrive, so that loading the resulting document gives the map
+    /// patched. Replaced roads take their signals with them, and the
+    /// references, controls and junction connections to the removed elements
+    /// are dropped.
+    ///
+    /// Returns false if either document could not be parsed (in which case
+    /// @a opendrive is not modified).
+    static bool MergePatch(
+        std::string &opendrive,
+        const std::string &opendrive_patch,
+        const road::MapChange &removed = road::MapChange{});
   };
 
 } // namespace opendrive
@@ -0,0 +1,57 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/pointcloud/PointCloudIO.h"
+
+#include <zlib.h>
+
+#include <limits>
+
+namespace carla {
+namespace pointcloud {
+
+  static void WriteGzip(gzFile file, const std::string &path, const void *data, std::streamsize size) {
+    const auto *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+      constexpr auto max_chunk = static_cast<std::streamsize>(std::numeric_limits<int>::max() / 2);
+      const auto chunk = static_cast<unsigned>(std::min(size, max_chunk));
+      if (gzwrite(file, bytes, chunk) != static_cast<int>(chunk)) {
+        gzclose(file);
+        throw_exception(std::runtime_error(path + ": failed to write compressed point cloud"));
+      }
+      bytes += chunk;
+      size -= static_cast<std::streamsize>(chunk);
+    }
+  }
+
+  void PointCloudIO::ValidateCompressedFilePath(std::string &path) {
+    const std::string ply = ".ply";
+    if ((path.size() >= ply.size()) &&
+        (path.compare(path.size() - ply.size(), ply.size(), ply) == 0)) {
+      path += ".gz";
+    }
+    FileSystem::ValidateFilePath(path, ".ply.gz");
+  }
+
+  void PointCloudIO::WriteCompressed(
+      const std::string &path,
+      const std::string &header,
+      const void *data,
+      const std::streamsize size) {
+    // Fastest compression level, writing has to keep up with the sensor.
+    gzFile file = gzopen(path.c_str(), "wb1");
+    if (file == nullptr) {
+      throw_exception(std::runtime_error(path + ": failed to open file"));
+    }
+    WriteGzip(file, path, header.data(), static_cast<std::streamsize>(header.size()));
+    WriteGzip(file, path, data, size);
+    if (gzclose(file) != Z_OK) {
+      throw_exception(std::runtime_error(path + ": failed to write compressed point cloud"));
+    }
+  }
+
+} // namespace pointcloud
+} // namespace carla
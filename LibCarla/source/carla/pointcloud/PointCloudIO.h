@@ -6,45 +6,130 @@
 
 #pragma once
 
+#include "carla/Debug.h"
+#include "carla/Exception.h"
 #include "carla/FileSystem.h"
 
+#include <cstdint>
 #include <fstream>
 #include <iterator>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace carla {
 namespace pointcloud {
 
+  enum class PointCloudFormat : uint8_t {
+    /// PLY with one line of text per point.
+    PlyAscii,
+    /// Little-endian binary PLY.
+    PlyBinary,
+    /// Little-endian binary PLY compressed with gzip.
+    PlyBinaryGzip
+  };
+
   class PointCloudIO {
 
   public:
     template <typename PointIt>
     static void Dump(std::ostream &out, PointIt begin, PointIt end) {
-      WriteHeader(out, begin, end);
+      WriteHeader(out, begin, end, "ascii");
+      out << std::fixed << std::setprecision(4u);
       for (; begin != end; ++begin) {
         begin->WriteDetection(out);
         out << '\n';
       }
     }
 
+    /// Dump the points as binary little-endian PLY. The points are written
+    /// as they are in memory, so the layout of @a PointT must match the
+    /// properties it declares in WritePlyHeaderInfo.
+    template <typename PointT>
+    static void DumpBinary(std::ostream &out, const PointT *begin, const PointT *end) {
+      out.write(reinterpret_cast<const char *>(begin), BinarySize(begin, end));
+    }
+
     template <typename PointIt>
     static std::string SaveToDisk(std::string path, PointIt begin, PointIt end) {
       FileSystem::ValidateFilePath(path, ".ply");
       std::ofstream out(path);
+      CheckStream(out, path, "failed to open file");
       Dump(out, begin, end);
+      out.close();
+      CheckStream(out, path, "failed to write point cloud");
       return path;
     }
 
+    template <typename PointT>
+    static std::string SaveToDisk(
+        std::string path,
+        const PointT *begin,
+        const PointT *end,
+        PointCloudFormat format) {
+      switch (format) {
+        case PointCloudFormat::PlyAscii:
+          return SaveToDisk(std::move(path), begin, end);
+        case PointCloudFormat::PlyBinary: {
+          FileSystem::ValidateFilePath(path, ".ply");
+          std::ofstream out(path, std::ios::binary);
+          CheckStream(out, path, "failed to open file");
+          WriteHeader(out, begin, end, "binary_little_endian");
+          DumpBinary(out, begin, end);
+          out.close();
+          CheckStream(out, path, "failed to write point cloud");
+          return path;
+        }
+        case PointCloudFormat::PlyBinaryGzip: {
+          ValidateCompressedFilePath(path);
+          std::ostringstream header;
+          WriteHeader(header, begin, end, "binary_little_endian");
+          WriteCompressed(path, header.str(), begin, BinarySize(begin, end));
+          return path;
+        }
+        default:
+          throw_exception(std::invalid_argument("invalid point cloud format"));
+      }
+    }
+
   private:
-    template <typename PointIt> static void WriteHeader(std::ostream &out, PointIt begin, PointIt end) {
+    template <typename PointIt>
+    static void WriteHeader(std::ostream &out, PointIt begin, PointIt end, const char *format) {
       DEBUG_ASSERT(std::distance(begin, end) >= 0);
       out << "ply\n"
-           "format ascii 1.0\n"
+           "format " << format << " 1.0\n"
            "element vertex " << std::to_string(static_cast<size_t>(std::distance(begin, end))) << "\n";
       begin->WritePlyHeaderInfo(out);
       out << "\nend_header\n";
-      out << std::fixed << std::setprecision(4u);
     }
+
+    static void CheckStream(const std::ostream &out, const std::string &path, const char *error) {
+      if (!out) {
+        throw_exception(std::runtime_error(path + ": " + error));
+      }
+    }
+
+    /// Same as FileSystem::ValidateFilePath with extension ".ply.gz", paths
+    /// ending in ".ply" get the ".gz" extension too.
+    static void ValidateCompressedFilePath(std::string &path);
+
+    template <typename PointT>
+    static std::streamsize BinarySize(const PointT *begin, const PointT *end) {
+      static_assert(std::is_trivially_copyable<PointT>::value, "Points must be trivially copyable");
+      DEBUG_ASSERT(begin <= end);
+      return static_cast<std::streamsize>(sizeof(PointT) * static_cast<size_t>(end - begin));
+    }
+
+    /// Write @a header followed by @a size bytes of @a data to a gzip file.
+    ///
+    /// @throw std::runtime_error if the file cannot be written.
+    static void WriteCompressed(
+        const std::string &path,
+        const std::string &header,
+        const void *data,
+        std::streamsize size);
   };
 
 } // namespace pointcloud
@@ -64,6 +64,15 @@ namespace road {
       return vec;
     }
 
+    /// Remove all infos of a given type that satisfy @a pred.
+    template <typename T, typename PredT>
+    void RemoveIf(PredT &&pred) {
+      _road_set.RemoveIf([&](const std::unique_ptr<element::RoadInfo> &info) {
+        const auto *ptr = dynamic_cast<const T *>(info.get());
+        return (ptr != nullptr) && pred(*ptr);
+      });
+    }
+
   private:
 
     RoadElementSet<std::unique_ptr<element::RoadInfo>> _road_set;
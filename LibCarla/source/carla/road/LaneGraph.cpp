@@ -0,0 +1,83 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/LaneGraph.h"
+
+#include "carla/Debug.h"
+#include "carla/road/Lane.h"
+#include "carla/road/LaneSection.h"
+#include "carla/road/MapData.h"
+#include "carla/road/Road.h"
+
+namespace carla {
+namespace road {
+
+  constexpr LaneGraph::LaneIndex LaneGraph::InvalidIndex;
+
+  template <typename FuncT>
+  static void BuildAdjacency(
+      const std::vector<const Lane *> &lanes,
+      std::vector<uint32_t> &offsets,
+      std::vector<LaneGraph::LaneIndex> &adjacency,
+      FuncT &&get_index_list) {
+    offsets.reserve(lanes.size() + 1u);
+    offsets.emplace_back(0u);
+    for (const auto *lane : lanes) {
+      for (auto index : get_index_list(*lane)) {
+        adjacency.emplace_back(index);
+      }
+      offsets.emplace_back(static_cast<uint32_t>(adjacency.size()));
+    }
+    adjacency.shrink_to_fit();
+  }
+
+  LaneGraph::LaneGraph(const MapData &data) {
+    // Assign a dense index to every lane.
+    for (const auto &road_pair : data.GetRoads()) {
+      const auto &road = road_pair.second;
+      for (const auto &section : road.GetLaneSections()) {
+        for (const auto &lane_pair : section.GetLanes()) {
+          const auto &lane = lane_pair.second;
+          const auto index = static_cast<LaneIndex>(_nodes.size());
+          _nodes.emplace_back(LaneNode{
+              road.GetId(),
+              section.GetId(),
+              lane.GetId(),
+              lane.GetDistance(),
+              lane.GetLength()});
+          _lanes.emplace_back(&lane);
+          _index.emplace(&lane, index);
+        }
+      }
+    }
+
+    auto to_indices = [this](const std::vector<Lane *> &lanes) {
+      std::vector<LaneIndex> result;
+      result.reserve(lanes.size());
+      for (const auto *lane : lanes) {
+        RELEASE_ASSERT(lane != nullptr);
+        const auto index = GetIndex(*lane);
+        RELEASE_ASSERT(index != InvalidIndex);
+        result.emplace_back(index);
+      }
+      return result;
+    };
+
+    BuildAdjacency(_lanes, _successor_offsets, _successors, [&](const Lane &lane) {
+      return to_indices(lane.GetNextLanes());
+    });
+    BuildAdjacency(_lanes, _predecessor_offsets, _predecessors, [&](const Lane &lane) {
+      return to_indices(lane.GetPreviousLanes());
+    });
+  }
+
+  LaneGraph::LaneIndex LaneGraph::GetIndex(const Lane &lane) const {
+    auto it = _index.find(&lane);
+    return it != _index.end() ? it->second : InvalidIndex;
+  }
+
+} // namespace road
+} // namespace carla
@@ -0,0 +1,107 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/ListView.h"
+#include "carla/NonCopyable.h"
+#include "carla/road/RoadTypes.h"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Lane;
+  class MapData;
+
+  /// Compact read-only index of the lanes of a MapData. Each lane gets a dense
+  /// index, and its successors and predecessors are stored as adjacency arrays
+  /// together with the lane section range, so walking the graph does not need
+  /// to go through the road containers.
+  class LaneGraph : private MovableNonCopyable {
+  public:
+
+    using LaneIndex = uint32_t;
+
+    static constexpr LaneIndex InvalidIndex = std::numeric_limits<LaneIndex>::max();
+
+    struct LaneNode {
+
+      RoadId road_id = 0u;
+
+      SectionId section_id = 0u;
+
+      LaneId lane_id = 0;
+
+      /// Distance at the start of the lane section.
+      double s = 0.0;
+
+      /// Length of the lane section.
+      double length = 0.0;
+    };
+
+    using IndexList = ListView<std::vector<LaneIndex>::const_iterator>;
+
+    LaneGraph() = default;
+
+    explicit LaneGraph(const MapData &data);
+
+    size_t size() const {
+      return _nodes.size();
+    }
+
+    bool empty() const {
+      return _nodes.empty();
+    }
+
+    /// Return the index of @a lane, or InvalidIndex if the lane does not
+    /// belong to the indexed map.
+    LaneIndex GetIndex(const Lane &lane) const;
+
+    const LaneNode &GetNode(LaneIndex index) const {
+      return _nodes[index];
+    }
+
+    const Lane &GetLane(LaneIndex index) const {
+      return *_lanes[index];
+    }
+
+    IndexList GetSuccessors(LaneIndex index) const {
+      return MakeListView(
+          _successors.begin() + _successor_offsets[index],
+          _successors.begin() + _successor_offsets[index + 1u]);
+    }
+
+    IndexList GetPredecessors(LaneIndex index) const {
+      return MakeListView(
+          _predecessors.begin() + _predecessor_offsets[index],
+          _predecessors.begin() + _predecessor_offsets[index + 1u]);
+    }
+
+  private:
+
+    std::vector<LaneNode> _nodes;
+
+    std::vector<const Lane *> _lanes;
+
+    std::unordered_map<const Lane *, LaneIndex> _index;
+
+    /// Successors of lane i are in the range [offsets[i], offsets[i+1]).
+    std::vector<uint32_t> _successor_offsets;
+
+    std::vector<LaneIndex> _successors;
+
+    std::vector<uint32_t> _predecessor_offsets;
+
+    std::vector<LaneIndex> _predecessors;
+  };
+
+} // namespace road
+} // namespace carla
@@ -17,6 +17,7 @@
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
@@ -149,6 +150,192 @@ namespace road {
     return section.ContainsLane(waypoint.lane_id);
   }
 
+  static double GetDistanceAtStartOfLane(const LaneGraph::LaneNode &node) {
+    if (node.lane_id <= 0) {
+      return node.s + 10.0 * EPSILON;
+    } else {
+      return node.s + node.length - 10.0 * EPSILON;
+    }
+  }
+
+  static double GetDistanceAtEndOfLane(const LaneGraph::LaneNode &node) {
+    if (node.lane_id > 0) {
+      return node.s + 10.0 * EPSILON;
+    } else {
+      return node.s + node.length - 10.0 * EPSILON;
+    }
+  }
+
+  /// Non-owning output buffer of fixed capacity, extra waypoints are dropped.
+  class FixedWaypointBuffer {
+  public:
+
+    FixedWaypointBuffer(Waypoint *data, size_t capacity)
+      : _data(data),
+        _capacity(capacity) {}
+
+    size_t size() const {
+      return _size;
+    }
+
+    bool full() const {
+      return _size == _capacity;
+    }
+
+    void push_back(const Waypoint &waypoint) {
+      if (_size < _capacity) {
+        _data[_size++] = waypoint;
+      }
+    }
+
+    Waypoint *begin() {
+      return _data;
+    }
+
+    Waypoint *end() {
+      return _data + _size;
+    }
+
+  private:
+
+    Waypoint *_data;
+
+    size_t _capacity;
+
+    size_t _size = 0u;
+  };
+
+  static bool IsFull(const std::vector<Waypoint> &) {
+    return false;
+  }
+
+  static bool IsFull(const FixedWaypointBuffer &buffer) {
+    return buffer.full();
+  }
+
+  /// Walk @a distance along the lane graph starting at @a s on lane @a index,
+  /// following successors if @a Next is true or predecessors otherwise, and
+  /// append the resulting waypoints to @a out. The order of the results is the
+  /// same as concatenating the results of each branch with ConcatVectors.
+  template <bool Next, typename BufferT>
+  static void WalkLaneGraph(
+      const LaneGraph &graph,
+      const LaneGraph::LaneIndex index,
+      const double s,
+      const double distance,
+      BufferT &out) {
+    const auto &node = graph.GetNode(index);
+    const bool forward = Next ? (node.lane_id <= 0) : (node.lane_id > 0);
+    const double relative_s = s - node.s;
+    const double remaining_lane_length = forward ? node.length - relative_s : relative_s;
+    DEBUG_ASSERT(remaining_lane_length >= 0.0);
+
+    // If after subtracting the distance we are still in the same lane, return
+    // same waypoint with the extra distance.
+    if (distance <= remaining_lane_length) {
+      Waypoint result{node.road_id, node.section_id, node.lane_id, s};
+      result.s += forward ? distance : -distance;
+      result.s += forward ? -EPSILON : EPSILON;
+      RELEASE_ASSERT(result.s > 0.0);
+      out.push_back(result);
+      return;
+    }
+
+    // If we run out of remaining_lane_length we have to go to the successors.
+    const size_t begin = out.size();
+    const auto next_lanes = Next ? graph.GetSuccessors(index) : graph.GetPredecessors(index);
+    for (const auto next_index : next_lanes) {
+      if (IsFull(out)) {
+        break;
+      }
+      DEBUG_ASSERT(next_index != index);
+      const auto &next_node = graph.GetNode(next_index);
+      const double next_s = Next ?
+          GetDistanceAtStartOfLane(next_node) :
+          GetDistanceAtEndOfLane(next_node);
+      const size_t middle = out.size();
+      WalkLaneGraph<Next>(graph, next_index, next_s, distance - remaining_lane_length, out);
+      // ConcatVectors places the larger of the two vectors first.
+      if ((out.size() - middle) > (middle - begin)) {
+        std::rotate(out.begin() + begin, out.begin() + middle, out.end());
+      }
+    }
+  }
+
+  /// Append to @a out the signals affecting the lane @a index found driving
+  /// @a distance from @a waypoint. The order of the results is the same as
+  /// concatenating the results of each successor with ConcatVectors.
+  static void FindSignalsInDistance(
+      const Map &map,
+      const LaneGraph::LaneIndex index,
+      const Waypoint &waypoint,
+      const double distance,
+      const bool stop_at_junction,
+      std::vector<Map::SignalSearchData> &out) {
+    const auto &graph = map.GetLaneGraph();
+    const auto &node = graph.GetNode(index);
+    const bool forward = (waypoint.lane_id <= 0);
+    const double relative_s = waypoint.s - node.s;
+    const double remaining_lane_length = forward ? node.length - relative_s : relative_s;
+    DEBUG_ASSERT(remaining_lane_length >= 0.0);
+
+    // Signals in the same lane up to the distance, or to the end of the lane.
+    const bool ends_in_lane = (distance <= remaining_lane_length);
+    const double range = ends_in_lane ? distance : remaining_lane_length;
+    const double signed_range = forward ? range : -range;
+    const size_t begin = out.size();
+    map.GetSignalIndex().ForEachLaneSignalInRange(
+        index,
+        waypoint.s,
+        waypoint.s + signed_range,
+        [&](const element::RoadInfoSignal *signal) {
+      double distance_to_signal = 0;
+      if (waypoint.lane_id < 0){
+        distance_to_signal = signal->GetDistance() - waypoint.s;
+      } else {
+        distance_to_signal = waypoint.s - signal->GetDistance();
+      }
+      if (distance_to_signal == 0) {
+        out.emplace_back(Map::SignalSearchData{signal, waypoint, distance_to_signal});
+      } else {
+        out.emplace_back(Map::SignalSearchData
+            {signal, map.GetNext(waypoint, distance_to_signal).front(),
+            distance_to_signal});
+      }
+    });
+    if (ends_in_lane) {
+      return;
+    }
+
+    // If we run out of remaining_lane_length we have to go to the successors.
+    for (const auto next_index : graph.GetSuccessors(index)) {
+      if (stop_at_junction && graph.GetLane(next_index).GetRoad()->IsJunction()) {
+        continue;
+      }
+      const auto &next_node = graph.GetNode(next_index);
+      const Waypoint successor{
+          next_node.road_id,
+          next_node.section_id,
+          next_node.lane_id,
+          next_node.lane_id < 0 ? next_node.s : next_node.s + next_node.length};
+      const size_t middle = out.size();
+      FindSignalsInDistance(
+          map,
+          next_index,
+          successor,
+          distance - remaining_lane_length,
+          stop_at_junction,
+          out);
+      for (auto it = out.begin() + static_cast<std::ptrdiff_t>(middle); it != out.end(); ++it) {
+        it->accumulated_s += remaining_lane_length;
+      }
+      // ConcatVectors places the larger of the two vectors first.
+      if ((out.size() - middle) > (middle - begin)) {
+        std::rotate(out.begin() + begin, out.begin() + middle, out.end());
+      }
+    }
+  }
+
   // ===========================================================================
   // -- Map: Geometry ----------------------------------------------------------
   // ===========================================================================
@@ -209,18 +396,21 @@ namespace road {
       return w;
     }
 
-    const auto dist = geom::Math::Distance2D(ComputeTransform(*w).location, pos);
-    const auto lane_width_info = GetLane(*w).GetInfo<RoadInfoLaneWidth>(w->s);
-    const auto half_lane_width =
-        lane_width_info->GetPolynomial().Evaluate(w->s) * 0.5;
-
-    if (dist < half_lane_width) {
+    if (IsWithinLane(*w, pos)) {
       return w;
     }
 
     return boost::optional<Waypoint>{};
   }
 
+  bool Map::IsWithinLane(const Waypoint &waypoint, const geom::Location &pos) const {
+    const auto dist = geom::Math::Distance2D(ComputeTransform(waypoint).location, pos);
+    const auto lane_width_info = GetLane(waypoint).GetInfo<RoadInfoLaneWidth>(waypoint.s);
+    const auto half_lane_width =
+        lane_width_info->GetPolynomial().Evaluate(waypoint.s) * 0.5;
+    return dist < half_lane_width;
+  }
+
   boost::optional<Waypoint> Map::GetWaypoint(
       RoadId road_id,
       LaneId lane_id,
@@ -320,121 +510,38 @@ namespace road {
 
   std::vector<Map::SignalSearchData> Map::GetSignalsInDistance(
       Waypoint waypoint, double distance, bool stop_at_junction) const {
-
-    const auto &lane = GetLane(waypoint);
-    const bool forward = (waypoint.lane_id <= 0);
-    const double signed_distance = forward ? distance : -distance;
-    const double relative_s = waypoint.s - lane.GetDistance();
-    const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
-    DEBUG_ASSERT(remaining_lane_length >= 0.0);
-
-    auto &road =_data.GetRoad(waypoint.road_id);
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
     std::vector<SignalSearchData> result;
+    FindSignalsInDistance(*this, index, waypoint, distance, stop_at_junction, result);
+    return result;
+  }
 
-    // If after subtracting the distance we are still in the same lane, return
-    // same waypoint with the extra distance.
-    if (distance <= remaining_lane_length) {
-      auto signals = road.GetInfosInRange<RoadInfoSignal>(
-          waypoint.s, waypoint.s + signed_distance);
-      for(auto* signal : signals){
-        double distance_to_signal = 0;
-        if (waypoint.lane_id < 0){
-          distance_to_signal = signal->GetDistance() - waypoint.s;
-        } else {
-          distance_to_signal = waypoint.s - signal->GetDistance();
-        }
-        // check that the signal affects the waypoint
-        bool is_valid = false;
-        for (auto &validity : signal->GetValidities()) {
-          if (waypoint.lane_id >= validity._from_lane &&
-              waypoint.lane_id <= validity._to_lane) {
-            is_valid = true;
-            break;
-          }
-        }
-        if(!is_valid){
-          continue;
-        }
-        if (distance_to_signal == 0) {
-          result.emplace_back(SignalSearchData
-              {signal, waypoint,
-              distance_to_signal});
-        } else {
-          result.emplace_back(SignalSearchData
-              {signal, GetNext(waypoint, distance_to_signal).front(),
-              distance_to_signal});
-        }
-
-      }
-      return result;
-    }
-    const double signed_remaining_length = forward ? remaining_lane_length : -remaining_lane_length;
-
-    //result = road.GetInfosInRange<RoadInfoSignal>(waypoint.s, waypoint.s + signed_remaining_length);
-    auto signals = road.GetInfosInRange<RoadInfoSignal>(
-        waypoint.s, waypoint.s + signed_remaining_length);
-    for(auto* signal : signals){
-      double distance_to_signal = 0;
-      if (waypoint.lane_id < 0){
-        distance_to_signal = signal->GetDistance() - waypoint.s;
-      } else {
-        distance_to_signal = waypoint.s - signal->GetDistance();
-      }
-      // check that the signal affects the waypoint
-      bool is_valid = false;
-      for (auto &validity : signal->GetValidities()) {
-        if (waypoint.lane_id >= validity._from_lane &&
-            waypoint.lane_id <= validity._to_lane) {
-          is_valid = true;
-          break;
-        }
-      }
-      if(!is_valid){
-        continue;
-      }
-      if (distance_to_signal == 0) {
-        result.emplace_back(SignalSearchData
-            {signal, waypoint,
-            distance_to_signal});
-      } else {
-        result.emplace_back(SignalSearchData
-            {signal, GetNext(waypoint, distance_to_signal).front(),
-            distance_to_signal});
-      }
-    }
-    // If we run out of remaining_lane_length we have to go to the successors.
-    for (auto &successor : GetSuccessors(waypoint)) {
-      if(_data.GetRoad(successor.road_id).IsJunction() && stop_at_junction){
-        continue;
-      }
-      auto& sucessor_lane = _data.GetRoad(successor.road_id).
-            GetLaneByDistance(successor.s, successor.lane_id);
-      if (successor.lane_id < 0) {
-        successor.s = sucessor_lane.GetDistance();
-      } else {
-        successor.s = sucessor_lane.GetDistance() + sucessor_lane.GetLength();
-      }
-      auto sucessor_signals = GetSignalsInDistance(
-          successor, distance - remaining_lane_length, stop_at_junction);
-      for(auto& signal : sucessor_signals){
-        signal.accumulated_s += remaining_lane_length;
-      }
-      result = ConcatVectors(result, sucessor_signals);
+  std::vector<std::vector<Map::SignalSearchData>> Map::GetSignalsInDistance(
+      const std::vector<Waypoint> &waypoints,
+      const double distance,
+      const bool stop_at_junction) const {
+    std::vector<std::vector<SignalSearchData>> result;
+    result.reserve(waypoints.size());
+    for (const auto &waypoint : waypoints) {
+      result.emplace_back(GetSignalsInDistance(waypoint, distance, stop_at_junction));
     }
     return result;
   }
 
   std::vector<const element::RoadInfoSignal*>
       Map::GetAllSignalReferences() const {
-    std::vector<const element::RoadInfoSignal*> result;
-    for (const auto& road_pair : _data.GetRoads()) {
-      const auto &road = road_pair.second;
-      auto road_infos = road.GetInfos<element::RoadInfoSignal>();
-      for(const auto* road_info : road_infos) {
-        result.push_back(road_info);
-      }
-    }
-    return result;
+    return _signal_index.GetAllSignalReferences();
+  }
+
+  std::vector<const element::RoadInfoSignal*>
+      Map::GetSignalReferencesById(const SignId &signal_id) const {
+    return _signal_index.GetSignalReferencesById(signal_id);
+  }
+
+  std::vector<const element::RoadInfoSignal*>
+      Map::GetSignalReferencesInRadius(const geom::Location &location, const double radius) const {
+    return _signal_index.GetSignalReferencesInRadius(location, radius);
   }
 
   std::vector<LaneMarking> Map::CalculateCrossedLanes(
@@ -507,37 +614,37 @@ namespace road {
   // ===========================================================================
 
   std::vector<Waypoint> Map::GetSuccessors(const Waypoint waypoint) const {
-    const auto &next_lanes = GetLane(waypoint).GetNextLanes();
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
+    const auto next_lanes = _lane_graph.GetSuccessors(index);
     std::vector<Waypoint> result;
     result.reserve(next_lanes.size());
-    for (auto *next_lane : next_lanes) {
-      RELEASE_ASSERT(next_lane != nullptr);
-      const auto lane_id = next_lane->GetId();
-      RELEASE_ASSERT(lane_id != 0);
-      const auto *section = next_lane->GetLaneSection();
-      RELEASE_ASSERT(section != nullptr);
-      const auto *road = next_lane->GetRoad();
-      RELEASE_ASSERT(road != nullptr);
-      const auto distance = GetDistanceAtStartOfLane(*next_lane);
-      result.emplace_back(Waypoint{road->GetId(), section->GetId(), lane_id, distance});
+    for (const auto next_index : next_lanes) {
+      const auto &next_node = _lane_graph.GetNode(next_index);
+      RELEASE_ASSERT(next_node.lane_id != 0);
+      result.emplace_back(Waypoint{
+          next_node.road_id,
+          next_node.section_id,
+          next_node.lane_id,
+          GetDistanceAtStartOfLane(next_node)});
     }
     return result;
   }
 
   std::vector<Waypoint> Map::GetPredecessors(const Waypoint waypoint) const {
-    const auto &prev_lanes = GetLane(waypoint).GetPreviousLanes();
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
+    const auto prev_lanes = _lane_graph.GetPredecessors(index);
     std::vector<Waypoint> result;
     result.reserve(prev_lanes.size());
-    for (auto *next_lane : prev_lanes) {
-      RELEASE_ASSERT(next_lane != nullptr);
-      const auto lane_id = next_lane->GetId();
-      RELEASE_ASSERT(lane_id != 0);
-      const auto *section = next_lane->GetLaneSection();
-      RELEASE_ASSERT(section != nullptr);
-      const auto *road = next_lane->GetRoad();
-      RELEASE_ASSERT(road != nullptr);
-      const auto distance = GetDistanceAtEndOfLane(*next_lane);
-      result.emplace_back(Waypoint{road->GetId(), section->GetId(), lane_id, distance});
+    for (const auto prev_index : prev_lanes) {
+      const auto &prev_node = _lane_graph.GetNode(prev_index);
+      RELEASE_ASSERT(prev_node.lane_id != 0);
+      result.emplace_back(Waypoint{
+          prev_node.road_id,
+          prev_node.section_id,
+          prev_node.lane_id,
+          GetDistanceAtEndOfLane(prev_node)});
     }
     return result;
   }
@@ -546,32 +653,10 @@ namespace road {
       const Waypoint waypoint,
       const double distance) const {
     RELEASE_ASSERT(distance > 0.0);
-    const auto &lane = GetLane(waypoint);
-    const bool forward = (waypoint.lane_id <= 0);
-    const double signed_distance = forward ? distance : -distance;
-    const double relative_s = waypoint.s - lane.GetDistance();
-    const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
-    DEBUG_ASSERT(remaining_lane_length >= 0.0);
-
-    // If after subtracting the distance we are still in the same lane, return
-    // same waypoint with the extra distance.
-    if (distance <= remaining_lane_length) {
-      Waypoint result = waypoint;
-      result.s += signed_distance;
-      result.s += forward ? -EPSILON : EPSILON;
-      RELEASE_ASSERT(result.s > 0.0);
-      return { result };
-    }
-
-    // If we run out of remaining_lane_length we have to go to the successors.
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
     std::vector<Waypoint> result;
-    for (const auto &successor : GetSuccessors(waypoint)) {
-      DEBUG_ASSERT(
-          successor.road_id != waypoint.road_id ||
-          successor.section_id != waypoint.section_id ||
-          successor.lane_id != waypoint.lane_id);
-      result = ConcatVectors(result, GetNext(successor, distance - remaining_lane_length));
-    }
+    WalkLaneGraph<true>(_lane_graph, index, waypoint.s, distance, result);
     return result;
   }
 
@@ -579,35 +664,41 @@ namespace road {
       const Waypoint waypoint,
       const double distance) const {
     RELEASE_ASSERT(distance > 0.0);
-    const auto &lane = GetLane(waypoint);
-    const bool forward = !(waypoint.lane_id <= 0);
-    const double signed_distance = forward ? distance : -distance;
-    const double relative_s = waypoint.s - lane.GetDistance();
-    const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
-    DEBUG_ASSERT(remaining_lane_length >= 0.0);
-
-    // If after subtracting the distance we are still in the same lane, return
-    // same waypoint with the extra distance.
-    if (distance <= remaining_lane_length) {
-      Waypoint result = waypoint;
-      result.s += signed_distance;
-      result.s += forward ? -EPSILON : EPSILON;
-      RELEASE_ASSERT(result.s > 0.0);
-      return { result };
-    }
-
-    // If we run out of remaining_lane_length we have to go to the successors.
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
     std::vector<Waypoint> result;
-    for (const auto &successor : GetPredecessors(waypoint)) {
-      DEBUG_ASSERT(
-          successor.road_id != waypoint.road_id ||
-          successor.section_id != waypoint.section_id ||
-          successor.lane_id != waypoint.lane_id);
-      result = ConcatVectors(result, GetPrevious(successor, distance - remaining_lane_length));
-    }
+    WalkLaneGraph<false>(_lane_graph, index, waypoint.s, distance, result);
     return result;
   }
 
+  size_t Map::GetNextN(
+      const Waypoint waypoint,
+      const double distance,
+      Waypoint *out,
+      const size_t capacity) const {
+    RELEASE_ASSERT(distance > 0.0);
+    RELEASE_ASSERT(out != nullptr || capacity == 0u);
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
+    FixedWaypointBuffer result(out, capacity);
+    WalkLaneGraph<true>(_lane_graph, index, waypoint.s, distance, result);
+    return result.size();
+  }
+
+  size_t Map::GetPreviousN(
+      const Waypoint waypoint,
+      const double distance,
+      Waypoint *out,
+      const size_t capacity) const {
+    RELEASE_ASSERT(distance > 0.0);
+    RELEASE_ASSERT(out != nullptr || capacity == 0u);
+    const auto index = _lane_graph.GetIndex(GetLane(waypoint));
+    RELEASE_ASSERT(index != LaneGraph::InvalidIndex);
+    FixedWaypointBuffer result(out, capacity);
+    WalkLaneGraph<false>(_lane_graph, index, waypoint.s, distance, result);
+    return result.size();
+  }
+
   boost::optional<Waypoint> Map::GetRight(Waypoint waypoint) const {
     RELEASE_ASSERT(waypoint.lane_id != 0);
     if (waypoint.lane_id > 0) {
@@ -630,15 +721,34 @@ namespace road {
     return IsLanePresent(_data, waypoint) ? waypoint : boost::optional<Waypoint>{};
   }
 
+  static void GenerateRoadWaypoints(
+      const Road &road,
+      const double distance,
+      std::vector<Waypoint> &result) {
+    for (double s = EPSILON; s < (road.GetLength() - EPSILON); s += distance) {
+      ForEachDrivableLaneAt(road, s, [&](auto &&waypoint) {
+        result.emplace_back(waypoint);
+      });
+    }
+  }
+
   std::vector<Waypoint> Map::GenerateWaypoints(const double distance) const {
     RELEASE_ASSERT(distance > 0.0);
     std::vector<Waypoint> result;
     for (const auto &pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      for (double s = EPSILON; s < (road.GetLength() - EPSILON); s += distance) {
-        ForEachDrivableLaneAt(road, s, [&](auto &&waypoint) {
-          result.emplace_back(waypoint);
-        });
+      GenerateRoadWaypoints(pair.second, distance, result);
+    }
+    return result;
+  }
+
+  std::vector<Waypoint> Map::GenerateWaypoints(
+      const double distance,
+      const std::vector<RoadId> &road_ids) const {
+    RELEASE_ASSERT(distance > 0.0);
+    std::vector<Waypoint> result;
+    for (auto road_id : road_ids) {
+      if (_data.ContainsRoad(road_id)) {
+        GenerateRoadWaypoints(_data.GetRoad(road_id), distance, result);
       }
     }
     return result;
@@ -859,7 +969,23 @@ namespace road {
     }
   }
 
+  void Map::CreateSignalIndex() {
+    _signal_index = SignalIndex(_data, _lane_graph);
+  }
+
   void Map::CreateRtree() {
+    // Container of segments and waypoints
+    std::vector<Rtree::TreeElement> rtree_elements;
+    for (const auto &pair : _data.GetRoads()) {
+      AddRoadToRtree(pair.second, rtree_elements);
+    }
+    // Add segments to Rtree
+    _rtree.InsertElements(rtree_elements);
+  }
+
+  void Map::AddRoadToRtree(
+      const Road &road,
+      std::vector<Rtree::TreeElement> &rtree_elements) {
     const double epsilon = 0.000001; // small delta in the road (set to 1
                                      // micrometer to prevent numeric errors)
     const double min_delta_s = 1;    // segments of minimum 1m through the road
@@ -871,17 +997,12 @@ namespace road {
 
     // Generate waypoints at start of every lane
     std::vector<Waypoint> topology;
-    for (const auto &pair : _data.GetRoads()) {
-      const auto &road = pair.second;
-      ForEachLane(road, Lane::LaneType::Any, [&](auto &&waypoint) {
-        if(waypoint.lane_id != 0) {
-          topology.push_back(waypoint);
-        }
-      });
-    }
+    ForEachLane(road, Lane::LaneType::Any, [&](auto &&waypoint) {
+      if(waypoint.lane_id != 0) {
+        topology.push_back(waypoint);
+      }
+    });
 
-    // Container of segments and waypoints
-    std::vector<Rtree::TreeElement> rtree_elements;
     // Loop through all lanes
     for (auto &waypoint : topology) {
       auto &lane_start_waypoint = waypoint;
@@ -965,7 +1086,22 @@ namespace road {
         }
       }
     }
-    // Add segments to Rtree
+  }
+
+  void Map::UpdateIndices(const std::vector<RoadId> &roads) {
+    _lane_graph = LaneGraph(_data);
+
+    std::unordered_set<RoadId> changed(roads.begin(), roads.end());
+    _rtree.RemoveElements([&](const Rtree::TreeElement &element) {
+      return changed.count(element.second.first.road_id) > 0u;
+    });
+
+    std::vector<Rtree::TreeElement> rtree_elements;
+    for (auto road_id : roads) {
+      if (_data.ContainsRoad(road_id)) {
+        AddRoadToRtree(_data.GetRoad(road_id), rtree_elements);
+      }
+    }
     _rtree.InsertElements(rtree_elements);
   }
 
@@ -13,12 +13,15 @@
 #include "carla/road/element/LaneMarking.h"
 #include "carla/road/element/RoadInfoMarkRecord.h"
 #include "carla/road/element/Waypoint.h"
+#include "carla/road/LaneGraph.h"
 #include "carla/road/MapData.h"
 #include "carla/road/RoadTypes.h"
+#include "carla/road/SignalIndex.h"
 #include "carla/rpc/OpendriveGenerationParameters.h"
 
 #include <boost/optional.hpp>
 
+#include <array>
 #include <vector>
 
 namespace carla {
@@ -33,8 +36,9 @@ namespace road {
     /// -- Constructor ---------------------------------------------------------
     /// ========================================================================
 
-    Map(MapData m) : _data(std::move(m)) {
+    Map(MapData m) : _data(std::move(m)), _lane_graph(_data) {
       CreateRtree();
+      CreateSignalIndex();
     }
 
     /// ========================================================================
@@ -62,6 +66,10 @@ namespace road {
         LaneId lane_id,
         float s) const;
 
+    /// Whether @a location lies within the lane of @a waypoint, the test used
+    /// by GetWaypoint on the closest waypoint on road.
+    bool IsWithinLane(const Waypoint &waypoint, const geom::Location &location) const;
+
     geom::Transform ComputeTransform(Waypoint waypoint) const;
 
     /// ========================================================================
@@ -100,10 +108,25 @@ namespace road {
     std::vector<SignalSearchData> GetSignalsInDistance(
         Waypoint waypoint, double distance, bool stop_at_junction = false) const;
 
+    /// Same as GetSignalsInDistance for each of the @a waypoints.
+    std::vector<std::vector<SignalSearchData>> GetSignalsInDistance(
+        const std::vector<Waypoint> &waypoints,
+        double distance,
+        bool stop_at_junction = false) const;
+
     /// Return all RoadInfoSignal in the map
     std::vector<const element::RoadInfoSignal*>
         GetAllSignalReferences() const;
 
+    /// Return the RoadInfoSignal referencing the signal @a signal_id
+    std::vector<const element::RoadInfoSignal*>
+        GetSignalReferencesById(const SignId &signal_id) const;
+
+    /// Return the RoadInfoSignal whose signal is within @a radius of
+    /// @a location, in no particular order
+    std::vector<const element::RoadInfoSignal*>
+        GetSignalReferencesInRadius(const geom::Location &location, double radius) const;
+
     /// ========================================================================
     /// -- Waypoint generation -------------------------------------------------
     /// ========================================================================
@@ -121,6 +144,35 @@ namespace road {
     /// that a vehicle at @a waypoint could drive to.
     std::vector<Waypoint> GetPrevious(Waypoint waypoint, double distance) const;
 
+    /// Same as GetNext but writes the waypoints into @a out, a buffer of @a
+    /// capacity elements, without allocating. Returns the number of waypoints
+    /// written; if there are more than @a capacity the result is truncated.
+    size_t GetNextN(
+        Waypoint waypoint,
+        double distance,
+        Waypoint *out,
+        size_t capacity) const;
+
+    template <size_t N>
+    size_t GetNextN(Waypoint waypoint, double distance, std::array<Waypoint, N> &out) const {
+      return GetNextN(waypoint, distance, out.data(), N);
+    }
+
+    /// Same as GetPrevious but writes the waypoints into @a out, a buffer of
+    /// @a capacity elements, without allocating. Returns the number of
+    /// waypoints written; if there are more than @a capacity the result is
+    /// truncated.
+    size_t GetPreviousN(
+        Waypoint waypoint,
+        double distance,
+        Waypoint *out,
+        size_t capacity) const;
+
+    template <size_t N>
+    size_t GetPreviousN(Waypoint waypoint, double distance, std::array<Waypoint, N> &out) const {
+      return GetPreviousN(waypoint, distance, out.data(), N);
+    }
+
     /// Return a waypoint at the lane of @a waypoint's right lane.
     boost::optional<Waypoint> GetRight(Waypoint waypoint) const;
 
@@ -130,6 +182,12 @@ namespace road {
     /// Generate all the waypoints in @a map separated by @a approx_distance.
     std::vector<Waypoint> GenerateWaypoints(double approx_distance) const;
 
+    /// Generate all the waypoints in the roads @a road_ids separated by @a
+    /// approx_distance, roads not in the map are ignored.
+    std::vector<Waypoint> GenerateWaypoints(
+        double approx_distance,
+        const std::vector<RoadId> &road_ids) const;
+
     /// Generate waypoints on each @a lane at the start of each @a road
     std::vector<Waypoint> GenerateWaypointsOnRoadEntries(Lane::LaneType lane_type = Lane::LaneType::Driving) const;
 
@@ -172,10 +230,24 @@ namespace road {
       return _data.GetControllers();
     }
 
+    /// Dense index of the lanes of this map and their connections.
+    const LaneGraph &GetLaneGraph() const {
+      return _lane_graph;
+    }
+
+    /// Index of the signal references per lane of the lane graph.
+    const SignalIndex &GetSignalIndex() const {
+      return _signal_index;
+    }
+
 #ifdef LIBCARLA_WITH_GTEST
     MapData &GetMap() {
       return _data;
     }
+
+    const MapData &GetMap() const {
+      return _data;
+    }
 #endif // LIBCARLA_WITH_GTEST
 
 private:
@@ -183,11 +255,28 @@ private:
     friend MapBuilder;
     MapData _data;
 
+    LaneGraph _lane_graph;
+
     using Rtree = geom::SegmentCloudRtree<Waypoint>;
     Rtree _rtree;
 
+    SignalIndex _signal_index;
+
     void CreateRtree();
 
+    /// Build the signal index, must be called again after the signal
+    /// references, their positions or the lane graph change.
+    void CreateSignalIndex();
+
+    /// Update the lane graph and the rtree after the roads in @a roads have
+    /// been added, replaced or removed from the map data.
+    void UpdateIndices(const std::vector<RoadId> &roads);
+
+    /// Append the segments of every lane of @a road to @a rtree_elements.
+    void AddRoadToRtree(
+        const Road &road,
+        std::vector<Rtree::TreeElement> &rtree_elements);
+
     /// Helper Functions for constructing the rtree element list
     void AddElementToRtree(
         std::vector<Rtree::TreeElement> &rtree_elements,
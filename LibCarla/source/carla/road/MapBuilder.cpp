@@ -39,25 +39,12 @@ namespace road {
 
     CreatePointersBetweenRoadSegments();
     RemoveZeroLaneValiditySignalReferences();
-
-    for (auto &&info : _temp_road_info_container) {
-      DEBUG_ASSERT(info.first != nullptr);
-      info.first->_info = InformationSet(std::move(info.second));
-    }
-
-    for (auto &&info : _temp_lane_info_container) {
-      DEBUG_ASSERT(info.first != nullptr);
-      info.first->_info = InformationSet(std::move(info.second));
-    }
+    SolveRoadAndLaneInfo();
 
     // compute transform requires the roads to have the RoadInfo
     SolveSignalReferencesAndTransforms();
 
-    SolveControllerAndJuntionReferences();
-
-    // remove temporal already used information
-    _temp_road_info_container.clear();
-    _temp_lane_info_container.clear();
+    SolveControllerAndJuntionReferences(_map_data);
 
     // _map_data is a memeber of MapBuilder so you must especify if
     // you want to keep it (will return copy -> Map(const Map &))
@@ -66,10 +53,284 @@ namespace road {
     CreateJunctionBoundingBoxes(map);
     ComputeJunctionRoadConflicts(map);
     CheckSignalsOnRoads(map);
+    // The signals may have been moved out of the road.
+    map.CreateSignalIndex();
 
     return map;
   }
 
+  MapChange MapBuilder::ApplyTo(Map &map, const MapChange &removed) {
+    MapData &data = map._data;
+
+    RemoveZeroLaneValiditySignalReferences();
+    SolveRoadAndLaneInfo();
+    GenerateDefaultValiditiesForSignalReferences();
+
+    // Roads and junctions added, replaced or removed.
+    std::set<RoadId> roads(removed.roads.begin(), removed.roads.end());
+    for (const auto &pair : _map_data._roads) {
+      roads.insert(pair.first);
+    }
+    std::set<RoadId> removed_roads;
+    for (auto road_id : removed.roads) {
+      if (_map_data._roads.find(road_id) == _map_data._roads.end()) {
+        removed_roads.insert(road_id);
+      }
+    }
+    std::set<JuncId> junctions(removed.junctions.begin(), removed.junctions.end());
+    for (const auto &pair : _map_data._junctions) {
+      junctions.insert(pair.first);
+    }
+
+    // Junctions whose connecting roads change, before and after the patch.
+    std::set<JuncId> affected_junctions = junctions;
+    for (auto road_id : roads) {
+      if (data.ContainsRoad(road_id) && data.GetRoad(road_id).IsJunction()) {
+        affected_junctions.insert(data.GetRoad(road_id).GetJunctionId());
+      }
+      auto it = _map_data._roads.find(road_id);
+      if (it != _map_data._roads.end() && it->second.IsJunction()) {
+        affected_junctions.insert(it->second.GetJunctionId());
+      }
+    }
+
+    // Signals defined in the replaced roads are removed unless the patch
+    // defines them again.
+    std::set<SignId> signals(removed.signals.begin(), removed.signals.end());
+    for (const auto &pair : data._signals) {
+      if (roads.count(pair.second->GetRoadId()) > 0u) {
+        signals.insert(pair.first);
+      }
+    }
+    std::set<SignId> removed_signals;
+    for (const auto &signal_id : signals) {
+      if (_temp_signal_container.find(signal_id) == _temp_signal_container.end()) {
+        removed_signals.insert(signal_id);
+      }
+    }
+    for (const auto &pair : _temp_signal_container) {
+      signals.insert(pair.first);
+    }
+
+    // Roads kept from the map whose lanes may link to the changed elements,
+    // their successors need to be recomputed.
+    auto links_to_changes = [&](RoadId id) {
+      return (roads.count(id) > 0u) ||
+          (affected_junctions.count(static_cast<JuncId>(id)) > 0u);
+    };
+    std::vector<Road *> relinked_roads;
+    for (auto &pair : data._roads) {
+      auto &road = pair.second;
+      if ((roads.count(pair.first) == 0u) &&
+          (links_to_changes(road.GetSuccessor()) || links_to_changes(road.GetPredecessor()))) {
+        relinked_roads.emplace_back(&road);
+      }
+    }
+
+    // Unlink the lanes of the roads that change, the roads at the other end
+    // of the removed links need their neighbours updated.
+    std::set<Road *> touched_roads;
+    auto unlink_lanes = [&](Road &road, bool unlink_predecessors) {
+      for (auto &section : road._lane_sections) {
+        for (auto &lane : section.second._lanes) {
+          for (auto *next_lane : lane.second._next_lanes) {
+            auto &prevs = next_lane->_prev_lanes;
+            prevs.erase(std::remove(prevs.begin(), prevs.end(), &lane.second), prevs.end());
+            touched_roads.insert(next_lane->GetRoad());
+          }
+          lane.second._next_lanes.clear();
+          if (unlink_predecessors) {
+            for (auto *prev_lane : lane.second._prev_lanes) {
+              auto &nexts = prev_lane->_next_lanes;
+              nexts.erase(std::remove(nexts.begin(), nexts.end(), &lane.second), nexts.end());
+              touched_roads.insert(prev_lane->GetRoad());
+            }
+            lane.second._prev_lanes.clear();
+          }
+        }
+      }
+    };
+    for (auto *road : relinked_roads) {
+      unlink_lanes(*road, false);
+    }
+    for (auto road_id : roads) {
+      if (data.ContainsRoad(road_id)) {
+        unlink_lanes(data.GetRoad(road_id), true);
+      }
+    }
+
+    // Remove the old elements.
+    for (auto road_id : roads) {
+      auto it = data._roads.find(road_id);
+      if (it != data._roads.end()) {
+        touched_roads.erase(&it->second);
+        data._roads.erase(it);
+      }
+    }
+    for (auto junction_id : junctions) {
+      data._junctions.erase(junction_id);
+    }
+    for (auto &pair : data._junctions) {
+      auto &connections = pair.second._connections;
+      for (auto it = connections.begin(); it != connections.end();) {
+        const auto &connection = it->second;
+        const bool is_removed =
+            (removed_roads.count(connection.incoming_road) > 0u) ||
+            (removed_roads.count(connection.connecting_road) > 0u);
+        if (is_removed) {
+          affected_junctions.insert(pair.first);
+          it = connections.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    // Signals placed on a road that does not exist after the patch are
+    // rejected.
+    for (auto it = _temp_signal_container.begin(); it != _temp_signal_container.end();) {
+      const auto &signal = *it->second;
+      const bool has_road = signal._using_inertial_position ||
+          data.ContainsRoad(signal._road_id) ||
+          (_map_data._roads.find(signal._road_id) != _map_data._roads.end());
+      if (!has_road) {
+        log_warning("removing signal", it->first, "placed on unknown road", signal._road_id);
+        removed_signals.insert(it->first);
+        it = _temp_signal_container.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (!removed_signals.empty()) {
+      for (const auto &signal_id : removed_signals) {
+        data._signals.erase(signal_id);
+      }
+      for (auto &pair : data._controllers) {
+        for (const auto &signal_id : removed_signals) {
+          pair.second->_signals.erase(signal_id);
+        }
+      }
+      for (auto &pair : data._roads) {
+        pair.second._info.RemoveIf<RoadInfoSignal>([&](const RoadInfoSignal &reference) {
+          return removed_signals.count(reference.GetSignalId()) > 0u;
+        });
+      }
+    }
+
+    // Move the new elements into the map.
+    std::vector<Road *> new_roads;
+    for (auto &pair : _map_data._roads) {
+      auto &road = data._roads[pair.first];
+      road = std::move(pair.second);
+      road._map_data = &data;
+      for (auto &section : road._lane_sections) {
+        section.second._road = &road;
+      }
+      new_roads.emplace_back(&road);
+    }
+    for (auto &pair : _map_data._junctions) {
+      data._junctions.emplace(pair.first, std::move(pair.second));
+    }
+    for (auto &pair : _map_data._controllers) {
+      data._controllers[pair.first] = std::move(pair.second);
+    }
+    std::vector<Signal *> new_signals;
+    for (auto &pair : _temp_signal_container) {
+      auto &signal = data._signals[pair.first];
+      if (signal == nullptr) {
+        signal = std::move(pair.second);
+      } else {
+        // Keep the address, other roads may be referencing this signal.
+        *signal = std::move(*pair.second);
+      }
+      SolveSignalTransform(signal, data);
+      new_signals.emplace_back(signal.get());
+    }
+    for (auto *signal_reference : _temp_signal_reference_container) {
+      auto it = data._signals.find(signal_reference->_signal_id);
+      if (it != data._signals.end()) {
+        signal_reference->_signal = it->second.get();
+      } else {
+        log_warning("removing reference to unknown signal", signal_reference->_signal_id);
+        auto road = data._roads.find(signal_reference->_road_id);
+        if (road != data._roads.end()) {
+          road->second._info.RemoveIf<RoadInfoSignal>(
+              [=](const RoadInfoSignal &reference) {
+                return &reference == signal_reference;
+              });
+        }
+      }
+    }
+    SolveControllerAndJuntionReferences(data);
+
+    // Link the lanes again.
+    for (auto *road : new_roads) {
+      LinkRoadLanes(data, *road);
+      touched_roads.insert(road);
+    }
+    for (auto *road : relinked_roads) {
+      LinkRoadLanes(data, *road);
+      touched_roads.insert(road);
+    }
+    std::vector<Road *> next_roads;
+    for (auto *road : touched_roads) {
+      for (const auto &section : road->_lane_sections) {
+        for (const auto &lane : section.second._lanes) {
+          for (auto *next_lane : lane.second._next_lanes) {
+            next_roads.emplace_back(next_lane->GetRoad());
+          }
+        }
+      }
+    }
+    touched_roads.insert(next_roads.begin(), next_roads.end());
+    for (auto *road : touched_roads) {
+      UpdateRoadNeighbours(*road);
+    }
+
+    // Update the indices of the map and the geometry that depends on the
+    // changed roads.
+    MapChange change;
+    change.roads.assign(roads.begin(), roads.end());
+    map.UpdateIndices(change.roads);
+
+    for (auto junction_id : affected_junctions) {
+      auto *junction = data.GetJunction(junction_id);
+      if (junction != nullptr) {
+        CreateJunctionBoundingBox(map, *junction);
+        junction->_road_conflicts = map.ComputeJunctionConflicts(junction_id);
+      }
+    }
+    for (auto *signal : new_signals) {
+      CheckSignalOnRoads(map, *signal);
+    }
+    map.CreateSignalIndex();
+
+    _map_data._roads.clear();
+    _map_data._junctions.clear();
+    _map_data._controllers.clear();
+    _temp_signal_container.clear();
+    _temp_signal_reference_container.clear();
+
+    change.junctions.assign(affected_junctions.begin(), affected_junctions.end());
+    change.signals.assign(signals.begin(), signals.end());
+    return change;
+  }
+
+  void MapBuilder::SolveRoadAndLaneInfo() {
+    for (auto &&info : _temp_road_info_container) {
+      DEBUG_ASSERT(info.first != nullptr);
+      info.first->_info = InformationSet(std::move(info.second));
+    }
+
+    for (auto &&info : _temp_lane_info_container) {
+      DEBUG_ASSERT(info.first != nullptr);
+      info.first->_info = InformationSet(std::move(info.second));
+    }
+
+    // remove temporal already used information
+    _temp_road_info_container.clear();
+    _temp_lane_info_container.clear();
+  }
+
   // called from profiles parser
   void MapBuilder::AddRoadElevationProfile(
       Road *road,
@@ -606,12 +867,16 @@ namespace road {
   }
 
   // return the pointer to a lane object
-  Lane *MapBuilder::GetEdgeLanePointer(RoadId road_id, bool from_start, LaneId lane_id) {
+  Lane *MapBuilder::GetEdgeLanePointer(
+      MapData &data,
+      RoadId road_id,
+      bool from_start,
+      LaneId lane_id) {
 
-    if (!_map_data.ContainsRoad(road_id)) {
+    if (!data.ContainsRoad(road_id)) {
       return nullptr;
     }
-    Road &road = _map_data.GetRoad(road_id);
+    Road &road = data.GetRoad(road_id);
 
     // get the lane section
     LaneSection *section;
@@ -629,15 +894,16 @@ namespace road {
   // return a list of pointers to all lanes from a lane (using road and junction
   // info)
   std::vector<Lane *> MapBuilder::GetLaneNext(
+      MapData &data,
       RoadId road_id,
       SectionId section_id,
       LaneId lane_id) {
     std::vector<Lane *> result;
 
-    if (!_map_data.ContainsRoad(road_id)) {
+    if (!data.ContainsRoad(road_id)) {
       return result;
     }
-    Road &road = _map_data.GetRoad(road_id);
+    Road &road = data.GetRoad(road_id);
 
     // get the section
     LaneSection &section = road._lane_sections.GetById(section_id);
@@ -658,7 +924,7 @@ namespace road {
     }
 
     // check to see if next is a road or a junction
-    bool next_is_junction = !_map_data.ContainsRoad(next_road);
+    bool next_is_junction = !data.ContainsRoad(next_road);
     double s = section.GetDistance();
 
     // check if we are in a lane section in the middle
@@ -677,7 +943,7 @@ namespace road {
       // change to another road / junction
       if (next != 0 || (lane_id == 0 && next == 0)) {
         // single road
-        result.push_back(GetEdgeLanePointer(next_road, (next <= 0), next));
+        result.push_back(GetEdgeLanePointer(data, next_road, (next <= 0), next));
       }
     } else {
       // several roads (junction)
@@ -685,23 +951,28 @@ namespace road {
       /// @todo Is it correct to use a road id as section id? (NS: I just added
       /// this cast to avoid compiler warnings).
       auto next_road_as_junction = static_cast<JuncId>(next_road);
-      auto options = GetJunctionLanes(next_road_as_junction, road_id, lane_id);
+      auto options = GetJunctionLanes(data, next_road_as_junction, road_id, lane_id);
       for (auto opt : options) {
-        result.push_back(GetEdgeLanePointer(opt.first, (opt.second <= 0), opt.second));
+        result.push_back(GetEdgeLanePointer(data, opt.first, (opt.second <= 0), opt.second));
       }
     }
 
+    // ignore the links to roads not present in the map (e.g. removed by a
+    // patch)
+    result.erase(std::remove(result.begin(), result.end(), nullptr), result.end());
+
     return result;
   }
 
   std::vector<std::pair<RoadId, LaneId>> MapBuilder::GetJunctionLanes(
+      MapData &data,
       JuncId junction_id,
       RoadId road_id,
       LaneId lane_id) {
     std::vector<std::pair<RoadId, LaneId>> result;
 
     // get the junction
-    Junction *junction = _map_data.GetJunction(junction_id);
+    Junction *junction = data.GetJunction(junction_id);
     if (junction == nullptr) {
       return result;
     }
@@ -734,53 +1005,63 @@ namespace road {
   void MapBuilder::CreatePointersBetweenRoadSegments(void) {
     // process each lane to define its nexts
     for (auto &road : _map_data._roads) {
-      for (auto &section : road.second._lane_sections) {
-        for (auto &lane : section.second._lanes) {
+      LinkRoadLanes(_map_data, road.second);
+    }
 
-          // assign the next lane pointers
-          lane.second._next_lanes = GetLaneNext(road.first, section.second._id, lane.first);
+    // process each road to define its next and previous roads
+    for (auto &road : _map_data._roads) {
+      UpdateRoadNeighbours(road.second);
+    }
+  }
 
-          // add to each lane found, this as its predecessor
-          for (auto next_lane : lane.second._next_lanes) {
-            // add as previous
-            DEBUG_ASSERT(next_lane != nullptr);
-            next_lane->_prev_lanes.push_back(&lane.second);
-          }
+  void MapBuilder::LinkRoadLanes(MapData &data, Road &road) {
+    for (auto &section : road._lane_sections) {
+      for (auto &lane : section.second._lanes) {
 
+        // assign the next lane pointers
+        lane.second._next_lanes = GetLaneNext(data, road._id, section.second._id, lane.first);
+
+        // add to each lane found, this as its predecessor
+        for (auto next_lane : lane.second._next_lanes) {
+          // add as previous
+          DEBUG_ASSERT(next_lane != nullptr);
+          next_lane->_prev_lanes.push_back(&lane.second);
         }
+
       }
     }
+  }
 
-    // process each lane to define its nexts
-    for (auto &road : _map_data._roads) {
-      for (auto &section : road.second._lane_sections) {
-        for (auto &lane : section.second._lanes) {
-
-          // add next roads
-          for (auto next_lane : lane.second._next_lanes) {
-            DEBUG_ASSERT(next_lane != nullptr);
-            // avoid same road
-            if (next_lane->GetRoad() != &road.second) {
-              if (std::find(road.second._nexts.begin(), road.second._nexts.end(),
-                  next_lane->GetRoad()) == road.second._nexts.end()) {
-                road.second._nexts.push_back(next_lane->GetRoad());
-              }
+  void MapBuilder::UpdateRoadNeighbours(Road &road) {
+    road._nexts.clear();
+    road._prevs.clear();
+    for (auto &section : road._lane_sections) {
+      for (auto &lane : section.second._lanes) {
+
+        // add next roads
+        for (auto next_lane : lane.second._next_lanes) {
+          DEBUG_ASSERT(next_lane != nullptr);
+          // avoid same road
+          if (next_lane->GetRoad() != &road) {
+            if (std::find(road._nexts.begin(), road._nexts.end(),
+                next_lane->GetRoad()) == road._nexts.end()) {
+              road._nexts.push_back(next_lane->GetRoad());
             }
           }
+        }
 
-          // add prev roads
-          for (auto prev_lane : lane.second._prev_lanes) {
-            DEBUG_ASSERT(prev_lane != nullptr);
-            // avoid same road
-            if (prev_lane->GetRoad() != &road.second) {
-              if (std::find(road.second._prevs.begin(), road.second._prevs.end(),
-                  prev_lane->GetRoad()) == road.second._prevs.end()) {
-                road.second._prevs.push_back(prev_lane->GetRoad());
-              }
+        // add prev roads
+        for (auto prev_lane : lane.second._prev_lanes) {
+          DEBUG_ASSERT(prev_lane != nullptr);
+          // avoid same road
+          if (prev_lane->GetRoad() != &road) {
+            if (std::find(road._prevs.begin(), road._prevs.end(),
+                prev_lane->GetRoad()) == road._prevs.end()) {
+              road._prevs.push_back(prev_lane->GetRoad());
             }
           }
-
         }
+
       }
     }
   }
@@ -804,16 +1085,7 @@ namespace road {
     }
 
     for(auto& signal_pair : _temp_signal_container) {
-      auto& signal = signal_pair.second;
-      if (signal->_using_inertial_position) {
-        continue;
-      }
-      auto transform = ComputeSignalTransform(signal, _map_data);
-      if (SignalType::IsTrafficLight(signal->GetType())) {
-        transform.location = transform.location +
-            geom::Location(transform.GetForwardVector()*0.25);
-      }
-      signal->_transform = transform;
+      SolveSignalTransform(signal_pair.second, _map_data);
     }
 
     _map_data._signals = std::move(_temp_signal_container);
@@ -821,14 +1093,26 @@ namespace road {
     GenerateDefaultValiditiesForSignalReferences();
   }
 
-  void MapBuilder::SolveControllerAndJuntionReferences() {
-    for(const auto& junction : _map_data._junctions) {
+  void MapBuilder::SolveSignalTransform(std::unique_ptr<Signal> &signal, MapData &data) {
+    if (signal->_using_inertial_position) {
+      return;
+    }
+    auto transform = ComputeSignalTransform(signal, data);
+    if (SignalType::IsTrafficLight(signal->GetType())) {
+      transform.location = transform.location +
+          geom::Location(transform.GetForwardVector()*0.25);
+    }
+    signal->_transform = transform;
+  }
+
+  void MapBuilder::SolveControllerAndJuntionReferences(MapData &data) {
+    for(const auto& junction : data._junctions) {
       for(const auto& controller : junction.second._controllers) {
-        auto it = _map_data._controllers.find(controller);
-        DEBUG_ASSERT(it != _map_data._controllers.end());
+        auto it = data._controllers.find(controller);
+        DEBUG_ASSERT(it != data._controllers.end());
         it->second->_junctions.insert(junction.first);
         for(const auto & signal : it->second->_signals) {
-          auto signal_it = _map_data._signals.find(signal);
+          auto signal_it = data._signals.find(signal);
           signal_it->second->_controllers.insert(controller);
         }
       }
@@ -837,70 +1121,73 @@ namespace road {
 
   void MapBuilder::CreateJunctionBoundingBoxes(Map &map) {
     for (auto &junctionpair : map._data.GetJunctions()) {
-      auto* junction = map.GetJunction(junctionpair.first);
-      auto waypoints = map.GetJunctionWaypoints(junction->GetId(), Lane::LaneType::Any);
-      const int number_intervals = 10;
-
-      float minx = std::numeric_limits<float>::max();
-      float miny = std::numeric_limits<float>::max();
-      float minz = std::numeric_limits<float>::max();
-      float maxx = -std::numeric_limits<float>::max();
-      float maxy = -std::numeric_limits<float>::max();
-      float maxz = -std::numeric_limits<float>::max();
-
-      auto get_min_max = [&](geom::Location position) {
-        if (position.x < minx) {
-          minx = position.x;
-        }
-        if (position.y < miny) {
-          miny = position.y;
-        }
-        if (position.z < minz) {
-          minz = position.z;
-        }
+      CreateJunctionBoundingBox(map, junctionpair.second);
+    }
+  }
 
-        if (position.x > maxx) {
-          maxx = position.x;
-        }
-        if (position.y > maxy) {
-          maxy = position.y;
-        }
-        if (position.z > maxz) {
-          maxz = position.z;
-        }
-      };
+  void MapBuilder::CreateJunctionBoundingBox(Map &map, Junction &junction) {
+    auto waypoints = map.GetJunctionWaypoints(junction.GetId(), Lane::LaneType::Any);
+    const int number_intervals = 10;
 
-      for (auto &waypoint_p : waypoints) {
-        auto &waypoint_start = waypoint_p.first;
-        auto &waypoint_end = waypoint_p.second;
-        double interval = (waypoint_end.s - waypoint_start.s) / static_cast<double>(number_intervals);
-        auto next_wp = waypoint_end;
-        auto location = map.ComputeTransform(next_wp).location;
+    float minx = std::numeric_limits<float>::max();
+    float miny = std::numeric_limits<float>::max();
+    float minz = std::numeric_limits<float>::max();
+    float maxx = -std::numeric_limits<float>::max();
+    float maxy = -std::numeric_limits<float>::max();
+    float maxz = -std::numeric_limits<float>::max();
 
-        get_min_max(location);
+    auto get_min_max = [&](geom::Location position) {
+      if (position.x < minx) {
+        minx = position.x;
+      }
+      if (position.y < miny) {
+        miny = position.y;
+      }
+      if (position.z < minz) {
+        minz = position.z;
+      }
 
-        next_wp = waypoint_start;
-        location = map.ComputeTransform(next_wp).location;
+      if (position.x > maxx) {
+        maxx = position.x;
+      }
+      if (position.y > maxy) {
+        maxy = position.y;
+      }
+      if (position.z > maxz) {
+        maxz = position.z;
+      }
+    };
 
-        get_min_max(location);
+    for (auto &waypoint_p : waypoints) {
+      auto &waypoint_start = waypoint_p.first;
+      auto &waypoint_end = waypoint_p.second;
+      double interval = (waypoint_end.s - waypoint_start.s) / static_cast<double>(number_intervals);
+      auto next_wp = waypoint_end;
+      auto location = map.ComputeTransform(next_wp).location;
 
-        for (int i = 0; i < number_intervals; ++i) {
-          if (interval < std::numeric_limits<double>::epsilon())
-            break;
-          auto next = map.GetNext(next_wp, interval);
-          if(next.size()){
-            next_wp = next.back();
-          }
+      get_min_max(location);
+
+      next_wp = waypoint_start;
+      location = map.ComputeTransform(next_wp).location;
+
+      get_min_max(location);
 
-          location = map.ComputeTransform(next_wp).location;
-          get_min_max(location);
+      for (int i = 0; i < number_intervals; ++i) {
+        if (interval < std::numeric_limits<double>::epsilon())
+          break;
+        auto next = map.GetNext(next_wp, interval);
+        if(next.size()){
+          next_wp = next.back();
         }
-      }
-      carla::geom::Location location(0.5f * (maxx + minx), 0.5f * (maxy + miny), 0.5f * (maxz + minz));
-      carla::geom::Vector3D extent(0.5f * (maxx - minx), 0.5f * (maxy - miny), 0.5f * (maxz - minz));
 
-      junction->_bounding_box = carla::geom::BoundingBox(location, extent);
+        location = map.ComputeTransform(next_wp).location;
+        get_min_max(location);
+      }
     }
+    carla::geom::Location location(0.5f * (maxx + minx), 0.5f * (maxy + miny), 0.5f * (maxz + minz));
+    carla::geom::Vector3D extent(0.5f * (maxx - minx), 0.5f * (maxy - miny), 0.5f * (maxz - minz));
+
+    junction._bounding_box = carla::geom::BoundingBox(location, extent);
   }
 
 void MapBuilder::CreateController(
@@ -1038,48 +1325,51 @@ void MapBuilder::CreateController(
 
   void MapBuilder::CheckSignalsOnRoads(Map &map) {
     for (auto& signal_pair : map._data._signals) {
-      auto& signal = signal_pair.second;
-      auto signal_position = signal->GetTransform().location;
-      auto closest_waypoint_to_signal =
-          map.GetClosestWaypointOnRoad(signal_position);
-      // workarround to not move speed signals
-      if (signal->GetName().substr(0, 6) == "Speed_" ||
-          signal->GetName().substr(0, 6) == "speed_" ||
-          signal->GetName().find("Stencil_STOP") != std::string::npos ||
-          signal->_using_inertial_position) {
-        continue;
-      }
-      if(closest_waypoint_to_signal) {
-        auto distance_to_road =
+      CheckSignalOnRoads(map, *signal_pair.second);
+    }
+  }
+
+  void MapBuilder::CheckSignalOnRoads(Map &map, Signal &signal) {
+    auto signal_position = signal.GetTransform().location;
+    auto closest_waypoint_to_signal =
+        map.GetClosestWaypointOnRoad(signal_position);
+    // workarround to not move speed signals
+    if (signal.GetName().substr(0, 6) == "Speed_" ||
+        signal.GetName().substr(0, 6) == "speed_" ||
+        signal.GetName().find("Stencil_STOP") != std::string::npos ||
+        signal._using_inertial_position) {
+      return;
+    }
+    if(closest_waypoint_to_signal) {
+      auto distance_to_road =
+          (map.ComputeTransform(closest_waypoint_to_signal.get()).location -
+          signal_position).Length();
+      double lane_width = map.GetLaneWidth(closest_waypoint_to_signal.get());
+      int iter = 0;
+      int MaxIter = 10;
+      // Displaces signal until it finds a suitable spot
+      while(distance_to_road < lane_width * 0.5 && iter < MaxIter) {
+        if(iter == 0) {
+          log_warning("Traffic sign",
+              signal.GetSignalId(),
+              "overlaps a driving lane. Moving out of the road...");
+        }
+        geom::Vector3D displacement = 1.f*(signal.GetTransform().GetRightVector()) *
+            static_cast<float>(abs(lane_width))*0.5f;
+        signal_position += displacement;
+        closest_waypoint_to_signal =
+            map.GetClosestWaypointOnRoad(signal_position);
+        distance_to_road =
             (map.ComputeTransform(closest_waypoint_to_signal.get()).location -
             signal_position).Length();
-        double lane_width = map.GetLaneWidth(closest_waypoint_to_signal.get());
-        int iter = 0;
-        int MaxIter = 10;
-        // Displaces signal until it finds a suitable spot
-        while(distance_to_road < lane_width * 0.5 && iter < MaxIter) {
-          if(iter == 0) {
-            log_warning("Traffic sign",
-                signal->GetSignalId(),
-                "overlaps a driving lane. Moving out of the road...");
-          }
-          geom::Vector3D displacement = 1.f*(signal->GetTransform().GetRightVector()) *
-              static_cast<float>(abs(lane_width))*0.5f;
-          signal_position += displacement;
-          closest_waypoint_to_signal =
-              map.GetClosestWaypointOnRoad(signal_position);
-          distance_to_road =
-              (map.ComputeTransform(closest_waypoint_to_signal.get()).location -
-              signal_position).Length();
-          lane_width = map.GetLaneWidth(closest_waypoint_to_signal.get());
-          iter++;
-        }
-        if(iter == MaxIter) {
-          log_warning("Failed to find suitable place for signal.");
-        } else {
-          // Only perform the displacement if a good location has been found
-          signal->_transform.location = signal_position;
-        }
+        lane_width = map.GetLaneWidth(closest_waypoint_to_signal.get());
+        iter++;
+      }
+      if(iter == MaxIter) {
+        log_warning("Failed to find suitable place for signal.");
+      } else {
+        // Only perform the displacement if a good location has been found
+        signal._transform.location = signal_position;
       }
     }
   }
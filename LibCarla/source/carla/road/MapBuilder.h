@@ -7,12 +7,14 @@
 #pragma once
 
 #include "carla/road/Map.h"
+#include "carla/road/MapChange.h"
 #include "carla/road/element/RoadInfoCrosswalk.h"
 #include "carla/road/element/RoadInfoSignal.h"
 
 #include <boost/optional.hpp>
 
 #include <map>
+#include <set>
 
 namespace carla {
 namespace road {
@@ -22,6 +24,17 @@ namespace road {
 
     boost::optional<Map> Build();
 
+    /// Apply the roads, junctions, signals and controllers added to this
+    /// builder on top of @a map, replacing the elements with the same id, and
+    /// remove the roads, junctions and signals listed in @a removed. The
+    /// signals defined in a replaced road are removed unless defined again.
+    ///
+    /// Only the lane links, rtree segments and junction bounding boxes of the
+    /// affected roads are recomputed. Returns the identifiers of every road,
+    /// junction and signal that changed. The builder must not be reused
+    /// afterwards.
+    MapChange ApplyTo(Map &map, const MapChange &removed = MapChange{});
+
     // called from road parser
     carla::road::Road *AddRoad(
         const RoadId road_id,
@@ -369,16 +382,30 @@ namespace road {
     /// Create the pointers between RoadSegments based on the ids.
     void CreatePointersBetweenRoadSegments();
 
+    /// Assign the next lanes of each lane of @a road, and add the lane as
+    /// previous lane of each of them.
+    void LinkRoadLanes(MapData &data, Road &road);
+
+    /// Recompute the next and previous roads of @a road from its lanes.
+    void UpdateRoadNeighbours(Road &road);
+
+    /// Move the temporary road and lane infos to their roads and lanes.
+    void SolveRoadAndLaneInfo();
+
     /// Create the bounding boxes of each junction
     void CreateJunctionBoundingBoxes(Map &map);
 
+    void CreateJunctionBoundingBox(Map &map, Junction &junction);
+
     geom::Transform ComputeSignalTransform(std::unique_ptr<Signal> &signal,  MapData &data);
 
+    void SolveSignalTransform(std::unique_ptr<Signal> &signal, MapData &data);
+
     /// Solves the signal references in the road
     void SolveSignalReferencesAndTransforms();
 
     /// Solve the references between Controllers and Juntions
-    void SolveControllerAndJuntionReferences();
+    void SolveControllerAndJuntionReferences(MapData &data);
 
     /// Compute the conflicts of the roads (intersecting roads)
     void ComputeJunctionRoadConflicts(Map &map);
@@ -393,17 +420,25 @@ namespace road {
     /// Checks signals overlapping driving lanes and emits a warning
     void CheckSignalsOnRoads(Map &map);
 
+    void CheckSignalOnRoads(Map &map, Signal &signal);
+
     /// Return the pointer to a lane object.
-    Lane *GetEdgeLanePointer(RoadId road_id, bool from_start, LaneId lane_id);
+    Lane *GetEdgeLanePointer(
+        MapData &data,
+        RoadId road_id,
+        bool from_start,
+        LaneId lane_id);
 
     /// Return a list of pointers to all lanes from a lane (using road and
     /// junction info).
     std::vector<Lane *> GetLaneNext(
+        MapData &data,
         RoadId road_id,
         SectionId section_id,
         LaneId lane_id);
 
     std::vector<std::pair<RoadId, LaneId>> GetJunctionLanes(
+        MapData &data,
         JuncId junction_id,
         RoadId road_id,
         LaneId lane_id);
@@ -0,0 +1,32 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/road/RoadTypes.h"
+
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  /// Identifiers of the roads, junctions and signals added, replaced or
+  /// removed by an incremental update of a Map.
+  struct MapChange {
+
+    std::vector<RoadId> roads;
+
+    std::vector<JuncId> junctions;
+
+    std::vector<SignId> signals;
+
+    bool empty() const {
+      return roads.empty() && junctions.empty() && signals.empty();
+    }
+  };
+
+} // namespace road
+} // namespace carla
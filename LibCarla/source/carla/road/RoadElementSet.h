@@ -82,6 +82,13 @@ namespace road {
       return _vec.end();
     }
 
+    /// Remove the elements that satisfy @a pred, keeping the order of the
+    /// rest.
+    template <typename PredT>
+    void RemoveIf(PredT &&pred) {
+      _vec.erase(std::remove_if(_vec.begin(), _vec.end(), pred), _vec.end());
+    }
+
   private:
 
     static key_type GetDistance(const key_type key) {
@@ -0,0 +1,450 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/RoutePlanner.h"
+
+#include "carla/Debug.h"
+#include "carla/ThreadGroup.h"
+#include "carla/geom/Math.h"
+#include "carla/road/Map.h"
+#include "carla/road/element/LaneMarking.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <thread>
+
+namespace carla {
+namespace road {
+
+  using namespace carla::road::element;
+
+  /// Keep the generated waypoints slightly inside the lane section.
+  static constexpr double EPSILON = 1e-6;
+
+  /// Distance between the points at which the lane markings are checked for
+  /// possible lane changes.
+  static constexpr double LANE_CHANGE_SAMPLING = 2.0;
+
+  /// Maximum deviation between the lanes at both sides of a junction to
+  /// consider the turn decision as going straight, 35 degrees.
+  static constexpr double TURN_THRESHOLD = 35.0 * geom::Math::Pi<double>() / 180.0;
+
+  static bool IsDriving(const Lane &lane) {
+    return lane.GetId() != 0 &&
+        (static_cast<int32_t>(lane.GetType()) & static_cast<int32_t>(Lane::LaneType::Driving)) > 0;
+  }
+
+  static bool AllowsLaneChange(
+      const RoadInfoMarkRecord *record,
+      LaneMarking::LaneChange lane_change) {
+    if (record == nullptr) {
+      return false;
+    }
+    const LaneMarking marking(*record);
+    return (static_cast<uint8_t>(marking.lane_change) & static_cast<uint8_t>(lane_change)) > 0u;
+  }
+
+  static double CrossZ(const geom::Vector3D &a, const geom::Vector3D &b) {
+    return static_cast<double>(a.x) * static_cast<double>(b.y) -
+        static_cast<double>(a.y) * static_cast<double>(b.x);
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner: Graph construction ---------------------------------------
+  // ===========================================================================
+
+  RoutePlanner::RoutePlanner(const Map &map, const double lane_change_cost)
+    : _map(map),
+      _graph(map.GetLaneGraph()),
+      _lane_change_cost(lane_change_cost) {
+    _lanes.resize(_graph.size());
+    for (LaneIndex index = 0u; index < _graph.size(); ++index) {
+      const auto &lane = _graph.GetLane(index);
+      if (!IsDriving(lane)) {
+        continue;
+      }
+      auto &data = _lanes[index];
+      data.is_driving = true;
+      data.is_junction = lane.GetRoad()->IsJunction();
+
+      const auto &node = _graph.GetNode(index);
+      const auto start = _map.ComputeTransform(MakeWaypoint(index, 0.0));
+      const auto end = _map.ComputeTransform(MakeWaypoint(index, node.length));
+      data.start_location = start.location;
+      data.end_location = end.location;
+      data.exit_vector = end.GetForwardVector();
+    }
+
+    // Lane changes are checked in a second pass, once we know which lanes are
+    // drivable.
+    for (LaneIndex index = 0u; index < _graph.size(); ++index) {
+      auto &data = _lanes[index];
+      if (!data.is_driving || data.is_junction) {
+        continue;
+      }
+      const auto &node = _graph.GetNode(index);
+      bool left_found = false;
+      bool right_found = false;
+      auto add_lane_change = [&](boost::optional<Waypoint> neighbour, EdgeType type, double progress) {
+        if (!neighbour.has_value() || (neighbour->lane_id > 0) != (node.lane_id > 0)) {
+          return false;
+        }
+        const auto neighbour_index = _graph.GetIndex(_map.GetLane(*neighbour));
+        if (neighbour_index == LaneGraph::InvalidIndex || !_lanes[neighbour_index].is_driving) {
+          return false;
+        }
+        data.lane_changes.emplace_back(LaneChange{neighbour_index, type, progress});
+        return true;
+      };
+      for (double progress = 0.0; progress < node.length; progress += LANE_CHANGE_SAMPLING) {
+        const auto waypoint = MakeWaypoint(index, progress);
+        const auto records = _map.GetMarkRecord(waypoint);
+        if (!right_found && AllowsLaneChange(records.first, LaneMarking::LaneChange::Right)) {
+          right_found = add_lane_change(_map.GetRight(waypoint), EdgeType::ChangeRight, progress);
+        }
+        if (!left_found && AllowsLaneChange(records.second, LaneMarking::LaneChange::Left)) {
+          left_found = add_lane_change(_map.GetLeft(waypoint), EdgeType::ChangeLeft, progress);
+        }
+        if (left_found && right_found) {
+          break;
+        }
+      }
+    }
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner: Path search ----------------------------------------------
+  // ===========================================================================
+
+  double RoutePlanner::GetProgress(const LaneIndex lane, const double s) const {
+    const auto &node = _graph.GetNode(lane);
+    const double progress = node.lane_id <= 0 ? s - node.s : node.s + node.length - s;
+    return std::max(0.0, std::min(progress, node.length));
+  }
+
+  RoutePlanner::Waypoint RoutePlanner::MakeWaypoint(const LaneIndex lane, double progress) const {
+    const auto &node = _graph.GetNode(lane);
+    progress = std::max(EPSILON, std::min(progress, node.length - EPSILON));
+    const double s = node.lane_id <= 0 ? node.s + progress : node.s + node.length - progress;
+    return Waypoint{node.road_id, node.section_id, node.lane_id, s};
+  }
+
+  std::vector<RoutePlanner::Step> RoutePlanner::FindPath(
+      const Waypoint &origin,
+      const Waypoint &destination) const {
+    const auto origin_lane = _graph.GetIndex(_map.GetLane(origin));
+    const auto destination_lane = _graph.GetIndex(_map.GetLane(destination));
+    if (origin_lane == LaneGraph::InvalidIndex ||
+        destination_lane == LaneGraph::InvalidIndex ||
+        !_lanes[origin_lane].is_driving ||
+        !_lanes[destination_lane].is_driving) {
+      return {};
+    }
+    const double origin_progress = GetProgress(origin_lane, origin.s);
+    const double destination_progress = GetProgress(destination_lane, destination.s);
+    const geom::Location destination_location = _map.ComputeTransform(destination).location;
+
+    // A lane may be reached at different points, each search label is the
+    // cost g of entering a lane at a given progress. A label is only useful if
+    // no other label of the same lane enters it earlier and at a lower cost to
+    // the end of the lane, g - entry, since it can reach less of the lane and
+    // costs more to leave it.
+    struct Label {
+      LaneIndex lane;
+      double g;
+      double entry;
+      size_t parent;
+      EdgeType edge;
+      bool closed;
+    };
+
+    struct QueueItem {
+      double f;
+      size_t label;
+      bool operator>(const QueueItem &rhs) const {
+        return f > rhs.f;
+      }
+    };
+
+    // Two extra virtual labels, one for the destination and one for the
+    // origin. The origin is not a label of its lane so a route can leave the
+    // origin lane and come back to it.
+    constexpr size_t goal = std::numeric_limits<size_t>::max();
+    constexpr size_t start = goal - 1u;
+
+    std::vector<Label> labels;
+    std::vector<std::vector<size_t>> lane_labels(_graph.size());
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+    double goal_cost = std::numeric_limits<double>::infinity();
+    size_t goal_parent = goal;
+
+    // Straight-line distance from the entry point to the destination, the
+    // distance already travelled along the lane is subtracted to keep the
+    // heuristic admissible for lanes entered through a lane change. It is not
+    // consistent across lane changes, a better label found later is expanded
+    // again even if the lane has already been expanded.
+    auto heuristic = [&](LaneIndex lane, double entry) {
+      const auto distance = geom::Math::Distance(_lanes[lane].start_location, destination_location);
+      return std::max(0.0, static_cast<double>(distance) - entry);
+    };
+
+    auto relax = [&](size_t from, LaneIndex to, EdgeType edge, double g, double entry) {
+      auto &list = lane_labels[to];
+      const double cost_to_end = g - entry;
+      for (auto it = list.begin(); it != list.end();) {
+        auto &label = labels[*it];
+        const double label_cost_to_end = label.g - label.entry;
+        if (label.entry <= entry && label_cost_to_end <= cost_to_end) {
+          return;
+        }
+        if (entry <= label.entry && cost_to_end <= label_cost_to_end) {
+          // Dominated, skip it if still in the queue.
+          label.closed = true;
+          it = list.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      list.emplace_back(labels.size());
+      labels.emplace_back(Label{to, g, entry, from, edge, false});
+      open.push(QueueItem{g + heuristic(to, entry), list.back()});
+    };
+
+    auto expand = [&](size_t id, LaneIndex lane, double entry, double g) {
+      if (lane == destination_lane && destination_progress >= entry) {
+        const double cost = g + destination_progress - entry;
+        if (cost < goal_cost) {
+          goal_cost = cost;
+          goal_parent = id;
+          open.push(QueueItem{cost, goal});
+        }
+      }
+      const double length = _graph.GetNode(lane).length;
+      for (const auto successor : _graph.GetSuccessors(lane)) {
+        if (_lanes[successor].is_driving) {
+          relax(id, successor, EdgeType::Follow, g + length - entry, 0.0);
+        }
+      }
+      for (const auto &change : _lanes[lane].lane_changes) {
+        const double progress = std::max(entry, change.progress);
+        if (progress < length) {
+          relax(id, change.lane, change.type, g + progress - entry + _lane_change_cost, progress);
+        }
+      }
+    };
+
+    expand(start, origin_lane, origin_progress, 0.0);
+    while (!open.empty()) {
+      const auto item = open.top();
+      open.pop();
+      if (item.label == goal) {
+        break;
+      }
+      const Label label = labels[item.label];
+      if (label.closed) {
+        continue;
+      }
+      labels[item.label].closed = true;
+      expand(item.label, label.lane, label.entry, label.g);
+    }
+
+    if (goal_parent == goal) {
+      return {};
+    }
+
+    std::vector<Step> path;
+    for (auto current = goal_parent; current != start; current = labels[current].parent) {
+      const auto &label = labels[current];
+      path.emplace_back(Step{label.lane, label.edge, label.entry});
+    }
+    path.emplace_back(Step{origin_lane, EdgeType::Origin, origin_progress});
+    std::reverse(path.begin(), path.end());
+    return path;
+  }
+
+#ifdef LIBCARLA_WITH_GTEST
+  std::vector<std::pair<LaneGraph::LaneIndex, double>> RoutePlanner::GetLaneChanges(
+      const LaneIndex lane) const {
+    std::vector<std::pair<LaneIndex, double>> result;
+    for (const auto &change : _lanes[lane].lane_changes) {
+      result.emplace_back(change.lane, change.progress);
+    }
+    return result;
+  }
+
+  double RoutePlanner::GetPathCost(const Waypoint &origin, const Waypoint &destination) const {
+    const auto path = FindPath(origin, destination);
+    if (path.empty()) {
+      return std::numeric_limits<double>::infinity();
+    }
+    double cost = 0.0;
+    for (size_t i = 0u; i < path.size(); ++i) {
+      const auto &step = path[i];
+      const double leave =
+          (i + 1u) == path.size() ? GetProgress(step.lane, destination.s) :
+          path[i + 1u].edge == EdgeType::Follow ? _graph.GetNode(step.lane).length :
+          path[i + 1u].entry;
+      cost += leave - step.entry;
+      if (step.edge == EdgeType::ChangeLeft || step.edge == EdgeType::ChangeRight) {
+        cost += _lane_change_cost;
+      }
+    }
+    return cost;
+  }
+#endif // LIBCARLA_WITH_GTEST
+
+  RoadOption RoutePlanner::GetTurnDecision(
+      const LaneIndex from,
+      const std::vector<Step> &path,
+      const size_t index) const {
+    // Skip to the last lane of the junction to compare the headings at both
+    // sides of it.
+    size_t last = index;
+    while ((last + 1u) < path.size() &&
+        path[last + 1u].edge == EdgeType::Follow &&
+        _lanes[path[last + 1u].lane].is_junction) {
+      ++last;
+    }
+    const auto &cv = _lanes[from].exit_vector;
+    const auto &nv = _lanes[path[last].lane].exit_vector;
+
+    std::vector<double> cross_list;
+    for (const auto sibling : _graph.GetSuccessors(from)) {
+      if (sibling != path[index].lane && _lanes[sibling].is_driving) {
+        const auto &data = _lanes[sibling];
+        cross_list.emplace_back(CrossZ(cv, data.end_location - data.start_location));
+      }
+    }
+    if (cross_list.empty()) {
+      cross_list.emplace_back(0.0);
+    }
+    const auto minmax = std::minmax_element(cross_list.begin(), cross_list.end());
+
+    const double next_cross = CrossZ(cv, nv);
+    const double norm = static_cast<double>(cv.Length()) * static_cast<double>(nv.Length());
+    const double cosine = norm > 0.0 ? static_cast<double>(geom::Math::Dot(cv, nv)) / norm : 1.0;
+    const double deviation = std::acos(std::max(-1.0, std::min(cosine, 1.0)));
+
+    if (deviation < TURN_THRESHOLD) {
+      return RoadOption::Straight;
+    } else if (next_cross < *minmax.first) {
+      return RoadOption::Left;
+    } else if (next_cross > *minmax.second) {
+      return RoadOption::Right;
+    } else if (next_cross < 0.0) {
+      return RoadOption::Left;
+    } else if (next_cross > 0.0) {
+      return RoadOption::Right;
+    }
+    return RoadOption::Straight;
+  }
+
+  // ===========================================================================
+  // -- RoutePlanner: Route tracing --------------------------------------------
+  // ===========================================================================
+
+  RoutePlanner::Route RoutePlanner::TraceRoute(
+      const Waypoint &origin,
+      const Waypoint &destination,
+      const double sampling_resolution) const {
+    RELEASE_ASSERT(sampling_resolution > 0.0);
+    const auto path = FindPath(origin, destination);
+    Route result;
+    if (path.empty()) {
+      return result;
+    }
+
+    // Every lane of a junction takes the turn decision taken at its entrance.
+    std::vector<RoadOption> options(path.size(), RoadOption::LaneFollow);
+    for (size_t i = 1u; i < path.size(); ++i) {
+      const bool enters_junction =
+          path[i].edge == EdgeType::Follow &&
+          _lanes[path[i].lane].is_junction &&
+          !_lanes[path[i - 1u].lane].is_junction;
+      if (enters_junction) {
+        options[i] = GetTurnDecision(path[i - 1u].lane, path, i);
+      } else if (path[i].edge == EdgeType::Follow && _lanes[path[i].lane].is_junction) {
+        options[i] = options[i - 1u];
+      }
+    }
+
+    const double destination_progress = GetProgress(path.back().lane, destination.s);
+    for (size_t i = 0u; i < path.size(); ++i) {
+      const auto &step = path[i];
+      const bool is_last = (i + 1u) == path.size();
+      const double length = _graph.GetNode(step.lane).length;
+      // Where the route leaves this lane, either at its end, at the point of a
+      // lane change, or at the destination.
+      const double leave =
+          is_last ? destination_progress :
+          path[i + 1u].edge == EdgeType::Follow ? length :
+          path[i + 1u].entry;
+
+      double progress = step.entry;
+      double last_emitted = -1.0;
+      if (step.edge == EdgeType::ChangeLeft || step.edge == EdgeType::ChangeRight) {
+        const auto option = step.edge == EdgeType::ChangeLeft ?
+            RoadOption::ChangeLaneLeft :
+            RoadOption::ChangeLaneRight;
+        result.emplace_back(MakeWaypoint(path[i - 1u].lane, step.entry), option);
+        progress = std::min(step.entry + sampling_resolution, leave);
+        result.emplace_back(MakeWaypoint(step.lane, progress), option);
+        last_emitted = progress;
+        progress += sampling_resolution;
+      }
+      for (; progress < leave; progress += sampling_resolution) {
+        result.emplace_back(MakeWaypoint(step.lane, progress), options[i]);
+        last_emitted = progress;
+      }
+      if (is_last && (last_emitted < 0.0 || (leave - last_emitted) > EPSILON)) {
+        result.emplace_back(MakeWaypoint(step.lane, leave), options[i]);
+      }
+    }
+    return result;
+  }
+
+  RoutePlanner::Route RoutePlanner::TraceRoute(
+      const geom::Location &origin,
+      const geom::Location &destination,
+      const double sampling_resolution) const {
+    const auto origin_waypoint = _map.GetClosestWaypointOnRoad(origin);
+    const auto destination_waypoint = _map.GetClosestWaypointOnRoad(destination);
+    if (!origin_waypoint.has_value() || !destination_waypoint.has_value()) {
+      return {};
+    }
+    return TraceRoute(*origin_waypoint, *destination_waypoint, sampling_resolution);
+  }
+
+  std::vector<RoutePlanner::Route> RoutePlanner::TraceRoutes(
+      const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+      const double sampling_resolution,
+      size_t worker_threads) const {
+    std::vector<Route> result(queries.size());
+    if (worker_threads == 0u) {
+      worker_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    worker_threads = std::min(worker_threads, queries.size());
+    std::atomic_size_t next_query{0u};
+    auto worker = [&]() {
+      for (auto i = next_query++; i < queries.size(); i = next_query++) {
+        result[i] = TraceRoute(queries[i].first, queries[i].second, sampling_resolution);
+      }
+    };
+    ThreadGroup workers;
+    if (worker_threads > 1u) {
+      workers.CreateThreads(worker_threads - 1u, worker);
+    }
+    worker();
+    workers.JoinAll();
+    return result;
+  }
+
+} // namespace road
+} // namespace carla
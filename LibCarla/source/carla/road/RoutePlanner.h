@@ -0,0 +1,163 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/road/LaneGraph.h"
+#include "carla/road/element/Waypoint.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class Map;
+
+  /// Topological configuration when moving from one lane to the next, same
+  /// values as the RoadOption of the Python agents.
+  enum class RoadOption : int32_t {
+    Void            = -1,
+    Left            =  1,
+    Right           =  2,
+    Straight        =  3,
+    LaneFollow      =  4,
+    ChangeLaneLeft  =  5,
+    ChangeLaneRight =  6
+  };
+
+  /// Global route planner running A* over the lane graph of a road::Map.
+  ///
+  /// Nodes are the driving lanes of the map, edges connect each lane with its
+  /// successors and with the neighbour lanes it can change to according to
+  /// its lane markings. The graph is built once in the constructor; tracing
+  /// routes is read-only and can be done concurrently from several threads.
+  class RoutePlanner : private NonCopyable {
+  public:
+
+    using Waypoint = element::Waypoint;
+
+    using Route = std::vector<std::pair<Waypoint, RoadOption>>;
+
+    /// @a map must outlive the planner. @a lane_change_cost is the extra cost
+    /// in meters added to every lane change.
+    explicit RoutePlanner(const Map &map, double lane_change_cost = 0.0);
+
+    /// Return the list of waypoints separated by @a sampling_resolution and
+    /// the road option to follow at each of them to drive from @a origin to
+    /// @a destination. Returns an empty route if the destination cannot be
+    /// reached.
+    Route TraceRoute(
+        const Waypoint &origin,
+        const Waypoint &destination,
+        double sampling_resolution) const;
+
+    /// @copydoc TraceRoute
+    ///
+    /// The locations are projected to the closest driving lane.
+    Route TraceRoute(
+        const geom::Location &origin,
+        const geom::Location &destination,
+        double sampling_resolution) const;
+
+    /// Trace a route for each pair of (origin, destination) locations, in
+    /// parallel using @a worker_threads threads, or all available hardware
+    /// concurrency if zero.
+    std::vector<Route> TraceRoutes(
+        const std::vector<std::pair<geom::Location, geom::Location>> &queries,
+        double sampling_resolution,
+        size_t worker_threads = 0u) const;
+
+#ifdef LIBCARLA_WITH_GTEST
+    bool IsDrivingLane(LaneGraph::LaneIndex lane) const {
+      return _lanes[lane].is_driving;
+    }
+
+    /// Lanes reachable from @a lane with a lane change, and the progress along
+    /// @a lane from which the change is allowed.
+    std::vector<std::pair<LaneGraph::LaneIndex, double>> GetLaneChanges(
+        LaneGraph::LaneIndex lane) const;
+
+    double GetLaneProgress(LaneGraph::LaneIndex lane, double s) const {
+      return GetProgress(lane, s);
+    }
+
+    /// Cost of the path found from @a origin to @a destination, infinity if
+    /// there is none.
+    double GetPathCost(const Waypoint &origin, const Waypoint &destination) const;
+#endif // LIBCARLA_WITH_GTEST
+
+  private:
+
+    using LaneIndex = LaneGraph::LaneIndex;
+
+    enum class EdgeType : uint8_t {
+      Origin,
+      Follow,
+      ChangeLeft,
+      ChangeRight
+    };
+
+    struct LaneChange {
+
+      LaneIndex lane;
+
+      EdgeType type;
+
+      /// Progress along the lane from which the change is allowed.
+      double progress;
+    };
+
+    struct LaneData {
+
+      bool is_driving = false;
+
+      bool is_junction = false;
+
+      geom::Location start_location;
+
+      geom::Location end_location;
+
+      geom::Vector3D exit_vector;
+
+      std::vector<LaneChange> lane_changes;
+    };
+
+    struct Step {
+
+      LaneIndex lane;
+
+      EdgeType edge;
+
+      /// Progress along the lane where the route enters the lane.
+      double entry;
+    };
+
+    std::vector<Step> FindPath(
+        const Waypoint &origin,
+        const Waypoint &destination) const;
+
+    RoadOption GetTurnDecision(LaneIndex from, const std::vector<Step> &path, size_t index) const;
+
+    double GetProgress(LaneIndex lane, double s) const;
+
+    Waypoint MakeWaypoint(LaneIndex lane, double progress) const;
+
+    const Map &_map;
+
+    const LaneGraph &_graph;
+
+    const double _lane_change_cost;
+
+    std::vector<LaneData> _lanes;
+  };
+
+} // namespace road
+} // namespace carla
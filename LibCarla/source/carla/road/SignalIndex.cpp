@@ -0,0 +1,126 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/road/SignalIndex.h"
+
+#include "carla/geom/Math.h"
+#include "carla/road/Lane.h"
+#include "carla/road/MapData.h"
+#include "carla/road/Road.h"
+#include "carla/road/Signal.h"
+#include "carla/road/element/RoadInfoSignal.h"
+
+#include <boost/geometry/geometries/box.hpp>
+
+namespace carla {
+namespace road {
+
+  /// Signals this far beyond the ends of a lane section are indexed too, to
+  /// account for rounding errors in the distances of the queries.
+  static constexpr double LANE_RANGE_TOLERANCE = 1.0;
+
+  static bool AffectsLane(const element::RoadInfoSignal &signal, const LaneId lane_id) {
+    for (const auto &validity : signal.GetValidities()) {
+      if (lane_id >= validity._from_lane && lane_id <= validity._to_lane) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  SignalIndex::SignalIndex(const MapData &data, const LaneGraph &graph) {
+    // Same order as visiting the roads.
+    for (const auto &road_pair : data.GetRoads()) {
+      for (const auto *signal : road_pair.second.GetInfos<element::RoadInfoSignal>()) {
+        _references.emplace_back(signal);
+      }
+    }
+
+    // Signals affecting each lane, road infos are already sorted by s.
+    _lane_offsets.reserve(graph.size() + 1u);
+    _lane_offsets.emplace_back(0u);
+    for (LaneIndex index = 0u; index < graph.size(); ++index) {
+      const auto &node = graph.GetNode(index);
+      const Road *road = graph.GetLane(index).GetRoad();
+      DEBUG_ASSERT(road != nullptr);
+      const double min_s = node.s - LANE_RANGE_TOLERANCE;
+      const double max_s = node.s + node.length + LANE_RANGE_TOLERANCE;
+      for (const auto *signal : road->GetInfosInRange<element::RoadInfoSignal>(min_s, max_s)) {
+        if (AffectsLane(*signal, node.lane_id)) {
+          _lane_signals.emplace_back(LaneSignal{signal->GetDistance(), signal});
+        }
+      }
+      _lane_offsets.emplace_back(static_cast<uint32_t>(_lane_signals.size()));
+    }
+    _lane_signals.shrink_to_fit();
+
+    _references_by_id.resize(_references.size());
+    for (auto i = 0u; i < _references.size(); ++i) {
+      _references_by_id[i] = i;
+    }
+    std::stable_sort(_references_by_id.begin(), _references_by_id.end(), [this](uint32_t a, uint32_t b) {
+      return _references[a]->GetSignalId() < _references[b]->GetSignalId();
+    });
+
+    using Rtree = geom::PointCloudRtree<SignalReference>;
+    std::vector<Rtree::TreeElement> rtree_elements;
+    rtree_elements.reserve(_references.size());
+    for (const auto *reference : _references) {
+      const Signal *signal = reference->GetSignal();
+      if (signal != nullptr) {
+        const auto location = signal->GetTransform().location;
+        rtree_elements.emplace_back(Rtree::BPoint(location.x, location.y, location.z), reference);
+      }
+    }
+    _rtree.InsertElements(rtree_elements);
+  }
+
+  std::vector<SignalIndex::SignalReference> SignalIndex::GetSignalReferencesById(
+      const SignId &signal_id) const {
+    auto begin = std::lower_bound(
+        _references_by_id.begin(),
+        _references_by_id.end(),
+        signal_id,
+        [this](uint32_t index, const SignId &id) {
+          return _references[index]->GetSignalId() < id;
+        });
+    auto end = std::upper_bound(
+        begin,
+        _references_by_id.end(),
+        signal_id,
+        [this](const SignId &id, uint32_t index) {
+          return id < _references[index]->GetSignalId();
+        });
+    std::vector<SignalReference> result;
+    for (auto it = begin; it != end; ++it) {
+      result.emplace_back(_references[*it]);
+    }
+    return result;
+  }
+
+  std::vector<SignalIndex::SignalReference> SignalIndex::GetSignalReferencesInRadius(
+      const geom::Location &location,
+      const double radius) const {
+    using Rtree = geom::PointCloudRtree<SignalReference>;
+    const float r = static_cast<float>(radius);
+    const boost::geometry::model::box<Rtree::BPoint> box(
+        Rtree::BPoint(location.x - r, location.y - r, location.z - r),
+        Rtree::BPoint(location.x + r, location.y + r, location.z + r));
+    std::vector<SignalReference> result;
+    for (const auto &element : _rtree.GetIntersections(box)) {
+      const geom::Location position(
+          element.first.get<0>(),
+          element.first.get<1>(),
+          element.first.get<2>());
+      if (geom::Math::Distance(position, location) <= r) {
+        result.emplace_back(element.second);
+      }
+    }
+    return result;
+  }
+
+} // namespace road
+} // namespace carla
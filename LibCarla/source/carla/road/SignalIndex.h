@@ -0,0 +1,127 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/ListView.h"
+#include "carla/NonCopyable.h"
+#include "carla/geom/Location.h"
+#include "carla/geom/Rtree.h"
+#include "carla/road/LaneGraph.h"
+#include "carla/road/RoadTypes.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace road {
+
+  class MapData;
+
+namespace element { class RoadInfoSignal; }
+
+  /// Read-only index of the signal references of a MapData.
+  ///
+  /// For each lane of the LaneGraph the references affecting the lane, as
+  /// given by their validities, are stored sorted by s, so the signals along a
+  /// lane are found with a binary search. Signal positions are also indexed
+  /// in an R-tree for spatial queries.
+  class SignalIndex : private MovableNonCopyable {
+  public:
+
+    using LaneIndex = LaneGraph::LaneIndex;
+
+    using SignalReference = const element::RoadInfoSignal *;
+
+    struct LaneSignal {
+
+      /// Distance along the road of the signal reference.
+      double s;
+
+      SignalReference signal;
+    };
+
+    using LaneSignalList = ListView<std::vector<LaneSignal>::const_iterator>;
+
+    SignalIndex() = default;
+
+    SignalIndex(const MapData &data, const LaneGraph &graph);
+
+    /// Signal references affecting the lane @a index sorted by s. Includes
+    /// those placed slightly beyond the ends of the lane section.
+    LaneSignalList GetLaneSignals(LaneIndex index) const {
+      return MakeListView(
+          _lane_signals.begin() + _lane_offsets[index],
+          _lane_signals.begin() + _lane_offsets[index + 1u]);
+    }
+
+    /// Call @a callback for each signal reference affecting the lane @a index
+    /// with s in the closed range between @a from_s and @a to_s, ordered from
+    /// @a from_s to @a to_s.
+    template <typename FuncT>
+    void ForEachLaneSignalInRange(
+        LaneIndex index,
+        double from_s,
+        double to_s,
+        FuncT &&callback) const;
+
+    /// All the signal references of the map, in the same order as they are
+    /// found visiting the roads of the map.
+    const std::vector<SignalReference> &GetAllSignalReferences() const {
+      return _references;
+    }
+
+    /// Signal references to the signal @a signal_id, in the same order as in
+    /// GetAllSignalReferences.
+    std::vector<SignalReference> GetSignalReferencesById(const SignId &signal_id) const;
+
+    /// Signal references whose signal is within @a radius of @a location.
+    std::vector<SignalReference> GetSignalReferencesInRadius(
+        const geom::Location &location,
+        double radius) const;
+
+  private:
+
+    /// Signals of lane i are in the range [offsets[i], offsets[i+1]).
+    std::vector<uint32_t> _lane_offsets;
+
+    std::vector<LaneSignal> _lane_signals;
+
+    std::vector<SignalReference> _references;
+
+    /// Indices into _references sorted by signal id.
+    std::vector<uint32_t> _references_by_id;
+
+    geom::PointCloudRtree<SignalReference> _rtree;
+  };
+
+  template <typename FuncT>
+  void SignalIndex::ForEachLaneSignalInRange(
+      const LaneIndex index,
+      const double from_s,
+      const double to_s,
+      FuncT &&callback) const {
+    const auto signals = GetLaneSignals(index);
+    const double min_s = std::min(from_s, to_s);
+    const double max_s = std::max(from_s, to_s);
+    auto begin = std::lower_bound(signals.begin(), signals.end(), min_s,
+        [](const LaneSignal &signal, double s) { return signal.s < s; });
+    auto end = std::upper_bound(begin, signals.end(), max_s,
+        [](double s, const LaneSignal &signal) { return s < signal.s; });
+    if (from_s < to_s) {
+      for (auto it = begin; it != end; ++it) {
+        callback(it->signal);
+      }
+    } else {
+      for (auto it = end; it != begin; --it) {
+        callback(std::prev(it)->signal);
+      }
+    }
+  }
+
+} // namespace road
+} // namespace carla
@@ -7,6 +7,7 @@
 #include "carla/road/element/LaneCrossingCalculator.h"
 #include "carla/road/element/LaneMarking.h"
 
+#include "carla/Debug.h"
 #include "carla/geom/Location.h"
 #include "carla/road/Map.h"
 
@@ -53,16 +54,33 @@ namespace element {
     return {};
   }
 
-  static bool IsOffRoad(const Map &map, const geom::Location &location) {
-    return !map.GetWaypoint(location, FLAGS).has_value();
+  LaneCrossingCalculator::Position LaneCrossingCalculator::Locate(
+      const Map &map,
+      const geom::Location &location) {
+    // Same as Map::GetWaypoint but keeping the closest waypoint of off-road
+    // locations, so a single R-tree query is needed.
+    Position result;
+    result.location = location;
+    result.waypoint = map.GetClosestWaypointOnRoad(location, FLAGS);
+    if (result.waypoint.has_value()) {
+      result.is_offroad = !map.IsWithinLane(*result.waypoint, location);
+    }
+    return result;
   }
 
   std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
       const Map &map,
       const geom::Location &origin,
       const geom::Location &destination) {
-    auto w0 = map.GetClosestWaypointOnRoad(origin, FLAGS);
-    auto w1 = map.GetClosestWaypointOnRoad(destination, FLAGS);
+    return Calculate(map, Locate(map, origin), Locate(map, destination));
+  }
+
+  std::vector<LaneMarking> LaneCrossingCalculator::Calculate(
+      const Map &map,
+      const Position &origin,
+      const Position &destination) {
+    const auto &w0 = origin.waypoint;
+    const auto &w1 = destination.waypoint;
 
     if (!w0.has_value() || !w1.has_value()) {
       return {};
@@ -77,8 +95,8 @@ namespace element {
       return {};
     }
 
-    const auto w0_is_offroad = IsOffRoad(map, origin);
-    const auto w1_is_offroad = IsOffRoad(map, destination);
+    const auto w0_is_offroad = origin.is_offroad;
+    const auto w1_is_offroad = destination.is_offroad;
 
     if (w0_is_offroad && w1_is_offroad) {
       // outside the road
@@ -92,7 +110,7 @@ namespace element {
 
     const auto transform = map.ComputeTransform(*w0);
     geom::Vector3D orig_vec = transform.GetForwardVector();
-    geom::Vector3D dest_vec = (destination - origin).MakeSafeUnitVector(2 * std::numeric_limits<float>::epsilon());
+    geom::Vector3D dest_vec = (destination.location - origin.location).MakeSafeUnitVector(2 * std::numeric_limits<float>::epsilon());
 
     // cross product
     const auto dest_is_at_right =
@@ -106,6 +124,21 @@ namespace element {
         dest_is_at_right);
   }
 
+  std::vector<std::vector<LaneMarking>> LaneCrossingCalculator::Calculate(
+      const Map &map,
+      std::vector<Position> &positions,
+      const std::vector<geom::Location> &destinations) {
+    DEBUG_ASSERT(positions.size() == destinations.size());
+    std::vector<std::vector<LaneMarking>> result;
+    result.reserve(positions.size());
+    for (auto i = 0u; i < positions.size(); ++i) {
+      auto destination = Locate(map, destinations[i]);
+      result.emplace_back(Calculate(map, positions[i], destination));
+      positions[i] = std::move(destination);
+    }
+    return result;
+  }
+
 } // namespace element
 } // namespace road
 } // namespace carla
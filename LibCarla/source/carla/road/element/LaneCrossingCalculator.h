@@ -6,12 +6,15 @@
 
 #pragma once
 
+#include "carla/geom/Location.h"
 #include "carla/road/element/LaneMarking.h"
+#include "carla/road/element/Waypoint.h"
+
+#include <boost/optional.hpp>
 
 #include <vector>
 
 namespace carla {
-namespace geom { class Location; }
 namespace road {
 
   class Map;
@@ -21,10 +24,39 @@ namespace element {
   class LaneCrossingCalculator {
   public:
 
+    /// A location resolved against the lanes of the map. Resolving a location
+    /// requires querying the R-tree of the map, a position can be kept and
+    /// reused as origin of the next calculation.
+    struct Position {
+
+      geom::Location location;
+
+      /// Closest waypoint on a lane with road marks.
+      boost::optional<Waypoint> waypoint;
+
+      bool is_offroad = true;
+    };
+
+    static Position Locate(const Map &map, const geom::Location &location);
+
     static std::vector<LaneMarking> Calculate(
         const Map &map,
         const geom::Location &origin,
         const geom::Location &destination);
+
+    static std::vector<LaneMarking> Calculate(
+        const Map &map,
+        const Position &origin,
+        const Position &destination);
+
+    /// Calculate the lane markings crossed moving from each of the
+    /// @a positions to the location at the same index in @a destinations.
+    /// On return @a positions hold the resolved destinations, so only one
+    /// location is resolved per pair when called every tick.
+    static std::vector<std::vector<LaneMarking>> Calculate(
+        const Map &map,
+        std::vector<Position> &positions,
+        const std::vector<geom::Location> &destinations);
   };
 
 } // namespace element
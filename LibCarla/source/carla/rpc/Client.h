@@ -38,6 +38,15 @@ namespace rpc {
       _client.async_call(function, Metadata::MakeAsync(), std::forward<Args>(args)...);
     }
 
+    /// Send the request without waiting for the response, unlike async_call
+    /// the server does reply and the response is delivered through the
+    /// returned future. Several requests can be in flight at once on the same
+    /// connection, the responses are matched by message id.
+    template <typename... Args>
+    auto pipelined_call(const std::string &function, Args &&... args) {
+      return _client.async_call(function, Metadata::MakeSync(), std::forward<Args>(args)...);
+    }
+
   private:
 
     ::rpc::client _client;
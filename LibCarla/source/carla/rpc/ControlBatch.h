@@ -0,0 +1,335 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/Exception.h"
+#include "carla/MsgPack.h"
+#include "carla/geom/Vector3D.h"
+#include "carla/rpc/ActorId.h"
+#include "carla/rpc/VehicleControl.h"
+#include "carla/rpc/VehicleLightState.h"
+#include "carla/rpc/WalkerControl.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Controls for many actors at once, stored in parallel arrays (one array
+  /// per field) and sent as a single binary blob.
+  ///
+  /// This is a cheaper alternative to a batch of Command::ApplyVehicleControl,
+  /// Command::SetVehicleLightState and Command::ApplyWalkerControl: there is
+  /// no per element encoding nor variant dispatch, decoding is a copy of
+  /// each array.
+  class ControlBatch {
+  public:
+
+    enum VehicleFlags : uint8_t {
+      HandBrake       = (0x1 << 0),
+      Reverse         = (0x1 << 1),
+      ManualGearShift = (0x1 << 2)
+    };
+
+    ControlBatch() = default;
+
+    // =========================================================================
+    /// @name Building the batch
+    // =========================================================================
+    /// @{
+
+    void Reserve(size_t vehicles, size_t light_states = 0u, size_t walkers = 0u) {
+      _vehicles.Reserve(vehicles);
+      _lights.Reserve(light_states);
+      _walkers.Reserve(walkers);
+    }
+
+    void AddVehicleControl(ActorId id, const VehicleControl &control) {
+      _vehicles.id.emplace_back(id);
+      _vehicles.throttle.emplace_back(control.throttle);
+      _vehicles.steer.emplace_back(control.steer);
+      _vehicles.brake.emplace_back(control.brake);
+      _vehicles.gear.emplace_back(control.gear);
+      uint8_t flags = 0u;
+      flags |= control.hand_brake ? uint8_t(HandBrake) : uint8_t(0u);
+      flags |= control.reverse ? uint8_t(Reverse) : uint8_t(0u);
+      flags |= control.manual_gear_shift ? uint8_t(ManualGearShift) : uint8_t(0u);
+      _vehicles.flags.emplace_back(flags);
+    }
+
+    void AddVehicleLightState(ActorId id, VehicleLightState light_state) {
+      _lights.id.emplace_back(id);
+      _lights.light_state.emplace_back(light_state.light_state);
+    }
+
+    void AddWalkerControl(ActorId id, const WalkerControl &control) {
+      _walkers.id.emplace_back(id);
+      _walkers.direction_x.emplace_back(control.direction.x);
+      _walkers.direction_y.emplace_back(control.direction.y);
+      _walkers.direction_z.emplace_back(control.direction.z);
+      _walkers.speed.emplace_back(control.speed);
+      _walkers.jump.emplace_back(control.jump ? 1u : 0u);
+    }
+
+    void clear() {
+      _vehicles.Clear();
+      _lights.Clear();
+      _walkers.Clear();
+    }
+
+    /// @}
+    // =========================================================================
+    /// @name Reading the batch
+    // =========================================================================
+    /// @{
+
+    bool empty() const {
+      return
+          _vehicles.id.empty() &&
+          _lights.id.empty() &&
+          _walkers.id.empty();
+    }
+
+    size_t GetNumberOfVehicleControls() const {
+      return _vehicles.id.size();
+    }
+
+    ActorId GetVehicleId(size_t index) const {
+      return _vehicles.id.at(index);
+    }
+
+    VehicleControl GetVehicleControl(size_t index) const {
+      const auto flags = _vehicles.flags.at(index);
+      return {
+          _vehicles.throttle[index],
+          _vehicles.steer[index],
+          _vehicles.brake[index],
+          (flags & HandBrake) != 0u,
+          (flags & Reverse) != 0u,
+          (flags & ManualGearShift) != 0u,
+          _vehicles.gear[index]};
+    }
+
+    size_t GetNumberOfVehicleLightStates() const {
+      return _lights.id.size();
+    }
+
+    ActorId GetLightStateVehicleId(size_t index) const {
+      return _lights.id.at(index);
+    }
+
+    VehicleLightState GetVehicleLightState(size_t index) const {
+      return _lights.light_state.at(index);
+    }
+
+    size_t GetNumberOfWalkerControls() const {
+      return _walkers.id.size();
+    }
+
+    ActorId GetWalkerId(size_t index) const {
+      return _walkers.id.at(index);
+    }
+
+    WalkerControl GetWalkerControl(size_t index) const {
+      return {
+          geom::Vector3D{
+              _walkers.direction_x.at(index),
+              _walkers.direction_y[index],
+              _walkers.direction_z[index]},
+          _walkers.speed[index],
+          _walkers.jump[index] != 0u};
+    }
+
+    /// @}
+    // =========================================================================
+    /// @name Binary encoding
+    // =========================================================================
+    /// @{
+
+    /// Size in bytes of the encoded batch.
+    size_t GetEncodedSize() const {
+      size_t size = sizeof(Header);
+      ForEachColumn([&size](const auto &column) {
+        size += column.size() * sizeof(column[0u]);
+      });
+      return size;
+    }
+
+    /// Encode the batch as a header followed by every array, @a write is
+    /// called with each piece as (const unsigned char *data, size_t size).
+    template <typename WriterT>
+    void Encode(WriterT &&write) const {
+      const Header header{
+          static_cast<uint32_t>(_vehicles.id.size()),
+          static_cast<uint32_t>(_lights.id.size()),
+          static_cast<uint32_t>(_walkers.id.size())};
+      write(reinterpret_cast<const unsigned char *>(&header), sizeof(header));
+      ForEachColumn([&write](const auto &column) {
+        DEBUG_ASSERT(column.data() != nullptr || column.empty());
+        write(
+            reinterpret_cast<const unsigned char *>(column.data()),
+            column.size() * sizeof(column[0u]));
+      });
+    }
+
+    /// Replace the contents of this batch with the batch encoded in @a data.
+    void Decode(const unsigned char *data, size_t size) {
+      Header header;
+      if (size < sizeof(header)) {
+        throw_exception(std::invalid_argument("control batch: message too short"));
+      }
+      std::memcpy(&header, data, sizeof(header));
+      const uint64_t expected_size =
+          sizeof(header) +
+          uint64_t(header.vehicles) * GetRowSize<VehicleColumns>() +
+          uint64_t(header.light_states) * GetRowSize<LightStateColumns>() +
+          uint64_t(header.walkers) * GetRowSize<WalkerColumns>();
+      if (expected_size != size) {
+        throw_exception(std::invalid_argument("control batch: size mismatch"));
+      }
+      _vehicles.Resize(header.vehicles);
+      _lights.Resize(header.light_states);
+      _walkers.Resize(header.walkers);
+      const unsigned char *position = data + sizeof(header);
+      ForEachColumn([&position](auto &column) {
+        const auto column_size = column.size() * sizeof(column[0u]);
+        if (column_size > 0u) {
+          std::memcpy(column.data(), position, column_size);
+        }
+        position += column_size;
+      });
+    }
+
+    /// @}
+
+    template <typename Packer>
+    void msgpack_pack(Packer &pk) const {
+      pk.pack_bin(static_cast<uint32_t>(GetEncodedSize()));
+      Encode([&pk](const unsigned char *data, size_t size) {
+        pk.pack_bin_body(reinterpret_cast<const char *>(data), static_cast<uint32_t>(size));
+      });
+    }
+
+    void msgpack_unpack(clmdep_msgpack::object const &o) {
+      if (o.type != clmdep_msgpack::type::BIN) {
+        throw_exception(clmdep_msgpack::type_error());
+      }
+      Decode(reinterpret_cast<const unsigned char *>(o.via.bin.ptr), o.via.bin.size);
+    }
+
+  private:
+
+#pragma pack(push, 1)
+    struct Header {
+      uint32_t vehicles;
+      uint32_t light_states;
+      uint32_t walkers;
+    };
+#pragma pack(pop)
+
+    struct VehicleColumns {
+      std::vector<ActorId> id;
+      std::vector<float> throttle;
+      std::vector<float> steer;
+      std::vector<float> brake;
+      std::vector<int32_t> gear;
+      std::vector<uint8_t> flags;
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) {
+        func(id); func(throttle); func(steer); func(brake); func(gear); func(flags);
+      }
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) const {
+        func(id); func(throttle); func(steer); func(brake); func(gear); func(flags);
+      }
+
+      void Reserve(size_t n) { ForEach([n](auto &column) { column.reserve(n); }); }
+      void Resize(size_t n) { ForEach([n](auto &column) { column.resize(n); }); }
+      void Clear() { ForEach([](auto &column) { column.clear(); }); }
+    };
+
+    struct LightStateColumns {
+      std::vector<ActorId> id;
+      std::vector<VehicleLightState::flag_type> light_state;
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) {
+        func(id); func(light_state);
+      }
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) const {
+        func(id); func(light_state);
+      }
+
+      void Reserve(size_t n) { ForEach([n](auto &column) { column.reserve(n); }); }
+      void Resize(size_t n) { ForEach([n](auto &column) { column.resize(n); }); }
+      void Clear() { ForEach([](auto &column) { column.clear(); }); }
+    };
+
+    struct WalkerColumns {
+      std::vector<ActorId> id;
+      std::vector<float> direction_x;
+      std::vector<float> direction_y;
+      std::vector<float> direction_z;
+      std::vector<float> speed;
+      std::vector<uint8_t> jump;
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) {
+        func(id); func(direction_x); func(direction_y); func(direction_z); func(speed); func(jump);
+      }
+
+      template <typename FuncT>
+      void ForEach(FuncT &&func) const {
+        func(id); func(direction_x); func(direction_y); func(direction_z); func(speed); func(jump);
+      }
+
+      void Reserve(size_t n) { ForEach([n](auto &column) { column.reserve(n); }); }
+      void Resize(size_t n) { ForEach([n](auto &column) { column.resize(n); }); }
+      void Clear() { ForEach([](auto &column) { column.clear(); }); }
+    };
+
+    /// Bytes taken by one element in all the columns of @a ColumnsT.
+    template <typename ColumnsT>
+    static size_t GetRowSize() {
+      size_t size = 0u;
+      ColumnsT{}.ForEach([&size](const auto &column) {
+        size += sizeof(column[0u]);
+      });
+      return size;
+    }
+
+    template <typename FuncT>
+    void ForEachColumn(FuncT &&func) {
+      _vehicles.ForEach(func);
+      _lights.ForEach(func);
+      _walkers.ForEach(func);
+    }
+
+    template <typename FuncT>
+    void ForEachColumn(FuncT &&func) const {
+      _vehicles.ForEach(func);
+      _lights.ForEach(func);
+      _walkers.ForEach(func);
+    }
+
+    VehicleColumns _vehicles;
+
+    LightStateColumns _lights;
+
+    WalkerColumns _walkers;
+  };
+
+} // namespace rpc
+} // namespace carla
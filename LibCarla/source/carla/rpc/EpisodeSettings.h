@@ -15,6 +15,8 @@
 
 #include <boost/optional.hpp>
 
+#include <cstdint>
+
 namespace carla {
 namespace rpc {
 
@@ -45,9 +47,14 @@ namespace rpc {
 
     float actor_active_distance = 2000.f; // 2km
 
+    /// Number of world snapshots between two full snapshots of the episode
+    /// state, the snapshots in between only carry the actors that changed. 0
+    /// or 1 sends a full snapshot every tick.
+    uint32_t state_keyframe_interval = 1u;
+
     MSGPACK_DEFINE_ARRAY(synchronous_mode, no_rendering_mode, fixed_delta_seconds, substepping,
         max_substep_delta_time, max_substeps, max_culling_distance, deterministic_ragdolls,
-        tile_stream_distance, actor_active_distance);
+        tile_stream_distance, actor_active_distance, state_keyframe_interval);
 
     // =========================================================================
     // -- Constructors ---------------------------------------------------------
@@ -65,7 +72,8 @@ namespace rpc {
         float max_culling_distance = 0.0f,
         bool deterministic_ragdolls = true,
         float tile_stream_distance = 3000.f,
-        float actor_active_distance = 2000.f)
+        float actor_active_distance = 2000.f,
+        uint32_t state_keyframe_interval = 1u)
       : synchronous_mode(synchronous_mode),
         no_rendering_mode(no_rendering_mode),
         fixed_delta_seconds(
@@ -76,7 +84,8 @@ namespace rpc {
         max_culling_distance(max_culling_distance),
         deterministic_ragdolls(deterministic_ragdolls),
         tile_stream_distance(tile_stream_distance),
-        actor_active_distance(actor_active_distance) {}
+        actor_active_distance(actor_active_distance),
+        state_keyframe_interval(state_keyframe_interval) {}
 
     // =========================================================================
     // -- Comparison operators -------------------------------------------------
@@ -93,7 +102,8 @@ namespace rpc {
           (max_culling_distance == rhs.max_culling_distance) &&
           (deterministic_ragdolls == rhs.deterministic_ragdolls) &&
           (tile_stream_distance == tile_stream_distance) &&
-          (actor_active_distance == actor_active_distance);
+          (actor_active_distance == actor_active_distance) &&
+          (state_keyframe_interval == rhs.state_keyframe_interval);
     }
 
     bool operator!=(const EpisodeSettings &rhs) const {
@@ -117,7 +127,8 @@ namespace rpc {
             Settings.MaxCullingDistance,
             Settings.bDeterministicRagdolls,
             Settings.TileStreamingDistance,
-            Settings.ActorActiveDistance) {
+            Settings.ActorActiveDistance,
+            static_cast<uint32_t>(FMath::Max(Settings.StateKeyframeInterval, 0))) {
       constexpr float CMTOM = 1.f/100.f;
       tile_stream_distance = CMTOM * Settings.TileStreamingDistance;
       actor_active_distance = CMTOM * Settings.ActorActiveDistance;
@@ -138,6 +149,7 @@ namespace rpc {
       Settings.bDeterministicRagdolls = deterministic_ragdolls;
       Settings.TileStreamingDistance = MTOCM * tile_stream_distance;
       Settings.ActorActiveDistance = MTOCM * actor_active_distance;
+      Settings.StateKeyframeInterval = static_cast<int>(state_keyframe_interval);
 
       return Settings;
     }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "carla/MoveHandler.h"
+#include "carla/ThreadPool.h"
 #include "carla/Time.h"
 #include "carla/rpc/Metadata.h"
 #include "carla/rpc/Response.h"
@@ -16,6 +17,9 @@
 
 #include <rpc/server.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
 
 namespace carla {
@@ -31,9 +35,9 @@ namespace rpc {
   /// Use `AsyncRun` to start the worker threads, and use `SyncRunFor` to
   /// run a slice of work in the caller's thread.
   ///
-  /// Functions that are bind using `BindAsync` will run asynchronously in the
-  /// worker threads. Functions that are bind using `BindSync` will run within
-  /// `SyncRunFor` function.
+  /// Functions that are bind using `BindAsync` or `BindReadOnly` will run
+  /// asynchronously in the worker threads. Functions that are bind using
+  /// `BindSync` will run within `SyncRunFor` or `SyncRunSome` functions.
   class Server {
   public:
 
@@ -46,10 +50,32 @@ namespace rpc {
     template <typename FunctorT>
     void BindAsync(const std::string &name, FunctorT &&functor);
 
+    /// Bind a function that does not modify the simulation and is safe to
+    /// call concurrently with the game thread, typically a query reading an
+    /// immutable snapshot published by the game thread. It runs in the worker
+    /// threads, so it is answered without waiting for the game thread to
+    /// process its queue.
+    template <typename FunctorT>
+    void BindReadOnly(const std::string &name, FunctorT &&functor) {
+      BindAsync(name, std::forward<FunctorT>(functor));
+    }
+
     void AsyncRun(size_t worker_threads) {
       _server.async_run(worker_threads);
     }
 
+    /// Launch @a options.threads worker threads pinned to
+    /// @a options.cpu_affinity. rpclib creates its own threads, they inherit
+    /// the affinity of this thread, which is restored afterwards.
+    void AsyncRun(const ThreadPoolOptions &options) {
+      const auto previous_affinity = GetCurrentThreadAffinity();
+      const bool pinned = SetCurrentThreadAffinity(options.cpu_affinity);
+      _server.async_run(options.threads);
+      if (pinned) {
+        SetCurrentThreadAffinity(previous_affinity);
+      }
+    }
+
     void SyncRunFor(time_duration duration) {
       #ifdef LIBCARLA_INCLUDED_FROM_UE4
       TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
@@ -58,6 +84,43 @@ namespace rpc {
       _sync_io_context.run_for(duration.to_chrono());
     }
 
+    /// Run the tasks queued for the game thread, returns as soon as the queue
+    /// is drained or the time slice expires.
+    ///
+    /// The time slice adapts to the queue length: it starts at @a budget,
+    /// and doubles each time a call returns with tasks still queued, up to
+    /// the maximum set with SetMaxSyncRunBudget. Once the queue is drained it
+    /// goes back to @a budget.
+    ///
+    /// @return the number of tasks run.
+    size_t SyncRunSome(time_duration budget) {
+      #ifdef LIBCARLA_INCLUDED_FROM_UE4
+      TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
+      #endif // LIBCARLA_INCLUDED_FROM_UE4
+      const auto slice = std::max(budget.to_chrono(), _sync_run_budget);
+      _sync_io_context.reset();
+      const auto count = _sync_io_context.run_for(slice);
+      _sync_run_budget = (_sync_queue_length > 0u) ?
+          std::min(2 * slice, _max_sync_run_budget) :
+          std::chrono::milliseconds(0);
+      return count;
+    }
+
+    /// Upper bound of the time slice of SyncRunSome.
+    void SetMaxSyncRunBudget(time_duration budget) {
+      _max_sync_run_budget = budget.to_chrono();
+    }
+
+    /// Time slice the next call to SyncRunSome will use at least.
+    time_duration GetSyncRunBudget() const {
+      return _sync_run_budget;
+    }
+
+    /// Number of tasks waiting for the game thread.
+    size_t GetSyncQueueLength() const {
+      return _sync_queue_length;
+    }
+
     /// @warning does not stop the game thread.
     void Stop() {
       _server.stop();
@@ -67,6 +130,12 @@ namespace rpc {
 
     boost::asio::io_context _sync_io_context;
 
+    std::atomic_size_t _sync_queue_length{0u};
+
+    std::chrono::milliseconds _sync_run_budget{0};
+
+    std::chrono::milliseconds _max_sync_run_budget{100};
+
     ::rpc::server _server;
   };
 
@@ -103,12 +172,19 @@ namespace detail {
     /// @a functor provided is always called from the context of the io_context.
     /// I.e., we can use the io_context to run tasks on a specific thread (e.g.
     /// game thread).
+    ///
+    /// @a queue_length counts the tasks posted and not yet run.
     template <typename FuncT>
-    static auto WrapSyncCall(boost::asio::io_context &io, FuncT &&functor) {
-      return [&io, functor=std::forward<FuncT>(functor)](Metadata metadata, Args... args) -> R {
-        auto task = std::packaged_task<R()>([functor=std::move(functor), args...]() {
+    static auto WrapSyncCall(
+        boost::asio::io_context &io,
+        std::atomic_size_t &queue_length,
+        FuncT &&functor) {
+      return [&io, &queue_length, functor=std::forward<FuncT>(functor)](Metadata metadata, Args... args) -> R {
+        auto task = std::packaged_task<R()>([functor=std::move(functor), &queue_length, args...]() {
+          --queue_length;
           return functor(args...);
         });
+        ++queue_length;
         if (metadata.IsResponseIgnored()) {
           // Post task and ignore result.
           boost::asio::post(io, MoveHandler(task));
@@ -151,7 +227,7 @@ namespace detail {
     using Wrapper = detail::FunctionWrapper<FunctorT>;
     _server.bind(
         name,
-        Wrapper::WrapSyncCall(_sync_io_context, std::forward<FunctorT>(functor)));
+        Wrapper::WrapSyncCall(_sync_io_context, _sync_queue_length, std::forward<FunctorT>(functor)));
   }
 
   template <typename FunctorT>
@@ -0,0 +1,41 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/MsgPack.h"
+#include "carla/rpc/ActorDescription.h"
+#include "carla/rpc/Transform.h"
+
+#include <vector>
+
+namespace carla {
+namespace rpc {
+
+  /// Request to spawn many actors at once, the simulator places each of them
+  /// at the first candidate spawn point that is free.
+  ///
+  /// A candidate is free if no vehicle nor walker, including the ones spawned
+  /// by this same request, is closer than @a min_distance. Candidates where
+  /// the spawn fails due to a collision are discarded and the next one is
+  /// tried, so a single round trip replaces the usual spawn-and-retry loop.
+  class SpawnActorsBulk {
+  public:
+
+    std::vector<ActorDescription> descriptions;
+
+    /// Candidate spawn points, tried in order. If empty, the recommended
+    /// spawn points of the map are used.
+    std::vector<Transform> spawn_points;
+
+    /// Minimum distance in meters to other vehicles and walkers.
+    float min_distance = 5.0f;
+
+    MSGPACK_DEFINE_ARRAY(descriptions, spawn_points, min_distance);
+  };
+
+} // namespace rpc
+} // namespace carla
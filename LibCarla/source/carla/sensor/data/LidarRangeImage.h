@@ -0,0 +1,82 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/sensor/data/Array.h"
+#include "carla/sensor/s11n/LidarRangeImageSerializer.h"
+
+namespace carla {
+namespace sensor {
+namespace data {
+
+  /// Measurement produced by a Lidar as a dense range image. Consists of an
+  /// array of channels x width LidarDetection in row-major order, see
+  /// LidarRangeImageData for the layout.
+  class LidarRangeImage : public Array<data::LidarDetection> {
+    static_assert(sizeof(data::LidarDetection) == 4u * sizeof(float), "Location size missmatch");
+    using Super = Array<data::LidarDetection>;
+
+  protected:
+
+    using Serializer = s11n::LidarRangeImageSerializer;
+
+    friend Serializer;
+
+    explicit LidarRangeImage(RawData &&data)
+      : Super(Serializer::header_offset, std::move(data)) {
+      DEBUG_ASSERT(GetChannelCount() * GetWidth() == Super::size());
+    }
+
+  private:
+
+    const auto &GetHeader() const {
+      return Serializer::DeserializeHeader(Super::GetRawData());
+    }
+
+  public:
+
+    /// Number of channels of the Lidar, the rows of the image.
+    uint32_t GetChannelCount() const {
+      return GetHeader().channels;
+    }
+
+    /// Number of azimuth bins, the columns of the image.
+    uint32_t GetWidth() const {
+      return GetHeader().width;
+    }
+
+    /// Horizontal field of view covered by the columns in degrees.
+    float GetHorizontalFov() const {
+      return GetHeader().horizontal_fov;
+    }
+
+    /// Angle of the first channel in degrees.
+    float GetUpperFov() const {
+      return GetHeader().upper_fov;
+    }
+
+    /// Angle of the last channel in degrees.
+    float GetLowerFov() const {
+      return GetHeader().lower_fov;
+    }
+
+    const LidarDetection &GetPoint(size_t channel, size_t column) const {
+      DEBUG_ASSERT(channel < GetChannelCount());
+      DEBUG_ASSERT(column < GetWidth());
+      return Super::operator[](channel * GetWidth() + column);
+    }
+
+    /// Whether the cell at @a channel, @a column holds a return.
+    bool IsValid(size_t channel, size_t column) const {
+      return LidarRangeImageData::IsValidReturn(GetPoint(channel, column));
+    }
+  };
+
+} // namespace data
+} // namespace sensor
+} // namespace carla
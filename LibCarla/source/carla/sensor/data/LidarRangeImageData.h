@@ -0,0 +1,130 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Debug.h"
+#include "carla/sensor/data/LidarData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace carla {
+namespace sensor {
+
+namespace s11n {
+  class LidarRangeImageSerializer;
+}
+
+namespace data {
+
+#pragma pack(push, 1)
+  /// Header of a Lidar range image, angles in degrees.
+  struct LidarRangeImageHeader {
+    uint32_t channels;
+    uint32_t width;
+    float horizontal_fov;
+    float upper_fov;
+    float lower_fov;
+  };
+#pragma pack(pop)
+
+  /// Helper class to store and serialize the data generated by a Lidar as a
+  /// dense "range image".
+  ///
+  /// The points are stored in a fixed array of channels x width
+  /// LidarDetection, row @a c holds the returns of channel @a c and column
+  /// @a j the returns of the azimuth bin
+  ///
+  ///    [-fov/2 + j * fov / width, -fov/2 + (j + 1) * fov / width)
+  ///
+  /// Cells without a return have all the coordinates set to zero and a
+  /// negative intensity.
+  ///
+  /// The size depends only on the Lidar description, so the memory is
+  /// allocated once and every row can be written from a different thread.
+  class LidarRangeImageData {
+  public:
+
+    static LidarDetection GetInvalidReturn() {
+      return LidarDetection{0.0f, 0.0f, 0.0f, -1.0f};
+    }
+
+    static bool IsValidReturn(const LidarDetection &detection) {
+      return detection.intensity >= 0.0f;
+    }
+
+    explicit LidarRangeImageData(
+        uint32_t channels = 0u,
+        uint32_t width = 0u,
+        float horizontal_fov = 360.0f,
+        float upper_fov = 0.0f,
+        float lower_fov = 0.0f)
+      : _header{channels, width, horizontal_fov, upper_fov, lower_fov},
+        _points(channels * width, GetInvalidReturn()) {}
+
+    LidarRangeImageData &operator=(LidarRangeImageData &&) = default;
+
+    uint32_t GetChannelCount() const {
+      return _header.channels;
+    }
+
+    uint32_t GetWidth() const {
+      return _header.width;
+    }
+
+    /// Mark every cell as invalid, the memory is not reallocated.
+    void Reset() {
+      std::fill(_points.begin(), _points.end(), GetInvalidReturn());
+    }
+
+    /// Column of the azimuth bin containing @a azimuth, in degrees.
+    uint32_t GetColumn(float azimuth) const {
+      DEBUG_ASSERT(_header.width > 0u);
+      const float fov = _header.horizontal_fov;
+      const auto bin = static_cast<int64_t>(
+          std::floor((azimuth + 0.5f * fov) / fov * static_cast<float>(_header.width)));
+      const auto width = static_cast<int64_t>(_header.width);
+      if (fov >= 360.0f) {
+        // The image wraps around.
+        return static_cast<uint32_t>(((bin % width) + width) % width);
+      }
+      return static_cast<uint32_t>(std::min(std::max<int64_t>(bin, 0), width - 1));
+    }
+
+    LidarDetection &At(uint32_t channel, uint32_t column) {
+      DEBUG_ASSERT(channel < _header.channels);
+      DEBUG_ASSERT(column < _header.width);
+      return _points[channel * _header.width + column];
+    }
+
+    /// Write @a detection in its cell, if the cell already has a return the
+    /// closest one is kept.
+    ///
+    /// Only the row of @a channel is modified, different channels can be
+    /// written concurrently.
+    void WritePoint(uint32_t channel, float azimuth, const LidarDetection &detection) {
+      auto &cell = At(channel, GetColumn(azimuth));
+      if (!IsValidReturn(cell) ||
+          (detection.point.SquaredLength() < cell.point.SquaredLength())) {
+        cell = detection;
+      }
+    }
+
+  private:
+
+    LidarRangeImageHeader _header;
+
+    std::vector<LidarDetection> _points;
+
+    friend class s11n::LidarRangeImageSerializer;
+  };
+
+} // namespace data
+} // namespace sensor
+} // namespace carla
@@ -11,6 +11,8 @@
 #include "carla/sensor/data/Array.h"
 #include "carla/sensor/s11n/EpisodeStateSerializer.h"
 
+#include <cstring>
+
 namespace carla {
 namespace sensor {
 namespace data {
@@ -24,15 +26,26 @@ namespace data {
 
     friend Serializer;
 
+    /// In delta messages the array of actors is empty, the payload is read
+    /// with the delta accessors instead.
     explicit RawEpisodeState(RawData &&data)
-      : Super(Serializer::header_offset, std::move(data)) {}
+      : Super(std::move(data), [](const RawData &message) {
+          const auto &header = Serializer::DeserializeHeader(message);
+          return header.encoding == Serializer::Encoding::Delta ?
+              message.size() :
+              Serializer::header_offset;
+        }) {}
 
   private:
 
-    auto GetHeader() const {
+    const Serializer::Header &GetHeader() const {
       return Serializer::DeserializeHeader(Super::GetRawData());
     }
 
+    const unsigned char *GetPayload() const {
+      return Super::GetRawData().begin() + Serializer::header_offset;
+    }
+
   public:
 
     /// Unique id of the episode at which this data was generated.
@@ -66,6 +79,46 @@ namespace data {
       return GetHeader().simulation_state;
     }
 
+    /// Sequence number of this message in the stream.
+    uint64_t GetSequence() const {
+      return GetHeader().sequence;
+    }
+
+    /// Whether this message only contains the changes since the message with
+    /// the previous sequence number.
+    bool IsDelta() const {
+      return GetHeader().encoding == Serializer::Encoding::Delta;
+    }
+
+    /// @pre IsDelta()
+    Serializer::DeltaHeader GetDeltaHeader() const {
+      DEBUG_ASSERT(IsDelta());
+      Serializer::DeltaHeader header;
+      std::memcpy(&header, GetPayload(), sizeof(header));
+      return header;
+    }
+
+    /// Position of the first delta record, see
+    /// EpisodeStateSerializer::ReadDeltaRecord.
+    ///
+    /// @pre IsDelta()
+    const unsigned char *GetDeltaRecords() const {
+      DEBUG_ASSERT(IsDelta());
+      return GetPayload() + sizeof(Serializer::DeltaHeader);
+    }
+
+    /// Id of the @a index-th actor removed since the previous message.
+    ///
+    /// @pre IsDelta()
+    ActorId GetRemovedActorId(size_t index) const {
+      const auto count = GetDeltaHeader().number_of_removed_actors;
+      DEBUG_ASSERT(index < count);
+      const auto *end = Super::GetRawData().end();
+      ActorId id;
+      std::memcpy(&id, end - (count - index) * sizeof(ActorId), sizeof(id));
+      return id;
+    }
+
   };
 
 } // namespace data
@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/DVSEventArraySerializer.h"
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/DVSEventArray.h"
 
 namespace carla {
@@ -14,7 +15,9 @@ namespace s11n {
 
   SharedPtr<SensorData> DVSEventArraySerializer::Deserialize(RawData &&data) {
 
-    auto events_array = SharedPtr<data::DVSEventArray>(new data::DVSEventArray{std::move(data)});
+    auto events_array = MakePooledShared<data::DVSEventArray>([&](void *memory) {
+      return new (memory) data::DVSEventArray{std::move(data)};
+    });
 
     return events_array;
   }
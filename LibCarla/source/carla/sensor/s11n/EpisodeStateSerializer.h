@@ -14,7 +14,10 @@
 #include "carla/sensor/RawData.h"
 #include "carla/sensor/data/ActorDynamicState.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace carla {
 namespace sensor {
@@ -33,6 +36,26 @@ namespace s11n {
       PendingLightUpdate = (0x1 << 1)
     };
 
+    /// How the actors are encoded after the header.
+    enum class Encoding : uint8_t {
+      /// An ActorDynamicState for every actor in the episode.
+      Keyframe,
+      /// Only the actors that changed since the previous message, see
+      /// DeltaHeader.
+      Delta
+    };
+
+    /// Fields of an actor that can be sent in a delta record.
+    enum ActorField : uint8_t {
+      ActorStateField        = (0x1 << 0),
+      TransformField         = (0x1 << 1),
+      VelocityField          = (0x1 << 2),
+      AngularVelocityField   = (0x1 << 3),
+      AccelerationField      = (0x1 << 4),
+      TypeDependentField     = (0x1 << 5),
+      AllFields              = (0x1 << 6) - 1
+    };
+
 #pragma pack(push, 1)
     struct Header {
       uint64_t episode_id;
@@ -40,6 +63,26 @@ namespace s11n {
       float delta_seconds;
       geom::Vector3DInt map_origin;
       SimulationState simulation_state = SimulationState::None;
+      /// Incremented by one with every message, a delta can only be applied
+      /// on top of the message with the previous sequence number.
+      uint64_t sequence = 0u;
+      Encoding encoding = Encoding::Keyframe;
+    };
+
+    /// Follows the header in delta messages. It is followed by @a
+    /// number_of_records records, each one a DeltaRecordHeader followed by
+    /// the fields flagged in it in declaration order; and finally the ids of
+    /// the @a number_of_removed_actors actors that no longer exist.
+    ///
+    /// Actors that appear for the first time are sent with all the fields.
+    struct DeltaHeader {
+      uint32_t number_of_records;
+      uint32_t number_of_removed_actors;
+    };
+
+    struct DeltaRecordHeader {
+      ActorId id;
+      uint8_t fields;
     };
 #pragma pack(pop)
 
@@ -49,12 +92,109 @@ namespace s11n {
       return *reinterpret_cast<const Header *>(message.begin());
     }
 
+    // =========================================================================
+    /// @name Delta encoding
+    // =========================================================================
+    /// @{
+
+    /// Fields of @a current that differ from @a previous. Works with any
+    /// type with the same fields as ActorDynamicState.
+    template <typename StateT>
+    static uint8_t GetChangedFields(const StateT &previous, const StateT &current) {
+      const auto *lhs = reinterpret_cast<const unsigned char *>(&previous);
+      const auto *rhs = reinterpret_cast<const unsigned char *>(&current);
+      uint8_t result = 0u;
+      for (auto &&field : GetFieldLayout<StateT>()) {
+        if (std::memcmp(lhs + field.offset, rhs + field.offset, field.size) != 0) {
+          result |= field.flag;
+        }
+      }
+      return result;
+    }
+
+    /// Size of a delta record containing @a fields.
+    static size_t GetDeltaRecordSize(uint8_t fields) {
+      size_t size = sizeof(DeltaRecordHeader);
+      for (auto &&field : GetFieldLayout<data::ActorDynamicState>()) {
+        if ((fields & field.flag) != 0u) {
+          size += field.size;
+        }
+      }
+      return size;
+    }
+
+    /// Write a record with the @a fields of @a state at @a out, which must
+    /// have at least GetDeltaRecordSize(fields) bytes. Return the position
+    /// past the record.
+    template <typename StateT>
+    static unsigned char *WriteDeltaRecord(
+        unsigned char *out,
+        const StateT &state,
+        uint8_t fields) {
+      const DeltaRecordHeader header{state.id, fields};
+      std::memcpy(out, &header, sizeof(header));
+      out += sizeof(header);
+      const auto *in = reinterpret_cast<const unsigned char *>(&state);
+      for (auto &&field : GetFieldLayout<StateT>()) {
+        if ((fields & field.flag) != 0u) {
+          std::memcpy(out, in + field.offset, field.size);
+          out += field.size;
+        }
+      }
+      return out;
+    }
+
+    /// Copy the fields of the record starting at @a in into @a state, the
+    /// rest of the fields are not modified. Return the position past the
+    /// record.
+    template <typename StateT>
+    static const unsigned char *ReadDeltaRecord(
+        const unsigned char *in,
+        DeltaRecordHeader &header,
+        StateT &state) {
+      std::memcpy(&header, in, sizeof(header));
+      in += sizeof(header);
+      state.id = header.id;
+      auto *out = reinterpret_cast<unsigned char *>(&state);
+      for (auto &&field : GetFieldLayout<StateT>()) {
+        if ((header.fields & field.flag) != 0u) {
+          std::memcpy(out + field.offset, in, field.size);
+          in += field.size;
+        }
+      }
+      return in;
+    }
+
+    /// @}
+
     template <typename SensorT>
     static Buffer Serialize(const SensorT &, Buffer &&buffer) {
       return std::move(buffer);
     }
 
     static SharedPtr<SensorData> Deserialize(RawData &&data);
+
+  private:
+
+    struct FieldLayout {
+      ActorField flag;
+      size_t offset;
+      size_t size;
+    };
+
+    /// Offset and size of each field of @a StateT, in the order they are
+    /// written in a delta record.
+    template <typename StateT>
+    static const std::array<FieldLayout, 6u> &GetFieldLayout() {
+      static const std::array<FieldLayout, 6u> layout{{
+        {ActorStateField, offsetof(StateT, actor_state), sizeof(StateT::actor_state)},
+        {TransformField, offsetof(StateT, transform), sizeof(StateT::transform)},
+        {VelocityField, offsetof(StateT, velocity), sizeof(StateT::velocity)},
+        {AngularVelocityField, offsetof(StateT, angular_velocity), sizeof(StateT::angular_velocity)},
+        {AccelerationField, offsetof(StateT, acceleration), sizeof(StateT::acceleration)},
+        {TypeDependentField, offsetof(StateT, state), sizeof(StateT::state)}}};
+      return layout;
+    }
   };
 
 } // namespace s11n
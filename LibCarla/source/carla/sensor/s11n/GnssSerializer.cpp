@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/GnssSerializer.h"
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/GnssMeasurement.h"
 
 namespace carla {
@@ -13,7 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> GnssSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<SensorData>(new data::GnssMeasurement(std::move(data)));
+    return MakePooledShared<data::GnssMeasurement>([&](void *memory) {
+      return new (memory) data::GnssMeasurement(std::move(data));
+    });
   }
 
 } // namespace s11n
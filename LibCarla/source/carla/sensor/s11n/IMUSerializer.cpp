@@ -4,6 +4,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/s11n/IMUSerializer.h"
 #include "carla/sensor/data/IMUMeasurement.h"
 
@@ -12,7 +13,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> IMUSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<SensorData>(new data::IMUMeasurement(std::move(data)));
+    return MakePooledShared<data::IMUMeasurement>([&](void *memory) {
+      return new (memory) data::IMUMeasurement(std::move(data));
+    });
   }
 
 } // namespace s11n
@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/ImageSerializer.h"
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/Image.h"
 
 namespace carla {
@@ -13,7 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> ImageSerializer::Deserialize(RawData &&data) {
-    auto image = SharedPtr<data::Image>(new data::Image{std::move(data)});
+    auto image = MakePooledShared<data::Image>([&](void *memory) {
+      return new (memory) data::Image{std::move(data)};
+    });
     // Set alpha of each pixel in the buffer to max to make it 100% opaque
     for (auto &pixel : *image) {
       pixel.a = 255u;
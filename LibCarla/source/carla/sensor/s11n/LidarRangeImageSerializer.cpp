@@ -0,0 +1,24 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/sensor/s11n/LidarRangeImageSerializer.h"
+
+#include "carla/MemoryPool.h"
+#include "carla/sensor/data/LidarRangeImage.h"
+
+namespace carla {
+namespace sensor {
+namespace s11n {
+
+  SharedPtr<SensorData> LidarRangeImageSerializer::Deserialize(RawData &&data) {
+    return MakePooledShared<data::LidarRangeImage>([&](void *memory) {
+      return new (memory) data::LidarRangeImage{std::move(data)};
+    });
+  }
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
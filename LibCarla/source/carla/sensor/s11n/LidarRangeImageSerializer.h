@@ -0,0 +1,63 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Memory.h"
+#include "carla/sensor/RawData.h"
+#include "carla/sensor/data/LidarRangeImageData.h"
+
+#include <array>
+
+namespace carla {
+namespace sensor {
+
+  class SensorData;
+
+namespace s11n {
+
+  // ===========================================================================
+  // -- LidarRangeImageSerializer ----------------------------------------------
+  // ===========================================================================
+
+  /// Serializes the data generated by Lidar sensors as a dense range image.
+  class LidarRangeImageSerializer {
+  public:
+
+    constexpr static auto header_offset = sizeof(data::LidarRangeImageHeader);
+
+    static const data::LidarRangeImageHeader &DeserializeHeader(const RawData &data) {
+      return *reinterpret_cast<const data::LidarRangeImageHeader *>(data.begin());
+    }
+
+    template <typename Sensor>
+    static Buffer Serialize(
+        const Sensor &sensor,
+        const data::LidarRangeImageData &data,
+        Buffer &&output);
+
+    static SharedPtr<SensorData> Deserialize(RawData &&data);
+  };
+
+  // ===========================================================================
+  // -- LidarRangeImageSerializer implementation -------------------------------
+  // ===========================================================================
+
+  template <typename Sensor>
+  inline Buffer LidarRangeImageSerializer::Serialize(
+      const Sensor &,
+      const data::LidarRangeImageData &data,
+      Buffer &&output) {
+    std::array<boost::asio::const_buffer, 2u> seq = {
+        boost::asio::buffer(&data._header, sizeof(data._header)),
+        boost::asio::buffer(data._points)};
+    output.copy_from(seq);
+    return std::move(output);
+  }
+
+} // namespace s11n
+} // namespace sensor
+} // namespace carla
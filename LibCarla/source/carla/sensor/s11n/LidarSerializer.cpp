@@ -5,6 +5,7 @@
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/LidarMeasurement.h"
 #include "carla/sensor/s11n/LidarSerializer.h"
 
@@ -13,8 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> LidarSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<data::LidarMeasurement>(
-        new data::LidarMeasurement{std::move(data)});
+    return MakePooledShared<data::LidarMeasurement>([&](void *memory) {
+      return new (memory) data::LidarMeasurement{std::move(data)};
+    });
   }
 
 } // namespace s11n
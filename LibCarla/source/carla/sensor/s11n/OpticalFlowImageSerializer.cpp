@@ -2,6 +2,7 @@
 // Created by flo on 09.11.20.
 //
 
+#include "carla/MemoryPool.h"
 #include "OpticalFlowImageSerializer.h"
 #include "carla/sensor/s11n/OpticalFlowImageSerializer.h"
 
@@ -12,7 +13,9 @@ namespace carla {
     namespace s11n {
 
       SharedPtr<SensorData> OpticalFlowImageSerializer::Deserialize(RawData &&data) {
-        auto image = SharedPtr<data::OpticalFlowImage>(new data::OpticalFlowImage{std::move(data)});
+        auto image = MakePooledShared<data::OpticalFlowImage>([&](void *memory) {
+          return new (memory) data::OpticalFlowImage{std::move(data)};
+        });
         return image;
       }
 
@@ -45,8 +45,8 @@ namespace carla {
       inline Buffer OpticalFlowImageSerializer::Serialize(const Sensor &sensor, Buffer &&bitmap) {
         DEBUG_ASSERT(bitmap.size() > sizeof(ImageHeader));
         ImageHeader header = {
-            sensor.GetImageWidth(),
-            sensor.GetImageHeight(),
+            sensor.GetOutputImageWidth(),
+            sensor.GetOutputImageHeight(),
             sensor.GetFOVAngle()
         };
         std::memcpy(bitmap.data(), reinterpret_cast<const void *>(&header), sizeof(header));
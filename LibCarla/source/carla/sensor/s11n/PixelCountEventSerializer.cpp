@@ -4,6 +4,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/PixelCountEvent.h"
 #include "carla/sensor/s11n/PixelCountEventSerializer.h"
 
@@ -12,7 +13,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> PixelCountEventSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<SensorData>(new data::PixelCountEvent(std::move(data)));
+    return MakePooledShared<data::PixelCountEvent>([&](void *memory) {
+      return new (memory) data::PixelCountEvent(std::move(data));
+    });
   }
 
 } // namespace s11n
@@ -6,6 +6,7 @@
 
 #include "carla/sensor/s11n/RadarSerializer.h"
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/data/RadarMeasurement.h"
 
 namespace carla {
@@ -13,8 +14,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> RadarSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<data::RadarMeasurement>(
-        new data::RadarMeasurement{std::move(data)});
+    return MakePooledShared<data::RadarMeasurement>([&](void *memory) {
+      return new (memory) data::RadarMeasurement{std::move(data)};
+    });
   }
 
 } // namespace s11n
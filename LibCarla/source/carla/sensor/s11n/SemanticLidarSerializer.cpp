@@ -4,6 +4,7 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include "carla/MemoryPool.h"
 #include "carla/sensor/s11n/SemanticLidarSerializer.h"
 #include "carla/sensor/data/SemanticLidarMeasurement.h"
 
@@ -12,8 +13,9 @@ namespace sensor {
 namespace s11n {
 
   SharedPtr<SensorData> SemanticLidarSerializer::Deserialize(RawData &&data) {
-    return SharedPtr<data::SemanticLidarMeasurement>(
-        new data::SemanticLidarMeasurement{std::move(data)});
+    return MakePooledShared<data::SemanticLidarMeasurement>([&](void *memory) {
+      return new (memory) data::SemanticLidarMeasurement{std::move(data)};
+    });
   }
 
 } // namespace s11n
@@ -0,0 +1,184 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "carla/streaming/CallbackExecutor.h"
+
+#include "carla/Debug.h"
+#include "carla/Logging.h"
+
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+
+namespace carla {
+namespace streaming {
+
+  // ===========================================================================
+  // -- CallbackExecutor::StreamQueue ------------------------------------------
+  // ===========================================================================
+
+  class CallbackExecutor::StreamQueue
+    : public std::enable_shared_from_this<StreamQueue>,
+      private NonCopyable {
+  public:
+
+    StreamQueue(
+        boost::asio::io_context &io_context,
+        callback_type callback,
+        size_t max_queue_size,
+        OverflowPolicy overflow_policy)
+      : _io_context(io_context),
+        _callback(std::move(callback)),
+        _max_queue_size(std::max<size_t>(1u, max_queue_size)),
+        _overflow_policy(overflow_policy) {}
+
+    void Push(Buffer message) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_closed) {
+        return;
+      }
+      if (_queue.size() >= _max_queue_size) {
+        ++_dropped;
+        if (_overflow_policy == OverflowPolicy::DropNewest) {
+          return;
+        }
+        _queue.pop_front();
+      }
+      _queue.emplace_back(std::move(message));
+      ScheduleNext();
+    }
+
+    void Close() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _closed = true;
+      _queue.clear();
+    }
+
+    CallbackQueueStats GetStats() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      CallbackQueueStats stats;
+      stats.queue_size = _queue.size();
+      stats.max_queue_size = _max_queue_size;
+      stats.delivered = _delivered;
+      stats.dropped = _dropped;
+      return stats;
+    }
+
+  private:
+
+    /// Post a task delivering the next message, unless one is already posted.
+    /// A task delivers a single message so busy streams do not starve the
+    /// others.
+    void ScheduleNext() {
+      if (_scheduled || _queue.empty()) {
+        return;
+      }
+      _scheduled = true;
+      boost::asio::post(_io_context, [self=shared_from_this()]() { self->DeliverNext(); });
+    }
+
+    void DeliverNext() {
+      Buffer message;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_closed || _queue.empty()) {
+          _scheduled = false;
+          return;
+        }
+        message = std::move(_queue.front());
+        _queue.pop_front();
+      }
+      try {
+        _callback(std::move(message));
+      } catch (const std::exception &e) {
+        log_error("streaming client: exception in callback:", e.what());
+      }
+      std::lock_guard<std::mutex> lock(_mutex);
+      ++_delivered;
+      _scheduled = false;
+      ScheduleNext();
+    }
+
+    boost::asio::io_context &_io_context;
+
+    const callback_type _callback;
+
+    const size_t _max_queue_size;
+
+    const OverflowPolicy _overflow_policy;
+
+    mutable std::mutex _mutex;
+
+    std::deque<Buffer> _queue;
+
+    bool _scheduled = false;
+
+    bool _closed = false;
+
+    uint64_t _delivered = 0u;
+
+    uint64_t _dropped = 0u;
+  };
+
+  // ===========================================================================
+  // -- CallbackExecutor -------------------------------------------------------
+  // ===========================================================================
+
+  void CallbackExecutor::EnsureWorkerThreads(const size_t worker_threads) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (worker_threads > _worker_threads) {
+      _pool.AsyncRun(worker_threads - _worker_threads);
+      _worker_threads = worker_threads;
+    }
+  }
+
+  CallbackExecutor::callback_type CallbackExecutor::Wrap(
+      const detail::stream_id_type stream_id,
+      callback_type callback,
+      const size_t max_queue_size,
+      const OverflowPolicy overflow_policy) {
+    auto queue = std::make_shared<StreamQueue>(
+        _pool.io_context(),
+        std::move(callback),
+        max_queue_size,
+        overflow_policy);
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      DEBUG_ASSERT(_worker_threads > 0u);
+      auto &entry = _queues[stream_id];
+      if (entry != nullptr) {
+        entry->Close();
+      }
+      entry = queue;
+    }
+    return [queue=std::move(queue)](Buffer message) {
+      queue->Push(std::move(message));
+    };
+  }
+
+  void CallbackExecutor::Remove(const detail::stream_id_type stream_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _queues.find(stream_id);
+    if (it != _queues.end()) {
+      it->second->Close();
+      _queues.erase(it);
+    }
+  }
+
+  boost::optional<CallbackQueueStats> CallbackExecutor::GetStats(
+      const detail::stream_id_type stream_id) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _queues.find(stream_id);
+    if (it == _queues.end()) {
+      return boost::none;
+    }
+    return it->second->GetStats();
+  }
+
+} // namespace streaming
+} // namespace carla
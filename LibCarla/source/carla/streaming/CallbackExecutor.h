@@ -0,0 +1,75 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "carla/Buffer.h"
+#include "carla/NonCopyable.h"
+#include "carla/ThreadPool.h"
+#include "carla/streaming/CallbackQueueOptions.h"
+#include "carla/streaming/detail/Types.h"
+
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace carla {
+namespace streaming {
+
+  /// Runs the callbacks of the streams in its own pool of threads, so the
+  /// streaming threads never wait for user code.
+  ///
+  /// Each stream has a bounded queue, its callback is never called
+  /// concurrently and receives the messages in order, different streams run in
+  /// parallel.
+  class CallbackExecutor : private NonCopyable {
+  public:
+
+    using callback_type = std::function<void(Buffer)>;
+
+    ~CallbackExecutor() {
+      Stop();
+    }
+
+    /// Launch threads until there are at least @a worker_threads.
+    void EnsureWorkerThreads(size_t worker_threads);
+
+    /// Return a callback that queues each message for @a callback, replacing
+    /// the queue of a previous subscription to the same stream.
+    callback_type Wrap(
+        detail::stream_id_type stream_id,
+        callback_type callback,
+        size_t max_queue_size,
+        OverflowPolicy overflow_policy);
+
+    /// Discard the queue of @a stream_id, queued messages are not delivered.
+    void Remove(detail::stream_id_type stream_id);
+
+    boost::optional<CallbackQueueStats> GetStats(detail::stream_id_type stream_id) const;
+
+    /// Stop the threads, queued messages are not delivered.
+    void Stop() {
+      _pool.Stop();
+    }
+
+  private:
+
+    class StreamQueue;
+
+    mutable std::mutex _mutex;
+
+    size_t _worker_threads = 0u;
+
+    std::unordered_map<detail::stream_id_type, std::shared_ptr<StreamQueue>> _queues;
+
+    ThreadPool _pool;
+  };
+
+} // namespace streaming
+} // namespace carla
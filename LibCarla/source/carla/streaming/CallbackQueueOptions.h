@@ -0,0 +1,49 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace carla {
+namespace streaming {
+
+  /// What to do with a new message when the queue of its stream is full.
+  enum class OverflowPolicy : uint8_t {
+    /// Discard the oldest queued message, the consumer always gets the latest
+    /// ones.
+    DropOldest,
+    /// Discard the new message.
+    DropNewest
+  };
+
+  struct CallbackQueueOptions {
+    /// Number of threads running the callbacks, 0 runs them in the streaming
+    /// threads as they arrive.
+    size_t worker_threads = 0u;
+
+    /// Maximum number of messages waiting for the callback of each stream.
+    size_t max_queue_size = 4u;
+
+    OverflowPolicy overflow_policy = OverflowPolicy::DropOldest;
+  };
+
+  struct CallbackQueueStats {
+    /// Number of messages waiting for the callback.
+    size_t queue_size = 0u;
+
+    size_t max_queue_size = 0u;
+
+    /// Number of messages passed to the callback.
+    uint64_t delivered = 0u;
+
+    /// Number of messages discarded because the queue was full.
+    uint64_t dropped = 0u;
+  };
+
+} // namespace streaming
+} // namespace carla
@@ -8,12 +8,15 @@
 
 #include "carla/Logging.h"
 #include "carla/ThreadPool.h"
+#include "carla/streaming/CallbackExecutor.h"
 #include "carla/streaming/Token.h"
 #include "carla/streaming/detail/tcp/Client.h"
 #include "carla/streaming/low_level/Client.h"
 
 #include <boost/asio/io_context.hpp>
 
+#include <atomic>
+
 namespace carla {
 namespace streaming {
 
@@ -31,6 +34,7 @@ namespace streaming {
 
     ~Client() {
       _service.Stop();
+      _executor.Stop();
     }
 
     /// @warning cannot subscribe twice to the same stream (even if it's a
@@ -38,10 +42,41 @@ namespace streaming {
     template <typename Functor>
     void Subscribe(const Token &token, Functor &&callback) {
       _client.Subscribe(_service.io_context(), token, std::forward<Functor>(callback));
+      const auto streams = ++_number_of_streams;
+      if (_max_threads > 0u) {
+        _service.EnsureThreads(std::min<size_t>(streams, _max_threads));
+      }
+    }
+
+    /// Subscribe with the @a callback running in a separate pool of threads,
+    /// fed by a bounded queue as configured in @a options.
+    ///
+    /// @copydetails Subscribe(const Token &, Functor &&)
+    template <typename Functor>
+    void Subscribe(const Token &token, const CallbackQueueOptions &options, Functor &&callback) {
+      if (options.worker_threads == 0u) {
+        Subscribe(token, std::forward<Functor>(callback));
+        return;
+      }
+      _executor.EnsureWorkerThreads(options.worker_threads);
+      Subscribe(token, _executor.Wrap(
+          detail::token_type(token).get_stream_id(),
+          std::forward<Functor>(callback),
+          options.max_queue_size,
+          options.overflow_policy));
     }
 
     void UnSubscribe(const Token &token) {
-      _client.UnSubscribe(token);
+      if (_client.UnSubscribe(token)) {
+        --_number_of_streams;
+      }
+      _executor.Remove(detail::token_type(token).get_stream_id());
+    }
+
+    /// Return the state of the callback queue of @a token, if it was
+    /// subscribed with a callback queue.
+    boost::optional<CallbackQueueStats> GetCallbackQueueStats(const Token &token) const {
+      return _executor.GetStats(detail::token_type(token).get_stream_id());
     }
 
     void Run() {
@@ -52,13 +87,33 @@ namespace streaming {
       _service.AsyncRun(worker_threads);
     }
 
+    /// Launch @a options.threads threads, and one more for each stream
+    /// subscribed beyond those up to @a options.max_threads. Threads are not
+    /// stopped when streams are unsubscribed.
+    void AsyncRun(const ThreadPoolOptions &options) {
+      _service.AsyncRun(options);
+      _max_threads = options.GetMaxThreads();
+      _service.EnsureThreads(std::min<size_t>(_number_of_streams, _max_threads));
+    }
+
+    /// Number of IO threads launched.
+    size_t GetNumberOfThreads() const {
+      return _service.GetNumberOfThreads();
+    }
   private:
 
     // The order of these two arguments is very important.
 
     ThreadPool _service;
 
+    CallbackExecutor _executor;
+
     underlying_client _client;
+
+    std::atomic_size_t _number_of_streams{0u};
+
+    /// Zero unless the threads grow with the number of streams.
+    std::atomic_size_t _max_threads{0u};
   };
 
 } // namespace streaming
@@ -60,6 +60,11 @@ namespace streaming {
       _pool.AsyncRun(worker_threads);
     }
 
+    /// Launch @a options.threads threads pinned to @a options.cpu_affinity.
+    void AsyncRun(const ThreadPoolOptions &options) {
+      _pool.AsyncRun(options);
+    }
+
     void SetSynchronousMode(bool is_synchro) {
       _server.SetSynchronousMode(is_synchro);
     }
@@ -54,11 +54,48 @@ namespace detail {
       }
     }
 
+    /// Write @a buffer and keep it, so the sessions connecting later receive
+    /// it first, after the messages kept before. If @a restart is true, the
+    /// messages kept so far are dropped; otherwise @a buffer is only kept if
+    /// a message was kept with @a restart before, i.e. it makes sense on top
+    /// of them.
+    void WriteAndKeep(Buffer &&buffer, bool restart) {
+      auto message = Session::MakeMessage(std::move(buffer));
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (restart) {
+        _kept_messages.clear();
+      }
+      if (restart || !_kept_messages.empty()) {
+        _kept_messages.emplace_back(message);
+      }
+      for (auto &s : _sessions) {
+        if (s != nullptr) {
+          s->Write(message);
+        }
+      }
+    }
+
+    /// Number of sessions connected since the stream was created, including
+    /// the ones already disconnected.
+    size_t GetNumberOfConnections() const {
+      return _number_of_connections;
+    }
+
+    /// Number of sessions currently connected.
+    size_t GetNumberOfSessions() const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      return _sessions.size();
+    }
+
   private:
 
     void ConnectSession(std::shared_ptr<Session> session) final {
       DEBUG_ASSERT(session != nullptr);
       std::lock_guard<std::mutex> lock(_mutex);
+      ++_number_of_connections;
+      for (auto &message : _kept_messages) {
+        session->Write(message);
+      }
       _sessions.emplace_back(std::move(session));
       log_debug("Connecting multistream sessions:", _sessions.size());
       if (_sessions.size() == 1) {
@@ -98,12 +135,17 @@ namespace detail {
       log_debug("Disconnecting all multistream sessions");
     }
 
-    std::mutex _mutex;
+    mutable std::mutex _mutex;
 
     // if there is only one session, then we use atomic
     AtomicSharedPtr<Session> _session;
     // if there are more than one session, we use vector of sessions with mutex
     std::vector<std::shared_ptr<Session>> _sessions;
+
+    std::atomic_size_t _number_of_connections{0u};
+
+    // Messages sent to every session when it connects, see WriteAndKeep.
+    std::vector<std::shared_ptr<const tcp::Message>> _kept_messages;
   };
 
 } // namespace detail
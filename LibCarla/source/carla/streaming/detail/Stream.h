@@ -52,6 +52,23 @@ namespace detail {
       _shared_state->Write(std::move(buffers)...);
     }
 
+    /// Flush @a buffer down the stream and keep it for the clients
+    /// subscribing later, see MultiStreamState::WriteAndKeep.
+    void WriteAndKeep(Buffer &&buffer, bool restart) {
+      _shared_state->WriteAndKeep(std::move(buffer), restart);
+    }
+
+    /// Number of clients currently subscribed to this stream.
+    size_t GetNumberOfSessions() const {
+      return _shared_state->GetNumberOfSessions();
+    }
+
+    /// Number of clients that subscribed to this stream so far, including
+    /// the ones already unsubscribed.
+    size_t GetNumberOfConnections() const {
+      return _shared_state->GetNumberOfConnections();
+    }
+
     /// Make a copy of @a data and flush it down the stream.
     template <typename T>
     Stream &operator<<(const T &data) {
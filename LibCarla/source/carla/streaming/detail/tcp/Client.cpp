@@ -10,6 +10,7 @@
 #include "carla/Debug.h"
 #include "carla/Exception.h"
 #include "carla/Logging.h"
+#include "carla/MemoryPool.h"
 #include "carla/Time.h"
 
 #include <boost/asio/connect.hpp>
@@ -30,11 +31,11 @@ namespace tcp {
   // ===========================================================================
 
   /// Helper for reading incoming TCP messages. Allocates the whole message in
-  /// a single buffer.
+  /// a single buffer, popped from @a buffer_pool once the size is known.
   class IncomingMessage {
   public:
 
-    explicit IncomingMessage(Buffer &&buffer) : _message(std::move(buffer)) {}
+    explicit IncomingMessage(BufferPool &buffer_pool) : _buffer_pool(buffer_pool) {}
 
     boost::asio::mutable_buffer size_as_buffer() {
       return boost::asio::buffer(&_size, sizeof(_size));
@@ -42,7 +43,7 @@ namespace tcp {
 
     boost::asio::mutable_buffer buffer() {
       DEBUG_ASSERT(_size > 0u);
-      _message.reset(_size);
+      _message = _buffer_pool.Pop(_size);
       return _message.buffer();
     }
 
@@ -56,6 +57,8 @@ namespace tcp {
 
   private:
 
+    BufferPool &_buffer_pool;
+
     message_size_type _size = 0u;
 
     Buffer _message;
@@ -172,7 +175,11 @@ namespace tcp {
 
       // log_debug("streaming client: Client::ReadData");
 
-      auto message = std::make_shared<IncomingMessage>(_buffer_pool->Pop());
+      // The message and the buffer come from pools, so reading at a steady
+      // rate does not allocate.
+      auto message = std::allocate_shared<IncomingMessage>(
+          PoolAllocator<IncomingMessage>{},
+          *_buffer_pool);
 
       auto handle_read_data = [this, self, message](boost::system::error_code ec, size_t DEBUG_ONLY(bytes)) {
         DEBUG_ONLY(log_debug("streaming client: Client::ReadData.handle_read_data", bytes, "bytes"));
@@ -65,12 +65,15 @@ namespace low_level {
       _clients.emplace(token.get_stream_id(), std::move(client));
     }
 
-    void UnSubscribe(token_type token) {
+    /// Return whether a stream was subscribed to @a token.
+    bool UnSubscribe(token_type token) {
       auto it = _clients.find(token.get_stream_id());
-      if (it != _clients.end()) {
-        it->second->Stop();
-        _clients.erase(it);
+      if (it == _clients.end()) {
+        return false;
       }
+      it->second->Stop();
+      _clients.erase(it);
+      return true;
     }
 
   private:
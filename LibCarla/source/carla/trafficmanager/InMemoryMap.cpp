@@ -10,6 +10,8 @@
 #include "carla/trafficmanager/InMemoryMap.h"
 #include <boost/geometry/geometries/box.hpp>
 
+#include <algorithm>
+
 namespace carla {
 namespace traffic_manager {
 
@@ -163,15 +165,13 @@ namespace traffic_manager {
     return true;
   }
 
-  void InMemoryMap::SetUp() {
-
-    // 1. Building segment topology (i.e., defining set of segment predecessors and successors)
+  void InMemoryMap::SetUpSegmentTopology(
+      SegmentTopology &segment_topology,
+      std::unordered_map<crd::RoadId, bool> &is_real_junction) const {
     assert(_world_map != nullptr && "No map reference found.");
     auto waypoint_topology = _world_map->GetTopology();
 
-    SegmentTopology segment_topology;
     std::unordered_map<int64_t, std::pair<std::set<crd::RoadId>, std::set<crd::RoadId>>> std_road_connectivity;
-    std::unordered_map<crd::RoadId, bool> is_real_junction;
 
     for (auto &connection : waypoint_topology) {
       auto &waypoint = connection.first;
@@ -220,6 +220,14 @@ namespace traffic_manager {
         }
       }
     }
+  }
+
+  void InMemoryMap::SetUp() {
+
+    // 1. Building segment topology (i.e., defining set of segment predecessors and successors)
+    SegmentTopology segment_topology;
+    std::unordered_map<crd::RoadId, bool> is_real_junction;
+    SetUpSegmentTopology(segment_topology, is_real_junction);
 
     // 2. Consuming the raw dense topology from cc::Map into SimpleWaypoints.
     SegmentMap segment_map;
@@ -230,94 +238,116 @@ namespace traffic_manager {
     }
 
     // 3. Processing waypoints.
-    auto distance_squared = [](cg::Location l1, cg::Location l2) {
-      return cg::Math::DistanceSquared(l1, l2);
-    };
-    auto square = [](float input) {return std::pow(input, 2);};
-    auto compare_s = [](const SimpleWaypointPtr &swp1, const SimpleWaypointPtr &swp2) {
-      return (swp1->GetWaypoint()->GetDistance() < swp2->GetWaypoint()->GetDistance());
-    };
-    auto wpt_angle = [](cg::Vector3D l1, cg::Vector3D l2) {
-      return cg::Math::GetVectorAngle(l1, l2);
-    };
-    auto max = [](int16_t x, int16_t y) {
-      return x ^ ((x ^ y) & -(x < y));
-    };
-
     GeoGridId geodesic_grid_id_counter = -1;
     for (auto &segment: segment_map) {
+      SetUpSegment(segment.second, geodesic_grid_id_counter, is_real_junction);
+    }
+
+    SetUpSpatialTree();
+
+    // Placing inter-segment connections.
+    for (auto &segment : segment_map) {
+      SegmentId segment_id = segment.first;
       auto &segment_waypoints = segment.second;
 
-      // Generating geodesic grid ids.
-      ++geodesic_grid_id_counter;
+      auto successors = GetSuccessors(segment_id, segment_topology, segment_map);
+      auto predecessors = GetPredecessors(segment_id, segment_topology, segment_map);
+
+      segment_waypoints.front()->SetPreviousWaypoint(predecessors);
+      segment_waypoints.back()->SetNextWaypoint(successors);
+    }
 
-      // Ordering waypoints according to road direction.
-      std::sort(segment_waypoints.begin(), segment_waypoints.end(), compare_s);
-      auto lane_id = segment_waypoints.front()->GetWaypoint()->GetLaneId();
-      if (lane_id > 0) {
-        std::reverse(segment_waypoints.begin(), segment_waypoints.end());
+    // Linking lane change connections.
+    for (auto &swp : dense_topology) {
+      if (!swp->CheckJunction()) {
+        FindAndLinkLaneChange(swp);
       }
+    }
 
-      // Adding more waypoints if the angle is too tight or if they are too distant.
-      for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
-          double distance = std::abs(segment_waypoints.at(i)->GetWaypoint()->GetDistance() - segment_waypoints.at(i+1)->GetWaypoint()->GetDistance());
-          double angle = wpt_angle(segment_waypoints.at(i)->GetTransform().GetForwardVector(), segment_waypoints.at(i+1)->GetTransform().GetForwardVector());
-          int16_t angle_splits = static_cast<int16_t>(angle/MAX_WPT_RADIANS);
-          int16_t distance_splits = static_cast<int16_t>((distance*distance)/MAX_WPT_DISTANCE);
-          auto max_splits = max(angle_splits, distance_splits);
-          if (max_splits >= 1) {
-            // Compute how many waypoints do we need to generate.
-            for (uint16_t j = 0; j < max_splits; ++j) {
-              auto next_waypoints = segment_waypoints.at(i)->GetWaypoint()->GetNext(distance/(max_splits+1));
-              if (next_waypoints.size() != 0) {
-                auto new_waypoint = next_waypoints.front();
-                i++;
-                segment_waypoints.insert(segment_waypoints.begin()+static_cast<int64_t>(i), std::make_shared<SimpleWaypoint>(new_waypoint));
-              } else {
-                // Reached end of the road.
-                break;
-              }
-            }
-          }
+    // Linking any unconnected segments.
+    for (auto &swp : dense_topology) {
+      if (swp->GetNextWaypoint().empty()) {
+        auto neighbour = swp->GetRightWaypoint();
+        if (!neighbour) {
+          neighbour = swp->GetLeftWaypoint();
         }
 
-      // Placing intra-segment connections.
-      cg::Location grid_edge_location = segment_waypoints.front()->GetLocation();
-      for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
-        SimpleWaypointPtr current_waypoint = segment_waypoints.at(i);
-        SimpleWaypointPtr next_waypoint = segment_waypoints.at(i+1);
-        // Assigning grid id.
-        if (distance_squared(grid_edge_location, current_waypoint->GetLocation()) >
-        square(MAX_GEODESIC_GRID_LENGTH)) {
-          ++geodesic_grid_id_counter;
-          grid_edge_location = current_waypoint->GetLocation();
+        if (neighbour) {
+          swp->SetNextWaypoint(neighbour->GetNextWaypoint());
+          for (auto next_waypoint : neighbour->GetNextWaypoint()) {
+            next_waypoint->SetPreviousWaypoint({swp});
+          }
         }
-        current_waypoint->SetGeodesicGridId(geodesic_grid_id_counter);
+      }
+    }
 
-        current_waypoint->SetNextWaypoint({next_waypoint});
-        next_waypoint->SetPreviousWaypoint({current_waypoint});
+    // Specifying a RoadOption for each SimpleWaypoint
+    SetUpRoadOption(dense_topology);
+  }
 
-      }
-      segment_waypoints.back()->SetGeodesicGridId(geodesic_grid_id_counter);
-
-      // Adding simple waypoints to processed dense topology.
-      for (auto swp: segment_waypoints) {
-        // Checking whether the waypoint is in a real junction.
-        auto wpt = swp->GetWaypoint();
-        auto road_id = wpt->GetRoadId();
-        if (wpt->IsJunction() && !is_real_junction.count(road_id)) {
-          swp->SetIsJunction(false);
-        } else {
-          swp->SetIsJunction(swp->GetWaypoint()->IsJunction());
-        }
+  void InMemoryMap::UpdateRoads(const std::vector<crd::RoadId> &road_ids) {
+    assert(_world_map != nullptr && "No map reference found.");
+    const std::unordered_set<crd::RoadId> changed_roads(road_ids.begin(), road_ids.end());
+    auto is_changed = [&](const SimpleWaypointPtr &swp) {
+      return changed_roads.count(swp->GetWaypoint()->GetRoadId()) > 0u;
+    };
 
-        dense_topology.push_back(swp);
+    // 1. Dropping the waypoints of the changed roads and every link to them.
+    GeoGridId geodesic_grid_id_counter = -1;
+    NodeList kept_topology;
+    kept_topology.reserve(dense_topology.size());
+    for (auto &swp : dense_topology) {
+      if (is_changed(swp)) {
+        const cg::Location loc = swp->GetLocation();
+        rtree.remove(std::make_pair(Point3D(loc.x, loc.y, loc.z), swp));
+      } else {
+        swp->RemoveLinksToRoads(changed_roads);
+        geodesic_grid_id_counter = std::max(geodesic_grid_id_counter, swp->GetGeodesicGridId());
+        kept_topology.push_back(swp);
       }
     }
+    dense_topology = std::move(kept_topology);
+    const std::size_t number_of_kept_waypoints = dense_topology.size();
 
-    SetUpSpatialTree();
+    // 2. Building the segment topology of the updated map, the junction flag
+    // of the kept paths may change too.
+    SegmentTopology segment_topology;
+    std::unordered_map<crd::RoadId, bool> is_real_junction;
+    SetUpSegmentTopology(segment_topology, is_real_junction);
+    for (auto &swp : dense_topology) {
+      auto wpt = swp->GetWaypoint();
+      swp->SetIsJunction(wpt->IsJunction() && is_real_junction.count(wpt->GetRoadId()));
+    }
 
-    // Placing inter-segment connections.
+    // 3. Sampling and processing only the changed roads.
+    SegmentMap new_segment_map;
+    for (auto &waypoint_ptr : _world_map->GenerateWaypoints(MAP_RESOLUTION, road_ids)) {
+      new_segment_map[GetSegmentId(waypoint_ptr)].emplace_back(std::make_shared<SimpleWaypoint>(waypoint_ptr));
+    }
+    for (auto &segment : new_segment_map) {
+      SetUpSegment(segment.second, geodesic_grid_id_counter, is_real_junction);
+    }
+    for (auto it = dense_topology.begin() + static_cast<int64_t>(number_of_kept_waypoints);
+         it != dense_topology.end();
+         ++it) {
+      const cg::Location loc = (*it)->GetLocation();
+      rtree.insert(std::make_pair(Point3D(loc.x, loc.y, loc.z), *it));
+    }
+
+    // 4. Placing inter-segment connections. Segments are stored contiguously
+    // in the dense topology, so the kept ones can be regrouped in order.
+    SegmentMap segment_map = std::move(new_segment_map);
+    for (std::size_t i = 0u; i < number_of_kept_waypoints; ++i) {
+      segment_map[GetSegmentId(dense_topology[i])].push_back(dense_topology[i]);
+    }
+    auto filter_changed = [&](NodeList waypoints) {
+      waypoints.erase(
+          std::remove_if(waypoints.begin(), waypoints.end(), [&](const SimpleWaypointPtr &swp) {
+            return !is_changed(swp);
+          }),
+          waypoints.end());
+      return waypoints;
+    };
     for (auto &segment : segment_map) {
       SegmentId segment_id = segment.first;
       auto &segment_waypoints = segment.second;
@@ -325,15 +355,24 @@ namespace traffic_manager {
       auto successors = GetSuccessors(segment_id, segment_topology, segment_map);
       auto predecessors = GetPredecessors(segment_id, segment_topology, segment_map);
 
+      if (!is_changed(segment_waypoints.front())) {
+        // Kept segments are already linked to the other kept segments.
+        successors = filter_changed(std::move(successors));
+        predecessors = filter_changed(std::move(predecessors));
+      }
       segment_waypoints.front()->SetPreviousWaypoint(predecessors);
       segment_waypoints.back()->SetNextWaypoint(successors);
     }
 
-    // Linking lane change connections.
-    for (auto &swp : dense_topology) {
-      if (!swp->CheckJunction()) {
-        FindAndLinkLaneChange(swp);
+    // Lane change links never cross roads, only the new waypoints need them.
+    NodeList affected_waypoints;
+    for (auto it = dense_topology.begin() + static_cast<int64_t>(number_of_kept_waypoints);
+         it != dense_topology.end();
+         ++it) {
+      if (!(*it)->CheckJunction()) {
+        FindAndLinkLaneChange(*it);
       }
+      affected_waypoints.push_back(*it);
     }
 
     // Linking any unconnected segments.
@@ -353,8 +392,107 @@ namespace traffic_manager {
       }
     }
 
-    // Specifying a RoadOption for each SimpleWaypoint
-    SetUpRoadOption();
+    // 5. Recomputing the RoadOption of the new waypoints and of the kept
+    // waypoints leading to them.
+    for (std::size_t i = 0u; i < number_of_kept_waypoints; ++i) {
+      auto &swp = dense_topology[i];
+      const auto next_waypoints = swp->GetNextWaypoint();
+      if (next_waypoints.empty() ||
+          std::any_of(next_waypoints.begin(), next_waypoints.end(), is_changed)) {
+        // Keep the options assigned while traversing a junction.
+        if (swp->GetRoadOption() == RoadOption::RoadEnd) {
+          swp->SetRoadOption(RoadOption::Void);
+        }
+        affected_waypoints.push_back(swp);
+      }
+    }
+    SetUpRoadOption(affected_waypoints);
+  }
+
+  void InMemoryMap::SetUpSegment(
+      NodeList &segment_waypoints,
+      GeoGridId &geodesic_grid_id_counter,
+      const std::unordered_map<crd::RoadId, bool> &is_real_junction) {
+    auto distance_squared = [](cg::Location l1, cg::Location l2) {
+      return cg::Math::DistanceSquared(l1, l2);
+    };
+    auto square = [](float input) {return std::pow(input, 2);};
+    auto compare_s = [](const SimpleWaypointPtr &swp1, const SimpleWaypointPtr &swp2) {
+      return (swp1->GetWaypoint()->GetDistance() < swp2->GetWaypoint()->GetDistance());
+    };
+    auto wpt_angle = [](cg::Vector3D l1, cg::Vector3D l2) {
+      return cg::Math::GetVectorAngle(l1, l2);
+    };
+    auto max = [](int16_t x, int16_t y) {
+      return x ^ ((x ^ y) & -(x < y));
+    };
+
+
+    // Generating geodesic grid ids.
+    ++geodesic_grid_id_counter;
+
+    // Ordering waypoints according to road direction.
+    std::sort(segment_waypoints.begin(), segment_waypoints.end(), compare_s);
+    auto lane_id = segment_waypoints.front()->GetWaypoint()->GetLaneId();
+    if (lane_id > 0) {
+      std::reverse(segment_waypoints.begin(), segment_waypoints.end());
+    }
+
+    // Adding more waypoints if the angle is too tight or if they are too distant.
+    for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
+        double distance = std::abs(segment_waypoints.at(i)->GetWaypoint()->GetDistance() - segment_waypoints.at(i+1)->GetWaypoint()->GetDistance());
+        double angle = wpt_angle(segment_waypoints.at(i)->GetTransform().GetForwardVector(), segment_waypoints.at(i+1)->GetTransform().GetForwardVector());
+        int16_t angle_splits = static_cast<int16_t>(angle/MAX_WPT_RADIANS);
+        int16_t distance_splits = static_cast<int16_t>((distance*distance)/MAX_WPT_DISTANCE);
+        auto max_splits = max(angle_splits, distance_splits);
+        if (max_splits >= 1) {
+          // Compute how many waypoints do we need to generate.
+          for (uint16_t j = 0; j < max_splits; ++j) {
+            auto next_waypoints = segment_waypoints.at(i)->GetWaypoint()->GetNext(distance/(max_splits+1));
+            if (next_waypoints.size() != 0) {
+              auto new_waypoint = next_waypoints.front();
+              i++;
+              segment_waypoints.insert(segment_waypoints.begin()+static_cast<int64_t>(i), std::make_shared<SimpleWaypoint>(new_waypoint));
+            } else {
+              // Reached end of the road.
+              break;
+            }
+          }
+        }
+      }
+
+    // Placing intra-segment connections.
+    cg::Location grid_edge_location = segment_waypoints.front()->GetLocation();
+    for (std::size_t i = 0; i < segment_waypoints.size() - 1; ++i) {
+      SimpleWaypointPtr current_waypoint = segment_waypoints.at(i);
+      SimpleWaypointPtr next_waypoint = segment_waypoints.at(i+1);
+      // Assigning grid id.
+      if (distance_squared(grid_edge_location, current_waypoint->GetLocation()) >
+      square(MAX_GEODESIC_GRID_LENGTH)) {
+        ++geodesic_grid_id_counter;
+        grid_edge_location = current_waypoint->GetLocation();
+      }
+      current_waypoint->SetGeodesicGridId(geodesic_grid_id_counter);
+
+      current_waypoint->SetNextWaypoint({next_waypoint});
+      next_waypoint->SetPreviousWaypoint({current_waypoint});
+
+    }
+    segment_waypoints.back()->SetGeodesicGridId(geodesic_grid_id_counter);
+
+    // Adding simple waypoints to processed dense topology.
+    for (auto swp: segment_waypoints) {
+      // Checking whether the waypoint is in a real junction.
+      auto wpt = swp->GetWaypoint();
+      auto road_id = wpt->GetRoadId();
+      if (wpt->IsJunction() && !is_real_junction.count(road_id)) {
+        swp->SetIsJunction(false);
+      } else {
+        swp->SetIsJunction(swp->GetWaypoint()->IsJunction());
+      }
+
+      dense_topology.push_back(swp);
+    }
   }
 
   void InMemoryMap::SetUpSpatialTree() {
@@ -367,8 +505,8 @@ namespace traffic_manager {
     }
   }
 
-  void InMemoryMap::SetUpRoadOption() {
-    for (auto &swp : dense_topology) {
+  void InMemoryMap::SetUpRoadOption(const NodeList &waypoints) {
+    for (auto &swp : waypoints) {
       std::vector<SimpleWaypointPtr> next_waypoints = swp->GetNextWaypoint();
       std::size_t next_swp_size = next_waypoints.size();
 
@@ -78,6 +78,11 @@ namespace bgi = boost::geometry::index;
     /// This method constructs the local map with a resolution of sampling_resolution.
     void SetUp();
 
+    /// This method rebuilds only the part of the local map belonging to
+    /// @a road_ids after they have been added, replaced or removed from the
+    /// world map by an OpenDRIVE patch.
+    void UpdateRoads(const std::vector<crd::RoadId> &road_ids);
+
     /// This method returns the closest waypoint to a given location on the map.
     SimpleWaypointPtr GetWaypoint(const cg::Location loc) const;
 
@@ -95,8 +100,17 @@ namespace bgi = boost::geometry::index;
     void Save(const std::string& path);
 
     void SetUpDenseTopology();
+    void SetUpSegmentTopology(
+        SegmentTopology &segment_topology,
+        std::unordered_map<crd::RoadId, bool> &is_real_junction) const;
+    /// Sorts, densifies and links the waypoints of a segment and appends them
+    /// to the dense topology.
+    void SetUpSegment(
+        NodeList &segment_waypoints,
+        GeoGridId &geodesic_grid_id_counter,
+        const std::unordered_map<crd::RoadId, bool> &is_real_junction);
     void SetUpSpatialTree();
-    void SetUpRoadOption();
+    void SetUpRoadOption(const NodeList &waypoints);
 
     /// This method is used to find and place lane change links.
     void FindAndLinkLaneChange(SimpleWaypointPtr reference_waypoint);
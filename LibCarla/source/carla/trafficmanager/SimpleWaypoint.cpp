@@ -8,6 +8,8 @@
 
 #include "carla/trafficmanager/SimpleWaypoint.h"
 
+#include <algorithm>
+
 namespace carla {
 namespace traffic_manager {
 
@@ -84,6 +86,29 @@ namespace traffic_manager {
     }
   }
 
+  bool SimpleWaypoint::RemoveLinksToRoads(const std::unordered_set<carla::road::RoadId> &road_ids) {
+    auto is_removed = [&](const SimpleWaypointPtr &simple_waypoint) {
+      return simple_waypoint != nullptr &&
+          road_ids.count(simple_waypoint->GetWaypoint()->GetRoadId()) > 0u;
+    };
+    auto remove_from = [&](std::vector<SimpleWaypointPtr> &waypoints) {
+      const auto size = waypoints.size();
+      waypoints.erase(std::remove_if(waypoints.begin(), waypoints.end(), is_removed), waypoints.end());
+      return waypoints.size() != size;
+    };
+    bool removed = remove_from(next_waypoints);
+    removed = remove_from(previous_waypoints) || removed;
+    if (is_removed(next_left_waypoint)) {
+      next_left_waypoint = nullptr;
+      removed = true;
+    }
+    if (is_removed(next_right_waypoint)) {
+      next_right_waypoint = nullptr;
+      removed = true;
+    }
+    return removed;
+  }
+
   float SimpleWaypoint::Distance(const cg::Location &location) const {
     return GetLocation().Distance(location);
   }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <memory.h>
+#include <unordered_set>
 
 #include "carla/client/Waypoint.h"
 #include "carla/geom/Location.h"
@@ -99,6 +100,11 @@ namespace traffic_manager {
     /// This method is used to get the closest right waypoint for a lane change.
     SimpleWaypointPtr GetRightWaypoint();
 
+    /// This method removes the links (next, previous, left and right) to the
+    /// waypoints on the roads in @a road_ids. Returns true if any link was
+    /// removed.
+    bool RemoveLinksToRoads(const std::unordered_set<carla::road::RoadId> &road_ids);
+
     /// Accessor methods for geodesic grid id.
     void SetGeodesicGridId(GeoGridId _geodesic_grid_id);
     GeoGridId GetGeodesicGridId();
@@ -131,6 +131,29 @@ void TrafficManagerLocal::SetupLocalMap() {
     log_warning("No InMemoryMap cache found. Setting up local map. This may take a while...");
     local_map->SetUp();
   }
+
+  map_change_callback_id = world_map->RegisterOnChangeEvent([this](const crd::MapChange &change) {
+    std::lock_guard<std::mutex> lock(map_change_mutex);
+    pending_map_changes.insert(change.roads.begin(), change.roads.end());
+  });
+}
+
+void TrafficManagerLocal::UpdateLocalMap() {
+  std::vector<crd::RoadId> changed_roads;
+  {
+    std::lock_guard<std::mutex> lock(map_change_mutex);
+    if (pending_map_changes.empty()) {
+      return;
+    }
+    changed_roads.assign(pending_map_changes.begin(), pending_map_changes.end());
+    pending_map_changes.clear();
+  }
+  local_map->UpdateRoads(changed_roads);
+
+  // Buffered waypoints may belong to the replaced roads.
+  buffer_map.clear();
+  track_traffic.Clear();
+  localization_stage.Reset();
 }
 
 void TrafficManagerLocal::Start() {
@@ -181,6 +204,9 @@ void TrafficManagerLocal::Run() {
     }
 
     std::unique_lock<std::mutex> registration_lock(registration_mutex);
+    // Rebuilding the parts of the local map changed by OpenDRIVE patches.
+    UpdateLocalMap();
+
     // Updating simulation state, actor life cycle and performing necessary cleanup.
     alsm.Update();
 
@@ -243,17 +269,41 @@ void TrafficManagerLocal::Run() {
 
     // Sending the current cycle's batch command to the simulator.
     if (synchronous_mode) {
-      episode_proxy.Lock()->ApplyBatchSync(control_frame, false);
+      SendControlFrame(true);
       step_end.store(true);
       step_end_trigger.notify_one();
     } else {
-      if (control_frame.size() > 0){
-        episode_proxy.Lock()->ApplyBatchSync(control_frame, false);
-      }
+      SendControlFrame(false);
     }
   }
 }
 
+void TrafficManagerLocal::SendControlFrame(bool always_send) {
+  using Command = carla::rpc::Command;
+  control_batch.clear();
+  other_commands.clear();
+  for (const Command &command : control_frame) {
+    if (auto *control = boost::get<Command::ApplyVehicleControl>(&command.command)) {
+      control_batch.AddVehicleControl(control->actor, control->control);
+    } else if (auto *lights = boost::get<Command::SetVehicleLightState>(&command.command)) {
+      control_batch.AddVehicleLightState(lights->actor, lights->light_state);
+    } else {
+      other_commands.emplace_back(command);
+    }
+  }
+  auto simulator = episode_proxy.Lock();
+  // The rest of the commands go first without waiting, the server applies
+  // them in order before the control batch, which is the only blocking call
+  // of the frame.
+  if (!other_commands.empty()) {
+    simulator->ApplyBatch(std::move(other_commands), false);
+    other_commands.clear();
+  }
+  if (always_send || !control_frame.empty()) {
+    simulator->ApplyControlBatchSync(control_batch, false);
+  }
+}
+
 bool TrafficManagerLocal::SynchronousTick() {
   if (parameters.GetSynchronousMode()) {
     step_begin.store(true);
@@ -309,7 +359,11 @@ void TrafficManagerLocal::Release() {
 
   Stop();
 
+  if (local_map != nullptr) {
+    local_map->GetMap().RemoveOnChangeEvent(map_change_callback_id);
+  }
   local_map.reset();
+  pending_map_changes.clear();
 }
 
 void TrafficManagerLocal::Reset() {
@@ -10,6 +10,7 @@
 #include <chrono>
 #include <mutex>
 #include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "carla/client/detail/EpisodeProxy.h"
@@ -17,6 +18,7 @@
 #include "carla/client/World.h"
 #include "carla/Memory.h"
 #include "carla/rpc/Command.h"
+#include "carla/rpc/ControlBatch.h"
 
 #include "carla/trafficmanager/AtomicActorSet.h"
 #include "carla/trafficmanager/InMemoryMap.h"
@@ -68,6 +70,12 @@ private:
   std::vector<ActorId> vehicle_id_list;
   /// Pointer to local map cache.
   LocalMapPtr local_map;
+  /// Roads changed by OpenDRIVE patches since the last update cycle.
+  std::unordered_set<crd::RoadId> pending_map_changes;
+  /// Mutex protecting the pending map changes.
+  std::mutex map_change_mutex;
+  /// Id of the map change callback registered on the world map.
+  size_t map_change_callback_id {0u};
   /// Structures to hold waypoint buffers for all vehicles.
   BufferMap buffer_map;
   /// Object for tracking paths of the traffic vehicles.
@@ -86,6 +94,11 @@ private:
   TLFrame tl_frame;
   /// Array to hold output data of motion planning.
   ControlFrame control_frame;
+  /// Vehicle controls and light states of control_frame, sent in columnar
+  /// form.
+  carla::rpc::ControlBatch control_batch;
+  /// Commands of control_frame that do not fit in control_batch.
+  ControlFrame other_commands;
   /// Variable to keep track of currently reserved array space for frames.
   uint64_t current_reserved_capacity {0u};
   /// Various stages representing core operations of traffic manager.
@@ -121,6 +134,16 @@ private:
   /// Method to check if all traffic lights are frozen in a group.
   bool CheckAllFrozen(TLGroup tl_to_freeze);
 
+  /// Method to send control_frame to the simulator. Vehicle controls and
+  /// light states go in a ControlBatch, the rest as regular commands sent
+  /// asynchronously before it. Waits for the ControlBatch only, if
+  /// @a always_send is true it is sent even if empty.
+  void SendControlFrame(bool always_send);
+
+  /// Method to rebuild the parts of the local map changed by OpenDRIVE
+  /// patches applied to the world map.
+  void UpdateLocalMap();
+
 public:
   /// Private constructor for singleton lifecycle management.
   TrafficManagerLocal(std::vector<float> longitudinal_PID_parameters,
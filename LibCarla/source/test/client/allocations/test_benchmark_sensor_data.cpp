@@ -0,0 +1,122 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/BufferPool.h>
+#include <carla/StopWatch.h>
+#include <carla/sensor/Deserializer.h>
+#include <carla/sensor/SensorData.h>
+#include <carla/sensor/SensorRegistry.h>
+#include <carla/sensor/s11n/ImageSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// =============================================================================
+// -- Global allocation counter ------------------------------------------------
+// =============================================================================
+
+// Replacing the global operator new affects the whole executable, this file is
+// therefore built into its own test binary (libcarla_test_client_allocations).
+
+static std::atomic_size_t ALLOCATION_COUNT{0u};
+
+void *operator new(size_t size) {
+  ++ALLOCATION_COUNT;
+  if (void *pointer = std::malloc(size > 0u ? size : 1u)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+// =============================================================================
+// -- Benchmark ----------------------------------------------------------------
+// =============================================================================
+
+using namespace carla::sensor;
+
+static constexpr uint64_t CAMERA_INDEX = SensorRegistry::get<ASceneCaptureCamera *>::index;
+
+static constexpr uint32_t WIDTH = 200u;
+static constexpr uint32_t HEIGHT = 150u;
+
+static constexpr size_t MESSAGE_SIZE =
+    s11n::SensorHeaderSerializer::header_offset +
+    s11n::ImageSerializer::header_offset +
+    4u * WIDTH * HEIGHT;
+
+/// Write an image message as the server sends it into @a message.
+static void FillMessage(carla::Buffer &message, uint64_t frame) {
+  const auto header = s11n::SensorHeaderSerializer::Serialize(
+      CAMERA_INDEX, frame, 0.05 * static_cast<double>(frame), carla::rpc::Transform{});
+  const s11n::ImageSerializer::ImageHeader image_header{WIDTH, HEIGHT, 90.0f};
+  std::memcpy(message.data(), header.data(), header.size());
+  std::memcpy(message.data() + header.size(), &image_header, sizeof(image_header));
+}
+
+/// Number of allocations per frame of @a number_of_sensors receiving one
+/// image each, once the pools are warm.
+template <typename MakeBufferT>
+static double benchmark_frames(
+    const char *name,
+    size_t number_of_sensors,
+    MakeBufferT &&make_buffer) {
+  constexpr auto warm_up_frames = 10u;
+  constexpr auto frames = 100u;
+  std::vector<carla::SharedPtr<SensorData>> measurements;
+  measurements.reserve(number_of_sensors);
+  size_t allocations = 0u;
+  carla::StopWatch stop_watch;
+  for (auto frame = 0u; frame < warm_up_frames + frames; ++frame) {
+    if (frame == warm_up_frames) {
+      allocations = ALLOCATION_COUNT.load();
+      stop_watch.Restart();
+    }
+    for (auto i = 0u; i < number_of_sensors; ++i) {
+      auto message = make_buffer();
+      FillMessage(message, frame);
+      measurements.emplace_back(Deserializer::Deserialize(std::move(message)));
+      EXPECT_EQ(measurements.back()->GetFrame(), frame);
+    }
+    // The user callbacks are done with this frame's measurements.
+    measurements.clear();
+  }
+  stop_watch.Stop();
+  const auto per_frame =
+      static_cast<double>(ALLOCATION_COUNT.load() - allocations) / frames;
+  carla::logging::log(
+      name, number_of_sensors, "sensors:",
+      per_frame, "allocations per frame,",
+      stop_watch.GetElapsedTime() / frames, "ms per frame");
+  return per_frame;
+}
+
+TEST(benchmark_sensor_data, allocations_per_frame_20_sensors) {
+  constexpr auto number_of_sensors = 20u;
+  const auto unpooled = benchmark_frames("unpooled buffers", number_of_sensors, []() {
+    return carla::Buffer(MESSAGE_SIZE);
+  });
+  auto pool = std::make_shared<carla::BufferPool>();
+  const auto pooled = benchmark_frames("pooled buffers", number_of_sensors, [&]() {
+    return pool->Pop(MESSAGE_SIZE);
+  });
+  ASSERT_LT(pooled, unpooled);
+  // Neither the buffers nor the sensor data should allocate in steady state.
+  ASSERT_EQ(pooled, 0.0);
+}
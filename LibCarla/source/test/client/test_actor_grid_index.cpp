@@ -0,0 +1,63 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/ActorGridIndex.h>
+#include <carla/geom/Math.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using carla::client::detail::ActorGridIndex;
+using carla::geom::Location;
+
+static std::vector<size_t> Query(
+    const ActorGridIndex &index,
+    const Location &center,
+    float radius) {
+  std::vector<size_t> result;
+  index.ForEachInRadius(center, radius, [&](size_t position) {
+    result.emplace_back(position);
+  });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+TEST(actor_grid_index, matches_brute_force) {
+  std::mt19937 rng(42u);
+  std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+  std::vector<Location> locations;
+  for (auto i = 0u; i < 2000u; ++i) {
+    locations.emplace_back(coordinate(rng), coordinate(rng), 0.1f * coordinate(rng));
+  }
+  ActorGridIndex index(50.0f);
+  index.Build(locations.begin(), locations.end(), [](const Location &location) {
+    return location;
+  });
+  for (auto radius : {0.0f, 10.0f, 75.0f, 300.0f, 5000.0f}) {
+    for (auto i = 0u; i < 20u; ++i) {
+      const Location center{coordinate(rng), coordinate(rng), 0.0f};
+      std::vector<size_t> expected;
+      for (auto j = 0u; j < locations.size(); ++j) {
+        if (carla::geom::Math::DistanceSquared(locations[j], center) <= radius * radius) {
+          expected.emplace_back(j);
+        }
+      }
+      ASSERT_EQ(Query(index, center, radius), expected);
+    }
+  }
+}
+
+TEST(actor_grid_index, empty) {
+  ActorGridIndex index;
+  std::vector<Location> locations;
+  index.Build(locations.begin(), locations.end(), [](const Location &location) {
+    return location;
+  });
+  ASSERT_TRUE(Query(index, Location{}, 100.0f).empty());
+}
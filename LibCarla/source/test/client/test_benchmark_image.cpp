@@ -0,0 +1,90 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/StopWatch.h>
+#include <carla/image/ImageConverter.h>
+#include <carla/image/ImageKernels.h>
+#include <carla/image/ImageView.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace carla::image;
+using Color = ImageKernels::Color;
+
+static std::vector<Color> MakeImage(size_t width, size_t height) {
+  std::vector<Color> image(width * height);
+  for (auto i = 0u; i < image.size(); ++i) {
+    image[i] = Color{
+        static_cast<uint8_t>(i & 0xFFu),
+        static_cast<uint8_t>((i >> 8u) & 0xFFu),
+        static_cast<uint8_t>((i >> 16u) & 0xFFu)};
+  }
+  return image;
+}
+
+template <typename ColorConverterT>
+static void benchmark_color_converter(const char *name, size_t width, size_t height) {
+  constexpr auto iterations = 20u;
+  const auto source = MakeImage(width, height);
+  auto image = source;
+  auto view = boost::gil::interleaved_view(
+      width,
+      height,
+      reinterpret_cast<boost::gil::bgra8_pixel_t *>(image.data()),
+      static_cast<long>(sizeof(Color) * width));
+
+  carla::StopWatch stop_watch;
+  for (auto i = 0u; i < iterations; ++i) {
+    std::memcpy(image.data(), source.data(), sizeof(Color) * source.size());
+    ImageConverter::ConvertInPlace(view, ColorConverterT());
+  }
+  stop_watch.Stop();
+  const auto gil_time = stop_watch.GetElapsedTime();
+  const auto expected = image;
+
+  stop_watch.Restart();
+  for (auto i = 0u; i < iterations; ++i) {
+    std::memcpy(image.data(), source.data(), sizeof(Color) * source.size());
+    ImageKernels::ConvertInPlace(image.data(), image.size(), ColorConverterT());
+  }
+  stop_watch.Stop();
+  const auto kernels_time = stop_watch.GetElapsedTime();
+
+  ASSERT_EQ(image, expected);
+  carla::logging::log(
+      name, width, 'x', height, ':',
+      "gil", gil_time / iterations, "ms,",
+      "kernels", kernels_time / iterations, "ms");
+}
+
+TEST(benchmark_image, depth_1920x1080) {
+  benchmark_color_converter<ColorConverter::Depth>("Depth", 1920u, 1080u);
+}
+
+TEST(benchmark_image, logarithmic_depth_1920x1080) {
+  benchmark_color_converter<ColorConverter::LogarithmicDepth>("LogarithmicDepth", 1920u, 1080u);
+}
+
+TEST(benchmark_image, semantic_segmentation_1920x1080) {
+  benchmark_color_converter<ColorConverter::CityScapesPalette>("CityScapesPalette", 1920u, 1080u);
+}
+
+TEST(benchmark_image, depth_in_meters_1920x1080) {
+  constexpr auto iterations = 20u;
+  const auto image = MakeImage(1920u, 1080u);
+  std::vector<float> depth(image.size());
+  carla::StopWatch stop_watch;
+  for (auto i = 0u; i < iterations; ++i) {
+    ImageKernels::DecodeDepthInMeters(image.data(), image.size(), depth.data());
+  }
+  stop_watch.Stop();
+  carla::logging::log(
+      "DepthInMeters 1920x1080:",
+      stop_watch.GetElapsedTime() / iterations, "ms");
+}
@@ -0,0 +1,144 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/streaming/CallbackExecutor.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace carla::streaming;
+
+namespace {
+
+  /// Records the messages received, the callback blocks while the consumer
+  /// is paused.
+  class Consumer {
+  public:
+
+    CallbackExecutor::callback_type MakeCallback() {
+      return [this](carla::Buffer message) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _received.emplace_back(util::buffer::as_string(message));
+        _cv.notify_all();
+        _cv.wait(lock, [this]() { return !_paused; });
+      };
+    }
+
+    void Pause() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _paused = true;
+    }
+
+    void Resume() {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _paused = false;
+      _cv.notify_all();
+    }
+
+    std::vector<std::string> WaitFor(size_t count) {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _cv.wait_for(lock, 1s, [&]() { return _received.size() >= count; });
+      return _received;
+    }
+
+  private:
+
+    std::mutex _mutex;
+
+    std::condition_variable _cv;
+
+    bool _paused = false;
+
+    std::vector<std::string> _received;
+  };
+
+} // namespace
+
+static carla::Buffer Message(const std::string &text) {
+  return carla::Buffer(boost::asio::buffer(text));
+}
+
+static std::vector<std::string> Strings(std::initializer_list<const char *> list) {
+  return {list.begin(), list.end()};
+}
+
+static void WaitForStats(const CallbackExecutor &executor, uint64_t delivered) {
+  for (auto i = 0u; i < 100u; ++i) {
+    if (executor.GetStats(0u)->delivered >= delivered) {
+      return;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+}
+
+TEST(callback_executor, keeps_order) {
+  constexpr auto number_of_messages = 200u;
+  Consumer consumer;
+  CallbackExecutor executor;
+  executor.EnsureWorkerThreads(4u);
+  auto callback = executor.Wrap(0u, consumer.MakeCallback(), number_of_messages, OverflowPolicy::DropNewest);
+  std::vector<std::string> expected;
+  for (auto i = 0u; i < number_of_messages; ++i) {
+    expected.emplace_back(std::to_string(i));
+    callback(Message(expected.back()));
+  }
+  ASSERT_EQ(consumer.WaitFor(number_of_messages), expected);
+  WaitForStats(executor, number_of_messages);
+  ASSERT_EQ(executor.GetStats(0u)->dropped, 0u);
+}
+
+static void test_overflow(OverflowPolicy policy, const std::vector<std::string> &expected) {
+  Consumer consumer;
+  CallbackExecutor executor;
+  executor.EnsureWorkerThreads(2u);
+  auto callback = executor.Wrap(0u, consumer.MakeCallback(), 2u, policy);
+  // Keep the callback busy with the first message while the rest queue up.
+  consumer.Pause();
+  callback(Message("0"));
+  ASSERT_EQ(consumer.WaitFor(1u).size(), 1u);
+  for (auto text : {"1", "2", "3", "4", "5"}) {
+    callback(Message(text));
+  }
+  auto stats = executor.GetStats(0u);
+  ASSERT_TRUE(stats != boost::none);
+  ASSERT_EQ(stats->queue_size, 2u);
+  ASSERT_EQ(stats->max_queue_size, 2u);
+  ASSERT_EQ(stats->dropped, 3u);
+  consumer.Resume();
+  ASSERT_EQ(consumer.WaitFor(expected.size()), expected);
+  WaitForStats(executor, expected.size());
+  ASSERT_EQ(executor.GetStats(0u)->delivered, expected.size());
+}
+
+TEST(callback_executor, drop_oldest) {
+  test_overflow(OverflowPolicy::DropOldest, Strings({"0", "4", "5"}));
+}
+
+TEST(callback_executor, drop_newest) {
+  test_overflow(OverflowPolicy::DropNewest, Strings({"0", "1", "2"}));
+}
+
+TEST(callback_executor, remove) {
+  Consumer consumer;
+  CallbackExecutor executor;
+  executor.EnsureWorkerThreads(1u);
+  auto callback = executor.Wrap(0u, consumer.MakeCallback(), 4u, OverflowPolicy::DropOldest);
+  consumer.Pause();
+  callback(Message("0"));
+  ASSERT_EQ(consumer.WaitFor(1u).size(), 1u);
+  callback(Message("1"));
+  executor.Remove(0u);
+  ASSERT_TRUE(executor.GetStats(0u) == boost::none);
+  callback(Message("2"));
+  consumer.Resume();
+  std::this_thread::sleep_for(20ms);
+  ASSERT_EQ(consumer.WaitFor(1u), Strings({"0"}));
+}
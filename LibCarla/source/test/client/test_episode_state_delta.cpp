@@ -0,0 +1,229 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/WorldSnapshot.h>
+#include <carla/client/detail/EpisodeState.h>
+#include <carla/sensor/Deserializer.h>
+#include <carla/sensor/SensorRegistry.h>
+#include <carla/sensor/data/RawEpisodeState.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace carla::sensor;
+using carla::client::detail::EpisodeState;
+using data::ActorDynamicState;
+using Serializer = s11n::EpisodeStateSerializer;
+
+static ActorDynamicState MakeState(carla::ActorId id, float x) {
+  ActorDynamicState state;
+  std::memset(static_cast<void *>(&state), 0, sizeof(state));
+  state.id = id;
+  state.transform.location.x = x;
+  return state;
+}
+
+/// Encode a message as FWorldObserver does, a delta if @a previous is not
+/// null.
+static carla::SharedPtr<SensorData> Encode(
+    uint64_t sequence,
+    const std::vector<ActorDynamicState> &actors,
+    const std::vector<ActorDynamicState> *previous = nullptr) {
+  Serializer::Header header;
+  std::memset(static_cast<void *>(&header), 0, sizeof(header));
+  header.episode_id = 1u;
+  header.sequence = sequence;
+  header.encoding = previous == nullptr ? Serializer::Encoding::Keyframe : Serializer::Encoding::Delta;
+  std::vector<unsigned char> payload(sizeof(header));
+  std::memcpy(payload.data(), &header, sizeof(header));
+  auto append = [&](const void *data, size_t size) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+    payload.insert(payload.end(), bytes, bytes + size);
+  };
+  if (previous == nullptr) {
+    for (auto &&actor : actors) {
+      append(&actor, sizeof(actor));
+    }
+  } else {
+    Serializer::DeltaHeader delta_header{0u, 0u};
+    std::vector<unsigned char> records;
+    for (auto &&actor : actors) {
+      uint8_t fields = Serializer::AllFields;
+      for (auto &&old : *previous) {
+        if (old.id == actor.id) {
+          fields = Serializer::GetChangedFields(old, actor);
+        }
+      }
+      if (fields != 0u) {
+        const auto offset = records.size();
+        records.resize(offset + Serializer::GetDeltaRecordSize(fields));
+        auto *end = Serializer::WriteDeltaRecord(records.data() + offset, actor, fields);
+        EXPECT_EQ(end, records.data() + records.size());
+        ++delta_header.number_of_records;
+      }
+    }
+    std::vector<carla::ActorId> removed;
+    for (auto &&old : *previous) {
+      if (std::none_of(actors.begin(), actors.end(), [&](auto &&a) { return a.id == old.id; })) {
+        removed.emplace_back(old.id);
+      }
+    }
+    delta_header.number_of_removed_actors = static_cast<uint32_t>(removed.size());
+    append(&delta_header, sizeof(delta_header));
+    append(records.data(), records.size());
+    append(removed.data(), removed.size() * sizeof(carla::ActorId));
+  }
+  const auto sensor_header = s11n::SensorHeaderSerializer::Serialize(
+      SensorRegistry::get<FWorldObserver *>::index, sequence, 0.0, carla::rpc::Transform{});
+  carla::Buffer message(sensor_header.size() + payload.size());
+  std::memcpy(message.data(), sensor_header.data(), sensor_header.size());
+  std::memcpy(message.data() + sensor_header.size(), payload.data(), payload.size());
+  return Deserializer::Deserialize(std::move(message));
+}
+
+static const data::RawEpisodeState &Cast(const carla::SharedPtr<SensorData> &data) {
+  return static_cast<const data::RawEpisodeState &>(*data);
+}
+
+TEST(episode_state_delta, changed_fields) {
+  auto a = MakeState(1u, 1.0f);
+  auto b = a;
+  ASSERT_EQ(Serializer::GetChangedFields(a, b), 0u);
+  b.velocity.y = 2.0f;
+  b.state.vehicle_data.speed_limit = 30.0f;
+  ASSERT_EQ(
+      Serializer::GetChangedFields(a, b),
+      Serializer::VelocityField | Serializer::TypeDependentField);
+  ASSERT_EQ(
+      Serializer::GetDeltaRecordSize(Serializer::AllFields),
+      sizeof(Serializer::DeltaRecordHeader) + sizeof(ActorDynamicState) - sizeof(carla::ActorId));
+}
+
+TEST(episode_state_delta, apply) {
+  const std::vector<ActorDynamicState> frame1 = {
+      MakeState(1u, 1.0f), MakeState(2u, 2.0f), MakeState(3u, 3.0f)};
+  auto keyframe = Encode(1u, frame1);
+  auto initial = std::make_shared<EpisodeState>(1u);
+  ASSERT_TRUE(initial->CanBeUpdatedWith(Cast(keyframe)));
+  auto state1 = std::make_shared<EpisodeState>(Cast(keyframe), *initial);
+  ASSERT_EQ(state1->size(), 3u);
+  ASSERT_EQ(state1->GetSequence(), 1u);
+
+  // Actor 1 does not change, 2 moves, 3 is destroyed and 4 spawned.
+  std::vector<ActorDynamicState> frame2 = {
+      MakeState(1u, 1.0f), MakeState(2u, 5.0f), MakeState(4u, 4.0f)};
+  frame2[1].velocity.x = 3.0f;
+  auto delta = Encode(2u, frame2, &frame1);
+  ASSERT_TRUE(Cast(delta).IsDelta());
+  ASSERT_EQ(Cast(delta).size(), 0u);
+  ASSERT_EQ(Cast(delta).GetDeltaHeader().number_of_records, 2u);
+  ASSERT_EQ(Cast(delta).GetDeltaHeader().number_of_removed_actors, 1u);
+  ASSERT_EQ(Cast(delta).GetRemovedActorId(0u), 3u);
+
+  // A delta can only be applied on top of the previous message.
+  ASSERT_FALSE(initial->CanBeUpdatedWith(Cast(delta)));
+  ASSERT_TRUE(state1->CanBeUpdatedWith(Cast(delta)));
+  auto state2 = std::make_shared<EpisodeState>(Cast(delta), *state1);
+  ASSERT_EQ(state2->size(), 3u);
+  ASSERT_FALSE(state2->ContainsActorSnapshot(3u));
+  ASSERT_EQ(state2->GetActorSnapshot(1u).transform.location.x, 1.0f);
+  ASSERT_EQ(state2->GetActorSnapshot(2u).transform.location.x, 5.0f);
+  ASSERT_EQ(state2->GetActorSnapshot(2u).velocity.x, 3.0f);
+  ASSERT_EQ(state2->GetActorSnapshot(4u).transform.location.x, 4.0f);
+  std::vector<carla::ActorId> ids;
+  for (auto id : state2->GetActorIds()) {
+    ids.emplace_back(id);
+  }
+  ASSERT_EQ(ids, (std::vector<carla::ActorId>{1u, 2u, 4u}));
+
+  // The previous state is not modified.
+  ASSERT_EQ(state1->GetActorSnapshot(2u).transform.location.x, 2.0f);
+  ASSERT_TRUE(state1->ContainsActorSnapshot(3u));
+
+  // An empty delta keeps every actor.
+  auto empty = Encode(3u, frame2, &frame2);
+  ASSERT_EQ(Cast(empty).GetDeltaHeader().number_of_records, 0u);
+  auto state3 = std::make_shared<EpisodeState>(Cast(empty), *state2);
+  ASSERT_EQ(state3->size(), 3u);
+  ASSERT_EQ(state3->GetActorSnapshot(2u).transform.location.x, 5.0f);
+}
+
+TEST(episode_state_delta, skip_delta) {
+  const std::vector<ActorDynamicState> frame1 = {MakeState(1u, 1.0f), MakeState(2u, 2.0f)};
+  std::vector<ActorDynamicState> frame2 = frame1;
+  frame2[0u].transform.location.x = 4.0f;
+  std::vector<ActorDynamicState> frame3 = frame2;
+  frame3[1u].transform.location.x = 6.0f;
+  auto initial = std::make_shared<EpisodeState>(1u);
+  auto state1 = std::make_shared<EpisodeState>(Cast(Encode(1u, frame1)), *initial);
+  ASSERT_FALSE(state1->IsStale());
+
+  // Delta 2 is lost, delta 3 only advances the timestamp.
+  auto delta3 = Encode(3u, frame3, &frame2);
+  ASSERT_FALSE(state1->CanBeUpdatedWith(Cast(delta3)));
+  auto state3 = std::make_shared<EpisodeState>(Cast(delta3), *state1);
+  ASSERT_EQ(state3->GetFrame(), 3u);
+  ASSERT_EQ(state3->GetSequence(), 0u);
+  ASSERT_TRUE(state3->IsStale());
+  ASSERT_TRUE(carla::client::WorldSnapshot(state3).IsStale());
+  ASSERT_EQ(state3->size(), 2u);
+  ASSERT_EQ(state3->GetActorSnapshot(1u).transform.location.x, 1.0f);
+  ASSERT_EQ(state3->GetActorSnapshot(2u).transform.location.x, 2.0f);
+
+  // Nor the following deltas update the actors until a keyframe arrives.
+  auto delta4 = Encode(4u, frame3, &frame3);
+  ASSERT_FALSE(state3->CanBeUpdatedWith(Cast(delta4)));
+  auto state4 = std::make_shared<EpisodeState>(Cast(delta4), *state3);
+  ASSERT_EQ(state4->GetFrame(), 4u);
+  ASSERT_TRUE(state4->IsStale());
+  auto keyframe = Encode(5u, frame3);
+  ASSERT_TRUE(state4->CanBeUpdatedWith(Cast(keyframe)));
+  auto state5 = std::make_shared<EpisodeState>(Cast(keyframe), *state4);
+  ASSERT_EQ(state5->GetSequence(), 5u);
+  ASSERT_FALSE(state5->IsStale());
+  ASSERT_EQ(state5->GetActorSnapshot(1u).transform.location.x, 4.0f);
+  ASSERT_EQ(state5->GetActorSnapshot(2u).transform.location.x, 6.0f);
+}
+
+TEST(episode_state_delta, kinematics) {
+  std::vector<ActorDynamicState> frame1 = {
+      MakeState(7u, 1.0f), MakeState(3u, 2.0f), MakeState(5u, 3.0f)};
+  frame1[1].velocity.y = 4.0f;
+  frame1[2].transform.rotation.yaw = 90.0f;
+  auto keyframe = Encode(1u, frame1);
+  auto initial = std::make_shared<EpisodeState>(1u);
+  auto state1 = std::make_shared<EpisodeState>(Cast(keyframe), *initial);
+  const auto &kinematics = state1->GetKinematics();
+  ASSERT_EQ(&kinematics, &state1->GetKinematics());
+  ASSERT_EQ(kinematics.size(), 3u);
+  ASSERT_EQ(kinematics.ids, (std::vector<carla::ActorId>{7u, 3u, 5u}));
+  ASSERT_EQ(kinematics.transforms.size(), 3u);
+  ASSERT_EQ(kinematics.velocities.size(), 3u);
+  ASSERT_EQ(kinematics.angular_velocities.size(), 3u);
+  ASSERT_EQ(kinematics.accelerations.size(), 3u);
+  ASSERT_EQ(kinematics.transforms[0u].location.x, 1.0f);
+  ASSERT_EQ(kinematics.velocities[1u].y, 4.0f);
+  ASSERT_EQ(kinematics.transforms[2u].rotation.yaw, 90.0f);
+
+  // The columns follow the order of the iterators, also after a delta
+  // removes actors.
+  std::vector<ActorDynamicState> frame2 = {frame1[0u], frame1[2u], MakeState(9u, 6.0f)};
+  auto delta = Encode(2u, frame2, &frame1);
+  auto state2 = std::make_shared<EpisodeState>(Cast(delta), *state1);
+  ASSERT_EQ(state2->GetKinematics().ids, (std::vector<carla::ActorId>{7u, 5u, 9u}));
+  size_t position = 0u;
+  for (auto &&snapshot : *state2) {
+    ASSERT_EQ(state2->GetKinematics().transforms[position].location.x, snapshot.transform.location.x);
+    ++position;
+  }
+  ASSERT_TRUE(state2->ContainsActorSnapshot(9u));
+  ASSERT_FALSE(state2->ContainsActorSnapshot(3u));
+  ASSERT_EQ(state2->GetActorSnapshot(5u).transform.rotation.yaw, 90.0f);
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/FrameBundler.h>
+#include <carla/sensor/SensorData.h>
+
+using namespace std::chrono_literals;
+using carla::client::detail::FrameBundler;
+
+namespace {
+
+  class MockSensorData : public carla::sensor::SensorData {
+  public:
+
+    MockSensorData(size_t frame)
+      : SensorData(frame, 0.0, carla::rpc::Transform{}) {}
+  };
+
+} // namespace
+
+static auto Data(size_t frame) {
+  return carla::MakeShared<MockSensorData>(frame);
+}
+
+TEST(frame_bundler, complete_frames) {
+  FrameBundler bundler(3u, carla::time_duration::seconds(0u), false);
+  const auto now = FrameBundler::clock::now();
+  ASSERT_TRUE(bundler.Push(0u, Data(1u), now).empty());
+  ASSERT_TRUE(bundler.Push(2u, Data(1u), now).empty());
+  ASSERT_TRUE(bundler.Push(0u, Data(2u), now).empty());
+  auto result = bundler.Push(1u, Data(1u), now);
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_EQ(result[0u]->GetFrame(), 1u);
+  ASSERT_TRUE(result[0u]->IsComplete());
+  ASSERT_EQ(result[0u]->size(), 3u);
+  for (auto &data : *result[0u]) {
+    ASSERT_NE(data, nullptr);
+    ASSERT_EQ(data->GetFrame(), 1u);
+  }
+  // Late data is discarded.
+  ASSERT_TRUE(bundler.Push(1u, Data(1u), now).empty());
+  ASSERT_EQ(bundler.GetNumberOfDroppedFrames(), 0u);
+}
+
+TEST(frame_bundler, incomplete_frames) {
+  for (bool allow_partial : {false, true}) {
+    FrameBundler bundler(2u, carla::time_duration::seconds(0u), allow_partial);
+    const auto now = FrameBundler::clock::now();
+    // Sensor 1 ticks every other frame.
+    ASSERT_TRUE(bundler.Push(0u, Data(1u), now).empty());
+    ASSERT_TRUE(bundler.Push(0u, Data(2u), now).empty());
+    ASSERT_TRUE(bundler.Push(0u, Data(3u), now).empty());
+    auto result = bundler.Push(1u, Data(2u), now);
+    ASSERT_EQ(result.size(), allow_partial ? 2u : 1u);
+    if (allow_partial) {
+      ASSERT_EQ(result[0u]->GetFrame(), 1u);
+      ASSERT_FALSE(result[0u]->IsComplete());
+      ASSERT_EQ(result[0u]->GetNumberOfSensorsWithData(), 1u);
+      ASSERT_NE((*result[0u])[0u], nullptr);
+      ASSERT_EQ((*result[0u])[1u], nullptr);
+    }
+    ASSERT_EQ(result.back()->GetFrame(), 2u);
+    ASSERT_TRUE(result.back()->IsComplete());
+    ASSERT_EQ(bundler.GetNumberOfDroppedFrames(), allow_partial ? 0u : 1u);
+  }
+}
+
+TEST(frame_bundler, timeout) {
+  FrameBundler bundler(2u, carla::time_duration::milliseconds(100u), true);
+  const auto now = FrameBundler::clock::now();
+  ASSERT_TRUE(bundler.Push(0u, Data(1u), now).empty());
+  ASSERT_TRUE(bundler.Push(0u, Data(2u), now + 50ms).empty());
+  auto expiration = bundler.GetNextExpiration();
+  ASSERT_TRUE(expiration.has_value());
+  ASSERT_EQ(*expiration, now + 100ms);
+  ASSERT_TRUE(bundler.Expire(now + 99ms).empty());
+  auto result = bundler.Expire(now + 100ms);
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_EQ(result[0u]->GetFrame(), 1u);
+  result = bundler.Expire(now + 150ms);
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_EQ(result[0u]->GetFrame(), 2u);
+  ASSERT_FALSE(bundler.GetNextExpiration().has_value());
+}
+
+TEST(frame_bundler, max_pending_frames) {
+  FrameBundler bundler(2u, carla::time_duration::seconds(0u), false);
+  const auto now = FrameBundler::clock::now();
+  size_t frame = 0u;
+  for (; frame < FrameBundler::MAX_PENDING_FRAMES; ++frame) {
+    ASSERT_TRUE(bundler.Push(0u, Data(frame), now).empty());
+  }
+  ASSERT_TRUE(bundler.Push(0u, Data(frame), now).empty());
+  ASSERT_EQ(bundler.GetNumberOfDroppedFrames(), 1u);
+}
@@ -8,6 +8,7 @@
 
 #include <carla/image/ImageConverter.h>
 #include <carla/image/ImageIO.h>
+#include <carla/image/ImageKernels.h>
 #include <carla/image/ImageView.h>
 
 #include <memory>
@@ -186,3 +187,80 @@ TEST(image, semantic_segmentation) {
     }
   }
 }
+
+template <typename ColorConverterT>
+static void test_image_kernels(ColorConverterT converter) {
+  using namespace boost::gil;
+  using namespace carla::image;
+  using Color = ImageKernels::Color;
+
+  // Every encoded depth in release, a subset otherwise (too slow).
+#ifdef NDEBUG
+  constexpr auto stride = 1u;
+#else
+  constexpr auto stride = 97u;
+#endif // NDEBUG
+  constexpr auto width = 256u * 256u * 256u / stride;
+
+  auto expected = MakeTestImage<bgra8_pixel_t>(width, 1u);
+  std::vector<Color> result(width);
+  for (auto i = 0u; i < width; ++i) {
+    const auto value = i * stride;
+    result[i] = Color{
+        static_cast<uint8_t>(value & 0xFFu),
+        static_cast<uint8_t>((value >> 8u) & 0xFFu),
+        static_cast<uint8_t>((value >> 16u) & 0xFFu),
+        static_cast<uint8_t>(i & 0xFFu)};
+  }
+  for (auto i = 0u; i < width; ++i) {
+    auto &pixel = expected.view(i, 0u);
+    get_color(pixel, red_t()) = result[i].r;
+    get_color(pixel, green_t()) = result[i].g;
+    get_color(pixel, blue_t()) = result[i].b;
+    get_color(pixel, alpha_t()) = result[i].a;
+  }
+
+  ImageConverter::ConvertInPlace(expected.view, converter);
+  ImageKernels::ConvertInPlace(result.data(), result.size(), converter);
+
+  for (auto i = 0u; i < width; ++i) {
+    const auto &pixel = expected.view(i, 0u);
+    const Color color{
+        get_color(pixel, red_t()),
+        get_color(pixel, green_t()),
+        get_color(pixel, blue_t()),
+        get_color(pixel, alpha_t())};
+    ASSERT_EQ(result[i], color) << "at pixel " << i;
+  }
+}
+
+TEST(image, kernels_depth) {
+  test_image_kernels(carla::image::ColorConverter::Depth());
+}
+
+TEST(image, kernels_logarithmic_depth) {
+  test_image_kernels(carla::image::ColorConverter::LogarithmicDepth());
+}
+
+TEST(image, kernels_semantic_segmentation) {
+  test_image_kernels(carla::image::ColorConverter::CityScapesPalette());
+}
+
+TEST(image, kernels_depth_in_meters) {
+  using namespace carla::image;
+  using Color = ImageKernels::Color;
+  std::vector<Color> image;
+  for (auto i = 0u; i < 256u * 256u; ++i) {
+    image.emplace_back(
+        static_cast<uint8_t>(i & 0xFFu),
+        static_cast<uint8_t>(i >> 8u),
+        static_cast<uint8_t>((i * 7u) & 0xFFu));
+  }
+  std::vector<float> depth(image.size());
+  ImageKernels::DecodeDepthInMeters(image.data(), image.size(), depth.data());
+  for (auto i = 0u; i < image.size(); ++i) {
+    const auto &c = image[i];
+    const float normalized = (c.r + c.g * 256.0f + c.b * 256.0f * 256.0f) / (256.0f * 256.0f * 256.0f - 1.0f);
+    ASSERT_FLOAT_EQ(depth[i], 1000.0f * normalized) << "at pixel " << i;
+  }
+}
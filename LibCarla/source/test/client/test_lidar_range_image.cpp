@@ -0,0 +1,77 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/sensor/Deserializer.h>
+#include <carla/sensor/SensorRegistry.h>
+#include <carla/sensor/data/LidarRangeImage.h>
+#include <carla/sensor/data/LidarRangeImageData.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+
+#include <cstring>
+
+using namespace carla::sensor;
+using data::LidarDetection;
+using data::LidarRangeImageData;
+
+TEST(lidar_range_image, columns) {
+  const LidarRangeImageData full(1u, 8u, 360.0f);
+  ASSERT_EQ(full.GetColumn(-180.0f), 0u);
+  ASSERT_EQ(full.GetColumn(-0.1f), 3u);
+  ASSERT_EQ(full.GetColumn(0.0f), 4u);
+  ASSERT_EQ(full.GetColumn(179.9f), 7u);
+  // A full turn wraps around.
+  ASSERT_EQ(full.GetColumn(180.0f), 0u);
+  ASSERT_EQ(full.GetColumn(-190.0f), 7u);
+  const LidarRangeImageData partial(1u, 4u, 90.0f);
+  ASSERT_EQ(partial.GetColumn(-45.0f), 0u);
+  ASSERT_EQ(partial.GetColumn(44.9f), 3u);
+  // Out of the field of view is clamped.
+  ASSERT_EQ(partial.GetColumn(60.0f), 3u);
+  ASSERT_EQ(partial.GetColumn(-60.0f), 0u);
+}
+
+TEST(lidar_range_image, serialize) {
+  struct Sensor {} sensor;
+  LidarRangeImageData image(2u, 4u, 360.0f, 10.0f, -10.0f);
+  image.WritePoint(0u, -170.0f, LidarDetection{3.0f, 0.0f, 0.0f, 0.5f});
+  // Same cell, only the closest return is kept.
+  image.WritePoint(0u, -160.0f, LidarDetection{2.0f, 0.0f, 0.0f, 0.7f});
+  image.WritePoint(0u, -150.0f, LidarDetection{4.0f, 0.0f, 0.0f, 0.9f});
+  image.WritePoint(1u, 100.0f, LidarDetection{0.0f, 1.0f, 0.0f, 0.0f});
+
+  const auto header = s11n::SensorHeaderSerializer::Serialize(
+      SensorRegistry::get<ARayCastRangeImageLidar *>::index, 42u, 1.0, carla::rpc::Transform{});
+  const auto payload = s11n::LidarRangeImageSerializer::Serialize(sensor, image, carla::Buffer());
+  carla::Buffer message(header.size() + payload.size());
+  std::memcpy(message.data(), header.data(), header.size());
+  std::memcpy(message.data() + header.size(), payload.data(), payload.size());
+
+  auto result = Deserializer::Deserialize(std::move(message));
+  ASSERT_EQ(result->GetFrame(), 42u);
+  auto range_image = boost::dynamic_pointer_cast<data::LidarRangeImage>(result);
+  ASSERT_NE(range_image, nullptr);
+  ASSERT_EQ(range_image->GetChannelCount(), 2u);
+  ASSERT_EQ(range_image->GetWidth(), 4u);
+  ASSERT_EQ(range_image->size(), 8u);
+  ASSERT_EQ(range_image->GetUpperFov(), 10.0f);
+  ASSERT_EQ(range_image->GetLowerFov(), -10.0f);
+  size_t valid = 0u;
+  for (auto channel = 0u; channel < 2u; ++channel) {
+    for (auto column = 0u; column < 4u; ++column) {
+      valid += range_image->IsValid(channel, column) ? 1u : 0u;
+    }
+  }
+  ASSERT_EQ(valid, 2u);
+  ASSERT_EQ(range_image->GetPoint(0u, 0u).intensity, 0.7f);
+  ASSERT_EQ(range_image->GetPoint(1u, 3u).point.y, 1.0f);
+
+  // Reset keeps the size and invalidates every cell.
+  image.Reset();
+  ASSERT_FALSE(LidarRangeImageData::IsValidReturn(image.At(0u, 0u)));
+  ASSERT_EQ(image.GetChannelCount() * image.GetWidth(), 8u);
+}
@@ -10,18 +10,30 @@
 
 #include <carla/StopWatch.h>
 #include <carla/ThreadPool.h>
+#include <carla/client/Map.h>
+#include <carla/client/Waypoint.h>
 #include <carla/geom/Location.h>
 #include <carla/geom/Math.h>
 #include <carla/opendrive/OpenDriveParser.h>
 #include <carla/road/MapBuilder.h>
+#include <carla/road/RoutePlanner.h>
+#include <carla/road/element/LaneCrossingCalculator.h>
 #include <carla/road/element/RoadInfoElevation.h>
 #include <carla/road/element/RoadInfoGeometry.h>
 #include <carla/road/element/RoadInfoMarkRecord.h>
+#include <carla/road/element/RoadInfoSignal.h>
 #include <carla/road/element/RoadInfoVisitor.h>
 
 #include <pugixml/pugixml.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <map>
+#include <queue>
+#include <sstream>
 #include <string>
 
 using namespace carla::road;
@@ -424,3 +436,613 @@ TEST(road, get_waypoint) {
     result.get();
   }
 }
+
+TEST(road, lane_graph) {
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    const auto &graph = map.GetLaneGraph();
+    ASSERT_FALSE(graph.empty());
+    for (auto i = 0u; i < graph.size(); ++i) {
+      const auto &lane = graph.GetLane(i);
+      ASSERT_EQ(graph.GetIndex(lane), i);
+      ASSERT_EQ(graph.GetNode(i).lane_id, lane.GetId());
+      ASSERT_EQ(graph.GetSuccessors(i).size(), lane.GetNextLanes().size());
+      ASSERT_EQ(graph.GetPredecessors(i).size(), lane.GetPreviousLanes().size());
+    }
+    auto waypoints = map.GenerateWaypoints(2.0);
+    ASSERT_FALSE(waypoints.empty());
+    Random::Shuffle(waypoints);
+    const auto number_of_waypoints_to_explore =
+        std::min<size_t>(2000u, waypoints.size());
+    std::array<Waypoint, 16u> buffer;
+    for (auto i = 0u; i < number_of_waypoints_to_explore; ++i) {
+      const auto &wp = waypoints[i];
+      const auto distance = Random::Uniform(0.0001, 150.0);
+      const auto next = map.GetNext(wp, distance);
+      const auto next_count = map.GetNextN(wp, distance, buffer);
+      ASSERT_EQ(next_count, std::min(next.size(), buffer.size()));
+      if (next.size() <= buffer.size()) {
+        for (auto j = 0u; j < next_count; ++j) {
+          ASSERT_EQ(buffer[j], next[j]);
+        }
+      }
+      const auto previous = map.GetPrevious(wp, distance);
+      const auto previous_count = map.GetPreviousN(wp, distance, buffer);
+      ASSERT_EQ(previous_count, std::min(previous.size(), buffer.size()));
+      if (previous.size() <= buffer.size()) {
+        for (auto j = 0u; j < previous_count; ++j) {
+          ASSERT_EQ(buffer[j], previous[j]);
+        }
+      }
+    }
+  }
+}
+
+TEST(road, route_planner) {
+  constexpr double sampling_resolution = 2.0;
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    const RoutePlanner planner(map);
+    auto waypoints = map.GenerateWaypoints(5.0);
+    ASSERT_FALSE(waypoints.empty());
+    Random::Shuffle(waypoints);
+    const auto number_of_routes = std::min<size_t>(200u, waypoints.size() / 2u);
+    std::vector<std::pair<Location, Location>> queries;
+    auto found = 0u;
+    for (auto i = 0u; i < number_of_routes; ++i) {
+      const auto &origin = waypoints[2u * i];
+      const auto &destination = waypoints[2u * i + 1u];
+      queries.emplace_back(
+          map.ComputeTransform(origin).location,
+          map.ComputeTransform(destination).location);
+      const auto route = planner.TraceRoute(origin, destination, sampling_resolution);
+      if (route.empty()) {
+        continue;
+      }
+      ++found;
+      ASSERT_EQ(route.front().first.road_id, origin.road_id);
+      ASSERT_EQ(route.front().first.lane_id, origin.lane_id);
+      ASSERT_EQ(route.back().first.road_id, destination.road_id);
+      ASSERT_EQ(route.back().first.lane_id, destination.lane_id);
+      ASSERT_NEAR(route.back().first.s, destination.s, 1e-3);
+      for (auto j = 1u; j < route.size(); ++j) {
+        const auto distance = Math::Distance(
+            map.ComputeTransform(route[j - 1u].first).location,
+            map.ComputeTransform(route[j].first).location);
+        // Lane changes also move sideways one lane width.
+        ASSERT_LT(distance, 2.0 * sampling_resolution + 10.0);
+      }
+    }
+    ASSERT_GT(found, 0u);
+    const auto routes = planner.TraceRoutes(queries, sampling_resolution, 4u);
+    ASSERT_EQ(routes.size(), queries.size());
+    for (auto i = 0u; i < queries.size(); ++i) {
+      const auto route = planner.TraceRoute(queries[i].first, queries[i].second, sampling_resolution);
+      ASSERT_EQ(routes[i].size(), route.size());
+      for (auto j = 0u; j < route.size(); ++j) {
+        ASSERT_EQ(routes[i][j].first, route[j].first);
+        ASSERT_EQ(routes[i][j].second, route[j].second);
+      }
+    }
+  }
+}
+
+/// Cost from @a origin to @a destination with an exhaustive Dijkstra search
+/// over every (lane, entry) state of the graph of @a planner.
+static double ReferencePathCost(
+    const Map &map,
+    const RoutePlanner &planner,
+    const double lane_change_cost,
+    const Waypoint &origin,
+    const Waypoint &destination) {
+  const auto &graph = map.GetLaneGraph();
+  const auto origin_lane = graph.GetIndex(map.GetLane(origin));
+  const auto destination_lane = graph.GetIndex(map.GetLane(destination));
+  if (!planner.IsDrivingLane(origin_lane) || !planner.IsDrivingLane(destination_lane)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double destination_progress = planner.GetLaneProgress(destination_lane, destination.s);
+
+  using State = std::pair<LaneGraph::LaneIndex, double>;
+  using Item = std::pair<double, State>;
+  std::map<State, double> costs;
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+  double best = std::numeric_limits<double>::infinity();
+
+  auto push = [&](const State &state, double g) {
+    auto it = costs.find(state);
+    if (it == costs.end() || g < it->second) {
+      costs[state] = g;
+      open.emplace(g, state);
+    }
+  };
+  auto expand = [&](const State &state, double g) {
+    const auto lane = state.first;
+    const auto entry = state.second;
+    if (lane == destination_lane && destination_progress >= entry) {
+      best = std::min(best, g + destination_progress - entry);
+    }
+    const double length = graph.GetNode(lane).length;
+    for (const auto successor : graph.GetSuccessors(lane)) {
+      if (planner.IsDrivingLane(successor)) {
+        push(State{successor, 0.0}, g + length - entry);
+      }
+    }
+    for (const auto &change : planner.GetLaneChanges(lane)) {
+      const double progress = std::max(entry, change.second);
+      if (progress < length) {
+        push(State{change.first, progress}, g + progress - entry + lane_change_cost);
+      }
+    }
+  };
+
+  // The origin is not a state of its lane, the route may come back to it.
+  expand(State{origin_lane, planner.GetLaneProgress(origin_lane, origin.s)}, 0.0);
+  while (!open.empty()) {
+    const auto item = open.top();
+    open.pop();
+    if (item.first >= best) {
+      break;
+    }
+    if (item.first > costs[item.second]) {
+      continue;
+    }
+    expand(item.second, item.first);
+  }
+  return best;
+}
+
+TEST(road, route_planner_optimal) {
+  constexpr double lane_change_cost = 5.0;
+  auto lane_changes = 0u;
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+    const RoutePlanner planner(map, lane_change_cost);
+    for (LaneGraph::LaneIndex lane = 0u; lane < map.GetLaneGraph().size(); ++lane) {
+      lane_changes += planner.GetLaneChanges(lane).size();
+    }
+
+    auto waypoints = map.GenerateWaypoints(5.0);
+    ASSERT_FALSE(waypoints.empty());
+    Random::Shuffle(waypoints);
+    const auto number_of_routes = std::min<size_t>(100u, waypoints.size() / 2u);
+    for (auto i = 0u; i < number_of_routes; ++i) {
+      const auto &origin = waypoints[2u * i];
+      const auto &destination = waypoints[2u * i + 1u];
+      const auto cost = planner.GetPathCost(origin, destination);
+      const auto reference = ReferencePathCost(map, planner, lane_change_cost, origin, destination);
+      if (std::isinf(reference)) {
+        ASSERT_TRUE(std::isinf(cost));
+      } else {
+        ASSERT_NEAR(cost, reference, 1e-6);
+      }
+    }
+  }
+  ASSERT_GT(lane_changes, 0u);
+}
+
+static void SortWaypoints(std::vector<Waypoint> &waypoints) {
+  std::sort(waypoints.begin(), waypoints.end(), [](const auto &lhs, const auto &rhs) {
+    return std::tie(lhs.road_id, lhs.section_id, lhs.lane_id, lhs.s) <
+           std::tie(rhs.road_id, rhs.section_id, rhs.lane_id, rhs.s);
+  });
+}
+
+TEST(road, map_patch) {
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    const auto xodr = util::OpenDrive::Load(file);
+    auto reference = OpenDriveParser::Load(xodr);
+    auto m = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(reference.has_value());
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+
+    // Pick a connecting road of a junction and send it again as a patch.
+    pugi::xml_document xml;
+    ASSERT_TRUE(xml.load_string(xodr.c_str()));
+    pugi::xml_node road_node;
+    for (auto node : xml.child("OpenDRIVE").children("road")) {
+      if (node.attribute("junction").as_int() != -1) {
+        road_node = node;
+        break;
+      }
+    }
+    if (!road_node) {
+      continue;
+    }
+    const RoadId road_id = road_node.attribute("id").as_uint();
+    const JuncId junction_id = road_node.attribute("junction").as_int();
+    pugi::xml_document patch_xml;
+    patch_xml.append_child("OpenDRIVE").append_copy(road_node);
+    std::ostringstream patch;
+    patch_xml.save(patch);
+
+    auto change = OpenDriveParser::LoadPatch(map, patch.str());
+    ASSERT_TRUE(change.has_value());
+    ASSERT_EQ(change->roads, std::vector<RoadId>{road_id});
+    ASSERT_NE(
+        std::find(change->junctions.begin(), change->junctions.end(), junction_id),
+        change->junctions.end());
+
+    // Replacing a road with itself must leave an equivalent map.
+    ASSERT_EQ(map.GetLaneGraph().size(), reference->GetLaneGraph().size());
+    ASSERT_EQ(map.GetSignals().size(), reference->GetSignals().size());
+    for (const auto &pair : reference->GetSignals()) {
+      auto it = map.GetSignals().find(pair.first);
+      ASSERT_NE(it, map.GetSignals().end());
+      ASSERT_NEAR(
+          (it->second->GetTransform().location - pair.second->GetTransform().location).Length(),
+          0.0f, 1e-3f);
+    }
+    const auto &box = map.GetJunction(junction_id)->GetBoundingBox();
+    const auto &reference_box = reference->GetJunction(junction_id)->GetBoundingBox();
+    ASSERT_NEAR((box.location - reference_box.location).Length(), 0.0f, 1e-3f);
+    ASSERT_NEAR((box.extent - reference_box.extent).Length(), 0.0f, 1e-3f);
+
+    auto waypoints = reference->GenerateWaypoints(2.0);
+    ASSERT_FALSE(waypoints.empty());
+    Random::Shuffle(waypoints);
+    const auto number_of_waypoints_to_explore =
+        std::min<size_t>(2000u, waypoints.size());
+    for (auto i = 0u; i < number_of_waypoints_to_explore; ++i) {
+      const auto &wp = waypoints[i];
+      const auto distance = Random::Uniform(0.0001, 50.0);
+      auto next = map.GetNext(wp, distance);
+      auto reference_next = reference->GetNext(wp, distance);
+      SortWaypoints(next);
+      SortWaypoints(reference_next);
+      ASSERT_EQ(next, reference_next);
+      auto previous = map.GetPrevious(wp, distance);
+      auto reference_previous = reference->GetPrevious(wp, distance);
+      SortWaypoints(previous);
+      SortWaypoints(reference_previous);
+      ASSERT_EQ(previous, reference_previous);
+      const auto location = reference->ComputeTransform(wp).location;
+      // Ties between overlapping lanes may resolve to a different road.
+      auto closest = map.GetClosestWaypointOnRoad(location);
+      auto reference_closest = reference->GetClosestWaypointOnRoad(location);
+      ASSERT_TRUE(closest.has_value());
+      ASSERT_NEAR(
+          Math::Distance(map.ComputeTransform(*closest).location, location),
+          Math::Distance(reference->ComputeTransform(*reference_closest).location, location),
+          1e-3f);
+    }
+
+    // Remove the road, nothing should lead to it anymore.
+    MapChange removed;
+    removed.roads.emplace_back(road_id);
+    change = OpenDriveParser::LoadPatch(map, "", removed);
+    ASSERT_TRUE(change.has_value());
+    ASSERT_EQ(change->roads, std::vector<RoadId>{road_id});
+    ASSERT_FALSE(map.GetMap().ContainsRoad(road_id));
+    for (const auto &wp : map.GenerateWaypoints(2.0)) {
+      ASSERT_NE(wp.road_id, road_id);
+      for (const auto &next : map.GetNext(wp, 5.0)) {
+        ASSERT_NE(next.road_id, road_id);
+      }
+      for (const auto &previous : map.GetPrevious(wp, 5.0)) {
+        ASSERT_NE(previous.road_id, road_id);
+      }
+      auto closest = map.GetClosestWaypointOnRoad(map.ComputeTransform(wp).location);
+      ASSERT_TRUE(closest.has_value());
+      ASSERT_NE(closest->road_id, road_id);
+    }
+  }
+}
+
+/// Check that @a map and @a reference have the same elements.
+static void CompareMaps(const Map &map, const Map &reference) {
+  ASSERT_EQ(map.GetMap().GetRoads().size(), reference.GetMap().GetRoads().size());
+  for (const auto &pair : reference.GetMap().GetRoads()) {
+    ASSERT_TRUE(map.GetMap().ContainsRoad(pair.first));
+  }
+  ASSERT_EQ(map.GetMap().GetJunctions().size(), reference.GetMap().GetJunctions().size());
+  for (const auto &pair : reference.GetMap().GetJunctions()) {
+    const auto *junction = map.GetJunction(pair.first);
+    ASSERT_NE(junction, nullptr);
+    ASSERT_EQ(junction->GetConnections().size(), pair.second.GetConnections().size());
+  }
+  ASSERT_EQ(map.GetLaneGraph().size(), reference.GetLaneGraph().size());
+  ASSERT_EQ(map.GetSignals().size(), reference.GetSignals().size());
+  for (const auto &pair : reference.GetSignals()) {
+    ASSERT_EQ(map.GetSignals().count(pair.first), 1u);
+  }
+  ASSERT_EQ(map.GetAllSignalReferences().size(), reference.GetAllSignalReferences().size());
+  ASSERT_EQ(map.GetControllers().size(), reference.GetControllers().size());
+  for (const auto &pair : reference.GetControllers()) {
+    auto it = map.GetControllers().find(pair.first);
+    ASSERT_NE(it, map.GetControllers().end());
+    ASSERT_EQ(it->second->GetSignals(), pair.second->GetSignals());
+  }
+}
+
+TEST(road, map_patch_merge) {
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto xodr = util::OpenDrive::Load(file);
+    auto m = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+
+    // Send a connecting road of a junction again, then remove a road with
+    // signals if there is any.
+    pugi::xml_document xml;
+    ASSERT_TRUE(xml.load_string(xodr.c_str()));
+    pugi::xml_node connecting_road;
+    pugi::xml_node signal_road;
+    for (auto node : xml.child("OpenDRIVE").children("road")) {
+      if (!connecting_road && (node.attribute("junction").as_int() != -1)) {
+        connecting_road = node;
+      } else if (!signal_road && node.child("signals").child("signal")) {
+        signal_road = node;
+      }
+    }
+    if (!connecting_road) {
+      continue;
+    }
+    pugi::xml_document patch_xml;
+    patch_xml.append_child("OpenDRIVE").append_copy(connecting_road);
+    std::ostringstream patch;
+    patch_xml.save(patch);
+    MapChange removed;
+    removed.roads.emplace_back(signal_road ?
+        signal_road.attribute("id").as_uint() :
+        xml.child("OpenDRIVE").child("road").attribute("id").as_uint());
+
+    ASSERT_TRUE(OpenDriveParser::LoadPatch(map, patch.str()).has_value());
+    ASSERT_TRUE(OpenDriveParser::MergePatch(xodr, patch.str()));
+    ASSERT_TRUE(OpenDriveParser::LoadPatch(map, "", removed).has_value());
+    ASSERT_TRUE(OpenDriveParser::MergePatch(xodr, "", removed));
+
+    // Loading the merged document gives the patched map.
+    auto merged = OpenDriveParser::Load(xodr);
+    ASSERT_TRUE(merged.has_value());
+    ASSERT_FALSE(merged->GetMap().ContainsRoad(removed.roads.front()));
+    CompareMaps(*merged, map);
+
+    // A patch that cannot be parsed leaves the document untouched.
+    const auto previous = xodr;
+    ASSERT_FALSE(OpenDriveParser::MergePatch(xodr, "<OpenDRIVE><road"));
+    ASSERT_EQ(xodr, previous);
+  }
+}
+
+TEST(road, map_patch_snapshot) {
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto map = carla::MakeShared<carla::client::Map>(file, util::OpenDrive::Load(file));
+    auto waypoints = map->GenerateWaypoints(10.0);
+    if (waypoints.size() < 5u) {
+      continue;
+    }
+    const auto snapshot = map->GetMap();
+    const auto planner = map->GetRoutePlanner();
+    const auto waypoint = waypoints.front();
+    const auto width = waypoint->GetLaneWidth();
+
+    // Patches replace the road map, the old one is left untouched.
+    std::vector<RoadId> removed_roads;
+    auto remove_road = [&](RoadId road_id) {
+      if (std::find(removed_roads.begin(), removed_roads.end(), road_id) != removed_roads.end()) {
+        return;
+      }
+      MapChange removed;
+      removed.roads.emplace_back(road_id);
+      map->ApplyOpenDrivePatch("", removed);
+      removed_roads.emplace_back(road_id);
+      ASSERT_FALSE(map->GetMap()->GetMap().ContainsRoad(road_id));
+    };
+    remove_road(waypoint->GetRoadId());
+    ASSERT_NE(map->GetMap(), snapshot);
+    ASSERT_TRUE(snapshot->GetMap().ContainsRoad(waypoint->GetRoadId()));
+    ASSERT_EQ(waypoint->GetLaneWidth(), width);
+    waypoint->GetNext(5.0);
+    ASSERT_NE(map->GetRoutePlanner(), planner);
+    ASSERT_EQ(planner.use_count(), 1);
+
+    // Loaded from the patched document while every road map is in use, then
+    // reusing the retired road maps once nothing holds them.
+    std::vector<std::shared_ptr<const Map>> snapshots{snapshot};
+    for (auto i = 1u; i < 3u; ++i) {
+      snapshots.emplace_back(map->GetMap());
+      remove_road(waypoints[i]->GetRoadId());
+    }
+    snapshots.clear();
+    for (auto i = 3u; i < 5u; ++i) {
+      remove_road(waypoints[i]->GetRoadId());
+    }
+    auto reference = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(reference.has_value());
+    for (auto road_id : removed_roads) {
+      MapChange removed;
+      removed.roads.emplace_back(road_id);
+      ASSERT_TRUE(OpenDriveParser::LoadPatch(*reference, "", removed).has_value());
+    }
+    CompareMaps(*map->GetMap(), *reference);
+  }
+}
+
+TEST(road, lane_crossing_batch) {
+  constexpr int32_t flags =
+      static_cast<int32_t>(Lane::LaneType::Driving) |
+      static_cast<int32_t>(Lane::LaneType::Bidirectional) |
+      static_cast<int32_t>(Lane::LaneType::Biking) |
+      static_cast<int32_t>(Lane::LaneType::Parking);
+  for (const auto& file : util::OpenDrive::GetAvailableFiles()) {
+    auto m = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(m.has_value());
+    auto &map = *m;
+
+    // Start a trajectory next to some of the waypoints of the map.
+    auto waypoints = map.GenerateWaypoints(20.0);
+    Random::Shuffle(waypoints);
+    waypoints.resize(std::min<size_t>(waypoints.size(), 200u));
+    std::vector<Location> locations;
+    for (auto &waypoint : waypoints) {
+      auto location = map.ComputeTransform(waypoint).location;
+      location.x += static_cast<float>(Random::Uniform(-3.0, 3.0));
+      location.y += static_cast<float>(Random::Uniform(-3.0, 3.0));
+      locations.emplace_back(location);
+    }
+
+    std::vector<LaneCrossingCalculator::Position> positions;
+    for (auto &location : locations) {
+      auto position = LaneCrossingCalculator::Locate(map, location);
+      ASSERT_EQ(position.is_offroad, !map.GetWaypoint(location, flags).has_value());
+      positions.emplace_back(std::move(position));
+    }
+
+    for (auto step = 0u; step < 20u; ++step) {
+      std::vector<Location> destinations;
+      for (auto &location : locations) {
+        destinations.emplace_back(
+            location.x + static_cast<float>(Random::Uniform(-1.5, 1.5)),
+            location.y + static_cast<float>(Random::Uniform(-1.5, 1.5)),
+            location.z);
+      }
+      const auto result = LaneCrossingCalculator::Calculate(map, positions, destinations);
+      ASSERT_EQ(result.size(), locations.size());
+      for (auto i = 0u; i < locations.size(); ++i) {
+        const auto expected = map.CalculateCrossedLanes(locations[i], destinations[i]);
+        ASSERT_EQ(result[i].size(), expected.size());
+        for (auto j = 0u; j < expected.size(); ++j) {
+          ASSERT_EQ(result[i][j].type, expected[j].type);
+          ASSERT_EQ(result[i][j].color, expected[j].color);
+          ASSERT_EQ(result[i][j].lane_change, expected[j].lane_change);
+          ASSERT_EQ(result[i][j].width, expected[j].width);
+        }
+        ASSERT_EQ(positions[i].location, destinations[i]);
+      }
+      locations = destinations;
+    }
+  }
+}
+
+using SignalList = std::vector<std::pair<const RoadInfoSignal *, double>>;
+
+// Brute force version of Map::GetSignalsInDistance, scanning every signal
+// reference of the map for each lane visited.
+static void BruteForceSignalsInDistance(
+    const Map &map,
+    const std::vector<const RoadInfoSignal *> &references,
+    Waypoint waypoint,
+    double distance,
+    double accumulated_s,
+    SignalList &result) {
+  const auto &lane = map.GetLane(waypoint);
+  const bool forward = (waypoint.lane_id <= 0);
+  const double relative_s = waypoint.s - lane.GetDistance();
+  const double remaining_lane_length = forward ? lane.GetLength() - relative_s : relative_s;
+  const double range = std::min(distance, remaining_lane_length);
+  const double min_s = forward ? waypoint.s : waypoint.s - range;
+  const double max_s = forward ? waypoint.s + range : waypoint.s;
+  for (const auto *reference : references) {
+    const double s = reference->GetDistance();
+    if ((reference->GetRoadId() != waypoint.road_id) || (s < min_s) || (s > max_s)) {
+      continue;
+    }
+    for (const auto &validity : reference->GetValidities()) {
+      if ((waypoint.lane_id >= validity._from_lane) && (waypoint.lane_id <= validity._to_lane)) {
+        result.emplace_back(reference, accumulated_s + std::abs(s - waypoint.s));
+        break;
+      }
+    }
+  }
+  if (distance <= remaining_lane_length) {
+    return;
+  }
+  for (auto successor : map.GetSuccessors(waypoint)) {
+    const auto &next_lane = map.GetLane(successor);
+    successor.s = successor.lane_id < 0 ?
+        next_lane.GetDistance() :
+        next_lane.GetDistance() + next_lane.GetLength();
+    BruteForceSignalsInDistance(
+        map,
+        references,
+        successor,
+        distance - remaining_lane_length,
+        accumulated_s + remaining_lane_length,
+        result);
+  }
+}
+
+static void SortSignals(SignalList &signals) {
+  std::sort(signals.begin(), signals.end());
+}
+
+TEST(road, signal_index) {
+  for (const auto &file : util::OpenDrive::GetAvailableFiles()) {
+    carla::logging::log("Parsing", file);
+    auto map = OpenDriveParser::Load(util::OpenDrive::Load(file));
+    ASSERT_TRUE(map.has_value());
+
+    // The index references every signal of the roads.
+    std::vector<const RoadInfoSignal *> road_references;
+    for (const auto &road : map->GetMap().GetRoads()) {
+      for (const auto *reference : road.second.GetInfos<RoadInfoSignal>()) {
+        road_references.emplace_back(reference);
+      }
+    }
+    auto references = map->GetAllSignalReferences();
+    std::sort(references.begin(), references.end());
+    std::sort(road_references.begin(), road_references.end());
+    ASSERT_EQ(references, road_references);
+
+    for (const auto *reference : references) {
+      auto by_id = map->GetSignalReferencesById(reference->GetSignalId());
+      std::vector<const RoadInfoSignal *> expected_by_id;
+      for (const auto *other : references) {
+        if (other->GetSignalId() == reference->GetSignalId()) {
+          expected_by_id.emplace_back(other);
+        }
+      }
+      std::sort(by_id.begin(), by_id.end());
+      ASSERT_EQ(by_id, expected_by_id);
+
+      const auto location = reference->GetSignal()->GetTransform().location;
+      auto in_radius = map->GetSignalReferencesInRadius(location, 20.0);
+      std::vector<const RoadInfoSignal *> expected_in_radius;
+      for (const auto *other : references) {
+        const auto other_location = other->GetSignal()->GetTransform().location;
+        if (Math::Distance(location, other_location) <= 20.0f) {
+          expected_in_radius.emplace_back(other);
+        }
+      }
+      std::sort(in_radius.begin(), in_radius.end());
+      ASSERT_EQ(in_radius, expected_in_radius);
+    }
+
+    // Signals along the lanes match a linear scan of every reference, and the
+    // batched query gives the same results as the single one.
+    const auto waypoints = map->GenerateWaypoints(2.0);
+    const auto batch = map->GetSignalsInDistance(waypoints, 50.0);
+    ASSERT_EQ(batch.size(), waypoints.size());
+    for (auto i = 0u; i < waypoints.size(); ++i) {
+      const auto expected = map->GetSignalsInDistance(waypoints[i], 50.0);
+      ASSERT_EQ(batch[i].size(), expected.size());
+      SignalList found;
+      for (auto j = 0u; j < expected.size(); ++j) {
+        ASSERT_EQ(batch[i][j].signal, expected[j].signal);
+        ASSERT_EQ(batch[i][j].waypoint, expected[j].waypoint);
+        ASSERT_EQ(batch[i][j].accumulated_s, expected[j].accumulated_s);
+        // Signals are found ahead of the waypoint.
+        ASSERT_GE(batch[i][j].accumulated_s, 0.0);
+        ASSERT_LE(batch[i][j].accumulated_s, 50.0);
+        found.emplace_back(expected[j].signal, expected[j].accumulated_s);
+      }
+      SignalList brute_force;
+      BruteForceSignalsInDistance(*map, references, waypoints[i], 50.0, 0.0, brute_force);
+      SortSignals(found);
+      SortSignals(brute_force);
+      ASSERT_EQ(found.size(), brute_force.size());
+      for (auto j = 0u; j < found.size(); ++j) {
+        ASSERT_EQ(found[j].first, brute_force[j].first);
+        ASSERT_NEAR(found[j].second, brute_force[j].second, 1e-6);
+      }
+    }
+  }
+}
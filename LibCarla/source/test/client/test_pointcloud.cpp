@@ -0,0 +1,107 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/pointcloud/PointCloudIO.h>
+#include <carla/sensor/data/LidarData.h>
+#include <carla/sensor/data/SemanticLidarData.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+using namespace carla::pointcloud;
+using carla::sensor::data::LidarDetection;
+using carla::sensor::data::SemanticLidarDetection;
+
+namespace fs = boost::filesystem;
+
+static std::string ReadFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+template <typename PointT>
+static void test_binary_ply(const std::vector<PointT> &points, const char *properties) {
+  const auto path = (fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%.ply")).string();
+  ASSERT_EQ(
+      PointCloudIO::SaveToDisk(path, points.data(), points.data() + points.size(), PointCloudFormat::PlyBinary),
+      path);
+  const auto file = ReadFile(path);
+  fs::remove(path);
+  const auto expected_header =
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "element vertex " + std::to_string(points.size()) + "\n" +
+      properties +
+      "\nend_header\n";
+  ASSERT_EQ(file.size(), expected_header.size() + sizeof(PointT) * points.size());
+  ASSERT_EQ(file.substr(0u, expected_header.size()), expected_header);
+  ASSERT_EQ(std::memcmp(file.data() + expected_header.size(), points.data(), sizeof(PointT) * points.size()), 0);
+}
+
+TEST(pointcloud, binary_ply) {
+  test_binary_ply(
+      std::vector<LidarDetection>{{1.0f, 2.0f, 3.0f, 0.5f}, {-1.0f, 0.0f, 1e4f, 1.0f}},
+      "property float32 x\n"
+      "property float32 y\n"
+      "property float32 z\n"
+      "property float32 I");
+  test_binary_ply(
+      std::vector<SemanticLidarDetection>{{1.0f, 2.0f, 3.0f, 0.5f, 42u, 7u}},
+      "property float32 x\n"
+      "property float32 y\n"
+      "property float32 z\n"
+      "property float32 CosAngle\n"
+      "property uint32 ObjIdx\n"
+      "property uint32 ObjTag");
+}
+
+TEST(pointcloud, ascii_ply) {
+  const std::vector<LidarDetection> points{{1.0f, 2.0f, 3.0f, 0.5f}};
+  std::ostringstream out;
+  PointCloudIO::Dump(out, points.begin(), points.end());
+  ASSERT_EQ(
+      out.str(),
+      "ply\n"
+      "format ascii 1.0\n"
+      "element vertex 1\n"
+      "property float32 x\n"
+      "property float32 y\n"
+      "property float32 z\n"
+      "property float32 I\n"
+      "end_header\n"
+      "1.0000 2.0000 3.0000 0.5000\n");
+}
+
+TEST(pointcloud, save_paths) {
+  const std::vector<LidarDetection> points{{1.0f, 2.0f, 3.0f, 0.5f}};
+  const auto begin = points.data();
+  const auto end = points.data() + points.size();
+  const auto base = (fs::temp_directory_path() / fs::unique_path("carla-%%%%-%%%%")).string();
+
+  // Compressed point clouds always get the ".ply.gz" extension.
+  for (const auto &path : {base, base + ".ply", base + ".ply.gz"}) {
+    const auto saved = PointCloudIO::SaveToDisk(path, begin, end, PointCloudFormat::PlyBinaryGzip);
+    ASSERT_EQ(saved, base + ".ply.gz");
+    ASSERT_TRUE(fs::exists(saved));
+    fs::remove(saved);
+  }
+
+  // Failing to write the file is reported.
+  const auto directory = base + ".ply";
+  fs::create_directories(directory);
+  ASSERT_THROW(PointCloudIO::SaveToDisk(directory, begin, end), std::runtime_error);
+  ASSERT_THROW(
+      PointCloudIO::SaveToDisk(directory, begin, end, PointCloudFormat::PlyBinary),
+      std::runtime_error);
+  fs::remove(directory);
+}
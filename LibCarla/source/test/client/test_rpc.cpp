@@ -6,6 +6,7 @@
 
 #include "test.h"
 
+#include <carla/AtomicSharedPtr.h>
 #include <carla/MsgPackAdaptors.h>
 #include <carla/ThreadGroup.h>
 #include <carla/rpc/Actor.h>
@@ -13,7 +14,9 @@
 #include <carla/rpc/Response.h>
 #include <carla/rpc/Server.h>
 
+#include <future>
 #include <thread>
+#include <vector>
 
 using namespace carla::rpc;
 using namespace std::chrono_literals;
@@ -62,3 +65,108 @@ TEST(rpc, server_bind_sync_run_on_game_thread) {
   std::cout << "game thread: run " << i << " slices.\n";
   ASSERT_TRUE(done);
 }
+
+TEST(rpc, pipelined_calls) {
+  const uint16_t port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+
+  server.BindSync("square", [](int x) -> Response<int> {
+    return x * x;
+  });
+
+  server.AsyncRun(1u);
+
+  std::atomic_bool done{false};
+
+  carla::ThreadGroup threads;
+  threads.CreateThread([&]() {
+    Client client("localhost", port);
+    constexpr auto number_of_calls = 300;
+    std::vector<std::future<clmdep_msgpack::object_handle>> futures;
+    for (auto i = 0; i < number_of_calls; ++i) {
+      futures.emplace_back(client.pipelined_call("square", i));
+    }
+    for (auto i = 0; i < number_of_calls; ++i) {
+      auto response = futures[i].get().as<Response<int>>();
+      ASSERT_FALSE(response.HasError());
+      EXPECT_EQ(response.Get(), i * i);
+    }
+    done = true;
+  });
+
+  for (auto i = 0u; (i < 1'000'000u) && !done; ++i) {
+    server.SyncRunFor(2ms);
+  }
+  ASSERT_TRUE(done);
+}
+
+TEST(rpc, read_only_calls_run_off_game_thread) {
+  const uint16_t port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+
+  // The game thread publishes an immutable snapshot, read-only functions
+  // answer from it without waiting for the game thread.
+  carla::AtomicSharedPtr<const int> snapshot{std::make_shared<const int>(42)};
+
+  server.BindSync("set", [&](int value) {
+    snapshot = std::make_shared<const int>(value);
+  });
+
+  server.BindReadOnly("get", [&]() -> int {
+    return *snapshot.load();
+  });
+
+  server.AsyncRun(2u);
+
+  Client client("localhost", port);
+  // Nobody is running the game thread's queue.
+  for (auto i = 0; i < 100; ++i) {
+    ASSERT_EQ(client.call("get").as<int>(), 42);
+  }
+  client.async_call("set", 7);
+  while (server.GetSyncQueueLength() == 0u) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(client.call("get").as<int>(), 42);
+  server.SyncRunSome(10ms);
+  ASSERT_EQ(client.call("get").as<int>(), 7);
+}
+
+TEST(rpc, sync_run_budget_adapts_to_queue_length) {
+  const uint16_t port = (TESTING_PORT != 0u ? TESTING_PORT : 2017u);
+
+  Server server(port);
+  server.SetMaxSyncRunBudget(40ms);
+
+  server.BindSync("slow", []() {
+    std::this_thread::sleep_for(5ms);
+  });
+
+  server.AsyncRun(1u);
+
+  constexpr auto number_of_calls = 20u;
+  Client client("localhost", port);
+  for (auto i = 0u; i < number_of_calls; ++i) {
+    client.async_call("slow");
+  }
+  while (server.GetSyncQueueLength() < number_of_calls) {
+    std::this_thread::yield();
+  }
+
+  // Mock game loop, each frame runs the queue with a 10ms base budget.
+  size_t count = server.SyncRunSome(10ms);
+  ASSERT_LT(count, number_of_calls);
+  ASSERT_EQ(server.GetSyncRunBudget().milliseconds(), 20u);
+  count += server.SyncRunSome(10ms);
+  ASSERT_EQ(server.GetSyncRunBudget().milliseconds(), 40u);
+  for (auto frame = 0u; (frame < 100u) && (server.GetSyncQueueLength() > 0u); ++frame) {
+    count += server.SyncRunSome(10ms);
+    ASSERT_LE(server.GetSyncRunBudget().milliseconds(), 40u);
+  }
+  ASSERT_EQ(count, number_of_calls);
+  ASSERT_EQ(server.GetSyncQueueLength(), 0u);
+  // The queue is drained, back to the base budget.
+  ASSERT_EQ(server.GetSyncRunBudget().milliseconds(), 0u);
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/detail/RpcRecorder.h>
+
+#include <thread>
+
+using namespace std::chrono_literals;
+using carla::client::detail::RpcRecorder;
+
+TEST(rpc_recorder, counts_calls) {
+  RpcRecorder recorder;
+  {
+    auto &call = recorder.GetCall("tick_cue");
+    const auto start = RpcRecorder::clock::now() - 2ms;
+    call.RecordRequest(10u);
+    call.RecordResponse(start, 20u);
+    call.RecordRequest(10u);
+    call.RecordError();
+  }
+  recorder.GetCall("apply_batch").RecordRequest(100u);
+  ASSERT_EQ(&recorder.GetCall("tick_cue"), &recorder.GetCall("tick_cue"));
+
+  const auto statistics = recorder.GetStatistics();
+  ASSERT_EQ(statistics.calls.size(), 2u);
+  // Sorted by name.
+  const auto &batch = statistics.calls[0u];
+  const auto &tick = statistics.calls[1u];
+  ASSERT_EQ(batch.function, "apply_batch");
+  ASSERT_EQ(batch.calls, 1u);
+  ASSERT_EQ(batch.bytes_sent, 100u);
+  ASSERT_EQ(batch.latency.count, 0u);
+  ASSERT_EQ(tick.function, "tick_cue");
+  ASSERT_EQ(tick.calls, 2u);
+  ASSERT_EQ(tick.errors, 1u);
+  ASSERT_EQ(tick.bytes_sent, 20u);
+  ASSERT_EQ(tick.bytes_received, 20u);
+  ASSERT_EQ(tick.latency.count, 1u);
+  ASSERT_GE(tick.latency.max, 2.0);
+
+  // Looking up a literal gives the same entry.
+  ASSERT_EQ(&recorder.GetLiteralCall("tick_cue"), &recorder.GetCall("tick_cue"));
+  ASSERT_EQ(&recorder.GetLiteralCall("tick_cue"), &recorder.GetLiteralCall("tick_cue"));
+  ASSERT_EQ(recorder.GetStatistics().calls.size(), 2u);
+
+  recorder.Reset();
+  const auto reset = recorder.GetStatistics();
+  ASSERT_EQ(reset.calls.size(), 2u);
+  ASSERT_EQ(reset.calls[1u].calls, 0u);
+  ASSERT_EQ(reset.calls[1u].latency.count, 0u);
+}
+
+TEST(rpc_recorder, counts_stream_messages) {
+  RpcRecorder recorder;
+  auto stream = recorder.AddStream("token", 42u);
+  std::vector<std::thread> threads;
+  for (auto i = 0u; i < 4u; ++i) {
+    threads.emplace_back([stream]() {
+      for (auto j = 0u; j < 1000u; ++j) {
+        stream->RecordMessage(8u);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::this_thread::sleep_for(10ms);
+  auto statistics = recorder.GetStatistics();
+  ASSERT_EQ(statistics.streams.size(), 1u);
+  ASSERT_EQ(statistics.streams[0u].stream_id, 42u);
+  ASSERT_EQ(statistics.streams[0u].messages, 4000u);
+  ASSERT_EQ(statistics.streams[0u].bytes, 32000u);
+  ASSERT_GT(statistics.streams[0u].GetMessagesPerSecond(), 0.0);
+  ASSERT_LE(statistics.streams[0u].GetMessagesPerSecond(), 4000.0 / 0.01);
+  recorder.RemoveStream("token");
+  ASSERT_TRUE(recorder.GetStatistics().streams.empty());
+}
+
+TEST(rpc_recorder, export_formats) {
+  RpcRecorder recorder;
+  auto &call = recorder.GetCall("get_actors_by_id");
+  call.RecordRequest(5u);
+  call.RecordResponse(RpcRecorder::clock::now() - 3ms, 50u);
+  recorder.AddStream("token", 7u)->RecordMessage(1024u);
+
+  const auto statistics = recorder.GetStatistics();
+  const auto json = statistics.ToJson();
+  ASSERT_EQ(json.find("{\"calls\":[{\"function\":\"get_actors_by_id\",\"calls\":1,"), 0u);
+  ASSERT_NE(json.find("\"bytes_received\":50"), std::string::npos);
+  ASSERT_NE(json.find("\"streams\":[{\"stream_id\":7,\"messages\":1,\"bytes\":1024"), std::string::npos);
+
+  const auto prometheus = statistics.ToPrometheus();
+  ASSERT_NE(prometheus.find("# TYPE carla_rpc_latency_seconds histogram\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_calls_total{function=\"get_actors_by_id\"} 1\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"get_actors_by_id\",le=\"+Inf\"} 1\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_count{function=\"get_actors_by_id\"} 1\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_stream_received_bytes_total{stream_id=\"7\"} 1024\n"), std::string::npos);
+  // 3ms falls in the [2^11, 2^12) us bucket.
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"get_actors_by_id\",le=\"0.002048\"} 0\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"get_actors_by_id\",le=\"0.004096\"} 1\n"), std::string::npos);
+}
+
+TEST(rpc_recorder, prometheus_buckets) {
+  const size_t number_of_buckets = carla::LatencyHistogram::number_of_buckets;
+  carla::client::RpcStatistics statistics;
+  statistics.calls.resize(2u);
+  statistics.calls[0u].function = "fast";
+  statistics.calls[0u].latency.count = 1u;
+  statistics.calls[0u].latency.buckets.assign(number_of_buckets, 0u);
+  statistics.calls[0u].latency.buckets[0u] = 1u;
+  statistics.calls[1u].function = "odd\"name\n";
+  const auto prometheus = statistics.ToPrometheus();
+
+  // Every series has every bucket, whether they have samples or not.
+  auto count = [&](const std::string &pattern) {
+    size_t result = 0u;
+    for (auto i = prometheus.find(pattern); i != std::string::npos; i = prometheus.find(pattern, i + 1u)) {
+      ++result;
+    }
+    return result;
+  };
+  ASSERT_EQ(count("carla_rpc_latency_seconds_bucket{function=\"fast\","), number_of_buckets);
+  ASSERT_EQ(count("carla_rpc_latency_seconds_bucket{function=\"odd\\\"name\\n\","), number_of_buckets);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"fast\",le=\"1e-06\"} 1\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"fast\",le=\"0.004096\"} 1\n"), std::string::npos);
+  ASSERT_NE(prometheus.find("carla_rpc_latency_seconds_bucket{function=\"odd\\\"name\\n\",le=\"0.004096\"} 0\n"), std::string::npos);
+  // No raw line breaks inside a label.
+  ASSERT_EQ(prometheus.find("name\n"), std::string::npos);
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/client/StreamProxy.h>
+#include <carla/sensor/SensorRegistry.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <carla/sensor/s11n/SensorHeaderSerializer.h>
+#include <carla/streaming/Client.h>
+#include <carla/streaming/Server.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(stream_proxy, relays_to_every_subscriber) {
+  using namespace util::buffer;
+  using namespace carla::streaming;
+
+  const std::string message_text = "Hello clients!";
+  const uint16_t proxy_port = (TESTING_PORT != 0u ? TESTING_PORT : 2027u);
+
+  Server simulator("127.0.0.1", 0u);
+  simulator.AsyncRun(1u);
+  auto stream = simulator.MakeStream();
+
+  carla::client::StreamProxy proxy("127.0.0.1", "127.0.0.1", proxy_port);
+
+  // Both clients get the same relay, only one subscription reaches the
+  // simulator.
+  const Token relayed = proxy.Relay(stream.token());
+  ASSERT_EQ(proxy.Relay(stream.token()).data, relayed.data);
+  ASSERT_EQ(proxy.GetNumberOfRelayedStreams(), 1u);
+  ASSERT_NE(relayed.data, stream.token().data);
+
+  std::atomic_size_t message_count[2u] = {{0u}, {0u}};
+  Client clients[2u];
+  for (auto i = 0u; i < 2u; ++i) {
+    clients[i].AsyncRun(1u);
+    clients[i].Subscribe(relayed, [&, i](auto message) {
+      ASSERT_EQ(as_string(message), message_text);
+      ++message_count[i];
+    });
+  }
+
+  for (auto i = 0u; i < 100u; ++i) {
+    std::this_thread::sleep_for(2ms);
+    stream << message_text;
+  }
+  std::this_thread::sleep_for(20ms);
+  ASSERT_GE(message_count[0u], 90u);
+  ASSERT_GE(message_count[1u], 90u);
+
+  proxy.Release(stream.token());
+  ASSERT_EQ(proxy.GetNumberOfRelayedStreams(), 1u);
+  proxy.Release(stream.token());
+  ASSERT_EQ(proxy.GetNumberOfRelayedStreams(), 0u);
+}
+
+TEST(stream_proxy, drops_relays_without_subscribers) {
+  using namespace carla::streaming;
+
+  const uint16_t proxy_port = (TESTING_PORT != 0u ? TESTING_PORT : 2027u) + 2u;
+
+  Server simulator("127.0.0.1", 0u);
+  simulator.AsyncRun(1u);
+  auto stream = simulator.MakeStream();
+
+  carla::client::StreamProxy proxy("127.0.0.1", "127.0.0.1", proxy_port);
+  const Token relayed = proxy.Relay(stream.token());
+
+  {
+    Client client;
+    client.AsyncRun(1u);
+    client.Subscribe(relayed, [](auto) {});
+    std::this_thread::sleep_for(1500ms);
+    // Still subscribed, the relay is kept.
+    ASSERT_EQ(proxy.GetNumberOfRelayedStreams(), 1u);
+  }
+
+  // The client went away without releasing the relay, the proxy notices
+  // when writing to it.
+  for (auto i = 0u; (i < 30u) && (proxy.GetNumberOfRelayedStreams() > 0u); ++i) {
+    stream << std::string("Hello?");
+    std::this_thread::sleep_for(100ms);
+  }
+  ASSERT_EQ(proxy.GetNumberOfRelayedStreams(), 0u);
+  proxy.Release(stream.token());
+}
+
+TEST(stream_proxy, replays_keyframe_to_late_subscribers) {
+  using namespace carla::streaming;
+  using namespace carla::sensor;
+  using Serializer = s11n::EpisodeStateSerializer;
+
+  const uint16_t proxy_port = (TESTING_PORT != 0u ? TESTING_PORT : 2027u) + 4u;
+
+  auto make_message = [](uint64_t sequence, Serializer::Encoding encoding) {
+    const auto sensor_header = s11n::SensorHeaderSerializer::Serialize(
+        SensorRegistry::get<FWorldObserver *>::index, sequence, 0.0, carla::rpc::Transform{});
+    Serializer::Header header;
+    std::memset(static_cast<void *>(&header), 0, sizeof(header));
+    header.sequence = sequence;
+    header.encoding = encoding;
+    carla::Buffer message(sensor_header.size() + sizeof(header));
+    std::memcpy(message.data(), sensor_header.data(), sensor_header.size());
+    std::memcpy(message.data() + sensor_header.size(), &header, sizeof(header));
+    return message;
+  };
+
+  auto get_sequence = [](const carla::Buffer &message) {
+    Serializer::Header header;
+    std::memcpy(&header, message.data() + s11n::SensorHeaderSerializer::header_offset, sizeof(header));
+    return header.sequence;
+  };
+
+  Server simulator("127.0.0.1", 0u);
+  simulator.AsyncRun(1u);
+  auto stream = simulator.MakeStream();
+
+  carla::client::StreamProxy proxy("127.0.0.1", "127.0.0.1", proxy_port);
+  const Token relayed = proxy.Relay(stream.token());
+
+  std::mutex mutex;
+  std::vector<uint64_t> received[2u];
+  Client clients[2u];
+  auto subscribe = [&](size_t i) {
+    clients[i].AsyncRun(1u);
+    clients[i].Subscribe(relayed, [&, i](carla::Buffer message) {
+      std::lock_guard<std::mutex> lock(mutex);
+      received[i].emplace_back(get_sequence(message));
+    });
+    std::this_thread::sleep_for(50ms);
+  };
+
+  subscribe(0u);
+  stream.Write(make_message(1u, Serializer::Encoding::Delta));
+  stream.Write(make_message(2u, Serializer::Encoding::Keyframe));
+  stream.Write(make_message(3u, Serializer::Encoding::Delta));
+  std::this_thread::sleep_for(50ms);
+
+  // The second client gets the last keyframe and the delta after it first.
+  subscribe(1u);
+  stream.Write(make_message(4u, Serializer::Encoding::Delta));
+  std::this_thread::sleep_for(50ms);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(received[0u], (std::vector<uint64_t>{1u, 2u, 3u, 4u}));
+  ASSERT_EQ(received[1u], (std::vector<uint64_t>{2u, 3u, 4u}));
+  proxy.Release(stream.token());
+}
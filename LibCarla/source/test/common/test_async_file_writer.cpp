@@ -0,0 +1,67 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/AsyncFileWriter.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(async_file_writer, flush) {
+  constexpr auto number_of_tasks = 20u;
+  std::atomic_size_t count{0u};
+  carla::AsyncFileWriter writer(2u);
+  std::vector<std::future<std::string>> results;
+  for (auto i = 0u; i < number_of_tasks; ++i) {
+    results.emplace_back(writer.Post([&count, i]() {
+      std::this_thread::sleep_for(1ms);
+      ++count;
+      return std::to_string(i);
+    }));
+  }
+  auto error = writer.Post([]() -> std::string {
+    throw std::runtime_error("expected error");
+  });
+  writer.Flush();
+  ASSERT_EQ(writer.GetNumberOfPendingTasks(), 0u);
+  ASSERT_EQ(count, number_of_tasks);
+  for (auto i = 0u; i < number_of_tasks; ++i) {
+    ASSERT_EQ(results[i].get(), std::to_string(i));
+  }
+  ASSERT_THROW(error.get(), std::runtime_error);
+}
+
+TEST(async_file_writer, bounded_queue) {
+  constexpr auto max_pending_tasks = 3u;
+  std::promise<void> release;
+  auto released = release.get_future().share();
+  carla::AsyncFileWriter writer(1u, max_pending_tasks);
+  for (auto i = 0u; i < max_pending_tasks; ++i) {
+    writer.Post([released]() {
+      released.wait();
+      return std::string();
+    });
+  }
+  ASSERT_EQ(writer.GetNumberOfPendingTasks(), max_pending_tasks);
+  std::atomic_bool posted{false};
+  std::thread producer([&]() {
+    writer.Post([]() { return std::string(); });
+    posted = true;
+  });
+  std::this_thread::sleep_for(20ms);
+  ASSERT_FALSE(posted);
+  release.set_value();
+  producer.join();
+  ASSERT_TRUE(posted);
+  writer.Flush();
+  ASSERT_EQ(writer.GetNumberOfPendingTasks(), 0u);
+}
@@ -134,3 +134,51 @@ TEST(buffer, buffer_pool) {
   // Now delete the pool to test the weak reference inside the buffers.
   pool.reset();
 }
+
+TEST(buffer, buffer_pool_size_classes) {
+  auto pool = std::make_shared<carla::BufferPool>();
+  {
+    auto small = pool->Pop(100u);
+    auto big = pool->Pop(10000u);
+    ASSERT_EQ(small.size(), 100u);
+    ASSERT_EQ(big.size(), 10000u);
+  }
+  ASSERT_EQ(pool->GetStatistics().misses, 2u);
+  ASSERT_EQ(pool->GetStatistics().idle_buffers, 2u);
+  // Fits in the small buffer, the big one stays in the pool.
+  auto buff1 = pool->Pop(90u);
+  ASSERT_EQ(buff1.capacity(), 100u);
+  // Too big for the small buffer's class, a new buffer is allocated.
+  auto buff2 = pool->Pop(1000u);
+  ASSERT_EQ(buff2.capacity(), 1000u);
+  auto buff3 = pool->Pop(9000u);
+  ASSERT_EQ(buff3.capacity(), 10000u);
+  const auto stats = pool->GetStatistics();
+  ASSERT_EQ(stats.hits, 2u);
+  ASSERT_EQ(stats.misses, 3u);
+  ASSERT_EQ(stats.idle_buffers, 0u);
+}
+
+TEST(buffer, buffer_pool_trim) {
+  constexpr auto trim_period = 10u;
+  auto pool = std::make_shared<carla::BufferPool>(trim_period);
+  {
+    // A burst of 8 buffers in use at the same time.
+    std::vector<carla::Buffer> burst;
+    for (auto i = 0u; i < 8u; ++i) {
+      burst.emplace_back(pool->Pop(1024u));
+    }
+  }
+  ASSERT_EQ(pool->GetStatistics().idle_buffers, 8u);
+  // Steady state using only 2 buffers at a time, the buffers that stay idle
+  // during a whole period are released.
+  for (auto i = 0u; i < 2u * trim_period; ++i) {
+    auto buff1 = pool->Pop(1024u);
+    auto buff2 = pool->Pop(1024u);
+  }
+  const auto stats = pool->GetStatistics();
+  ASSERT_EQ(stats.idle_buffers, 2u);
+  ASSERT_EQ(stats.idle_bytes, 2u * 1024u);
+  ASSERT_EQ(stats.trimmed, 6u);
+  ASSERT_EQ(stats.misses, 8u);
+}
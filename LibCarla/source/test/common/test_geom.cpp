@@ -8,6 +8,7 @@
 
 #include <carla/geom/Vector3D.h>
 #include <carla/geom/Math.h>
+#include <carla/geom/OccupancyGrid.h>
 #include <carla/geom/BoundingBox.h>
 #include <carla/geom/Transform.h>
 #include <limits>
@@ -227,3 +228,25 @@ TEST(geom, nearest_point_arc) {
   ASSERT_NEAR(Math::DistanceArcToPoint(Vector3D(1,2,0),
       Vector3D(0,0,0), 1.57f, 0, 1).second, 1.0f, 0.01f);
 }
+
+TEST(geom, occupancy_grid) {
+  OccupancyGrid grid(5.0f);
+  ASSERT_TRUE(grid.IsFree(Location(0.0f, 0.0f, 0.0f)));
+  grid.Occupy(Location(0.0f, 0.0f, 0.0f));
+  ASSERT_EQ(grid.size(), 1u);
+  ASSERT_FALSE(grid.IsFree(Location(0.0f, 0.0f, 0.0f)));
+  ASSERT_FALSE(grid.IsFree(Location(4.9f, 0.0f, 0.0f)));
+  ASSERT_FALSE(grid.IsFree(Location(-3.0f, -3.0f, 0.0f)));
+  ASSERT_TRUE(grid.IsFree(Location(5.1f, 0.0f, 0.0f)));
+  ASSERT_TRUE(grid.IsFree(Location(0.0f, -5.1f, 0.0f)));
+  // Roads on top of each other, e.g. a bridge.
+  ASSERT_TRUE(grid.IsFree(Location(0.0f, 0.0f, 10.0f)));
+  // Locations next to cell boundaries.
+  grid.Occupy(Location(9.9f, 9.9f, 0.0f));
+  ASSERT_FALSE(grid.IsFree(Location(10.1f, 10.1f, 0.0f)));
+  ASSERT_FALSE(grid.IsFree(Location(14.8f, 9.9f, 0.0f)));
+  ASSERT_TRUE(grid.IsFree(Location(15.0f, 9.9f, 0.0f)));
+  grid.clear();
+  ASSERT_EQ(grid.size(), 0u);
+  ASSERT_TRUE(grid.IsFree(Location(0.0f, 0.0f, 0.0f)));
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "test.h"
+
+#include <carla/image/ImageResampler.h>
+
+#include <vector>
+
+using carla::image::ImageResampler;
+using Filter = ImageResampler::Filter;
+
+/// Image of 4 channels where every channel is x + 10 * y.
+static std::vector<unsigned char> MakeImage(uint32_t width, uint32_t height) {
+  std::vector<unsigned char> image(width * height * 4u);
+  for (auto y = 0u; y < height; ++y) {
+    for (auto x = 0u; x < width; ++x) {
+      for (auto c = 0u; c < 4u; ++c) {
+        image[(y * width + x) * 4u + c] = static_cast<unsigned char>(x + 10u * y);
+      }
+    }
+  }
+  return image;
+}
+
+static std::vector<unsigned char> Resample(
+    const ImageResampler &resampler,
+    const std::vector<unsigned char> &image) {
+  std::vector<unsigned char> result(resampler.GetOutputSize());
+  resampler.Resample(image.data(), result.data());
+  return result;
+}
+
+TEST(image_resampler, identity) {
+  ASSERT_TRUE(ImageResampler(8u, 6u, 4u, 0u, 0u, 0u, 0u, 1u, Filter::Box).IsIdentity());
+  ASSERT_TRUE(ImageResampler(8u, 6u, 4u, 0u, 0u, 100u, 100u, 0u, Filter::Box).IsIdentity());
+  ASSERT_FALSE(ImageResampler(8u, 6u, 4u, 1u, 0u, 0u, 0u, 1u, Filter::Box).IsIdentity());
+  ASSERT_FALSE(ImageResampler(8u, 6u, 4u, 0u, 0u, 0u, 0u, 2u, Filter::Box).IsIdentity());
+}
+
+TEST(image_resampler, crop) {
+  const auto image = MakeImage(8u, 6u);
+  const ImageResampler resampler(8u, 6u, 4u, 2u, 1u, 3u, 2u, 1u, Filter::Nearest);
+  ASSERT_EQ(resampler.GetOutputWidth(), 3u);
+  ASSERT_EQ(resampler.GetOutputHeight(), 2u);
+  const auto result = Resample(resampler, image);
+  const std::vector<unsigned char> expected{12u, 13u, 14u, 22u, 23u, 24u};
+  for (auto i = 0u; i < expected.size(); ++i) {
+    ASSERT_EQ(result[i * 4u], expected[i]);
+  }
+}
+
+TEST(image_resampler, downscale) {
+  const auto image = MakeImage(8u, 6u);
+  // Box averages the 2x2 block, rounding half up.
+  const ImageResampler box(8u, 6u, 4u, 0u, 0u, 0u, 0u, 2u, Filter::Box);
+  ASSERT_EQ(box.GetOutputWidth(), 4u);
+  ASSERT_EQ(box.GetOutputHeight(), 3u);
+  auto result = Resample(box, image);
+  ASSERT_EQ(result[0u], 6u);
+  ASSERT_EQ(result[(1u * 4u + 2u) * 4u], 30u);
+  // Nearest picks the center pixel of the block.
+  const ImageResampler nearest(8u, 6u, 4u, 0u, 0u, 0u, 0u, 2u, Filter::Nearest);
+  result = Resample(nearest, image);
+  ASSERT_EQ(result[0u], 11u);
+  ASSERT_EQ(result[(1u * 4u + 2u) * 4u], 35u);
+  // Bilinear interpolates at the center of the block, the 2x2 central pixels
+  // for even factors.
+  const ImageResampler bilinear(8u, 8u, 4u, 0u, 0u, 0u, 0u, 4u, Filter::Bilinear);
+  result = Resample(bilinear, MakeImage(8u, 8u));
+  ASSERT_EQ(result[0u], 17u);
+}
+
+TEST(image_resampler, rows) {
+  const auto image = MakeImage(16u, 16u);
+  const ImageResampler resampler(16u, 16u, 4u, 1u, 3u, 0u, 0u, 3u, Filter::Box);
+  const auto expected = Resample(resampler, image);
+  std::vector<unsigned char> result(resampler.GetOutputSize());
+  for (auto row = 0u; row < resampler.GetOutputHeight(); ++row) {
+    resampler.ResampleRows(image.data(), result.data(), row, row + 1u);
+  }
+  ASSERT_EQ(result, expected);
+}
+
+TEST(image_resampler, wide_pixels_fall_back_to_nearest) {
+  const ImageResampler resampler(8u, 6u, 8u, 0u, 0u, 0u, 0u, 2u, Filter::Box);
+  ASSERT_EQ(resampler.GetFilter(), Filter::Nearest);
+  ASSERT_EQ(resampler.GetOutputSize(), 4u * 3u * 8u);
+}
@@ -6,8 +6,60 @@
 
 #include "test.h"
 
+#include <carla/LatencyHistogram.h>
+#include <carla/ThreadPool.h>
 #include <carla/Version.h>
 
+#include <chrono>
+
 TEST(miscellaneous, version) {
   std::cout << "LibCarla " << carla::version() << std::endl;
 }
+
+TEST(miscellaneous, latency_histogram) {
+  using namespace std::chrono_literals;
+  carla::LatencyHistogram histogram;
+  ASSERT_EQ(histogram.GetStatistics().count, 0u);
+  for (auto i = 0; i < 98; ++i) {
+    histogram.Record(3ms);
+  }
+  histogram.Record(100ms);
+  histogram.Record(1s);
+  const auto statistics = histogram.GetStatistics();
+  ASSERT_EQ(statistics.count, 100u);
+  ASSERT_EQ(statistics.buckets.size(), size_t{carla::LatencyHistogram::number_of_buckets});
+  ASSERT_DOUBLE_EQ(statistics.max, 1000.0);
+  ASSERT_DOUBLE_EQ(statistics.mean, (98 * 3.0 + 100.0 + 1000.0) / 100.0);
+  // 3ms falls in [2048, 4096) us.
+  ASSERT_DOUBLE_EQ(statistics.p50, 4.096);
+  ASSERT_DOUBLE_EQ(statistics.p90, 4.096);
+  ASSERT_GE(statistics.p99, 100.0);
+  ASSERT_LE(statistics.p99, 1000.0);
+  histogram.Reset();
+  ASSERT_EQ(histogram.GetStatistics().count, 0u);
+}
+
+TEST(miscellaneous, parse_cpu_list) {
+  using carla::ParseCpuList;
+  ASSERT_EQ(ParseCpuList("0-3,8"), (std::vector<size_t>{0u, 1u, 2u, 3u, 8u}));
+  ASSERT_EQ(ParseCpuList(" 5 , 2-2"), (std::vector<size_t>{5u, 2u}));
+  ASSERT_TRUE(ParseCpuList("").empty());
+  ASSERT_TRUE(ParseCpuList("3-1").empty());
+  ASSERT_TRUE(ParseCpuList("a,1").empty());
+}
+
+TEST(miscellaneous, thread_pool_grows) {
+  carla::ThreadPool pool;
+  carla::ThreadPoolOptions options;
+  options.threads = 1u;
+  options.cpu_affinity = carla::GetCurrentThreadAffinity();
+  pool.AsyncRun(options);
+  ASSERT_EQ(pool.GetNumberOfThreads(), 1u);
+  pool.EnsureThreads(3u);
+  ASSERT_EQ(pool.GetNumberOfThreads(), 3u);
+  pool.EnsureThreads(2u);
+  ASSERT_EQ(pool.GetNumberOfThreads(), 3u);
+  ASSERT_EQ(pool.Post([]() { return 42; }).get(), 42);
+  pool.Stop();
+  ASSERT_EQ(pool.GetNumberOfThreads(), 0u);
+}
@@ -8,6 +8,7 @@
 
 #include <carla/MsgPackAdaptors.h>
 #include <carla/rpc/Actor.h>
+#include <carla/rpc/ControlBatch.h>
 #include <carla/rpc/Response.h>
 
 #include <thread>
@@ -105,3 +106,54 @@ TEST(msgpack, optional) {
   ASSERT_TRUE(result.has_value());
   ASSERT_EQ(*result, 42.0f);
 }
+
+TEST(msgpack, control_batch) {
+  using mp = carla::MsgPack;
+  ControlBatch batch;
+  batch.AddVehicleControl(1u, VehicleControl{0.5f, -0.25f, 0.0f, true, false, true, 3});
+  batch.AddVehicleControl(2u, VehicleControl{0.0f, 0.0f, 1.0f, false, true, false, -1});
+  batch.AddVehicleLightState(2u, VehicleLightState::LightState::Brake);
+  batch.AddWalkerControl(7u, WalkerControl{carla::geom::Vector3D{0.0f, 1.0f, 0.0f}, 1.5f, true});
+  auto result = mp::UnPack<ControlBatch>(mp::Pack(batch));
+  ASSERT_EQ(result.GetEncodedSize(), batch.GetEncodedSize());
+  ASSERT_EQ(result.GetNumberOfVehicleControls(), 2u);
+  ASSERT_EQ(result.GetVehicleId(1u), 2u);
+  const auto control = result.GetVehicleControl(0u);
+  ASSERT_EQ(control.throttle, 0.5f);
+  ASSERT_EQ(control.steer, -0.25f);
+  ASSERT_TRUE(control.hand_brake);
+  ASSERT_FALSE(control.reverse);
+  ASSERT_TRUE(control.manual_gear_shift);
+  ASSERT_EQ(control.gear, 3);
+  ASSERT_TRUE(result.GetVehicleControl(1u).reverse);
+  ASSERT_EQ(result.GetVehicleControl(1u).gear, -1);
+  ASSERT_EQ(result.GetNumberOfVehicleLightStates(), 1u);
+  ASSERT_EQ(result.GetLightStateVehicleId(0u), 2u);
+  ASSERT_EQ(
+      result.GetVehicleLightState(0u).light_state,
+      static_cast<VehicleLightState::flag_type>(VehicleLightState::LightState::Brake));
+  ASSERT_EQ(result.GetNumberOfWalkerControls(), 1u);
+  ASSERT_EQ(result.GetWalkerId(0u), 7u);
+  ASSERT_EQ(result.GetWalkerControl(0u).direction.y, 1.0f);
+  ASSERT_EQ(result.GetWalkerControl(0u).speed, 1.5f);
+  ASSERT_TRUE(result.GetWalkerControl(0u).jump);
+  // A truncated blob is rejected.
+  std::vector<unsigned char> blob;
+  batch.Encode([&](const unsigned char *data, size_t size) {
+    blob.insert(blob.end(), data, data + size);
+  });
+  ASSERT_EQ(blob.size(), batch.GetEncodedSize());
+  ControlBatch truncated;
+  ASSERT_THROW(truncated.Decode(blob.data(), blob.size() - 1u), std::invalid_argument);
+}
+
+TEST(msgpack, packed_size) {
+  using mp = carla::MsgPack;
+  const std::string function = "apply_batch";
+  const std::vector<float> values(100u, 1.5f);
+  ASSERT_EQ(mp::GetPackedSize(), 0u);
+  ASSERT_EQ(mp::GetPackedSize(function), mp::Pack(function).size());
+  ASSERT_EQ(
+      mp::GetPackedSize(function, values, true),
+      mp::Pack(function).size() + mp::Pack(values).size() + mp::Pack(true).size());
+}
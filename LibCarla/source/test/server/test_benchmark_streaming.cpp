@@ -12,6 +12,7 @@
 #include <boost/asio/post.hpp>
 
 #include <algorithm>
+#include <chrono>
 
 using namespace carla::streaming;
 using namespace std::chrono_literals;
@@ -26,13 +27,16 @@ static auto make_special_message(size_t size) {
 class Benchmark {
 public:
 
-  Benchmark(uint16_t port, size_t message_size, double success_ratio)
+  /// @a worker_threads sets the IO threads of both server and client, zero
+  /// for one per stream.
+  Benchmark(uint16_t port, size_t message_size, double success_ratio, size_t worker_threads = 0u)
     : _server(port),
       _client(),
       _message(make_special_message(message_size)),
       _client_callback(),
       _work_to_do(_client_callback),
-      _success_ratio(success_ratio) {}
+      _success_ratio(success_ratio),
+      _worker_threads(worker_threads) {}
 
   void AddStream() {
     Stream stream = _server.MakeStream();
@@ -43,6 +47,7 @@ public:
       boost::asio::post(_client_callback, [this]() {
         CARLA_PROFILE_FPS(client, listen_callback);
         ++_number_of_messages_received;
+        _last_message_time = clock::now().time_since_epoch().count();
       });
     });
 
@@ -55,18 +60,24 @@ public:
     }
   }
 
-  void Run(size_t number_of_messages) {
+  /// Send @a number_of_messages through each stream, one every @a interval
+  /// (~90FPS by default, zero to send them as fast as possible).
+  void Run(size_t number_of_messages, std::chrono::milliseconds interval = 11ms) {
+    const auto worker_threads = _worker_threads > 0u ? _worker_threads : _streams.size();
     _threads.CreateThread([this]() { _client_callback.run(); });
-    _server.AsyncRun(_streams.size());
-    _client.AsyncRun(_streams.size());
+    _server.AsyncRun(worker_threads);
+    _client.AsyncRun(worker_threads);
 
     std::this_thread::sleep_for(1s); // the client needs to be ready so we make
                                      // sure we get all the messages.
 
+    _start_time = clock::now();
     for (auto &&stream : _streams) {
       _threads.CreateThread([=]() mutable {
         for (auto i = 0u; i < number_of_messages; ++i) {
-          std::this_thread::sleep_for(11ms); // ~90FPS.
+          if (interval > 0ms) {
+            std::this_thread::sleep_for(interval);
+          }
           {
             CARLA_PROFILE_SCOPE(game, write_to_stream);
             stream << _message.buffer();
@@ -79,13 +90,20 @@ public:
     const auto threshold =
         static_cast<size_t>(_success_ratio * static_cast<double>(expected_number_of_messages));
 
+    size_t previously_received = 0u;
     for (auto i = 0u; i < 10; ++i) {
-      std::cout << "received " << _number_of_messages_received
+      const size_t received = _number_of_messages_received;
+      std::cout << "received " << received
                 << " of " << expected_number_of_messages
                 << " messages,";
-      if (_number_of_messages_received >= expected_number_of_messages) {
+      if (received >= expected_number_of_messages) {
+        break;
+      }
+      if ((i > 1u) && (received == previously_received)) {
+        // Nothing arrived in the last second, the rest were dropped.
         break;
       }
+      previously_received = received;
       std::cout << " waiting..." << std::endl;
       std::this_thread::sleep_for(1s);
     }
@@ -103,8 +121,20 @@ public:
 #endif // NDEBUG
   }
 
+  /// Messages received per second, from the first message sent to the last
+  /// message received.
+  double GetMessagesPerSecond() const {
+    const auto last = clock::time_point(clock::duration(_last_message_time.load()));
+    const std::chrono::duration<double> elapsed = last - _start_time;
+    return elapsed.count() > 0.0 ?
+        static_cast<double>(_number_of_messages_received) / elapsed.count() :
+        0.0;
+  }
+
 private:
 
+  using clock = std::chrono::steady_clock;
+
   carla::ThreadGroup _threads;
 
   Server _server;
@@ -119,14 +149,20 @@ private:
 
   const double _success_ratio;
 
+  const size_t _worker_threads;
+
   std::vector<Stream> _streams;
 
   std::atomic_size_t _number_of_messages_received{0u};
+
+  clock::time_point _start_time;
+
+  std::atomic<clock::rep> _last_message_time{0};
 };
 
 static size_t get_max_concurrency() {
   size_t concurrency = std::thread::hardware_concurrency() / 2u;
-  return std::max(2ul, concurrency);
+  return std::max<size_t>(concurrency, 2u);
 }
 
 static void benchmark_image(
@@ -163,3 +199,30 @@ TEST(benchmark_streaming, image_800x600_mt) {
 TEST(benchmark_streaming, image_1920x1080_mt) {
   benchmark_image(1920u * 1080u, get_max_concurrency(), 0.9);
 }
+
+/// Throughput of @a number_of_streams streams sending as fast as possible,
+/// with increasing number of IO threads. The server drops the messages
+/// written while the previous one is still being sent, so this measures the
+/// messages delivered under saturation.
+static void benchmark_threads(const size_t dimensions, const size_t number_of_streams) {
+  constexpr auto number_of_messages = 200u;
+  const auto message_size = 4u * dimensions;
+  for (size_t threads = 1u; threads <= std::max<size_t>(number_of_streams, 2u); threads *= 2u) {
+    carla::logging::log("Benchmark:", number_of_streams, "streams,", threads, "IO threads.");
+    Benchmark benchmark(TESTING_PORT, message_size, 0.0, threads);
+    benchmark.AddStreams(number_of_streams);
+    benchmark.Run(number_of_messages, 0ms);
+    const auto messages_per_second = benchmark.GetMessagesPerSecond();
+    std::cout << threads << " threads: " << messages_per_second << " messages/s, "
+              << (messages_per_second * static_cast<double>(message_size) / 1e6) << " MB/s"
+              << std::endl;
+  }
+}
+
+TEST(benchmark_streaming, threads_200x200) {
+  benchmark_threads(200u * 200u, get_max_concurrency());
+}
+
+TEST(benchmark_streaming, threads_800x600) {
+  benchmark_threads(800u * 600u, get_max_concurrency());
+}
@@ -49,6 +49,7 @@ class BasicAgent(object):
         self._base_tlight_threshold = 5.0  # meters
         self._base_vehicle_threshold = 5.0  # meters
         self._max_brake = 0.5
+        self._use_native_planner = False
 
         # Change parameters according to the dictionary
         opt_dict['target_speed'] = target_speed
@@ -66,10 +67,13 @@ class BasicAgent(object):
             self._base_vehicle_threshold = opt_dict['base_vehicle_threshold']
         if 'max_brake' in opt_dict:
             self._max_steering = opt_dict['max_brake']
+        if 'use_native_planner' in opt_dict:
+            self._use_native_planner = opt_dict['use_native_planner']
 
         # Initialize the planners
         self._local_planner = LocalPlanner(self._vehicle, opt_dict=opt_dict)
-        self._global_planner = GlobalRoutePlanner(self._map, self._sampling_resolution)
+        self._global_planner = GlobalRoutePlanner(
+            self._map, self._sampling_resolution, use_native=self._use_native_planner)
 
     def add_emergency_stop(self, control):
         """
@@ -21,7 +21,7 @@ class GlobalRoutePlanner(object):
     This class provides a very high level route plan.
     """
 
-    def __init__(self, wmap, sampling_resolution):
+    def __init__(self, wmap, sampling_resolution, use_native=False):
         self._sampling_resolution = sampling_resolution
         self._wmap = wmap
         self._topology = None
@@ -32,6 +32,11 @@ class GlobalRoutePlanner(object):
         self._intersection_end_node = -1
         self._previous_decision = RoadOption.VOID
 
+        # The native planner of carla.Map builds its own lane graph
+        self._use_native = use_native and hasattr(wmap, 'trace_route')
+        if self._use_native:
+            return
+
         # Build the graph
         self._build_topology()
         self._build_graph()
@@ -43,6 +48,10 @@ class GlobalRoutePlanner(object):
         This method returns list of (carla.Waypoint, RoadOption)
         from origin to destination
         """
+        if self._use_native:
+            route = self._wmap.trace_route(origin, destination, self._sampling_resolution)
+            return [(waypoint, RoadOption(int(option))) for waypoint, option in route]
+
         route_trace = []
         route = self._path_search(origin, destination)
         current_waypoint = self._wmap.get_waypoint(origin)
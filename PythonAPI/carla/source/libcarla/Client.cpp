@@ -6,6 +6,8 @@
 
 #include "carla/PythonUtil.h"
 #include "carla/client/Client.h"
+#include "carla/client/RpcStatistics.h"
+#include "carla/client/StreamProxy.h"
 #include "carla/client/World.h"
 #include "carla/Logging.h"
 #include "carla/rpc/ActorId.h"
@@ -15,12 +17,53 @@
 
 #include <boost/python/stl_iterator.hpp>
 
+namespace carla {
+namespace client {
+
+  std::ostream &operator<<(std::ostream &out, const RpcCallStatistics &statistics) {
+    out << "RpcCallStatistics(function=" << statistics.function
+        << ", calls=" << statistics.calls
+        << ", errors=" << statistics.errors
+        << ", bytes_sent=" << statistics.bytes_sent
+        << ", bytes_received=" << statistics.bytes_received
+        << ", p50=" << statistics.latency.p50
+        << ", p99=" << statistics.latency.p99 << ')';
+    return out;
+  }
+
+  std::ostream &operator<<(std::ostream &out, const StreamStatistics &statistics) {
+    out << "StreamStatistics(stream_id=" << statistics.stream_id
+        << ", messages=" << statistics.messages
+        << ", bytes=" << statistics.bytes
+        << ", messages_per_second=" << statistics.GetMessagesPerSecond()
+        << ", bytes_per_second=" << statistics.GetBytesPerSecond() << ')';
+    return out;
+  }
+
+} // namespace client
+} // namespace carla
+
 namespace ctm = carla::traffic_manager;
 
 static void SetTimeout(carla::client::Client &client, double seconds) {
   client.SetTimeout(TimeDurationFromSeconds(seconds));
 }
 
+static void SetSensorCallbackOptions(
+    const carla::client::Client &self,
+    size_t worker_threads,
+    size_t max_queue_size,
+    carla::streaming::OverflowPolicy overflow_policy) {
+  if (max_queue_size == 0u) {
+    throw std::invalid_argument("max_queue_size must be greater than zero");
+  }
+  carla::streaming::CallbackQueueOptions options;
+  options.worker_threads = worker_threads;
+  options.max_queue_size = max_queue_size;
+  options.overflow_policy = overflow_policy;
+  self.SetSensorCallbackOptions(options);
+}
+
 static auto GetAvailableMaps(const carla::client::Client &self) {
   carla::PythonUtil::ReleaseGIL unlock;
   boost::python::list result;
@@ -38,6 +81,44 @@ static auto GetRequiredFiles(const carla::client::Client &self, const std::strin
   return result;
 }
 
+static std::vector<carla::rpc::ActorId> ClientActorIdsFromPython(const boost::python::object &actor_ids) {
+  return {
+      boost::python::stl_input_iterator<carla::rpc::ActorId>(actor_ids),
+      boost::python::stl_input_iterator<carla::rpc::ActorId>()};
+}
+
+static boost::python::list GetActorsPhysicsControl(
+    const carla::client::Client &self,
+    const boost::python::object &actor_ids) {
+  const auto ids = ClientActorIdsFromPython(actor_ids);
+  std::vector<carla::rpc::VehiclePhysicsControl> controls;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    controls = self.GetVehiclesPhysicsControl(ids);
+  }
+  boost::python::list result;
+  for (auto &&control : controls) {
+    result.append(control);
+  }
+  return result;
+}
+
+static boost::python::list GetActorsLightState(
+    const carla::client::Client &self,
+    const boost::python::object &actor_ids) {
+  const auto ids = ClientActorIdsFromPython(actor_ids);
+  std::vector<carla::rpc::VehicleLightState> light_states;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    light_states = self.GetVehiclesLightState(ids);
+  }
+  boost::python::list result;
+  for (auto &&light_state : light_states) {
+    result.append(light_state.GetLightStateEnum());
+  }
+  return result;
+}
+
 static void ApplyBatchCommands(
     const carla::client::Client &self,
     const boost::python::object &commands,
@@ -49,6 +130,38 @@ static void ApplyBatchCommands(
   self.ApplyBatch(std::move(cmds), do_tick);
 }
 
+static boost::python::list ApplyControlBatchSync(
+    const carla::client::Client &self,
+    const carla::rpc::ControlBatch &batch,
+    bool do_tick) {
+  std::vector<carla::rpc::ActorId> failed;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    failed = self.ApplyControlBatchSync(batch, do_tick);
+  }
+  boost::python::list result;
+  for (auto id : failed) {
+    result.append(id);
+  }
+  return result;
+}
+
+static boost::python::list SpawnActorsBulk(
+    const carla::client::Client &self,
+    const carla::rpc::SpawnActorsBulk &request,
+    bool do_tick) {
+  std::vector<carla::rpc::CommandResponse> responses;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    responses = self.SpawnActorsBulk(request, do_tick);
+  }
+  boost::python::list result;
+  for (auto &response : responses) {
+    result.append(std::move(response));
+  }
+  return result;
+}
+
 static auto ApplyBatchCommandsSync(
     const carla::client::Client &self,
     const boost::python::object &commands,
@@ -165,6 +278,19 @@ static auto ApplyBatchCommandsSync(
   return result;
 }
 
+template <typename T>
+static boost::python::list MakeStatisticsList(const std::vector<T> &elements) {
+  boost::python::list result;
+  for (const auto &element : elements) {
+    result.append(element);
+  }
+  return result;
+}
+
+static carla::client::RpcStatistics GetRpcStatistics(const carla::client::Client &self) {
+  return self.GetRpcStatistics();
+}
+
 void export_client() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -181,9 +307,39 @@ void export_client() {
     .def_readwrite("enable_pedestrian_navigation", &rpc::OpendriveGenerationParameters::enable_pedestrian_navigation)
   ;
 
+  class_<cc::RpcCallStatistics>("RpcCallStatistics", no_init)
+    .def_readonly("function", &cc::RpcCallStatistics::function)
+    .def_readonly("calls", &cc::RpcCallStatistics::calls)
+    .def_readonly("errors", &cc::RpcCallStatistics::errors)
+    .def_readonly("bytes_sent", &cc::RpcCallStatistics::bytes_sent)
+    .def_readonly("bytes_received", &cc::RpcCallStatistics::bytes_received)
+    .add_property("latency", +[](const cc::RpcCallStatistics &self) { return self.latency; })
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::StreamStatistics>("StreamStatistics", no_init)
+    .def_readonly("stream_id", &cc::StreamStatistics::stream_id)
+    .def_readonly("messages", &cc::StreamStatistics::messages)
+    .def_readonly("bytes", &cc::StreamStatistics::bytes)
+    .def_readonly("seconds", &cc::StreamStatistics::seconds)
+    .add_property("messages_per_second", &cc::StreamStatistics::GetMessagesPerSecond)
+    .add_property("bytes_per_second", &cc::StreamStatistics::GetBytesPerSecond)
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::RpcStatistics>("RpcStatistics", no_init)
+    .add_property("calls", +[](const cc::RpcStatistics &self) { return MakeStatisticsList(self.calls); })
+    .add_property("streams", +[](const cc::RpcStatistics &self) { return MakeStatisticsList(self.streams); })
+    .def("to_json", &cc::RpcStatistics::ToJson)
+    .def("to_prometheus", &cc::RpcStatistics::ToPrometheus)
+  ;
+
   class_<cc::Client>("Client",
       init<std::string, uint16_t, size_t>((arg("host"), arg("port"), arg("worker_threads")=0u)))
     .def("set_timeout", &::SetTimeout, (arg("seconds")))
+    .def("get_rpc_stats", &::GetRpcStatistics)
+    .def("reset_rpc_stats", &cc::Client::ResetRpcStatistics)
+    .def("set_sensor_callback_options", &::SetSensorCallbackOptions, (arg("worker_threads"), arg("max_queue_size")=4u, arg("overflow_policy")=carla::streaming::OverflowPolicy::DropOldest))
     .def("get_client_version", &cc::Client::GetClientVersion)
     .def("get_server_version", CONST_CALL_WITHOUT_GIL(cc::Client, GetServerVersion))
     .def("get_world", &cc::Client::GetWorld)
@@ -207,6 +363,16 @@ void export_client() {
     .def("set_replayer_ignore_hero", &cc::Client::SetReplayerIgnoreHero, (arg("ignore_hero")))
     .def("apply_batch", &ApplyBatchCommands, (arg("commands"), arg("do_tick")=false))
     .def("apply_batch_sync", &ApplyBatchCommandsSync, (arg("commands"), arg("do_tick")=false))
+    .def("apply_control_batch", CONST_CALL_WITHOUT_GIL_2(cc::Client, ApplyControlBatch, const rpc::ControlBatch &, bool), (arg("batch"), arg("do_tick")=false))
+    .def("apply_control_batch_sync", &ApplyControlBatchSync, (arg("batch"), arg("do_tick")=false))
+    .def("spawn_actors_bulk", &SpawnActorsBulk, (arg("request"), arg("do_tick")=false))
+    .def("get_actors_physics_control", &GetActorsPhysicsControl, (arg("actor_ids")))
+    .def("get_actors_light_state", &GetActorsLightState, (arg("actor_ids")))
     .def("get_trafficmanager", CONST_CALL_WITHOUT_GIL_1(cc::Client, GetInstanceTM, uint16_t), (arg("port")=ctm::TM_DEFAULT_PORT))
   ;
+
+  class_<cc::StreamProxy, boost::noncopyable>("StreamProxy",
+      init<std::string, std::string, uint16_t, size_t>((arg("host"), arg("listen_address")="127.0.0.1", arg("port")=2100u, arg("worker_threads")=1u)))
+    .def("get_number_of_relayed_streams", &cc::StreamProxy::GetNumberOfRelayedStreams)
+  ;
 }
@@ -7,6 +7,12 @@
 #include <carla/PythonUtil.h>
 #include <carla/rpc/Command.h>
 #include <carla/rpc/CommandResponse.h>
+#include <carla/rpc/ControlBatch.h>
+#include <carla/rpc/SpawnActorsBulk.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
 
 #define TM_DEFAULT_PORT     8000
 
@@ -42,6 +48,135 @@ namespace command_impl {
     return self;
   }
 
+  /// Whether @a view holds native values of the type given by @a format.
+  static bool IsBufferOf(const Py_buffer &view, char format, size_t item_size) {
+    if ((view.format == nullptr) || (static_cast<size_t>(view.itemsize) != item_size)) {
+      return false;
+    }
+    const char *f = view.format;
+    if ((*f == '@') || (*f == '=') || (*f == '<')) {
+      ++f;
+    }
+    return (f[0] == format) && (f[1] == '\0');
+  }
+
+  /// Copy the numbers in @a sequence to a vector. Contiguous buffers of
+  /// exactly this type (e.g. numpy arrays of the right dtype) are copied in
+  /// one go, anything else is converted element by element.
+  template <typename T>
+  static std::vector<T> ToVector(const boost::python::object &sequence, char format) {
+    namespace py = boost::python;
+    std::vector<T> result;
+    Py_buffer view;
+    if (PyObject_GetBuffer(sequence.ptr(), &view, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS) == 0) {
+      const bool is_native = IsBufferOf(view, format, sizeof(T));
+      if (is_native) {
+        result.resize(static_cast<size_t>(view.len) / sizeof(T));
+        if (!result.empty()) {
+          std::memcpy(result.data(), view.buf, result.size() * sizeof(T));
+        }
+      }
+      PyBuffer_Release(&view);
+      if (is_native) {
+        return result;
+      }
+    } else {
+      PyErr_Clear();
+    }
+    result.reserve(static_cast<size_t>(py::len(sequence)));
+    for (py::stl_input_iterator<py::object> it(sequence), end; it != end; ++it) {
+      // Go through __float__ and __int__ to accept numpy scalars too.
+      if (std::is_floating_point<T>::value) {
+        result.emplace_back(static_cast<T>(py::extract<double>(it->attr("__float__")())()));
+      } else {
+        result.emplace_back(static_cast<T>(py::extract<long long>(it->attr("__int__")())()));
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  static std::vector<T> ToOptionalVector(
+      const boost::python::object &sequence,
+      char format,
+      size_t size,
+      T default_value) {
+    if (sequence.is_none()) {
+      return std::vector<T>(size, default_value);
+    }
+    auto result = ToVector<T>(sequence, format);
+    if (result.size() != size) {
+      throw std::invalid_argument("all the arrays must have the same length");
+    }
+    return result;
+  }
+
+  static void AddVehicleControls(
+      carla::rpc::ControlBatch &self,
+      const boost::python::object &actor_ids,
+      const boost::python::object &throttle,
+      const boost::python::object &steer,
+      const boost::python::object &brake,
+      const boost::python::object &hand_brake,
+      const boost::python::object &reverse,
+      const boost::python::object &manual_gear_shift,
+      const boost::python::object &gear) {
+    const auto ids = ToVector<carla::rpc::ActorId>(actor_ids, 'I');
+    const auto size = ids.size();
+    const auto throttles = ToOptionalVector<float>(throttle, 'f', size, 0.0f);
+    const auto steers = ToOptionalVector<float>(steer, 'f', size, 0.0f);
+    const auto brakes = ToOptionalVector<float>(brake, 'f', size, 0.0f);
+    // Booleans as bytes, std::vector<bool> cannot be copied into.
+    const auto hand_brakes = ToOptionalVector<uint8_t>(hand_brake, '?', size, 0u);
+    const auto reverses = ToOptionalVector<uint8_t>(reverse, '?', size, 0u);
+    const auto manual_gear_shifts = ToOptionalVector<uint8_t>(manual_gear_shift, '?', size, 0u);
+    const auto gears = ToOptionalVector<int32_t>(gear, 'i', size, 0);
+    self.Reserve(self.GetNumberOfVehicleControls() + size);
+    for (auto i = 0u; i < size; ++i) {
+      self.AddVehicleControl(ids[i], carla::rpc::VehicleControl{
+          throttles[i],
+          steers[i],
+          brakes[i],
+          hand_brakes[i] != 0u,
+          reverses[i] != 0u,
+          manual_gear_shifts[i] != 0u,
+          gears[i]});
+    }
+  }
+
+  static void AddVehicleLightStates(
+      carla::rpc::ControlBatch &self,
+      const boost::python::object &actor_ids,
+      const boost::python::object &light_states) {
+    const auto ids = ToVector<carla::rpc::ActorId>(actor_ids, 'I');
+    const auto states = ToOptionalVector<carla::rpc::VehicleLightState::flag_type>(
+        light_states, 'I', ids.size(), 0u);
+    for (auto i = 0u; i < ids.size(); ++i) {
+      self.AddVehicleLightState(ids[i], states[i]);
+    }
+  }
+
+  static void SetSpawnPoints(
+      carla::rpc::SpawnActorsBulk &self,
+      const boost::python::object &spawn_points) {
+    self.spawn_points.clear();
+    if (!spawn_points.is_none()) {
+      self.spawn_points.assign(
+          boost::python::stl_input_iterator<carla::geom::Transform>(spawn_points),
+          boost::python::stl_input_iterator<carla::geom::Transform>());
+    }
+  }
+
+  static boost::python::object CustomSpawnActorsBulkInit(
+      boost::python::object self,
+      const boost::python::object &spawn_points,
+      float min_distance) {
+    carla::rpc::SpawnActorsBulk request;
+    SetSpawnPoints(request, spawn_points);
+    request.min_distance = min_distance;
+    return self.attr("__init__")(request);
+  }
+
 } // namespace command_impl
 
 void export_commands() {
@@ -208,6 +343,53 @@ void export_commands() {
     .def_readwrite("light_state", &cr::Command::SetVehicleLightState::light_state)
   ;
 
+  class_<cr::ControlBatch>("ControlBatch")
+    .def("add_vehicle_control", +[](cr::ControlBatch &self, ActorPtr actor, const cr::VehicleControl &control) {
+      self.AddVehicleControl(actor->GetId(), control);
+    }, (arg("actor"), arg("control")))
+    .def("add_vehicle_control", &cr::ControlBatch::AddVehicleControl, (arg("actor_id"), arg("control")))
+    .def("add_vehicle_controls", &command_impl::AddVehicleControls, (
+        arg("actor_ids"),
+        arg("throttle")=object(),
+        arg("steer")=object(),
+        arg("brake")=object(),
+        arg("hand_brake")=object(),
+        arg("reverse")=object(),
+        arg("manual_gear_shift")=object(),
+        arg("gear")=object()))
+    .def("add_vehicle_light_state", +[](cr::ControlBatch &self, cr::ActorId id, cr::VehicleLightState::flag_type light_state) {
+      self.AddVehicleLightState(id, light_state);
+    }, (arg("actor_id"), arg("light_state")))
+    .def("add_vehicle_light_states", &command_impl::AddVehicleLightStates, (arg("actor_ids"), arg("light_states")))
+    .def("add_walker_control", +[](cr::ControlBatch &self, ActorPtr actor, const cr::WalkerControl &control) {
+      self.AddWalkerControl(actor->GetId(), control);
+    }, (arg("actor"), arg("control")))
+    .def("add_walker_control", &cr::ControlBatch::AddWalkerControl, (arg("actor_id"), arg("control")))
+    .def("clear", &cr::ControlBatch::clear)
+    .add_property("number_of_vehicle_controls", &cr::ControlBatch::GetNumberOfVehicleControls)
+    .add_property("number_of_vehicle_light_states", &cr::ControlBatch::GetNumberOfVehicleLightStates)
+    .add_property("number_of_walker_controls", &cr::ControlBatch::GetNumberOfWalkerControls)
+  ;
+
+  class_<cr::SpawnActorsBulk>("SpawnActorsBulk")
+    .def("__init__", &command_impl::CustomSpawnActorsBulkInit, (arg("spawn_points")=object(), arg("min_distance")=5.0f))
+    .def(init<cr::SpawnActorsBulk>())
+    .def("add", +[](cr::SpawnActorsBulk &self, const cc::ActorBlueprint &blueprint) {
+      self.descriptions.emplace_back(blueprint.MakeActorDescription());
+    }, (arg("blueprint")))
+    .add_property("spawn_points", +[](const cr::SpawnActorsBulk &self) {
+      boost::python::list result;
+      for (const auto &transform : self.spawn_points) {
+        result.append(transform);
+      }
+      return result;
+    }, &command_impl::SetSpawnPoints)
+    .def_readwrite("min_distance", &cr::SpawnActorsBulk::min_distance)
+    .add_property("number_of_actors", +[](const cr::SpawnActorsBulk &self) {
+      return self.descriptions.size();
+    })
+  ;
+
   implicitly_convertible<cr::Command::SpawnActor, cr::Command>();
   implicitly_convertible<cr::Command::DestroyActor, cr::Command>();
   implicitly_convertible<cr::Command::ApplyVehicleControl, cr::Command>();
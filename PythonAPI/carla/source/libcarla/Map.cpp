@@ -72,6 +72,83 @@ static auto GetLaneValidities(const carla::client::Landmark &self){
   return result;
 }
 
+static boost::python::list RouteToPythonList(const carla::client::Map::Route &route) {
+  namespace py = boost::python;
+  py::list result;
+  for (auto &pair : route) {
+    result.append(py::make_tuple(pair.first, pair.second));
+  }
+  return result;
+}
+
+static auto TraceRoute(
+    const carla::client::Map &self,
+    const carla::geom::Location &origin,
+    const carla::geom::Location &destination,
+    double sampling_resolution) {
+  carla::client::Map::Route route;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    route = self.TraceRoute(origin, destination, sampling_resolution);
+  }
+  return RouteToPythonList(route);
+}
+
+static auto TraceRoutes(
+    const carla::client::Map &self,
+    const boost::python::list &queries,
+    double sampling_resolution) {
+  namespace py = boost::python;
+  std::vector<std::pair<carla::geom::Location, carla::geom::Location>> locations;
+  const py::ssize_t size = py::len(queries);
+  locations.reserve(static_cast<size_t>(size));
+  for (py::ssize_t i = 0; i < size; ++i) {
+    const py::object query = queries[i];
+    locations.emplace_back(
+        py::extract<carla::geom::Location>(query[0]),
+        py::extract<carla::geom::Location>(query[1]));
+  }
+  std::vector<carla::client::Map::Route> routes;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    routes = self.TraceRoutes(locations, sampling_resolution);
+  }
+  py::list result;
+  for (auto &route : routes) {
+    result.append(RouteToPythonList(route));
+  }
+  return result;
+}
+
+static auto ApplyOpenDrivePatch(
+    carla::client::Map &self,
+    const std::string &opendrive,
+    const boost::python::object &removed_roads,
+    const boost::python::object &removed_junctions,
+    const boost::python::object &removed_signals) {
+  namespace py = boost::python;
+  carla::road::MapChange removed;
+  removed.roads.assign(
+      py::stl_input_iterator<carla::road::RoadId>(removed_roads),
+      py::stl_input_iterator<carla::road::RoadId>());
+  removed.junctions.assign(
+      py::stl_input_iterator<carla::road::JuncId>(removed_junctions),
+      py::stl_input_iterator<carla::road::JuncId>());
+  removed.signals.assign(
+      py::stl_input_iterator<carla::road::SignId>(removed_signals),
+      py::stl_input_iterator<carla::road::SignId>());
+  carla::road::MapChange change;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    change = self.ApplyOpenDrivePatch(opendrive, removed);
+  }
+  py::list result;
+  for (auto road_id : change.roads) {
+    result.append(road_id);
+  }
+  return result;
+}
+
 static carla::geom::GeoLocation ToGeolocation(
     const carla::client::Map &self,
     const carla::geom::Location &location) {
@@ -145,6 +222,16 @@ void export_map() {
     .value("Curb", cre::LaneMarking::Type::Curb)
   ;
 
+  enum_<cr::RoadOption>("RoadOption")
+    .value("VOID", cr::RoadOption::Void)
+    .value("LEFT", cr::RoadOption::Left)
+    .value("RIGHT", cr::RoadOption::Right)
+    .value("STRAIGHT", cr::RoadOption::Straight)
+    .value("LANEFOLLOW", cr::RoadOption::LaneFollow)
+    .value("CHANGELANELEFT", cr::RoadOption::ChangeLaneLeft)
+    .value("CHANGELANERIGHT", cr::RoadOption::ChangeLaneRight)
+  ;
+
   enum_<cr::SignalOrientation>("LandmarkOrientation")
     .value("Positive", cr::SignalOrientation::Positive)
     .value("Negative", cr::SignalOrientation::Negative)
@@ -169,8 +256,12 @@ void export_map() {
     .def("get_all_landmarks", CALL_RETURNING_LIST(cc::Map, GetAllLandmarks))
     .def("get_all_landmarks_from_id", CALL_RETURNING_LIST_1(cc::Map, GetLandmarksFromId, std::string), (args("opendrive_id")))
     .def("get_all_landmarks_of_type", CALL_RETURNING_LIST_1(cc::Map, GetAllLandmarksOfType, std::string), (args("type")))
+    .def("get_landmarks_in_radius", CALL_RETURNING_LIST_2(cc::Map, GetLandmarksInRadius, cg::Location, double), (arg("location"), arg("radius")))
     .def("get_landmark_group", CALL_RETURNING_LIST_1(cc::Map, GetLandmarkGroup, cc::Landmark), args("landmark"))
     .def("cook_in_memory_map", &cc::Map::CookInMemoryMap, (arg("path")=""))
+    .def("trace_route", &TraceRoute, (arg("origin"), arg("destination"), arg("sampling_resolution")=2.0))
+    .def("trace_routes", &TraceRoutes, (arg("queries"), arg("sampling_resolution")=2.0))
+    .def("apply_opendrive_patch", &ApplyOpenDrivePatch, (arg("opendrive"), arg("removed_roads")=list(), arg("removed_junctions")=list(), arg("removed_signals")=list()))
     .def(self_ns::str(self_ns::self))
   ;
 
@@ -6,14 +6,85 @@
 
 #include <carla/PythonUtil.h>
 #include <carla/client/ClientSideSensor.h>
+#include <carla/client/FrameSynchronizer.h>
 #include <carla/client/LaneInvasionSensor.h>
 #include <carla/client/Sensor.h>
+#include <carla/client/SensorBundle.h>
 #include <carla/client/ServerSideSensor.h>
+#include <carla/streaming/CallbackQueueOptions.h>
+
+#include <ostream>
+
+namespace carla {
+namespace client {
+
+  std::ostream &operator<<(std::ostream &out, const SensorBundle &bundle) {
+    out << "SensorBundle(frame=" << std::to_string(bundle.GetFrame())
+        << ", size=" << std::to_string(bundle.size())
+        << ", is_complete=" << (bundle.IsComplete() ? "True" : "False") << ')';
+    return out;
+  }
+
+} // namespace client
+
+namespace streaming {
+
+  std::ostream &operator<<(std::ostream &out, const CallbackQueueStats &stats) {
+    out << "SensorCallbackStats(queue_size=" << std::to_string(stats.queue_size)
+        << ", max_queue_size=" << std::to_string(stats.max_queue_size)
+        << ", delivered=" << std::to_string(stats.delivered)
+        << ", dropped=" << std::to_string(stats.dropped) << ')';
+    return out;
+  }
+
+} // namespace streaming
+} // namespace carla
 
 static void SubscribeToStream(carla::client::Sensor &self, boost::python::object callback) {
   self.Listen(MakeCallback(std::move(callback)));
 }
 
+static auto MakeFrameSynchronizer(
+    boost::python::object sensors,
+    double timeout,
+    bool allow_partial,
+    size_t queue_size) {
+  namespace py = boost::python;
+  std::vector<carla::SharedPtr<carla::client::Sensor>> sensor_list;
+  const auto length = py::len(sensors);
+  sensor_list.reserve(length);
+  for (auto i = 0u; i < length; ++i) {
+    sensor_list.emplace_back(py::extract<carla::SharedPtr<carla::client::Sensor>>(sensors[i]));
+  }
+  return carla::MakeShared<carla::client::FrameSynchronizer>(
+      std::move(sensor_list),
+      TimeDurationFromSeconds(timeout),
+      allow_partial,
+      queue_size);
+}
+
+static void ListenToBundles(carla::client::FrameSynchronizer &self, boost::python::object callback) {
+  if (callback.is_none()) {
+    self.Listen();
+  } else {
+    self.Listen(MakeCallback(std::move(callback)));
+  }
+}
+
+static auto WaitForBundle(
+    carla::client::FrameSynchronizer &self,
+    boost::python::object frame,
+    double seconds) {
+  const auto timeout = TimeDurationFromSeconds(seconds);
+  if (frame.is_none()) {
+    carla::PythonUtil::ReleaseGIL unlock;
+    return self.WaitForBundle(timeout);
+  }
+  const size_t frame_number = boost::python::extract<size_t>(frame);
+  carla::PythonUtil::ReleaseGIL unlock;
+  return self.WaitForBundle(frame_number, timeout);
+}
+
 void export_sensor() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -25,8 +96,22 @@ void export_sensor() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  enum_<carla::streaming::OverflowPolicy>("OverflowPolicy")
+    .value("DropOldest", carla::streaming::OverflowPolicy::DropOldest)
+    .value("DropNewest", carla::streaming::OverflowPolicy::DropNewest)
+  ;
+
+  class_<carla::streaming::CallbackQueueStats>("SensorCallbackStats", no_init)
+    .def_readonly("queue_size", &carla::streaming::CallbackQueueStats::queue_size)
+    .def_readonly("max_queue_size", &carla::streaming::CallbackQueueStats::max_queue_size)
+    .def_readonly("delivered", &carla::streaming::CallbackQueueStats::delivered)
+    .def_readonly("dropped", &carla::streaming::CallbackQueueStats::dropped)
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<cc::ServerSideSensor, bases<cc::Sensor>, boost::noncopyable, boost::shared_ptr<cc::ServerSideSensor>>
       ("ServerSideSensor", no_init)
+    .def("get_callback_stats", &cc::ServerSideSensor::GetCallbackStats)
     .def(self_ns::str(self_ns::self))
   ;
 
@@ -40,4 +125,26 @@ void export_sensor() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<cc::SensorBundle, boost::noncopyable, boost::shared_ptr<cc::SensorBundle>>("SensorBundle", no_init)
+    .add_property("frame", &cc::SensorBundle::GetFrame)
+    .add_property("is_complete", &cc::SensorBundle::IsComplete)
+    .def("__len__", &cc::SensorBundle::size)
+    .def("__iter__", iterator<const cc::SensorBundle>())
+    .def("__getitem__", +[](const cc::SensorBundle &self, size_t pos) {
+      return self.at(pos);
+    })
+    .def(self_ns::str(self_ns::self))
+  ;
+
+  class_<cc::FrameSynchronizer, boost::noncopyable, boost::shared_ptr<cc::FrameSynchronizer>>("FrameSynchronizer", no_init)
+    .def("__init__", make_constructor(&MakeFrameSynchronizer, default_call_policies(),
+        (arg("sensors"), arg("timeout")=1.0, arg("allow_partial")=false, arg("queue_size")=100u)))
+    .add_property("is_listening", &cc::FrameSynchronizer::IsListening)
+    .add_property("dropped_frames", CONST_CALL_WITHOUT_GIL(cc::FrameSynchronizer, GetNumberOfDroppedFrames))
+    .add_property("sensors", CALL_RETURNING_LIST(cc::FrameSynchronizer, GetSensors))
+    .def("listen", &ListenToBundles, (arg("callback")=object()))
+    .def("get", &WaitForBundle, (arg("frame")=object(), arg("seconds")=10.0))
+    .def("stop", CALL_WITHOUT_GIL(cc::FrameSynchronizer, Stop))
+  ;
+
 }
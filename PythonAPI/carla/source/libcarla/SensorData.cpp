@@ -4,9 +4,11 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <carla/AsyncFileWriter.h>
 #include <carla/PythonUtil.h>
 #include <carla/image/ImageConverter.h>
 #include <carla/image/ImageIO.h>
+#include <carla/image/ImageKernels.h>
 #include <carla/image/ImageView.h>
 #include <carla/pointcloud/PointCloudIO.h>
 #include <carla/sensor/SensorData.h>
@@ -16,6 +18,7 @@
 #include <carla/sensor/data/Image.h>
 #include <carla/sensor/data/LaneInvasionEvent.h>
 #include <carla/sensor/data/LidarMeasurement.h>
+#include <carla/sensor/data/LidarRangeImage.h>
 #include <carla/sensor/data/SemanticLidarMeasurement.h>
 #include <carla/sensor/data/GnssMeasurement.h>
 #include <carla/sensor/data/RadarMeasurement.h>
@@ -30,7 +33,6 @@
 #include <cmath>
 #include <vector>
 #include <algorithm>
-#include <thread>
 
 namespace carla {
 namespace sensor {
@@ -60,6 +62,14 @@ namespace data {
     return out;
   }
 
+  std::ostream &operator<<(std::ostream &out, const LidarRangeImage &meas) {
+    out << "LidarRangeImage(frame=" << std::to_string(meas.GetFrame())
+        << ", timestamp=" << std::to_string(meas.GetTimestamp())
+        << ", size=" << std::to_string(meas.GetChannelCount()) << 'x' << std::to_string(meas.GetWidth())
+        << ')';
+    return out;
+  }
+
   std::ostream &operator<<(std::ostream &out, const SemanticLidarMeasurement &meas) {
     out << "SemanticLidarMeasurement(frame=" << std::to_string(meas.GetFrame())
         << ", timestamp=" << std::to_string(meas.GetTimestamp())
@@ -185,32 +195,228 @@ enum class EColorConverter {
   CityScapesPalette
 };
 
+// =============================================================================
+// -- Buffer protocol ----------------------------------------------------------
+// =============================================================================
+
+#if PY_MAJOR_VERSION >= 3
+
+/// Python object exporting the raw bytes of a sensor data object. Holds a
+/// reference to the sensor data object so the memory outlives any view.
+struct RawDataObject {
+  PyObject_HEAD
+  PyObject *owner;
+  void *buf;
+  Py_ssize_t len;
+};
+
+static int RawDataGetBuffer(PyObject *self, Py_buffer *view, int flags) {
+  auto *raw = reinterpret_cast<RawDataObject *>(self);
+  return PyBuffer_FillInfo(view, self, raw->buf, raw->len, 1, flags);
+}
+
+static void RawDataDealloc(PyObject *self) {
+  Py_XDECREF(reinterpret_cast<RawDataObject *>(self)->owner);
+  Py_TYPE(self)->tp_free(self);
+}
+
+static PyBufferProcs RawDataBufferProcs = {&RawDataGetBuffer, nullptr};
+
+// Zero-initialized, the header and the slots are filled in
+// RegisterRawDataType.
+static PyTypeObject RawDataType;
+
+static void RegisterRawDataType() {
+  auto *header = reinterpret_cast<PyObject *>(&RawDataType);
+  header->ob_refcnt = 1;
+  header->ob_type = &PyType_Type;
+  RawDataType.tp_name = "carla.libcarla.RawData";
+  RawDataType.tp_basicsize = sizeof(RawDataObject);
+  RawDataType.tp_dealloc = &RawDataDealloc;
+  RawDataType.tp_as_buffer = &RawDataBufferProcs;
+  RawDataType.tp_flags = Py_TPFLAGS_DEFAULT;
+  RawDataType.tp_doc = "Raw bytes of a sensor data object.";
+  if (PyType_Ready(&RawDataType) < 0) {
+    boost::python::throw_error_already_set();
+  }
+}
+
+#endif // PY_MAJOR_VERSION >= 3
+
+/// Read-only memoryview of the raw bytes of the data.
 template <typename T>
-static auto GetRawDataAsBuffer(T &self) {
-  auto *data = reinterpret_cast<unsigned char *>(self.data());
-  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * self.size());
+static auto GetRawDataAsBuffer(boost::python::object self) {
+  T &data = boost::python::extract<T &>(self);
+  auto size = static_cast<Py_ssize_t>(sizeof(typename T::value_type) * data.size());
 #if PY_MAJOR_VERSION >= 3
-  auto *ptr = PyMemoryView_FromMemory(reinterpret_cast<char *>(data), size, PyBUF_READ);
+  auto *raw = PyObject_New(RawDataObject, &RawDataType);
+  if (raw == nullptr) {
+    boost::python::throw_error_already_set();
+  }
+  Py_INCREF(self.ptr());
+  raw->owner = self.ptr();
+  raw->buf = data.data();
+  raw->len = size;
+  boost::python::handle<> exporter(reinterpret_cast<PyObject *>(raw));
+  auto *ptr = PyMemoryView_FromObject(exporter.get());
 #else
-  auto *ptr = PyBuffer_FromMemory(data, size);
+  auto *ptr = PyBuffer_FromMemory(data.data(), size);
 #endif
   return boost::python::object(boost::python::handle<>(ptr));
 }
 
+#if PY_MAJOR_VERSION >= 3
+
+/// Shape and element type of the data of a sensor, as exported with the
+/// buffer protocol. The data is always C-contiguous.
+struct BufferLayout {
+  void *buf;
+  Py_ssize_t itemsize;
+  const char *format;
+  int ndim;
+  Py_ssize_t shape[3];
+};
+
+static BufferLayout GetBufferLayout(carla::sensor::data::Image &image) {
+  static_assert(sizeof(carla::sensor::data::Color) == 4u, "Invalid Color size");
+  return {image.data(), 1, "B", 3, {image.GetHeight(), image.GetWidth(), 4}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::OpticalFlowImage &image) {
+  static_assert(sizeof(carla::sensor::data::OpticalFlowPixel) == 2u * sizeof(float), "Invalid OpticalFlowPixel size");
+  return {image.data(), sizeof(float), "f", 3, {image.GetHeight(), image.GetWidth(), 2}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::LidarMeasurement &data) {
+  static_assert(sizeof(carla::sensor::data::LidarDetection) == 4u * sizeof(float), "Invalid LidarDetection size");
+  return {
+      data.data(),
+      sizeof(carla::sensor::data::LidarDetection),
+      "T{f:x:f:y:f:z:f:intensity:}",
+      1,
+      {static_cast<Py_ssize_t>(data.size())}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::LidarRangeImage &data) {
+  return {
+      data.data(),
+      sizeof(carla::sensor::data::LidarDetection),
+      "T{f:x:f:y:f:z:f:intensity:}",
+      2,
+      {data.GetChannelCount(), data.GetWidth()}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::SemanticLidarMeasurement &data) {
+  static_assert(sizeof(carla::sensor::data::SemanticLidarDetection) == 6u * sizeof(float), "Invalid SemanticLidarDetection size");
+  return {
+      data.data(),
+      sizeof(carla::sensor::data::SemanticLidarDetection),
+      "T{f:x:f:y:f:z:f:cos_inc_angle:I:object_idx:I:object_tag:}",
+      1,
+      {static_cast<Py_ssize_t>(data.size())}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::RadarMeasurement &data) {
+  return {
+      data.data(),
+      sizeof(carla::sensor::data::RadarDetection),
+      "T{f:velocity:f:azimuth:f:altitude:f:depth:}",
+      1,
+      {static_cast<Py_ssize_t>(data.size())}};
+}
+
+static BufferLayout GetBufferLayout(carla::sensor::data::DVSEventArray &data) {
+  // DVSEvent is packed, standard sizes without alignment.
+  static_assert(sizeof(carla::sensor::data::DVSEvent) == 13u, "Invalid DVSEvent size");
+  return {
+      data.data(),
+      sizeof(carla::sensor::data::DVSEvent),
+      "T{=H:x:H:y:q:t:?:pol:}",
+      1,
+      {static_cast<Py_ssize_t>(data.size())}};
+}
+
+template <typename T>
+static int GetSensorDataBuffer(PyObject *self, Py_buffer *view, int flags) {
+  boost::python::extract<T &> extract(self);
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "sensor data is read-only");
+    view->obj = nullptr;
+    return -1;
+  }
+  if (!extract.check()) {
+    PyErr_SetString(PyExc_BufferError, "object does not hold sensor data");
+    view->obj = nullptr;
+    return -1;
+  }
+  const BufferLayout layout = GetBufferLayout(extract());
+  // Shape and strides must live as long as the view.
+  auto *shape = new Py_ssize_t[2u * layout.ndim];
+  auto *strides = shape + layout.ndim;
+  Py_ssize_t stride = layout.itemsize;
+  for (int i = layout.ndim - 1; i >= 0; --i) {
+    shape[i] = layout.shape[i];
+    strides[i] = stride;
+    stride *= layout.shape[i];
+  }
+  view->obj = self;
+  Py_INCREF(self);
+  view->buf = layout.buf;
+  view->len = stride;
+  view->readonly = 1;
+  view->itemsize = layout.itemsize;
+  view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? const_cast<char *>(layout.format) : nullptr;
+  if ((flags & PyBUF_ND) == PyBUF_ND) {
+    view->ndim = layout.ndim;
+    view->shape = shape;
+  } else {
+    view->ndim = 1;
+    view->shape = nullptr;
+  }
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = shape;
+  return 0;
+}
+
+static void ReleaseSensorDataBuffer(PyObject *, Py_buffer *view) {
+  delete[] static_cast<Py_ssize_t *>(view->internal);
+}
+
+/// Export the data of the Python objects holding a T with the buffer
+/// protocol, so e.g. numpy.asarray creates a view of the data without
+/// copying it.
+template <typename T>
+static void ExportBuffer() {
+  auto *type = reinterpret_cast<PyHeapTypeObject *>(
+      boost::python::converter::registered<T>::converters.get_class_object());
+  DEBUG_ASSERT(PyType_HasFeature(&type->ht_type, Py_TPFLAGS_HEAPTYPE));
+  type->as_buffer.bf_getbuffer = &GetSensorDataBuffer<T>;
+  type->as_buffer.bf_releasebuffer = &ReleaseSensorDataBuffer;
+  type->ht_type.tp_as_buffer = &type->as_buffer;
+  PyType_Modified(&type->ht_type);
+}
+
+#else
+
+template <typename T>
+static void ExportBuffer() {}
+
+#endif // PY_MAJOR_VERSION >= 3
+
 template <typename T>
 static void ConvertImage(T &self, EColorConverter cc) {
   carla::PythonUtil::ReleaseGIL unlock;
   using namespace carla::image;
-  auto view = ImageView::MakeView(self);
   switch (cc) {
     case EColorConverter::Depth:
-      ImageConverter::ConvertInPlace(view, ColorConverter::Depth());
+      ImageKernels::ConvertInPlace(self, ColorConverter::Depth());
       break;
     case EColorConverter::LogarithmicDepth:
-      ImageConverter::ConvertInPlace(view, ColorConverter::LogarithmicDepth());
+      ImageKernels::ConvertInPlace(self, ColorConverter::LogarithmicDepth());
       break;
     case EColorConverter::CityScapesPalette:
-      ImageConverter::ConvertInPlace(view, ColorConverter::CityScapesPalette());
+      ImageKernels::ConvertInPlace(self, ColorConverter::CityScapesPalette());
       break;
     case EColorConverter::Raw:
       break; // ignore.
@@ -219,6 +425,23 @@ static void ConvertImage(T &self, EColorConverter cc) {
   }
 }
 
+#if PY_MAJOR_VERSION >= 3
+
+static boost::python::object DecodeDepthInMeters(const carla::sensor::data::Image &self) {
+  namespace bp = boost::python;
+  const auto size = sizeof(float) * self.size();
+  bp::object buffer{bp::handle<>(PyByteArray_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size)))};
+  auto *dst = reinterpret_cast<float *>(PyByteArray_AsString(buffer.ptr()));
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    carla::image::ImageKernels::DecodeDepthInMeters(self.data(), self.size(), dst);
+  }
+  bp::object view{bp::handle<>(PyMemoryView_FromObject(buffer.ptr()))};
+  return view.attr("cast")("f", bp::make_tuple(self.GetHeight(), self.GetWidth()));
+}
+
+#endif // PY_MAJOR_VERSION >= 3
+
 // image object resturned from optical flow to color conversion
 class FakeImage : public std::vector<uint8_t> {
   public:
@@ -313,55 +536,169 @@ static FakeImage ColorCodedFlow (
       result[4*index + 3] = 0;
     }
   };
-  size_t num_threads = std::max(8u, std::thread::hardware_concurrency());
-  size_t batch_size = image.size() / num_threads;
-  std::vector<std::thread*> t(num_threads+1);
-
-  for(size_t n = 0; n < num_threads; n++) {
-    t[n] = new std::thread(command, n * batch_size, (n+1) * batch_size);
-  }
-  t[num_threads] = new std::thread(command, num_threads * batch_size, image.size());
-
-  for(size_t n = 0; n <= num_threads; n++) {
-    if(t[n]->joinable()){
-      t[n]->join();
-    }
-    delete t[n];
-  }
+  carla::PythonUtil::ReleaseGIL unlock;
+  carla::image::ImageKernels::ParallelFor(image.size(), 16384u, command);
   return result;
 }
 
+template <typename T, typename ColorConverterT>
+static std::string WriteConvertedImage(
+    const T &self,
+    std::string path,
+    ColorConverterT converter,
+    const carla::image::io::write_options &options) {
+  using namespace carla::image;
+  std::vector<carla::sensor::data::Color> pixels(self.begin(), self.end());
+  ImageKernels::ConvertInPlace(pixels, converter);
+  auto view = boost::gil::interleaved_view(
+      self.GetWidth(),
+      self.GetHeight(),
+      reinterpret_cast<boost::gil::bgra8_pixel_t *>(pixels.data()),
+      sizeof(carla::sensor::data::Color) * self.GetWidth());
+  return ImageIO::WriteView(std::move(path), view, options);
+}
+
 template <typename T>
-static std::string SaveImageToDisk(T &self, std::string path, EColorConverter cc) {
-  carla::PythonUtil::ReleaseGIL unlock;
+static std::string WriteImage(
+    const T &self,
+    std::string path,
+    EColorConverter cc,
+    const carla::image::io::write_options &options) {
   using namespace carla::image;
-  auto view = ImageView::MakeView(self);
   switch (cc) {
     case EColorConverter::Raw:
       return ImageIO::WriteView(
           std::move(path),
-          view);
+          ImageView::MakeView(self),
+          options);
     case EColorConverter::Depth:
-      return ImageIO::WriteView(
-          std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::Depth()));
+      return WriteConvertedImage(self, std::move(path), ColorConverter::Depth(), options);
     case EColorConverter::LogarithmicDepth:
-      return ImageIO::WriteView(
-          std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::LogarithmicDepth()));
+      return WriteConvertedImage(self, std::move(path), ColorConverter::LogarithmicDepth(), options);
     case EColorConverter::CityScapesPalette:
-      return ImageIO::WriteView(
-          std::move(path),
-          ImageView::MakeColorConvertedView(view, ColorConverter::CityScapesPalette()));
+      return WriteConvertedImage(self, std::move(path), ColorConverter::CityScapesPalette(), options);
     default:
       throw std::invalid_argument("invalid color converter!");
   }
 }
 
+static carla::image::io::write_options MakeImageWriteOptions(
+    int png_compression_level,
+    int jpeg_quality,
+    bool jpeg_fast_dct) {
+  if ((png_compression_level < 0) || (png_compression_level > 9)) {
+    throw std::invalid_argument("png_compression_level must be in the range [0, 9]");
+  }
+  if ((jpeg_quality < 0) || (jpeg_quality > 100)) {
+    throw std::invalid_argument("jpeg_quality must be in the range [0, 100]");
+  }
+  carla::image::io::write_options options;
+  options.png_compression_level = png_compression_level;
+  options.jpeg_quality = jpeg_quality;
+  options.jpeg_fast_dct = jpeg_fast_dct;
+  return options;
+}
+
+template <typename T>
+static std::string SaveImageToDisk(
+    T &self,
+    std::string path,
+    EColorConverter cc,
+    int png_compression_level,
+    int jpeg_quality,
+    bool jpeg_fast_dct) {
+  const auto options = MakeImageWriteOptions(png_compression_level, jpeg_quality, jpeg_fast_dct);
+  carla::PythonUtil::ReleaseGIL unlock;
+  return WriteImage(self, std::move(path), cc, options);
+}
+
 template <typename T>
-static std::string SavePointCloudToDisk(T &self, std::string path) {
+static std::string SavePointCloudToDisk(T &self, std::string path, carla::pointcloud::PointCloudFormat format) {
   carla::PythonUtil::ReleaseGIL unlock;
-  return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), self.begin(), self.end());
+  return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), self.begin(), self.end(), format);
+}
+
+using AsyncFileWriterPtr = carla::SharedPtr<carla::AsyncFileWriter>;
+
+static AsyncFileWriterPtr MakeAsyncFileWriter(size_t worker_threads, size_t max_queue_size) {
+  // Destroying the writer waits for its tasks, which may need the GIL.
+  using Deleter = carla::PythonUtil::ReleaseGILDeleter;
+  return AsyncFileWriterPtr{new carla::AsyncFileWriter(worker_threads, max_queue_size), Deleter()};
+}
+
+/// Requires the GIL.
+static AsyncFileWriterPtr &GetAsyncFileWriterInstance() {
+  static AsyncFileWriterPtr writer;
+  return writer;
+}
+
+/// Requires the GIL.
+static AsyncFileWriterPtr GetAsyncFileWriter() {
+  auto &writer = GetAsyncFileWriterInstance();
+  if (writer == nullptr) {
+    writer = MakeAsyncFileWriter(2u, 64u);
+  }
+  return writer;
+}
+
+static void FlushAsyncWrites() {
+  auto writer = GetAsyncFileWriter();
+  carla::PythonUtil::ReleaseGIL unlock;
+  writer->Flush();
+}
+
+static void SetAsyncWriterOptions(size_t worker_threads, size_t max_queue_size) {
+  if ((worker_threads == 0u) || (max_queue_size == 0u)) {
+    throw std::invalid_argument("worker_threads and max_queue_size must be positive");
+  }
+  // The previous writer finishes its pending tasks when released.
+  GetAsyncFileWriterInstance() = MakeAsyncFileWriter(worker_threads, max_queue_size);
+}
+
+/// Files still queued when the interpreter exits would lose the data they
+/// keep alive.
+static void ShutDownAsyncWriter() {
+  GetAsyncFileWriterInstance().reset();
+}
+
+/// Post @a write_task, which writes the sensor data @a self, to the
+/// asynchronous writer.
+template <typename FunctorT>
+static void PostAsyncWrite(boost::python::object self, FunctorT &&write_task) {
+  namespace bp = boost::python;
+  // Keep the data alive until it is written, it needs the GIL to be
+  // released.
+  using Deleter = carla::PythonUtil::AcquireGILDeleter;
+  auto keep_alive = carla::SharedPtr<bp::object>{new bp::object(self), Deleter()};
+  auto writer = GetAsyncFileWriter();
+  // Posting blocks while the queue is full.
+  carla::PythonUtil::ReleaseGIL unlock;
+  writer->Post([keep_alive=std::move(keep_alive), task=std::forward<FunctorT>(write_task)]() mutable {
+    return task();
+  });
+}
+
+template <typename T>
+static void SaveImageToDiskAsync(
+    boost::python::object self,
+    std::string path,
+    EColorConverter cc,
+    int png_compression_level,
+    int jpeg_quality,
+    bool jpeg_fast_dct) {
+  const T &image = boost::python::extract<const T &>(self);
+  const auto options = MakeImageWriteOptions(png_compression_level, jpeg_quality, jpeg_fast_dct);
+  PostAsyncWrite(self, [&image, path=std::move(path), cc, options]() mutable {
+    return WriteImage(image, std::move(path), cc, options);
+  });
+}
+
+template <typename T>
+static void SavePointCloudToDiskAsync(boost::python::object self, std::string path, carla::pointcloud::PointCloudFormat format) {
+  const T &data = boost::python::extract<const T &>(self);
+  PostAsyncWrite(self, [&data, path=std::move(path), format]() mutable {
+    return carla::pointcloud::PointCloudIO::SaveToDisk(std::move(path), data.begin(), data.end(), format);
+  });
 }
 
 void export_sensor_data() {
@@ -372,6 +709,10 @@ void export_sensor_data() {
   namespace csd = carla::sensor::data;
   namespace css = carla::sensor::s11n;
 
+#if PY_MAJOR_VERSION >= 3
+  RegisterRawDataType();
+#endif // PY_MAJOR_VERSION >= 3
+
   // Fake image returned from optical flow to color conversion
   // fakes the regular image object. Only used for visual purposes
   class_<FakeImage>("FakeImage", no_init)
@@ -395,13 +736,27 @@ void export_sensor_data() {
     .value("CityScapesPalette", EColorConverter::CityScapesPalette)
   ;
 
+  enum_<carla::pointcloud::PointCloudFormat>("PointCloudFormat")
+    .value("PlyAscii", carla::pointcloud::PointCloudFormat::PlyAscii)
+    .value("PlyBinary", carla::pointcloud::PointCloudFormat::PlyBinary)
+    .value("PlyBinaryGzip", carla::pointcloud::PointCloudFormat::PlyBinaryGzip)
+  ;
+
+  def("flush_async_writes", &FlushAsyncWrites);
+  def("set_async_writer_options", &SetAsyncWriterOptions, (arg("worker_threads")=2u, arg("max_queue_size")=64u));
+  import("atexit").attr("register")(make_function(&ShutDownAsyncWriter));
+
   class_<csd::Image, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::Image>>("Image", no_init)
     .add_property("width", &csd::Image::GetWidth)
     .add_property("height", &csd::Image::GetHeight)
     .add_property("fov", &csd::Image::GetFOVAngle)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::Image>)
     .def("convert", &ConvertImage<csd::Image>, (arg("color_converter")))
-    .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw))
+    .def("save_to_disk", &SaveImageToDisk<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw, arg("png_compression_level")=3, arg("jpeg_quality")=100, arg("jpeg_fast_dct")=false))
+    .def("save_to_disk_async", &SaveImageToDiskAsync<csd::Image>, (arg("path"), arg("color_converter")=EColorConverter::Raw, arg("png_compression_level")=3, arg("jpeg_quality")=100, arg("jpeg_fast_dct")=false))
+#if PY_MAJOR_VERSION >= 3
+    .def("to_depth_in_meters", &DecodeDepthInMeters)
+#endif // PY_MAJOR_VERSION >= 3
     .def("__len__", &csd::Image::size)
     .def("__iter__", iterator<csd::Image>())
     .def("__getitem__", +[](const csd::Image &self, size_t pos) -> csd::Color {
@@ -435,7 +790,8 @@ void export_sensor_data() {
     .add_property("channels", &csd::LidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarMeasurement>)
     .def("get_point_count", &csd::LidarMeasurement::GetPointCount, (arg("channel")))
-    .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path")))
+    .def("save_to_disk", &SavePointCloudToDisk<csd::LidarMeasurement>, (arg("path"), arg("format")=carla::pointcloud::PointCloudFormat::PlyAscii))
+    .def("save_to_disk_async", &SavePointCloudToDiskAsync<csd::LidarMeasurement>, (arg("path"), arg("format")=carla::pointcloud::PointCloudFormat::PlyAscii))
     .def("__len__", &csd::LidarMeasurement::size)
     .def("__iter__", iterator<csd::LidarMeasurement>())
     .def("__getitem__", +[](const csd::LidarMeasurement &self, size_t pos) -> csd::LidarDetection {
@@ -447,12 +803,37 @@ void export_sensor_data() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<csd::LidarRangeImage, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::LidarRangeImage>>("LidarRangeImage", no_init)
+    .add_property("channels", &csd::LidarRangeImage::GetChannelCount)
+    .add_property("width", &csd::LidarRangeImage::GetWidth)
+    .add_property("horizontal_fov", &csd::LidarRangeImage::GetHorizontalFov)
+    .add_property("upper_fov", &csd::LidarRangeImage::GetUpperFov)
+    .add_property("lower_fov", &csd::LidarRangeImage::GetLowerFov)
+    .add_property("raw_data", &GetRawDataAsBuffer<csd::LidarRangeImage>)
+    .def("get_point", +[](const csd::LidarRangeImage &self, size_t channel, size_t column) -> csd::LidarDetection {
+      if ((channel >= self.GetChannelCount()) || (column >= self.GetWidth())) {
+        throw std::out_of_range("index out of range");
+      }
+      return self.GetPoint(channel, column);
+    }, (arg("channel"), arg("column")))
+    .def("is_valid", +[](const csd::LidarRangeImage &self, size_t channel, size_t column) {
+      if ((channel >= self.GetChannelCount()) || (column >= self.GetWidth())) {
+        throw std::out_of_range("index out of range");
+      }
+      return self.IsValid(channel, column);
+    }, (arg("channel"), arg("column")))
+    .def("__len__", &csd::LidarRangeImage::size)
+    .def("__iter__", iterator<csd::LidarRangeImage>())
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<csd::SemanticLidarMeasurement, bases<cs::SensorData>, boost::noncopyable, boost::shared_ptr<csd::SemanticLidarMeasurement>>("SemanticLidarMeasurement", no_init)
     .add_property("horizontal_angle", &csd::SemanticLidarMeasurement::GetHorizontalAngle)
     .add_property("channels", &csd::SemanticLidarMeasurement::GetChannelCount)
     .add_property("raw_data", &GetRawDataAsBuffer<csd::SemanticLidarMeasurement>)
     .def("get_point_count", &csd::SemanticLidarMeasurement::GetPointCount, (arg("channel")))
-    .def("save_to_disk", &SavePointCloudToDisk<csd::SemanticLidarMeasurement>, (arg("path")))
+    .def("save_to_disk", &SavePointCloudToDisk<csd::SemanticLidarMeasurement>, (arg("path"), arg("format")=carla::pointcloud::PointCloudFormat::PlyAscii))
+    .def("save_to_disk_async", &SavePointCloudToDiskAsync<csd::SemanticLidarMeasurement>, (arg("path"), arg("format")=carla::pointcloud::PointCloudFormat::PlyAscii))
     .def("__len__", &csd::SemanticLidarMeasurement::size)
     .def("__iter__", iterator<csd::SemanticLidarMeasurement>())
     .def("__getitem__", +[](const csd::SemanticLidarMeasurement &self, size_t pos) -> csd::SemanticLidarDetection {
@@ -568,4 +949,12 @@ void export_sensor_data() {
     .def("to_array_pol", CALL_RETURNING_LIST(csd::DVSEventArray, ToArrayPol))
     .def(self_ns::str(self_ns::self))
   ;
+
+  ExportBuffer<csd::Image>();
+  ExportBuffer<csd::OpticalFlowImage>();
+  ExportBuffer<csd::LidarMeasurement>();
+  ExportBuffer<csd::LidarRangeImage>();
+  ExportBuffer<csd::SemanticLidarMeasurement>();
+  ExportBuffer<csd::RadarMeasurement>();
+  ExportBuffer<csd::DVSEventArray>();
 }
@@ -27,6 +27,151 @@ namespace client {
 } // namespace client
 } // namespace carla
 
+#if PY_MAJOR_VERSION >= 3
+
+/// Read-only array over the ActorKinematics of a snapshot, exported with the
+/// buffer protocol. Holds the kinematics alive so the views created from it
+/// share their memory without copying.
+struct ActorKinematicsArray {
+  std::shared_ptr<const carla::client::ActorKinematics> kinematics;
+  const void *data;
+  const char *format;
+  Py_ssize_t itemsize;
+  /// Number of rows, and elements per row; zero for one-dimensional arrays.
+  Py_ssize_t rows;
+  Py_ssize_t columns;
+  /// Distance in bytes between consecutive rows.
+  Py_ssize_t row_stride;
+};
+
+static int GetActorKinematicsBuffer(PyObject *self, Py_buffer *view, int flags) {
+  boost::python::extract<ActorKinematicsArray &> extract(self);
+  if (!extract.check()) {
+    PyErr_SetString(PyExc_BufferError, "object does not hold actor kinematics");
+    view->obj = nullptr;
+    return -1;
+  }
+  const ActorKinematicsArray &array = extract();
+  const bool is_contiguous = (array.columns == 0) || (array.row_stride == array.columns * array.itemsize);
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "actor kinematics are read-only");
+    view->obj = nullptr;
+    return -1;
+  }
+  if (!is_contiguous && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES)) {
+    PyErr_SetString(PyExc_BufferError, "actor kinematics array is not contiguous");
+    view->obj = nullptr;
+    return -1;
+  }
+  const int ndim = (array.columns == 0) ? 1 : 2;
+  // Shape and strides must live as long as the view.
+  auto *shape = new Py_ssize_t[4u];
+  auto *strides = shape + 2;
+  shape[0] = array.rows;
+  shape[1] = array.columns;
+  strides[0] = (ndim == 1) ? array.itemsize : array.row_stride;
+  strides[1] = array.itemsize;
+  static const float empty = 0.0f;
+  view->obj = self;
+  Py_INCREF(self);
+  view->buf = const_cast<void *>((array.rows > 0) ? array.data : &empty);
+  view->len = array.rows * std::max<Py_ssize_t>(array.columns, 1) * array.itemsize;
+  view->readonly = 1;
+  view->itemsize = array.itemsize;
+  view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? const_cast<char *>(array.format) : nullptr;
+  if ((flags & PyBUF_ND) == PyBUF_ND) {
+    view->ndim = ndim;
+    view->shape = shape;
+  } else {
+    view->ndim = 1;
+    view->shape = nullptr;
+  }
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = shape;
+  return 0;
+}
+
+static void ReleaseActorKinematicsBuffer(PyObject *, Py_buffer *view) {
+  delete[] static_cast<Py_ssize_t *>(view->internal);
+}
+
+/// Memoryview of @a rows x @a columns floats starting at @a data, with
+/// @a row_stride bytes between rows.
+static boost::python::object MakeActorKinematicsView(
+    std::shared_ptr<const carla::client::ActorKinematics> kinematics,
+    const void *data,
+    size_t rows,
+    size_t columns,
+    size_t row_stride) {
+  namespace bp = boost::python;
+  bp::object array{ActorKinematicsArray{
+      std::move(kinematics),
+      data,
+      "f",
+      sizeof(float),
+      static_cast<Py_ssize_t>(rows),
+      static_cast<Py_ssize_t>(columns),
+      static_cast<Py_ssize_t>(row_stride)}};
+  return bp::object{bp::handle<>(PyMemoryView_FromObject(array.ptr()))};
+}
+
+static boost::python::object GetSnapshotActorIds(const carla::client::WorldSnapshot &self) {
+  namespace bp = boost::python;
+  static_assert(sizeof(carla::ActorId) == sizeof(uint32_t), "Invalid ActorId size");
+  auto kinematics = self.GetActorKinematics();
+  const auto *data = kinematics->ids.data();
+  const auto rows = static_cast<Py_ssize_t>(kinematics->size());
+  bp::object array{ActorKinematicsArray{std::move(kinematics), data, "I", sizeof(carla::ActorId), rows, 0, 0}};
+  return bp::object{bp::handle<>(PyMemoryView_FromObject(array.ptr()))};
+}
+
+static boost::python::object GetSnapshotTransforms(const carla::client::WorldSnapshot &self) {
+  static_assert(sizeof(carla::geom::Transform) == 6u * sizeof(float), "Invalid Transform layout");
+  auto kinematics = self.GetActorKinematics();
+  const auto *data = kinematics->transforms.data();
+  const auto rows = kinematics->size();
+  return MakeActorKinematicsView(std::move(kinematics), data, rows, 6u, sizeof(carla::geom::Transform));
+}
+
+static boost::python::object GetSnapshotLocations(const carla::client::WorldSnapshot &self) {
+  // Strided view over the location part of the transforms.
+  auto kinematics = self.GetActorKinematics();
+  const auto *data = kinematics->transforms.empty() ? nullptr : &kinematics->transforms[0u].location;
+  const auto rows = kinematics->size();
+  return MakeActorKinematicsView(std::move(kinematics), data, rows, 3u, sizeof(carla::geom::Transform));
+}
+
+static boost::python::object GetSnapshotRotations(const carla::client::WorldSnapshot &self) {
+  // Strided view over the rotation part of the transforms.
+  static_assert(sizeof(carla::geom::Rotation) == 3u * sizeof(float), "Invalid Rotation layout");
+  auto kinematics = self.GetActorKinematics();
+  const auto *data = kinematics->transforms.empty() ? nullptr : &kinematics->transforms[0u].rotation;
+  const auto rows = kinematics->size();
+  return MakeActorKinematicsView(std::move(kinematics), data, rows, 3u, sizeof(carla::geom::Transform));
+}
+
+template <std::vector<carla::geom::Vector3D> carla::client::ActorKinematics::*Column>
+static boost::python::object GetSnapshotVectors(const carla::client::WorldSnapshot &self) {
+  static_assert(sizeof(carla::geom::Vector3D) == 3u * sizeof(float), "Invalid Vector3D layout");
+  auto kinematics = self.GetActorKinematics();
+  const auto *data = ((*kinematics).*Column).data();
+  const auto rows = kinematics->size();
+  return MakeActorKinematicsView(std::move(kinematics), data, rows, 3u, sizeof(carla::geom::Vector3D));
+}
+
+static void ExportActorKinematicsBuffer() {
+  auto *type = reinterpret_cast<PyHeapTypeObject *>(
+      boost::python::converter::registered<ActorKinematicsArray>::converters.get_class_object());
+  DEBUG_ASSERT(PyType_HasFeature(&type->ht_type, Py_TPFLAGS_HEAPTYPE));
+  type->as_buffer.bf_getbuffer = &GetActorKinematicsBuffer;
+  type->as_buffer.bf_releasebuffer = &ReleaseActorKinematicsBuffer;
+  type->ht_type.tp_as_buffer = &type->as_buffer;
+  PyType_Modified(&type->ht_type);
+}
+
+#endif // PY_MAJOR_VERSION >= 3
+
 void export_snapshot() {
   using namespace boost::python;
   namespace cc = carla::client;
@@ -44,6 +189,7 @@ void export_snapshot() {
     .add_property("id", &cc::WorldSnapshot::GetId)
     .add_property("frame", +[](const cc::WorldSnapshot &self) { return self.GetTimestamp().frame; })
     .add_property("timestamp", CALL_RETURNING_COPY(cc::WorldSnapshot, GetTimestamp))
+    .add_property("is_stale", &cc::WorldSnapshot::IsStale)
     /// Deprecated, use timestamp @{
     .add_property("frame_count", +[](const cc::WorldSnapshot &self) { return self.GetTimestamp().frame; })
     .add_property("elapsed_seconds", +[](const cc::WorldSnapshot &self) { return self.GetTimestamp().elapsed_seconds; })
@@ -57,5 +203,19 @@ void export_snapshot() {
     .def("__eq__", &cc::WorldSnapshot::operator==)
     .def("__ne__", &cc::WorldSnapshot::operator!=)
     .def(self_ns::str(self_ns::self))
+#if PY_MAJOR_VERSION >= 3
+    .def("get_actor_ids", &GetSnapshotActorIds)
+    .def("get_transforms", &GetSnapshotTransforms)
+    .def("get_locations", &GetSnapshotLocations)
+    .def("get_rotations", &GetSnapshotRotations)
+    .def("get_velocities", &GetSnapshotVectors<&cc::ActorKinematics::velocities>)
+    .def("get_angular_velocities", &GetSnapshotVectors<&cc::ActorKinematics::angular_velocities>)
+    .def("get_accelerations", &GetSnapshotVectors<&cc::ActorKinematics::accelerations>)
+#endif // PY_MAJOR_VERSION >= 3
   ;
+
+#if PY_MAJOR_VERSION >= 3
+  class_<ActorKinematicsArray>("_ActorKinematicsArray", no_init);
+  ExportActorKinematicsBuffer();
+#endif // PY_MAJOR_VERSION >= 3
 }
@@ -4,15 +4,31 @@
 // This work is licensed under the terms of the MIT license.
 // For a copy, see <https://opensource.org/licenses/MIT>.
 
+#include <carla/LatencyHistogram.h>
 #include <carla/PythonUtil.h>
 #include <carla/client/Actor.h>
 #include <carla/client/ActorList.h>
+#include <carla/client/ActorQuery.h>
 #include <carla/client/World.h>
 #include <carla/rpc/EnvironmentObject.h>
 #include <carla/rpc/ObjectLabel.h>
 
 #include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
+namespace carla {
+
+  std::ostream &operator<<(std::ostream &out, const LatencyHistogram::Statistics &statistics) {
+    out << "LatencyStatistics(count=" << statistics.count
+        << ", mean=" << statistics.mean
+        << ", p50=" << statistics.p50
+        << ", p90=" << statistics.p90
+        << ", p99=" << statistics.p99
+        << ", max=" << statistics.max << ')';
+    return out;
+  }
+
+} // namespace carla
+
 namespace carla {
 namespace client {
 
@@ -40,7 +56,8 @@ namespace rpc {
         << ",max_substep_delta_time=" << settings.max_substep_delta_time
         << ",max_substeps=" << settings.max_substeps
         << ",max_culling_distance=" << settings.max_culling_distance
-        << ",deterministic_ragdolls=" << BoolToStr(settings.deterministic_ragdolls) << ')';
+        << ",deterministic_ragdolls=" << BoolToStr(settings.deterministic_ragdolls)
+        << ",state_keyframe_interval=" << settings.state_keyframe_interval << ')';
     return out;
   }
 
@@ -69,11 +86,118 @@ static auto Tick(carla::client::World &world, double seconds) {
   return world.Tick(TimeDurationFromSeconds(seconds));
 }
 
+static boost::python::list GetLatencyBuckets(const carla::LatencyHistogram::Statistics &self) {
+  boost::python::list result;
+  for (auto count : self.buckets) {
+    result.append(count);
+  }
+  return result;
+}
+
 static auto ApplySettings(carla::client::World &world, carla::rpc::EpisodeSettings settings, double seconds) {
   carla::PythonUtil::ReleaseGIL unlock;
   return world.ApplySettings(settings, TimeDurationFromSeconds(seconds));
 }
 
+#if PY_MAJOR_VERSION >= 3
+
+/// Copy @a column into a new buffer and return a memoryview of it with shape
+/// (len(column), components), numpy.asarray makes an array of it without
+/// copying.
+template <typename T>
+static boost::python::object MakeQueryColumnView(
+    const std::vector<T> &column,
+    const char *format,
+    size_t components) {
+  namespace bp = boost::python;
+  const auto size = sizeof(T) * column.size();
+  bp::object buffer{bp::handle<>(PyByteArray_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size)))};
+  if (size > 0u) {
+    std::memcpy(PyByteArray_AsString(buffer.ptr()), column.data(), size);
+  }
+  bp::object view{bp::handle<>(PyMemoryView_FromObject(buffer.ptr()))};
+  if (components == 1u) {
+    return view.attr("cast")(format);
+  }
+  return view.attr("cast")(format, bp::make_tuple(column.size(), components));
+}
+
+static boost::python::dict QueryActors(
+    const carla::client::World &self,
+    const std::string &type_pattern,
+    const boost::python::object &location,
+    float radius,
+    const boost::python::object &attributes) {
+  namespace bp = boost::python;
+  using carla::client::ActorQuery;
+  static_assert(sizeof(carla::geom::Vector3D) == 3u * sizeof(float), "Invalid layout");
+  static_assert(sizeof(carla::geom::Rotation) == 3u * sizeof(float), "Invalid layout");
+  ActorQuery query;
+  query.type_pattern = type_pattern;
+  if (!location.is_none()) {
+    query.location = bp::extract<carla::geom::Location>(location)();
+    query.radius = radius;
+  }
+  if (!attributes.is_none()) {
+    const std::vector<std::pair<std::string, uint32_t>> names = {
+        {"location", ActorQuery::Location},
+        {"rotation", ActorQuery::Rotation},
+        {"velocity", ActorQuery::Velocity},
+        {"angular_velocity", ActorQuery::AngularVelocity},
+        {"acceleration", ActorQuery::Acceleration},
+        {"bounding_box", ActorQuery::BoundingBox}};
+    query.attributes = 0u;
+    for (bp::stl_input_iterator<std::string> it(attributes), end; it != end; ++it) {
+      auto found = std::find_if(names.begin(), names.end(), [&](const auto &name) {
+        return name.first == *it;
+      });
+      if (found == names.end()) {
+        throw std::invalid_argument("invalid actor attribute '" + *it + "'");
+      }
+      query.attributes |= found->second;
+    }
+  }
+  carla::client::ActorQueryResult result;
+  {
+    carla::PythonUtil::ReleaseGIL unlock;
+    result = self.QueryActors(query);
+  }
+  bp::dict dict;
+  dict["frame"] = result.frame;
+  dict["id"] = MakeQueryColumnView(result.ids, "I", 1u);
+  if ((query.attributes & ActorQuery::Location) != 0u) {
+    dict["location"] = MakeQueryColumnView(result.locations, "f", 3u);
+  }
+  if ((query.attributes & ActorQuery::Rotation) != 0u) {
+    // Pitch, yaw and roll.
+    dict["rotation"] = MakeQueryColumnView(result.rotations, "f", 3u);
+  }
+  if ((query.attributes & ActorQuery::Velocity) != 0u) {
+    dict["velocity"] = MakeQueryColumnView(result.velocities, "f", 3u);
+  }
+  if ((query.attributes & ActorQuery::AngularVelocity) != 0u) {
+    dict["angular_velocity"] = MakeQueryColumnView(result.angular_velocities, "f", 3u);
+  }
+  if ((query.attributes & ActorQuery::Acceleration) != 0u) {
+    dict["acceleration"] = MakeQueryColumnView(result.accelerations, "f", 3u);
+  }
+  if ((query.attributes & ActorQuery::BoundingBox) != 0u) {
+    std::vector<carla::geom::Vector3D> locations;
+    std::vector<carla::geom::Vector3D> extents;
+    locations.reserve(result.bounding_boxes.size());
+    extents.reserve(result.bounding_boxes.size());
+    for (auto &&bounding_box : result.bounding_boxes) {
+      locations.emplace_back(bounding_box.location);
+      extents.emplace_back(bounding_box.extent);
+    }
+    dict["bounding_box_location"] = MakeQueryColumnView(locations, "f", 3u);
+    dict["bounding_box_extent"] = MakeQueryColumnView(extents, "f", 3u);
+  }
+  return dict;
+}
+
+#endif // PY_MAJOR_VERSION >= 3
+
 static auto GetActorsById(carla::client::World &self, const boost::python::list &actor_ids) {
   std::vector<carla::ActorId> ids{
       boost::python::stl_input_iterator<carla::ActorId>(actor_ids),
@@ -152,8 +276,19 @@ void export_world() {
     .def(self_ns::str(self_ns::self))
   ;
 
+  class_<carla::LatencyHistogram::Statistics>("LatencyStatistics", no_init)
+    .def_readonly("count", &carla::LatencyHistogram::Statistics::count)
+    .def_readonly("mean", &carla::LatencyHistogram::Statistics::mean)
+    .def_readonly("max", &carla::LatencyHistogram::Statistics::max)
+    .def_readonly("p50", &carla::LatencyHistogram::Statistics::p50)
+    .def_readonly("p90", &carla::LatencyHistogram::Statistics::p90)
+    .def_readonly("p99", &carla::LatencyHistogram::Statistics::p99)
+    .add_property("buckets", &GetLatencyBuckets)
+    .def(self_ns::str(self_ns::self))
+  ;
+
   class_<cr::EpisodeSettings>("WorldSettings")
-    .def(init<bool, bool, double, bool, double, int, float, bool, float, float>(
+    .def(init<bool, bool, double, bool, double, int, float, bool, float, float, uint32_t>(
         (arg("synchronous_mode")=false,
          arg("no_rendering_mode")=false,
          arg("fixed_delta_seconds")=0.0,
@@ -163,7 +298,8 @@ void export_world() {
          arg("max_culling_distance")=0.0f,
          arg("deterministic_ragdolls")=false,
          arg("tile_stream_distance")=3000.f,
-         arg("actor_active_distance")=2000.f)))
+         arg("actor_active_distance")=2000.f,
+         arg("state_keyframe_interval")=1u)))
     .def_readwrite("synchronous_mode", &cr::EpisodeSettings::synchronous_mode)
     .def_readwrite("no_rendering_mode", &cr::EpisodeSettings::no_rendering_mode)
     .def_readwrite("substepping", &cr::EpisodeSettings::substepping)
@@ -181,6 +317,7 @@ void export_world() {
         })
     .def_readwrite("tile_stream_distance", &cr::EpisodeSettings::tile_stream_distance)
     .def_readwrite("actor_active_distance", &cr::EpisodeSettings::actor_active_distance)
+    .def_readwrite("state_keyframe_interval", &cr::EpisodeSettings::state_keyframe_interval)
     .def("__eq__", &cr::EpisodeSettings::operator==)
     .def("__ne__", &cr::EpisodeSettings::operator!=)
     .def(self_ns::str(self_ns::self))
@@ -312,12 +449,16 @@ void export_world() {
     .def("get_actor", CONST_CALL_WITHOUT_GIL_1(cc::World, GetActor, carla::ActorId), (arg("actor_id")))
     .def("get_actors", CONST_CALL_WITHOUT_GIL(cc::World, GetActors))
     .def("get_actors", &GetActorsById, (arg("actor_ids")))
+#if PY_MAJOR_VERSION >= 3
+    .def("query_actors", &QueryActors, (arg("type_pattern")="*", arg("location")=object(), arg("radius")=0.0f, arg("attributes")=object()))
+#endif // PY_MAJOR_VERSION >= 3
     .def("spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(SpawnActor))
     .def("try_spawn_actor", SPAWN_ACTOR_WITHOUT_GIL(TrySpawnActor))
     .def("wait_for_tick", &WaitForTick, (arg("seconds")=0.0))
     .def("on_tick", &OnTick, (arg("callback")))
     .def("remove_on_tick", &cc::World::RemoveOnTick, (arg("callback_id")))
     .def("tick", &Tick, (arg("seconds")=0.0))
+    .def("get_tick_latency_statistics", &cc::World::GetTickLatencyStatistics)
     .def("set_pedestrians_cross_factor", CALL_WITHOUT_GIL_1(cc::World, SetPedestriansCrossFactor, float), (arg("percentage")))
     .def("set_pedestrians_seed", CALL_WITHOUT_GIL_1(cc::World, SetPedestriansSeed, unsigned int), (arg("seed")))
     .def("get_traffic_sign", CONST_CALL_WITHOUT_GIL_1(cc::World, GetTrafficSign, cc::Landmark), arg("landmark"))
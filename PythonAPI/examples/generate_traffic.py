@@ -148,6 +148,11 @@ def main():
         action='store_true',
         default=False,
         help='Activate no rendering mode')
+    argparser.add_argument(
+        '--bulk-spawn',
+        action='store_true',
+        default=False,
+        help='Spawn the vehicles in a single request, the simulator picks the free spawn points')
 
     args = argparser.parse_args()
 
@@ -226,6 +231,7 @@ def main():
         # Spawn vehicles
         # --------------
         batch = []
+        bulk = carla.command.SpawnActorsBulk(spawn_points)
         hero = args.hero
         for n, transform in enumerate(spawn_points):
             if n >= args.number_of_vehicles:
@@ -243,14 +249,25 @@ def main():
             else:
                 blueprint.set_attribute('role_name', 'autopilot')
 
-            # spawn the cars and set their autopilot and light state all together
-            batch.append(SpawnActor(blueprint, transform)
-                .then(SetAutopilot(FutureActor, True, traffic_manager.get_port())))
+            if args.bulk_spawn:
+                bulk.add(blueprint)
+            else:
+                # spawn the cars and set their autopilot and light state all together
+                batch.append(SpawnActor(blueprint, transform)
+                    .then(SetAutopilot(FutureActor, True, traffic_manager.get_port())))
+
+        if args.bulk_spawn:
+            for response in client.spawn_actors_bulk(bulk):
+                if response.error:
+                    logging.error(response.error)
+                else:
+                    vehicles_list.append(response.actor_id)
+            batch = [SetAutopilot(x, True, traffic_manager.get_port()) for x in vehicles_list]
 
         for response in client.apply_batch_sync(batch, synchronous_master):
             if response.error:
                 logging.error(response.error)
-            else:
+            elif not args.bulk_spawn:
                 vehicles_list.append(response.actor_id)
 
         # Set automatic vehicle lights update if specified
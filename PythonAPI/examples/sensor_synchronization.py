@@ -19,6 +19,15 @@ have received its data.
 This suppose that all the sensors gather information at every tick. It this is
 not the case, the clients needs to take in account at each frame how many
 sensors are going to tick at each frame.
+
+The same can be achieved without queues with carla.FrameSynchronizer, which
+matches the data of the sensors by frame in the client library and delivers
+a single bundle per frame:
+
+    synchronizer = carla.FrameSynchronizer(sensor_list, timeout=1.0)
+    synchronizer.listen()
+    frame = world.tick()
+    bundle = synchronizer.get(frame)
 """
 
 import glob
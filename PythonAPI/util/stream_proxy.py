@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+
+# Copyright (c) 2021 Computer Vision Center (CVC) at the Universitat Autonoma de
+# Barcelona (UAB).
+#
+# This work is licensed under the terms of the MIT license.
+# For a copy, see <https://opensource.org/licenses/MIT>.
+
+"""
+Relays the streams of the simulator (world state and sensors) to the clients
+running on this host, so each stream is received once no matter how many
+clients subscribe to it.
+
+The clients use the proxy when the CARLA_STREAM_PROXY environment variable
+names it, e.g. CARLA_STREAM_PROXY=127.0.0.1:2100. RPC calls still go directly
+to the simulator.
+"""
+
+import glob
+import os
+import sys
+
+try:
+    sys.path.append(glob.glob('../carla/dist/carla-*%d.%d-%s.egg' % (
+        sys.version_info.major,
+        sys.version_info.minor,
+        'win-amd64' if os.name == 'nt' else 'linux-x86_64'))[0])
+except IndexError:
+    pass
+
+
+import carla
+
+import argparse
+import time
+
+
+def main():
+    argparser = argparse.ArgumentParser(
+        description=__doc__)
+    argparser.add_argument(
+        '--host',
+        metavar='H',
+        default='127.0.0.1',
+        help='IP of the host server (default: 127.0.0.1)')
+    argparser.add_argument(
+        '--listen-address',
+        metavar='A',
+        default='127.0.0.1',
+        help='local address the clients connect to (default: 127.0.0.1)')
+    argparser.add_argument(
+        '-p', '--port',
+        metavar='P',
+        default=2100,
+        type=int,
+        help='TCP port of the proxy, streams use the next one (default: 2100)')
+    argparser.add_argument(
+        '--worker-threads',
+        metavar='N',
+        default=1,
+        type=int,
+        help='threads forwarding the streams (default: 1)')
+    args = argparser.parse_args()
+
+    proxy = carla.StreamProxy(args.host, args.listen_address, args.port, args.worker_threads)
+    print('Relaying the streams of %s, export CARLA_STREAM_PROXY=%s:%d to use the proxy.' % (
+        args.host, args.listen_address, args.port))
+
+    try:
+        while True:
+            time.sleep(5.0)
+            print('Relaying %d streams.' % proxy.get_number_of_relayed_streams())
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+
+    main()
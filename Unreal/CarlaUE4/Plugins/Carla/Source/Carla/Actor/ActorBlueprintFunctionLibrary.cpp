@@ -646,6 +646,62 @@ void UActorBlueprintFunctionLibrary::MakeCameraDefinition(
   Success = CheckActorDefinition(Definition);
 }
 
+void UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(
+    FActorDefinition &Definition,
+    const bool bEnableInterpolation)
+{
+  // Region of interest, zero width or height extend it to the image edge.
+  FActorVariation RoiX;
+  RoiX.Id = TEXT("roi_x");
+  RoiX.Type = EActorAttributeType::Int;
+  RoiX.RecommendedValues = { TEXT("0") };
+  RoiX.bRestrictToRecommended = false;
+
+  FActorVariation RoiY;
+  RoiY.Id = TEXT("roi_y");
+  RoiY.Type = EActorAttributeType::Int;
+  RoiY.RecommendedValues = { TEXT("0") };
+  RoiY.bRestrictToRecommended = false;
+
+  FActorVariation RoiWidth;
+  RoiWidth.Id = TEXT("roi_width");
+  RoiWidth.Type = EActorAttributeType::Int;
+  RoiWidth.RecommendedValues = { TEXT("0") };
+  RoiWidth.bRestrictToRecommended = false;
+
+  FActorVariation RoiHeight;
+  RoiHeight.Id = TEXT("roi_height");
+  RoiHeight.Type = EActorAttributeType::Int;
+  RoiHeight.RecommendedValues = { TEXT("0") };
+  RoiHeight.bRestrictToRecommended = false;
+
+  // Integer factor the region of interest is downscaled by.
+  FActorVariation DownscaleFactor;
+  DownscaleFactor.Id = TEXT("downscale_factor");
+  DownscaleFactor.Type = EActorAttributeType::Int;
+  DownscaleFactor.RecommendedValues = { TEXT("1"), TEXT("2"), TEXT("4") };
+  DownscaleFactor.bRestrictToRecommended = false;
+
+  Definition.Variations.Append({
+    RoiX,
+    RoiY,
+    RoiWidth,
+    RoiHeight,
+    DownscaleFactor});
+
+  // Averaging pixels is only valid for color images, encoded images like
+  // depth or semantic tags always pick the nearest pixel.
+  if (bEnableInterpolation)
+  {
+    FActorVariation DownscaleFilter;
+    DownscaleFilter.Id = TEXT("downscale_filter");
+    DownscaleFilter.Type = EActorAttributeType::String;
+    DownscaleFilter.RecommendedValues = { TEXT("box"), TEXT("bilinear"), TEXT("nearest") };
+    DownscaleFilter.bRestrictToRecommended = true;
+    Definition.Variations.Emplace(DownscaleFilter);
+  }
+}
+
 FActorDefinition UActorBlueprintFunctionLibrary::MakeIMUDefinition()
 {
   FActorDefinition Definition;
@@ -885,6 +941,12 @@ void UActorBlueprintFunctionLibrary::MakeLidarDefinition(
   StdDevLidar.Id = TEXT("noise_stddev");
   StdDevLidar.Type = EActorAttributeType::Float;
   StdDevLidar.RecommendedValues = { TEXT("0.0") };
+  // Azimuth bins of the range image.
+  FActorVariation HorizontalBins;
+  HorizontalBins.Id = TEXT("horizontal_bins");
+  HorizontalBins.Type = EActorAttributeType::Int;
+  HorizontalBins.RecommendedValues = { TEXT("0") };
+  HorizontalBins.bRestrictToRecommended = false;
 
   if (Id == "ray_cast") {
     Definition.Variations.Append({
@@ -902,6 +964,23 @@ void UActorBlueprintFunctionLibrary::MakeLidarDefinition(
       StdDevLidar,
       HorizontalFOV});
   }
+  else if (Id == "ray_cast_range_image") {
+    Definition.Variations.Append({
+      Channels,
+      Range,
+      PointsPerSecond,
+      Frequency,
+      UpperFOV,
+      LowerFOV,
+      AtmospAttenRate,
+      NoiseSeed,
+      DropOffGenRate,
+      DropOffIntensityLimit,
+      DropOffAtZeroIntensity,
+      StdDevLidar,
+      HorizontalFOV,
+      HorizontalBins});
+  }
   else if (Id == "ray_cast_semantic") {
     Definition.Variations.Append({
       Channels,
@@ -1417,6 +1496,20 @@ void UActorBlueprintFunctionLibrary::SetCamera(
       RetrieveActorAttributeToInt("image_size_y", Description.Variations, 600));
   Camera->SetFOVAngle(
       RetrieveActorAttributeToFloat("fov", Description.Variations, 90.0f));
+  {
+    using Filter = carla::image::ImageResampler::Filter;
+    const FString DownscaleFilter =
+        RetrieveActorAttributeToString("downscale_filter", Description.Variations, "nearest");
+    Camera->SetOutputResampling(
+        FMath::Max(0, RetrieveActorAttributeToInt("roi_x", Description.Variations, 0)),
+        FMath::Max(0, RetrieveActorAttributeToInt("roi_y", Description.Variations, 0)),
+        FMath::Max(0, RetrieveActorAttributeToInt("roi_width", Description.Variations, 0)),
+        FMath::Max(0, RetrieveActorAttributeToInt("roi_height", Description.Variations, 0)),
+        FMath::Max(1, RetrieveActorAttributeToInt("downscale_factor", Description.Variations, 1)),
+        DownscaleFilter == "box" ? Filter::Box :
+        DownscaleFilter == "bilinear" ? Filter::Bilinear :
+        Filter::Nearest);
+  }
   if (Description.Variations.Contains("enable_postprocess_effects"))
   {
     Camera->EnablePostProcessingEffects(
@@ -1548,6 +1641,8 @@ void UActorBlueprintFunctionLibrary::SetLidar(
       RetrieveActorAttributeToFloat("dropoff_zero_intensity", Description.Variations, Lidar.DropOffAtZeroIntensity);
   Lidar.NoiseStdDev =
       RetrieveActorAttributeToFloat("noise_stddev", Description.Variations, Lidar.NoiseStdDev);
+  Lidar.HorizontalBins =
+      RetrieveActorAttributeToInt("horizontal_bins", Description.Variations, Lidar.HorizontalBins);
 }
 
 void UActorBlueprintFunctionLibrary::SetGnss(
@@ -71,6 +71,13 @@ public:
       bool &Success,
       FActorDefinition &Definition);
 
+  /// Add the variations to crop and downscale the images of a camera before
+  /// sending them. @a bEnableInterpolation exposes the filters that average
+  /// pixels, only valid for color images.
+  static void AddOutputResamplingVariations(
+      FActorDefinition &Definition,
+      bool bEnableInterpolation);
+
   static FActorDefinition MakeLidarDefinition(
       const FString &Id);
 
@@ -50,6 +50,13 @@ public:
     return (*Stream).token();
   }
 
+  /// Return the number of clients that subscribed to this stream so far.
+  size_t GetNumberOfConnections() const
+  {
+    check(Stream.has_value());
+    return (*Stream).GetNumberOfConnections();
+  }
+
 private:
 
   boost::optional<StreamType> Stream;
@@ -11,7 +11,10 @@
 
 FActorDefinition ADepthCamera::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("depth"));
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("depth"));
+  constexpr bool bEnableInterpolation = false;
+  UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(Definition, bEnableInterpolation);
+  return Definition;
 }
 
 ADepthCamera::ADepthCamera(const FObjectInitializer &ObjectInitializer)
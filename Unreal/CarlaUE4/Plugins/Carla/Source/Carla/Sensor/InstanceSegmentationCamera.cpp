@@ -14,7 +14,10 @@
 
 FActorDefinition AInstanceSegmentationCamera::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("instance_segmentation"));
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("instance_segmentation"));
+  constexpr bool bEnableInterpolation = false;
+  UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(Definition, bEnableInterpolation);
+  return Definition;
 }
 
 AInstanceSegmentationCamera::AInstanceSegmentationCamera(
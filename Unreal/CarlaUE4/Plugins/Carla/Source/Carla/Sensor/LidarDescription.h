@@ -69,4 +69,9 @@ struct CARLA_API FLidarDescription
 
   UPROPERTY(EditAnywhere)
   float NoiseStdDev = 0.0f;
+
+  /// Number of azimuth bins of the range image layout, 0 uses the points
+  /// scanned by one laser in a rotation.
+  UPROPERTY(EditAnywhere)
+  uint32 HorizontalBins = 0u;
 };
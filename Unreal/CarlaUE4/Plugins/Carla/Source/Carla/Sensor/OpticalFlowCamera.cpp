@@ -6,7 +6,10 @@
 
 FActorDefinition AOpticalFlowCamera::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("optical_flow"));
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("optical_flow"));
+  constexpr bool bEnableInterpolation = false;
+  UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(Definition, bEnableInterpolation);
+  return Definition;
 }
 
 AOpticalFlowCamera::AOpticalFlowCamera(const FObjectInitializer &ObjectInitializer)
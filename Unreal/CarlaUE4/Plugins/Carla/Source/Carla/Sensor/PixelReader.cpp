@@ -7,6 +7,7 @@
 #include "Carla.h"
 #include "Carla/Sensor/PixelReader.h"
 
+#include "Async/ParallelFor.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "HighResScreenshot.h"
 #include "Runtime/ImageWriteQueue/Public/ImageWriteQueue.h"
@@ -236,3 +237,35 @@ void FPixelReader::WritePixelsToBuffer(
     }
   }
 }
+
+bool FPixelReader::ResampleBuffer(
+    const carla::image::ImageResampler &Resampler,
+    const carla::Buffer &Source,
+    carla::Buffer &Destination,
+    uint32 Offset)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
+  if (Source.size() != Offset + Resampler.GetSourceSize())
+  {
+    UE_LOG(LogCarla, Warning, TEXT("FPixelReader: image size does not match the sensor, frame dropped"));
+    return false;
+  }
+  Destination.reset(Offset + Resampler.GetOutputSize());
+  const unsigned char *SourcePixels = Source.data() + Offset;
+  unsigned char *DestinationPixels = Destination.data() + Offset;
+
+  // Split the output in chunks of rows, big enough to amortize the task.
+  const uint32 Height = Resampler.GetOutputHeight();
+  const uint32 RowsPerChunk = 32u;
+  const int32 NumChunks = (Height + RowsPerChunk - 1u) / RowsPerChunk;
+  ParallelFor(NumChunks, [&](int32 Chunk)
+  {
+    const uint32 BeginRow = Chunk * RowsPerChunk;
+    Resampler.ResampleRows(
+        SourcePixels,
+        DestinationPixels,
+        BeginRow,
+        FMath::Min(BeginRow + RowsPerChunk, Height));
+  });
+  return true;
+}
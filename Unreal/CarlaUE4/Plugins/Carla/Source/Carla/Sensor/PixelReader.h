@@ -12,6 +12,7 @@
 
 #include <compiler/disable-ue4-macros.h>
 #include <carla/Buffer.h>
+#include <carla/image/ImageResampler.h>
 #include <carla/sensor/SensorRegistry.h>
 #include <carla/OpenCL/OpenCLcontext.h>
 #include <compiler/enable-ue4-macros.h>
@@ -80,6 +81,17 @@ private:
       FRHICommandListImmediate &InRHICmdList,
       bool use16BitFormat = false);
 
+  /// Crop and downscale the image in @a Source into @a Destination, leaving
+  /// @a Offset bytes in front for the header. Returns false if @a Source
+  /// does not hold an image of the size expected by @a Resampler.
+  ///
+  /// @pre To be called from render-thread.
+  static bool ResampleBuffer(
+      const carla::image::ImageResampler &Resampler,
+      const carla::Buffer &Source,
+      carla::Buffer &Destination,
+      uint32 Offset);
+
 };
 
 // =============================================================================
@@ -105,20 +117,31 @@ void FPixelReader::SendPixelsInRenderThread(TSensor &Sensor, bool use16BitFormat
   // game-thread.
   ENQUEUE_RENDER_COMMAND(FWritePixels_SendPixelsInRenderThread)
   (
-    [&Sensor, Stream=Sensor.GetDataStream(Sensor), use16BitFormat](auto &InRHICmdList) mutable
+    [&Sensor, Stream=Sensor.GetDataStream(Sensor), use16BitFormat, Resampler=Sensor.MakeImageResampler()](auto &InRHICmdList) mutable
     {
       TRACE_CPUPROFILER_EVENT_SCOPE_STR("FWritePixels_SendPixelsInRenderThread");
 
       /// @todo Can we make sure the sensor is not going to be destroyed?
       if (!Sensor.IsPendingKill())
       {
+        constexpr auto Offset = carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset;
         auto Buffer = Stream.PopBufferFromPool();
         WritePixelsToBuffer(
             *Sensor.CaptureRenderTarget,
             Buffer,
-            carla::sensor::SensorRegistry::get<TSensor *>::type::header_offset,
+            Offset,
             InRHICmdList, use16BitFormat);
 
+        if(Buffer.data() && !Resampler.IsIdentity())
+        {
+          auto Output = Stream.PopBufferFromPool();
+          if (!ResampleBuffer(Resampler, Buffer, Output, Offset))
+          {
+            return;
+          }
+          Buffer = std::move(Output);
+        }
+
         if(Buffer.data())
         {
           SCOPE_CYCLE_COUNTER(STAT_CarlaSensorStreamSend);
@@ -37,7 +37,7 @@ public:
 
   virtual void PostPhysTick(UWorld *World, ELevelTick TickType, float DeltaTime);
 
-private:
+protected:
   /// Compute the received intensity of the point
   float ComputeIntensity(const FSemanticDetection& RawDetection) const;
   FDetection ComputeDetection(const FHitResult& HitInfo, const FTransform& SensorTransf) const;
@@ -47,6 +47,7 @@ private:
 
   void ComputeAndSaveDetections(const FTransform& SensorTransform) override;
 
+private:
   FLidarData LidarData;
 
   /// Enable/Disable general dropoff of lidar points
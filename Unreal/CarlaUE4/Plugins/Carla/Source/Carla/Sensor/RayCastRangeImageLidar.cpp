@@ -0,0 +1,83 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#include "Carla.h"
+#include "Carla/Sensor/RayCastRangeImageLidar.h"
+#include "Carla/Actor/ActorBlueprintFunctionLibrary.h"
+
+#include "Runtime/Core/Public/Async/ParallelFor.h"
+
+FActorDefinition ARayCastRangeImageLidar::GetSensorDefinition()
+{
+  return UActorBlueprintFunctionLibrary::MakeLidarDefinition(TEXT("ray_cast_range_image"));
+}
+
+ARayCastRangeImageLidar::ARayCastRangeImageLidar(const FObjectInitializer &ObjectInitializer)
+  : Super(ObjectInitializer) {}
+
+void ARayCastRangeImageLidar::Set(const FActorDescription &ActorDescription)
+{
+  Super::Set(ActorDescription);
+}
+
+void ARayCastRangeImageLidar::Set(const FLidarDescription &LidarDescription)
+{
+  Super::Set(LidarDescription);
+  uint32 Width = Description.HorizontalBins;
+  if (Width == 0u)
+  {
+    // Points scanned by one laser while sweeping the horizontal field of view.
+    Width = FMath::RoundToInt(
+        Description.PointsPerSecond /
+        (Description.Channels * FMath::Max(Description.RotationFrequency, 0.1f)));
+  }
+  RangeImageData = FLidarRangeImageData(
+      Description.Channels,
+      FMath::Max(Width, 1u),
+      Description.HorizontalFov,
+      Description.UpperFovLimit,
+      Description.LowerFovLimit);
+}
+
+void ARayCastRangeImageLidar::PostPhysTick(UWorld *World, ELevelTick TickType, float DeltaTime)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(ARayCastRangeImageLidar::PostPhysTick);
+  SimulateLidar(DeltaTime);
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE_STR("Send Stream");
+    auto DataStream = GetDataStream(*this);
+    DataStream.Send(*this, RangeImageData, DataStream.PopBufferFromPool());
+  }
+}
+
+void ARayCastRangeImageLidar::ComputeAndSaveDetections(const FTransform &SensorTransform)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
+  RangeImageData.Reset();
+
+  // Each channel writes only its own row, so no synchronization is needed.
+  ParallelFor(Description.Channels, [&](int32 idxChannel) {
+    for (auto &Hit : RecordedHits[idxChannel]) {
+      // The azimuth of the ray in the sensor frame gives the column.
+      const FVector Direction =
+          SensorTransform.InverseTransformVectorNoScale(Hit.TraceEnd - Hit.TraceStart);
+      const float Azimuth = FMath::RadiansToDegrees(FMath::Atan2(Direction.Y, Direction.X));
+      RangeImageData.WritePoint(idxChannel, Azimuth, ComputeDetection(Hit, SensorTransform));
+    }
+  });
+
+  // Noise and drop-off draw from the random engine, which is not thread-safe,
+  // applied in a fixed order to keep the results deterministic.
+  for (auto idxChannel = 0u; idxChannel < RangeImageData.GetChannelCount(); ++idxChannel) {
+    for (auto idxColumn = 0u; idxColumn < RangeImageData.GetWidth(); ++idxColumn) {
+      auto &Detection = RangeImageData.At(idxChannel, idxColumn);
+      if (FLidarRangeImageData::IsValidReturn(Detection) && !PostprocessDetection(Detection)) {
+        Detection = FLidarRangeImageData::GetInvalidReturn();
+      }
+    }
+  }
+}
@@ -0,0 +1,41 @@
+// Copyright (c) 2020 Computer Vision Center (CVC) at the Universitat Autonoma
+// de Barcelona (UAB).
+//
+// This work is licensed under the terms of the MIT license.
+// For a copy, see <https://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "Carla/Actor/ActorDefinition.h"
+#include "Carla/Sensor/LidarDescription.h"
+#include "Carla/Sensor/RayCastLidar.h"
+
+#include <compiler/disable-ue4-macros.h>
+#include <carla/sensor/data/LidarRangeImageData.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include "RayCastRangeImageLidar.generated.h"
+
+/// A ray-cast based Lidar sensor that sends its measurements as a dense
+/// range image of channels x azimuth bins.
+UCLASS()
+class CARLA_API ARayCastRangeImageLidar : public ARayCastLidar
+{
+  GENERATED_BODY()
+
+  using FLidarRangeImageData = carla::sensor::data::LidarRangeImageData;
+
+public:
+  static FActorDefinition GetSensorDefinition();
+
+  ARayCastRangeImageLidar(const FObjectInitializer &ObjectInitializer);
+  virtual void Set(const FActorDescription &Description) override;
+  virtual void Set(const FLidarDescription &LidarDescription) override;
+
+  virtual void PostPhysTick(UWorld *World, ELevelTick TickType, float DeltaTime) override;
+
+private:
+  void ComputeAndSaveDetections(const FTransform &SensorTransform) override;
+
+  FLidarRangeImageData RangeImageData;
+};
@@ -12,9 +12,12 @@
 FActorDefinition ASceneCaptureCamera::GetSensorDefinition()
 {
   constexpr bool bEnableModifyingPostProcessEffects = true;
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(
       TEXT("rgb"),
       bEnableModifyingPostProcessEffects);
+  constexpr bool bEnableInterpolation = true;
+  UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(Definition, bEnableInterpolation);
+  return Definition;
 }
 
 ASceneCaptureCamera::ASceneCaptureCamera(const FObjectInitializer &ObjectInitializer)
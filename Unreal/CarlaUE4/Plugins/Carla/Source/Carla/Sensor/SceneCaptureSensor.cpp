@@ -88,6 +88,36 @@ void ASceneCaptureSensor::SetImageSize(uint32 InWidth, uint32 InHeight)
   ImageHeight = InHeight;
 }
 
+void ASceneCaptureSensor::SetOutputResampling(
+    uint32 InRoiX,
+    uint32 InRoiY,
+    uint32 InRoiWidth,
+    uint32 InRoiHeight,
+    uint32 InFactor,
+    carla::image::ImageResampler::Filter InFilter)
+{
+  RoiX = InRoiX;
+  RoiY = InRoiY;
+  RoiWidth = InRoiWidth;
+  RoiHeight = InRoiHeight;
+  DownscaleFactor = InFactor;
+  DownscaleFilter = InFilter;
+}
+
+carla::image::ImageResampler ASceneCaptureSensor::MakeImageResampler() const
+{
+  return carla::image::ImageResampler(
+      ImageWidth,
+      ImageHeight,
+      bEnable16BitFormat ? 8u : 4u,
+      RoiX,
+      RoiY,
+      RoiWidth,
+      RoiHeight,
+      DownscaleFactor,
+      DownscaleFilter);
+}
+
 void ASceneCaptureSensor::SetFOVAngle(const float FOVAngle)
 {
   check(CaptureComponent2D != nullptr);
@@ -51,6 +51,31 @@ public:
     return ImageHeight;
   }
 
+  /// Crop the rendered image to the given region of interest and downscale
+  /// it by an integer @a Factor before sending it. A zero @a RoiWidth or
+  /// @a RoiHeight extends the region to the edge of the image.
+  void SetOutputResampling(
+      uint32 RoiX,
+      uint32 RoiY,
+      uint32 RoiWidth,
+      uint32 RoiHeight,
+      uint32 Factor,
+      carla::image::ImageResampler::Filter Filter);
+
+  carla::image::ImageResampler MakeImageResampler() const;
+
+  /// Width in pixels of the image sent to the client.
+  uint32 GetOutputImageWidth() const
+  {
+    return MakeImageResampler().GetOutputWidth();
+  }
+
+  /// Height in pixels of the image sent to the client.
+  uint32 GetOutputImageHeight() const
+  {
+    return MakeImageResampler().GetOutputHeight();
+  }
+
   UFUNCTION(BlueprintCallable)
   void EnablePostProcessingEffects(bool Enable = true)
   {
@@ -336,6 +361,27 @@ protected:
   UPROPERTY(EditAnywhere)
   bool bEnable16BitFormat = false;
 
+  /// Region of interest of the image sent to the client, zero width or
+  /// height extend it to the edge of the image.
+  UPROPERTY(EditAnywhere)
+  uint32 RoiX = 0u;
+
+  UPROPERTY(EditAnywhere)
+  uint32 RoiY = 0u;
+
+  UPROPERTY(EditAnywhere)
+  uint32 RoiWidth = 0u;
+
+  UPROPERTY(EditAnywhere)
+  uint32 RoiHeight = 0u;
+
+  /// Integer factor the region of interest is downscaled by.
+  UPROPERTY(EditAnywhere)
+  uint32 DownscaleFactor = 1u;
+
+  carla::image::ImageResampler::Filter DownscaleFilter =
+      carla::image::ImageResampler::Filter::Nearest;
+
   FRenderCommandFence RenderFence;
 
 };
@@ -11,7 +11,10 @@
 
 FActorDefinition ASemanticSegmentationCamera::GetSensorDefinition()
 {
-  return UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("semantic_segmentation"));
+  auto Definition = UActorBlueprintFunctionLibrary::MakeCameraDefinition(TEXT("semantic_segmentation"));
+  constexpr bool bEnableInterpolation = false;
+  UActorBlueprintFunctionLibrary::AddOutputResamplingVariations(Definition, bEnableInterpolation);
+  return Definition;
 }
 
 ASemanticSegmentationCamera::ASemanticSegmentationCamera(
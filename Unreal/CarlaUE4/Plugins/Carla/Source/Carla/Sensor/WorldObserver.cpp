@@ -22,6 +22,7 @@
 #include <carla/rpc/String.h>
 #include <carla/sensor/SensorRegistry.h>
 #include <carla/sensor/data/ActorDynamicState.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
 #include <compiler/enable-ue4-macros.h>
 
 static auto FWorldObserver_GetActorState(const FCarlaActor &View, const FActorRegistry &Registry)
@@ -259,22 +260,92 @@ static carla::geom::Vector3D FWorldObserver_GetAcceleration(
   return {Acceleration.X, Acceleration.Y, Acceleration.Z};
 }
 
-static carla::Buffer FWorldObserver_Serialize(
-    carla::Buffer &&buffer,
+static carla::sensor::data::ActorDynamicState FWorldObserver_GetActorDynamicState(
+    const FCarlaActor &View,
+    const FActorRegistry &Registry,
+    float DeltaSeconds)
+{
+  constexpr float TO_METERS = 1e-2;
+
+  FTransform ActorTransform;
+  FVector Velocity(0.0f);
+  carla::geom::Vector3D AngularVelocity(0.0f, 0.0f, 0.0f);
+  carla::geom::Vector3D Acceleration(0.0f, 0.0f, 0.0f);
+  carla::sensor::data::ActorDynamicState::TypeDependentState State{};
+
+  if(View.IsDormant())
+  {
+    const FActorData* ActorData = View.GetActorData();
+    Velocity = TO_METERS * ActorData->Velocity;
+    AngularVelocity = carla::geom::Vector3D
+                      {ActorData->AngularVelocity.X,
+                       ActorData->AngularVelocity.Y,
+                       ActorData->AngularVelocity.Z};
+    Acceleration = FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds);
+    State = FWorldObserver_GetDormantActorState(View, Registry);
+  }
+  else
+  {
+    Velocity = TO_METERS * View.GetActor()->GetVelocity();
+    AngularVelocity = FWorldObserver_GetAngularVelocity(*View.GetActor());
+    Acceleration = FWorldObserver_GetAcceleration(View, Velocity, DeltaSeconds);
+    State = FWorldObserver_GetActorState(View, Registry);
+  }
+  ActorTransform = View.GetActorGlobalTransform();
+
+  // Zero the padding too, deltas compare the raw bytes.
+  carla::sensor::data::ActorDynamicState info;
+  std::memset(static_cast<void *>(&info), 0, sizeof(info));
+  info.id = View.GetActorId();
+  info.actor_state = View.GetActorState();
+  info.transform = carla::geom::Transform(ActorTransform);
+  info.velocity = carla::geom::Vector3D(Velocity.X, Velocity.Y, Velocity.Z);
+  info.angular_velocity = AngularVelocity;
+  info.acceleration = Acceleration;
+  info.state = State;
+  return info;
+}
+
+static carla::sensor::s11n::EpisodeStateSerializer::Header FWorldObserver_MakeHeader(
     const UCarlaEpisode &Episode,
     float DeltaSeconds,
     bool MapChange,
-    bool PendingLightUpdates)
+    bool PendingLightUpdates,
+    uint64_t Sequence,
+    bool bKeyframe)
 {
-  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
   using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
   using SimulationState = carla::sensor::s11n::EpisodeStateSerializer::SimulationState;
-  using ActorDynamicState = carla::sensor::data::ActorDynamicState;
 
+  Serializer::Header header;
+  header.episode_id = Episode.GetId();
+  header.platform_timestamp = FPlatformTime::Seconds();
+  header.delta_seconds = DeltaSeconds;
+  FIntVector MapOrigin = Episode.GetCurrentMapOrigin();
+  FIntVector MapOriginInMeters = MapOrigin / 100;
+  header.map_origin = carla::geom::Vector3DInt{ MapOriginInMeters.X, MapOriginInMeters.Y, MapOriginInMeters.Z };
+
+  uint8_t simulation_state = (SimulationState::MapChange * MapChange);
+  simulation_state |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
+
+  header.simulation_state = static_cast<SimulationState>(simulation_state);
+  header.sequence = Sequence;
+  header.encoding = bKeyframe ? Serializer::Encoding::Keyframe : Serializer::Encoding::Delta;
+  return header;
+}
+
+carla::Buffer FWorldObserver::SerializeKeyframe(
+    carla::Buffer &&buffer,
+    const UCarlaEpisode &Episode,
+    const FHeader &Header,
+    float DeltaSeconds,
+    bool bTrackSentStates)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
 
   const FActorRegistry &Registry = Episode.GetActorRegistry();
 
-  auto total_size = sizeof(Serializer::Header) + sizeof(ActorDynamicState) * Registry.Num();
+  auto total_size = sizeof(FHeader) + sizeof(FActorDynamicState) * Registry.Num();
   auto current_size = 0;
   // Set up buffer for writing.
   buffer.reset(total_size);
@@ -285,75 +356,112 @@ static carla::Buffer FWorldObserver_Serialize(
     current_size += sizeof(data);
   };
 
-  constexpr float TO_METERS = 1e-2;
-
-  // Write header.
-  Serializer::Header header;
-  header.episode_id = Episode.GetId();
-  header.platform_timestamp = FPlatformTime::Seconds();
-  header.delta_seconds = DeltaSeconds;
-  FIntVector MapOrigin = Episode.GetCurrentMapOrigin();
-  FIntVector MapOriginInMeters = MapOrigin / 100;
-  header.map_origin = carla::geom::Vector3DInt{ MapOriginInMeters.X, MapOriginInMeters.Y, MapOriginInMeters.Z };
-
-  uint8_t simulation_state = (SimulationState::MapChange * MapChange);
-  simulation_state |= (SimulationState::PendingLightUpdate * PendingLightUpdates);
-
-  header.simulation_state = static_cast<SimulationState>(simulation_state);
+  write_data(Header);
 
-  write_data(header);
+  if (bTrackSentStates)
+  {
+    SentStates.clear();
+    SentStates.reserve(Registry.Num());
+  }
 
   // Write every actor.
   for (auto& It : Registry)
   {
     const FCarlaActor* View = It.Value.Get();
-    const FActorInfo* ActorInfo = View->GetActorInfo();
+    check(View);
+    const FActorDynamicState info =
+        FWorldObserver_GetActorDynamicState(*View, Registry, DeltaSeconds);
+    write_data(info);
+    if (bTrackSentStates)
+    {
+      SentStates[info.id] = FSentActorState{info, Header.sequence};
+    }
+  }
 
-    FTransform ActorTransform;
-    FVector Velocity(0.0f);
-    carla::geom::Vector3D AngularVelocity(0.0f, 0.0f, 0.0f);
-    carla::geom::Vector3D Acceleration(0.0f, 0.0f, 0.0f);
-    carla::sensor::data::ActorDynamicState::TypeDependentState State{};
+  // Shrink buffer
+  buffer.resize(current_size);
 
+  check(buffer.size() == current_size);
 
+  return std::move(buffer);
+}
+
+carla::Buffer FWorldObserver::SerializeDelta(
+    carla::Buffer &&buffer,
+    const UCarlaEpisode &Episode,
+    const FHeader &Header,
+    float DeltaSeconds)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
+  using Serializer = carla::sensor::s11n::EpisodeStateSerializer;
+
+  const FActorRegistry &Registry = Episode.GetActorRegistry();
+
+  // Worst case, every actor changed every field and every actor we knew of
+  // was removed.
+  const auto max_size =
+      sizeof(FHeader) +
+      sizeof(Serializer::DeltaHeader) +
+      Serializer::GetDeltaRecordSize(Serializer::AllFields) * Registry.Num() +
+      sizeof(carla::rpc::ActorId) * SentStates.size();
+  buffer.reset(max_size);
+
+  unsigned char *begin = buffer.begin();
+  unsigned char *position = begin;
+  std::memcpy(position, &Header, sizeof(Header));
+  position += sizeof(Header);
+  unsigned char *delta_header_position = position;
+  position += sizeof(Serializer::DeltaHeader);
+
+  Serializer::DeltaHeader delta_header{0u, 0u};
+
+  // Write the actors that changed.
+  for (auto& It : Registry)
+  {
+    const FCarlaActor* View = It.Value.Get();
     check(View);
+    const FActorDynamicState info =
+        FWorldObserver_GetActorDynamicState(*View, Registry, DeltaSeconds);
+    auto Sent = SentStates.find(info.id);
+    uint8_t fields = Serializer::AllFields;
+    if (Sent == SentStates.end())
+    {
+      Sent = SentStates.emplace(info.id, FSentActorState{info, Header.sequence}).first;
+    }
+    else
+    {
+      fields = Serializer::GetChangedFields(Sent->second.State, info);
+      Sent->second.State = info;
+      Sent->second.Sequence = Header.sequence;
+    }
+    if (fields != 0u)
+    {
+      position = Serializer::WriteDeltaRecord(position, info, fields);
+      ++delta_header.number_of_records;
+    }
+  }
 
-    if(View->IsDormant())
+  // Write the actors that are gone.
+  for (auto It = SentStates.begin(); It != SentStates.end();)
+  {
+    if (It->second.Sequence != Header.sequence)
     {
-      const FActorData* ActorData = View->GetActorData();
-      Velocity = TO_METERS * ActorData->Velocity;
-      AngularVelocity = carla::geom::Vector3D
-                        {ActorData->AngularVelocity.X,
-                         ActorData->AngularVelocity.Y,
-                         ActorData->AngularVelocity.Z};
-      Acceleration = FWorldObserver_GetAcceleration(*View, Velocity, DeltaSeconds);
-      State = FWorldObserver_GetDormantActorState(*View, Registry);
+      std::memcpy(position, &It->first, sizeof(It->first));
+      position += sizeof(It->first);
+      ++delta_header.number_of_removed_actors;
+      It = SentStates.erase(It);
     }
     else
     {
-      Velocity = TO_METERS * View->GetActor()->GetVelocity();
-      AngularVelocity = FWorldObserver_GetAngularVelocity(*View->GetActor());
-      Acceleration = FWorldObserver_GetAcceleration(*View, Velocity, DeltaSeconds);
-      State = FWorldObserver_GetActorState(*View, Registry);
+      ++It;
     }
-    ActorTransform = View->GetActorGlobalTransform();
-
-    ActorDynamicState info = {
-      View->GetActorId(),
-      View->GetActorState(),
-      carla::geom::Transform(ActorTransform),
-      carla::geom::Vector3D(Velocity.X, Velocity.Y, Velocity.Z),
-      AngularVelocity,
-      Acceleration,
-      State,
-    };
-    write_data(info);
   }
 
-  // Shrink buffer
-  buffer.resize(current_size);
+  std::memcpy(delta_header_position, &delta_header, sizeof(delta_header));
 
-  check(buffer.size() == current_size);
+  const auto current_size = static_cast<size_t>(position - begin);
+  check(current_size <= max_size);
+  buffer.resize(current_size);
 
   return std::move(buffer);
 }
@@ -367,12 +475,39 @@ void FWorldObserver::BroadcastTick(
   TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
   auto AsyncStream = Stream.MakeAsyncDataStream(*this, Episode.GetElapsedGameTime());
 
-  carla::Buffer buffer = FWorldObserver_Serialize(
-      AsyncStream.PopBufferFromPool(),
+  const auto KeyframeInterval = Episode.GetSettings().StateKeyframeInterval;
+  const bool bSendDeltas = KeyframeInterval > 1;
+  const auto Connections = Stream.GetNumberOfConnections();
+  const bool bNewSubscriber = (Connections != NumberOfConnections);
+  NumberOfConnections = Connections;
+  bool bKeyframe = true;
+  if (!bSendDeltas)
+  {
+    SentStates.clear();
+    DeltasUntilKeyframe = 0u;
+  }
+  else if (MapChange || bNewSubscriber || (Episode.GetId() != LastEpisodeId) || (DeltasUntilKeyframe == 0u))
+  {
+    DeltasUntilKeyframe = static_cast<uint32_t>(KeyframeInterval - 1);
+  }
+  else
+  {
+    bKeyframe = false;
+    --DeltasUntilKeyframe;
+  }
+  LastEpisodeId = Episode.GetId();
+
+  const auto Header = FWorldObserver_MakeHeader(
       Episode,
       DeltaSecond,
       MapChange,
-      PendingLightUpdates);
+      PendingLightUpdates,
+      ++Sequence,
+      bKeyframe);
+
+  carla::Buffer buffer = bKeyframe ?
+      SerializeKeyframe(AsyncStream.PopBufferFromPool(), Episode, Header, DeltaSecond, bSendDeltas) :
+      SerializeDelta(AsyncStream.PopBufferFromPool(), Episode, Header, DeltaSecond);
 
   AsyncStream.Send(*this, std::move(buffer));
 }
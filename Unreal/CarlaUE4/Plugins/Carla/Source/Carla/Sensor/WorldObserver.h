@@ -8,9 +8,23 @@
 
 #include "Carla/Sensor/DataStream.h"
 
+#include <compiler/disable-ue4-macros.h>
+#include <carla/Buffer.h>
+#include <carla/rpc/ActorId.h>
+#include <carla/sensor/data/ActorDynamicState.h>
+#include <carla/sensor/s11n/EpisodeStateSerializer.h>
+#include <compiler/enable-ue4-macros.h>
+
+#include <unordered_map>
+
 class UCarlaEpisode;
 
 /// Serializes and sends all the actors in the current UCarlaEpisode.
+///
+/// If the episode settings have a StateKeyframeInterval greater than one,
+/// only every N-th message contains all the actors, the messages in between
+/// contain the actors and fields that changed since the previous message.
+/// A keyframe is sent as well whenever a new client subscribes.
 class FWorldObserver
 {
 public:
@@ -46,5 +60,48 @@ public:
 
 private:
 
+  using FHeader = carla::sensor::s11n::EpisodeStateSerializer::Header;
+
+  using FActorDynamicState = carla::sensor::data::ActorDynamicState;
+
+  /// Last state sent of an actor.
+  struct FSentActorState
+  {
+    FActorDynamicState State;
+
+    /// Sequence of the last message the actor was part of.
+    uint64_t Sequence;
+  };
+
+  carla::Buffer SerializeKeyframe(
+      carla::Buffer &&Buffer,
+      const UCarlaEpisode &Episode,
+      const FHeader &Header,
+      float DeltaSeconds,
+      bool bTrackSentStates);
+
+  carla::Buffer SerializeDelta(
+      carla::Buffer &&Buffer,
+      const UCarlaEpisode &Episode,
+      const FHeader &Header,
+      float DeltaSeconds);
+
   FDataMultiStream Stream;
+
+  /// Sequence number of the last message sent.
+  uint64_t Sequence = 0u;
+
+  /// Number of deltas to send before the next keyframe.
+  uint32_t DeltasUntilKeyframe = 0u;
+
+  /// Episode of the last message sent.
+  uint64_t LastEpisodeId = 0u;
+
+  /// Number of connections to the stream when the last message was sent, a
+  /// new subscriber needs a keyframe to decode the deltas.
+  size_t NumberOfConnections = 0u;
+
+  /// State of every actor as sent to the clients, only kept while sending
+  /// deltas.
+  std::unordered_map<carla::rpc::ActorId, FSentActorState> SentStates;
 };
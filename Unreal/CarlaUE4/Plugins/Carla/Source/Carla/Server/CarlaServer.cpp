@@ -27,14 +27,18 @@
 #include "Misc/FileHelper.h"
 
 #include <compiler/disable-ue4-macros.h>
+#include <carla/AtomicSharedPtr.h>
 #include <carla/Functional.h>
+#include <carla/ThreadPool.h>
 #include <carla/Version.h>
+#include <carla/geom/OccupancyGrid.h>
 #include <carla/rpc/Actor.h>
 #include <carla/rpc/ActorDefinition.h>
 #include <carla/rpc/ActorDescription.h>
 #include <carla/rpc/BoneTransformDataIn.h>
 #include <carla/rpc/Command.h>
 #include <carla/rpc/CommandResponse.h>
+#include <carla/rpc/ControlBatch.h>
 #include <carla/rpc/DebugShape.h>
 #include <carla/rpc/EnvironmentObject.h>
 #include <carla/rpc/EpisodeInfo.h>
@@ -45,6 +49,7 @@
 #include <carla/rpc/MapLayer.h>
 #include <carla/rpc/Response.h>
 #include <carla/rpc/Server.h>
+#include <carla/rpc/SpawnActorsBulk.h>
 #include <carla/rpc/String.h>
 #include <carla/rpc/Transform.h>
 #include <carla/rpc/Vector2D.h>
@@ -60,6 +65,7 @@
 #include <carla/rpc/VehicleWheels.h>
 #include <carla/rpc/WeatherParameters.h>
 #include <carla/streaming/Server.h>
+#include <boost/optional.hpp>
 #include <carla/rpc/Texture.h>
 #include <carla/rpc/MaterialParameter.h>
 #include <compiler/enable-ue4-macros.h>
@@ -110,11 +116,87 @@ public:
 
   size_t TickCuesReceived = 0u;
 
+  /// State answered by the read-only functions. It is published by the game
+  /// thread so these functions never touch the episode from the worker
+  /// threads.
+  struct FReadOnlyState
+  {
+    uint64_t Frame = 0u;
+
+    carla::rpc::EpisodeInfo EpisodeInfo;
+
+    carla::rpc::EpisodeSettings EpisodeSettings;
+
+    boost::optional<carla::rpc::WeatherParameters> Weather;
+
+    boost::optional<carla::rpc::Actor> Spectator;
+
+    /// Constant during the episode, shared between snapshots.
+    std::shared_ptr<const carla::rpc::MapInfo> MapInfo;
+
+    /// Constant during the episode, shared between snapshots.
+    std::shared_ptr<const std::vector<carla::rpc::ActorDefinition>> ActorDefinitions;
+  };
+
+  carla::AtomicSharedPtr<const FReadOnlyState> ReadOnlyState;
+
+  /// Publish a new read-only state, at most once per frame unless @a bForce
+  /// is set (after a function modifies the published state).
+  void PublishReadOnlyState(bool bForce = false);
+
 private:
 
   void BindActions();
 };
 
+void FCarlaServer::FPimpl::PublishReadOnlyState(bool bForce)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
+  if (Episode == nullptr)
+  {
+    // Keep answering with the last state while the next map loads.
+    return;
+  }
+  const uint64_t Frame = FCarlaEngine::GetFrameCounter();
+  auto Previous = ReadOnlyState.load();
+  if (!bForce && Previous != nullptr && Previous->Frame == Frame &&
+      Previous->EpisodeInfo.id == Episode->GetId())
+  {
+    return;
+  }
+  auto State = std::make_shared<FReadOnlyState>();
+  State->Frame = Frame;
+  State->EpisodeInfo = carla::rpc::EpisodeInfo{Episode->GetId(), BroadcastStream.token()};
+  State->EpisodeSettings = carla::rpc::EpisodeSettings{Episode->GetSettings()};
+  if (auto *Weather = Episode->GetWeather())
+  {
+    State->Weather = Weather->GetCurrentWeather();
+  }
+  if (FCarlaActor* Spectator = Episode->FindCarlaActor(Episode->GetSpectatorPawn()))
+  {
+    State->Spectator = Episode->SerializeActor(Spectator);
+  }
+  if (Previous != nullptr && Previous->EpisodeInfo.id == Episode->GetId())
+  {
+    State->MapInfo = Previous->MapInfo;
+    State->ActorDefinitions = Previous->ActorDefinitions;
+  }
+  else
+  {
+    ACarlaGameModeBase* GameMode = UCarlaStatics::GetGameMode(Episode->GetWorld());
+    const auto &SpawnPoints = Episode->GetRecommendedSpawnPoints();
+    FString FullMapPath = GameMode->GetFullMapPath();
+    FString MapDir = FullMapPath.RightChop(FullMapPath.Find("Content/", ESearchCase::CaseSensitive) + 8);
+    MapDir += "/" + Episode->GetMapName();
+    State->MapInfo = std::make_shared<const carla::rpc::MapInfo>(carla::rpc::MapInfo{
+        carla::rpc::FromFString(MapDir),
+        MakeVectorFromTArray<carla::geom::Transform>(SpawnPoints)});
+    State->ActorDefinitions = std::make_shared<const std::vector<carla::rpc::ActorDefinition>>(
+        MakeVectorFromTArray<carla::rpc::ActorDefinition>(Episode->GetActorDefinitions()));
+  }
+  ReadOnlyState = std::move(State);
+}
+
 // =============================================================================
 // -- Define helper macros -----------------------------------------------------
 // =============================================================================
@@ -156,25 +238,36 @@ carla::rpc::ResponseError RespondError(
   return RespondError(FuncName, GetStringError(Error), ExtraInfo);
 }
 
+enum class EServerBindMode
+{
+  Sync,
+  Async,
+  ReadOnly
+};
+
 class ServerBinder
 {
 public:
 
-  constexpr ServerBinder(const char *name, carla::rpc::Server &srv, bool sync)
+  constexpr ServerBinder(const char *name, carla::rpc::Server &srv, EServerBindMode mode)
     : _name(name),
       _server(srv),
-      _sync(sync) {}
+      _mode(mode) {}
 
   template <typename FuncT>
   auto operator<<(FuncT func)
   {
-    if (_sync)
-    {
-      _server.BindSync(_name, func);
-    }
-    else
+    switch (_mode)
     {
-      _server.BindAsync(_name, func);
+      case EServerBindMode::Sync:
+        _server.BindSync(_name, func);
+        break;
+      case EServerBindMode::Async:
+        _server.BindAsync(_name, func);
+        break;
+      case EServerBindMode::ReadOnly:
+        _server.BindReadOnly(_name, func);
+        break;
     }
     return func;
   }
@@ -185,11 +278,17 @@ private:
 
   carla::rpc::Server &_server;
 
-  bool _sync;
+  EServerBindMode _mode;
 };
 
-#define BIND_SYNC(name)   auto name = ServerBinder(# name, Server, true)
-#define BIND_ASYNC(name)  auto name = ServerBinder(# name, Server, false)
+#define BIND_SYNC(name)      auto name = ServerBinder(# name, Server, EServerBindMode::Sync)
+#define BIND_ASYNC(name)     auto name = ServerBinder(# name, Server, EServerBindMode::Async)
+/// Runs in the worker threads, must only read the published ReadOnlyState.
+#define BIND_READ_ONLY(name) auto name = ServerBinder(# name, Server, EServerBindMode::ReadOnly)
+
+#define REQUIRE_READ_ONLY_STATE() \
+    auto State = ReadOnlyState.load(); \
+    if (State == nullptr) { RESPOND_ERROR("episode not ready"); }
 
 // =============================================================================
 // -- Bind Actions -------------------------------------------------------------
@@ -430,23 +529,16 @@ void FCarlaServer::FPimpl::BindActions()
 
   // ~~ Episode settings and info ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
+  BIND_READ_ONLY(get_episode_info) << [this]() -> R<cr::EpisodeInfo>
   {
-    REQUIRE_CARLA_EPISODE();
-    return cr::EpisodeInfo{Episode->GetId(), BroadcastStream.token()};
+    REQUIRE_READ_ONLY_STATE();
+    return State->EpisodeInfo;
   };
 
-  BIND_SYNC(get_map_info) << [this]() -> R<cr::MapInfo>
+  BIND_READ_ONLY(get_map_info) << [this]() -> R<cr::MapInfo>
   {
-    REQUIRE_CARLA_EPISODE();
-    ACarlaGameModeBase* GameMode = UCarlaStatics::GetGameMode(Episode->GetWorld());
-    const auto &SpawnPoints = Episode->GetRecommendedSpawnPoints();
-    FString FullMapPath = GameMode->GetFullMapPath();
-    FString MapDir = FullMapPath.RightChop(FullMapPath.Find("Content/", ESearchCase::CaseSensitive) + 8);
-    MapDir += "/" + Episode->GetMapName();
-    return cr::MapInfo{
-      cr::FromFString(MapDir),
-      MakeVectorFromTArray<cg::Transform>(SpawnPoints)};
+    REQUIRE_READ_ONLY_STATE();
+    return *State->MapInfo;
   };
 
   BIND_SYNC(get_map_data) << [this]() -> R<std::string>
@@ -511,10 +603,10 @@ void FCarlaServer::FPimpl::BindActions()
     return Result;
   };
 
-  BIND_SYNC(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
+  BIND_READ_ONLY(get_episode_settings) << [this]() -> R<cr::EpisodeSettings>
   {
-    REQUIRE_CARLA_EPISODE();
-    return cr::EpisodeSettings{Episode->GetSettings()};
+    REQUIRE_READ_ONLY_STATE();
+    return State->EpisodeSettings;
   };
 
   BIND_SYNC(set_episode_settings) << [this](
@@ -523,24 +615,24 @@ void FCarlaServer::FPimpl::BindActions()
     REQUIRE_CARLA_EPISODE();
     Episode->ApplySettings(settings);
     StreamingServer.SetSynchronousMode(settings.synchronous_mode);
+    PublishReadOnlyState(true);
     return FCarlaEngine::GetFrameCounter();
   };
 
-  BIND_SYNC(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
+  BIND_READ_ONLY(get_actor_definitions) << [this]() -> R<std::vector<cr::ActorDefinition>>
   {
-    REQUIRE_CARLA_EPISODE();
-    return MakeVectorFromTArray<cr::ActorDefinition>(Episode->GetActorDefinitions());
+    REQUIRE_READ_ONLY_STATE();
+    return *State->ActorDefinitions;
   };
 
-  BIND_SYNC(get_spectator) << [this]() -> R<cr::Actor>
+  BIND_READ_ONLY(get_spectator) << [this]() -> R<cr::Actor>
   {
-    REQUIRE_CARLA_EPISODE();
-    FCarlaActor* CarlaActor = Episode->FindCarlaActor(Episode->GetSpectatorPawn());
-    if (!CarlaActor)
+    REQUIRE_READ_ONLY_STATE();
+    if (!State->Spectator.has_value())
     {
       RESPOND_ERROR("internal error: unable to find spectator");
     }
-    return Episode->SerializeActor(CarlaActor);
+    return *State->Spectator;
   };
 
   BIND_SYNC(get_all_level_BBs) << [this](uint8 QueriedTag) -> R<std::vector<cg::BoundingBox>>
@@ -605,15 +697,14 @@ void FCarlaServer::FPimpl::BindActions()
 
   // ~~ Weather ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-  BIND_SYNC(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
+  BIND_READ_ONLY(get_weather_parameters) << [this]() -> R<cr::WeatherParameters>
   {
-    REQUIRE_CARLA_EPISODE();
-    auto *Weather = Episode->GetWeather();
-    if (Weather == nullptr)
+    REQUIRE_READ_ONLY_STATE();
+    if (!State->Weather.has_value())
     {
       RESPOND_ERROR("internal error: unable to find weather");
     }
-    return Weather->GetCurrentWeather();
+    return *State->Weather;
   };
 
   BIND_SYNC(set_weather_parameters) << [this](
@@ -626,6 +717,7 @@ void FCarlaServer::FPimpl::BindActions()
       RESPOND_ERROR("internal error: unable to find weather");
     }
     Weather->ApplyWeather(weather);
+    PublishReadOnlyState(true);
     return R<void>::Success();
   };
 
@@ -2088,6 +2180,137 @@ void FCarlaServer::FPimpl::BindActions()
     return result;
   };
 
+  BIND_SYNC(apply_control_batch) << [=](
+      const cr::ControlBatch &batch,
+      bool do_tick_cue) -> std::vector<ActorId>
+  {
+    std::vector<ActorId> failed;
+    for (size_t i = 0u; i < batch.GetNumberOfVehicleControls(); ++i)
+    {
+      const ActorId Id = batch.GetVehicleId(i);
+      if (apply_control_to_vehicle(Id, batch.GetVehicleControl(i)).HasError())
+      {
+        failed.emplace_back(Id);
+      }
+    }
+    for (size_t i = 0u; i < batch.GetNumberOfVehicleLightStates(); ++i)
+    {
+      const ActorId Id = batch.GetLightStateVehicleId(i);
+      if (set_vehicle_light_state(Id, batch.GetVehicleLightState(i)).HasError())
+      {
+        failed.emplace_back(Id);
+      }
+    }
+    for (size_t i = 0u; i < batch.GetNumberOfWalkerControls(); ++i)
+    {
+      const ActorId Id = batch.GetWalkerId(i);
+      if (apply_control_to_walker(Id, batch.GetWalkerControl(i)).HasError())
+      {
+        failed.emplace_back(Id);
+      }
+    }
+    if (do_tick_cue)
+    {
+      tick_cue();
+    }
+    return failed;
+  };
+
+  BIND_SYNC(spawn_actors_bulk) << [=](
+      const cr::SpawnActorsBulk &Request,
+      bool do_tick_cue) -> R<std::vector<CR>>
+  {
+    REQUIRE_CARLA_EPISODE();
+
+    const std::vector<cr::Transform> RecommendedSpawnPoints =
+        Request.spawn_points.empty() ?
+            MakeVectorFromTArray<cr::Transform>(Episode->GetRecommendedSpawnPoints()) :
+            std::vector<cr::Transform>{};
+    const auto &SpawnPoints = Request.spawn_points.empty() ?
+        RecommendedSpawnPoints :
+        Request.spawn_points;
+
+    // Every vehicle and walker occupies its location, the candidates closer
+    // than the minimum distance are skipped without trying to spawn there.
+    carla::geom::OccupancyGrid Occupancy(Request.min_distance);
+    for (auto It = Episode->GetActorRegistry().begin(); It != Episode->GetActorRegistry().end(); ++It)
+    {
+      const FCarlaActor &View = *(It.Value().Get());
+      if ((View.GetActorType() == FCarlaActor::ActorType::Vehicle) ||
+          (View.GetActorType() == FCarlaActor::ActorType::Walker))
+      {
+        Occupancy.Occupy(View.GetActorGlobalLocation());
+      }
+    }
+
+    ALargeMapManager* LargeMap = UCarlaStatics::GetLargeMapManager(Episode->GetWorld());
+    const uint32 NumberOfDefinitions = static_cast<uint32>(Episode->GetActorDefinitions().Num());
+
+    std::vector<CR> Result;
+    Result.reserve(Request.descriptions.size());
+    size_t NextSpawnPoint = 0u;
+    for (const auto &Description : Request.descriptions)
+    {
+      // Resolve the blueprint before looking for a spawn point, an invalid
+      // description never consumes one.
+      if ((Description.uid == 0u) || (Description.uid > NumberOfDefinitions))
+      {
+        Result.emplace_back(cr::ResponseError(carla::rpc::FromFString(
+            FActorSpawnResult::StatusToString(EActorSpawnResultStatus::InvalidDescription))));
+        continue;
+      }
+      const FActorDescription UnrealDescription = Description;
+
+      TPair<EActorSpawnResultStatus, FCarlaActor*> Spawned{EActorSpawnResultStatus::UnknownError, nullptr};
+      while (NextSpawnPoint < SpawnPoints.size())
+      {
+        const cr::Transform &SpawnPoint = SpawnPoints[NextSpawnPoint];
+        if (!Occupancy.IsFree(SpawnPoint.location))
+        {
+          ++NextSpawnPoint;
+          continue;
+        }
+        Spawned = Episode->SpawnActorWithInfo(SpawnPoint, UnrealDescription);
+        if (Spawned.Key == EActorSpawnResultStatus::Collision)
+        {
+          // Something not registered as an actor is in the way.
+          Occupancy.Occupy(SpawnPoint.location);
+          ++NextSpawnPoint;
+          continue;
+        }
+        if (Spawned.Key == EActorSpawnResultStatus::Success)
+        {
+          Occupancy.Occupy(SpawnPoint.location);
+          ++NextSpawnPoint;
+        }
+        break;
+      }
+
+      if (Spawned.Key == EActorSpawnResultStatus::Success)
+      {
+        if (LargeMap)
+        {
+          LargeMap->OnActorSpawned(*Spawned.Value);
+        }
+        Result.emplace_back(Spawned.Value->GetActorId());
+      }
+      else if (NextSpawnPoint >= SpawnPoints.size())
+      {
+        Result.emplace_back(cr::ResponseError("no free spawn point left"));
+      }
+      else
+      {
+        Result.emplace_back(cr::ResponseError(carla::rpc::FromFString(
+            FActorSpawnResult::StatusToString(Spawned.Key))));
+      }
+    }
+    if (do_tick_cue)
+    {
+      tick_cue();
+    }
+    return Result;
+  };
+
   // ~~ Light Subsystem ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
   BIND_SYNC(query_lights_state) << [this](std::string client) -> R<std::vector<cr::LightState>>
@@ -2160,6 +2383,8 @@ void FCarlaServer::FPimpl::BindActions()
 // =============================================================================
 
 #undef BIND_ASYNC
+#undef REQUIRE_READ_ONLY_STATE
+#undef BIND_READ_ONLY
 #undef BIND_SYNC
 #undef REQUIRE_CARLA_EPISODE
 #undef RESPOND_ERROR_FSTRING
@@ -2192,6 +2417,7 @@ void FCarlaServer::NotifyBeginEpisode(UCarlaEpisode &Episode)
   check(Pimpl != nullptr);
   UE_LOG(LogCarlaServer, Log, TEXT("New episode '%s' started"), *Episode.GetMapName());
   Pimpl->Episode = &Episode;
+  Pimpl->PublishReadOnlyState(true);
 }
 
 void FCarlaServer::NotifyEndEpisode()
@@ -2200,36 +2426,69 @@ void FCarlaServer::NotifyEndEpisode()
   Pimpl->Episode = nullptr;
 }
 
+/// Number of threads and CPU affinity of one of the servers, from the command
+/// line (-<Name>Threads=N, -<Name>ThreadAffinity=0-3,8) or else from the
+/// environment (CARLA_<PREFIX>_THREADS, CARLA_<PREFIX>_CPU_AFFINITY).
+static carla::ThreadPoolOptions FCarlaServer_GetThreadPoolOptions(
+    const TCHAR *Name,
+    const TCHAR *EnvironmentPrefix,
+    uint32 DefaultThreads)
+{
+  carla::ThreadPoolOptions Options;
+  int32 Threads = 0;
+  if (!FParse::Value(FCommandLine::Get(), *FString::Printf(TEXT("-%sThreads="), Name), Threads))
+  {
+    Threads = FCString::Atoi(*FPlatformMisc::GetEnvironmentVariable(
+        *FString::Printf(TEXT("CARLA_%s_THREADS"), EnvironmentPrefix)));
+  }
+  Options.threads = Threads > 0 ? static_cast<size_t>(Threads) : DefaultThreads;
+  FString Affinity;
+  if (!FParse::Value(FCommandLine::Get(), *FString::Printf(TEXT("-%sThreadAffinity="), Name), Affinity))
+  {
+    Affinity = FPlatformMisc::GetEnvironmentVariable(
+        *FString::Printf(TEXT("CARLA_%s_CPU_AFFINITY"), EnvironmentPrefix));
+  }
+  if (!Affinity.IsEmpty())
+  {
+    Options.cpu_affinity = carla::ParseCpuList(TCHAR_TO_UTF8(*Affinity));
+    if (Options.cpu_affinity.empty())
+    {
+      UE_LOG(LogCarla, Warning, TEXT("Ignoring invalid %s thread affinity \"%s\""), Name, *Affinity);
+    }
+  }
+  return Options;
+}
+
 void FCarlaServer::AsyncRun(uint32 NumberOfWorkerThreads)
 {
   check(Pimpl != nullptr);
   /// @todo Define better the number of threads each server gets.
-  int32_t RPCThreads = std::max(2u, NumberOfWorkerThreads / 2u);
-  int32_t StreamingThreads = std::max(2u, NumberOfWorkerThreads - RPCThreads);
+  const auto RPCOptions = FCarlaServer_GetThreadPoolOptions(
+      TEXT("RPC"), TEXT("RPC_SERVER"), std::max(2u, NumberOfWorkerThreads / 2u));
+  const uint32 RemainingThreads = NumberOfWorkerThreads > RPCOptions.threads ?
+      NumberOfWorkerThreads - static_cast<uint32>(RPCOptions.threads) : 0u;
+  const auto StreamingOptions = FCarlaServer_GetThreadPoolOptions(
+      TEXT("Streaming"), TEXT("STREAMING_SERVER"), std::max(2u, RemainingThreads));
 
   UE_LOG(LogCarla, Log, TEXT("FCommandLine %s"), FCommandLine::Get());
 
-  if(!FParse::Value(FCommandLine::Get(), TEXT("-RPCThreads="), RPCThreads))
-  {
-    RPCThreads = std::max(2u, NumberOfWorkerThreads / 2u);
-  }
-  if(!FParse::Value(FCommandLine::Get(), TEXT("-StreamingThreads="), StreamingThreads))
-  {
-    StreamingThreads = std::max(2u, NumberOfWorkerThreads - RPCThreads);
-  }
-
-  UE_LOG(LogCarla, Log, TEXT("FCarlaServer AsyncRun %d, RPCThreads %d, StreamingThreads %d"),
-        NumberOfWorkerThreads, RPCThreads, StreamingThreads);
+  UE_LOG(LogCarla, Log, TEXT("FCarlaServer AsyncRun %d, RPCThreads %d (%d pinned CPUs), StreamingThreads %d (%d pinned CPUs)"),
+        NumberOfWorkerThreads,
+        static_cast<int32>(RPCOptions.threads),
+        static_cast<int32>(RPCOptions.cpu_affinity.size()),
+        static_cast<int32>(StreamingOptions.threads),
+        static_cast<int32>(StreamingOptions.cpu_affinity.size()));
 
-  Pimpl->Server.AsyncRun(RPCThreads);
-  Pimpl->StreamingServer.AsyncRun(StreamingThreads);
+  Pimpl->Server.AsyncRun(RPCOptions);
+  Pimpl->StreamingServer.AsyncRun(StreamingOptions);
 
 }
 
 void FCarlaServer::RunSome(uint32 Milliseconds)
 {
   TRACE_CPUPROFILER_EVENT_SCOPE_STR(__FUNCTION__);
-  Pimpl->Server.SyncRunFor(carla::time_duration::milliseconds(Milliseconds));
+  Pimpl->PublishReadOnlyState();
+  Pimpl->Server.SyncRunSome(carla::time_duration::milliseconds(Milliseconds));
 }
 
 bool FCarlaServer::TickCueReceived()
@@ -37,4 +37,9 @@ struct CARLA_API FEpisodeSettings
 
   float ActorActiveDistance = 200000.f; // 3km
 
+  /// Number of episode state messages between two keyframes, the messages in
+  /// between only carry the actors that changed. 0 or 1 disables the deltas.
+  UPROPERTY(EditAnywhere, BlueprintReadWrite)
+  int StateKeyframeInterval = 1;
+
 };
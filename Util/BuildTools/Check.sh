@@ -163,6 +163,10 @@ if ${LIBCARLA_RELEASE} ; then
 
   fi
 
+  log "Running LibCarla.client allocation tests (release)."
+  echo "Running: ${GDB} libcarla_test_client_allocations_release ${GTEST_ARGS}"
+  ${GDB} ${LIBCARLA_INSTALL_CLIENT_FOLDER}/test/libcarla_test_client_allocations_release ${GTEST_ARGS}
+
 fi
 
 # ==============================================================================